@@ -0,0 +1,120 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+// Geometry navigation benchmark: builds the DSPS geometry without physics, fires
+// straight-line rays from random points in the detector medium through it and reports
+// the time per navigation step and the memory taken by the voxel structures. Usage:
+//   ./NavigationBenchmark [rays] [macro ...]
+// The macros run after macros/parameters_detector.mac, e.g. to change
+// /geometry/detector/medium/smartless or /geometry/hierarchical.
+
+#include "DetectorConstruction.hh"
+#include "ConstructionMessenger.hh"
+#include "Materials.hh"
+
+#include "G4GeometryManager.hh"
+#include "G4Navigator.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4UImanager.hh"
+#include "Randomize.hh"
+
+#include<chrono>
+#include<fstream>
+#include<unistd.h>
+
+// resident memory of this process
+G4double get_memory() {
+    std::ifstream statm( "/proc/self/statm" );
+    G4double size{ 0 }, resident{ 0 };
+    statm >> size >> resident;
+    return resident * sysconf( _SC_PAGESIZE ) / ( 1024 * 1024 );
+}
+
+int main( int argc, char** argv ) {
+    ConstructionMessenger* constructionMessenger = ConstructionMessenger::get_instance();
+    G4UImanager          * UImanager             = G4UImanager::GetUIpointer();
+
+    G4int rays = ( argc > 1 ) ? std::stoi( argv[ 1 ] ) : 100000;
+    UImanager->ApplyCommand( "/control/execute macros/parameters_detector.mac" );
+    UImanager->ApplyCommand( "/geometry/checkOverlaps false" );
+    for( G4int nArgument{ 2 }; nArgument < argc; nArgument++ )
+        UImanager->ApplyCommand( G4String( "/control/execute " ) + argv[ nArgument ] );
+
+    // Build and voxelise the geometry
+    DetectorConstruction* detectorConstruction = new DetectorConstruction( false );
+    auto time_construct = std::chrono::steady_clock::now();
+    G4VPhysicalVolume* world = detectorConstruction->Construct();
+    G4double memory_constructed = get_memory();
+    auto time_close = std::chrono::steady_clock::now();
+    G4GeometryManager::GetInstance()->CloseGeometry( true, false );
+    G4double memory_closed = get_memory();
+    auto time_run = std::chrono::steady_clock::now();
+
+    // Fire the rays
+    G4Navigator navigator;
+    navigator.SetWorldVolume( world );
+    G4ThreeVector halfSize = detectorConstruction->get_mediums().at(0)->get_size() / 2;
+    CLHEP::HepRandom::setTheSeed( 12345 );
+
+    G4long   steps    { 0      };
+    G4long   steps_max{ 100000 }; // per ray, in case a ray gets stuck on a surface
+    G4double safety   { 0      };
+    for( G4int nRay{ 0 }; nRay < rays; nRay++ ) {
+        G4ThreeVector position( ( 2 * G4UniformRand() - 1 ) * halfSize.x(), 
+                                ( 2 * G4UniformRand() - 1 ) * halfSize.y(), 
+                                ( 2 * G4UniformRand() - 1 ) * halfSize.z() );
+        G4double cosTheta = 2 * G4UniformRand() - 1;
+        G4double phi      = twopi * G4UniformRand();
+        G4ThreeVector direction( std::sqrt( 1 - cosTheta * cosTheta ) * std::cos( phi ), 
+                                 std::sqrt( 1 - cosTheta * cosTheta ) * std::sin( phi ), 
+                                 cosTheta );
+
+        navigator.LocateGlobalPointAndSetup( position, &direction, false, false );
+        for( G4long nStep{ 0 }; nStep < steps_max; nStep++ ) {
+            G4double step = navigator.ComputeStep( position, direction, kInfinity, safety );
+            if( step == kInfinity )
+                break;
+            position += step * direction;
+            navigator.SetGeometricallyLimitedStep();
+            G4VPhysicalVolume* volume = navigator.LocateGlobalPointAndSetup( position, &direction, true );
+            steps++;
+            if( !volume )
+                break;
+        }
+    }
+    auto time_done = std::chrono::steady_clock::now();
+
+    auto get_seconds = []( std::chrono::steady_clock::time_point t_begin, std::chrono::steady_clock::time_point t_end ) {
+        return std::chrono::duration< G4double >( t_end - t_begin ).count();
+    };
+    G4double time_run_ns = 1e9 * get_seconds( time_run, time_done );
+    G4cout << "[-]==: Navigation benchmark"                                                                           << G4endl
+           << " |--< hierarchical >-------------: " << constructionMessenger->get_hierarchical            ()          << G4endl
+           << " |--< parameterised >------------: " << constructionMessenger->get_parameterised           ()          << G4endl
+           << " |--< calorimeters_merged >------: " << constructionMessenger->get_calorimeters_merged     ()          << G4endl
+           << " |--< detector_medium_smartless >: " << constructionMessenger->get_detector_medium_smartless()         << G4endl
+           << " |--< detector_medium_optimise >-: " << constructionMessenger->get_detector_medium_optimise ()         << G4endl
+           << " |--< voxels_max >---------------: " << constructionMessenger->get_voxels_max              ()          << G4endl
+           << " |--< construction [s] >---------: " << get_seconds( time_construct, time_close )                      << G4endl
+           << " |--< voxelisation [s] >---------: " << get_seconds( time_close    , time_run   )                      << G4endl
+           << " |--< voxel memory [MB] >--------: " << memory_closed - memory_constructed                             << G4endl
+           << " |--< total memory [MB] >--------: " << memory_closed                                                  << G4endl
+           << " |--< rays >---------------------: " << rays                                                           << G4endl
+           << " |--< steps per ray >------------: " << ( ( rays  > 0 ) ? G4double( steps ) / rays : 0 )               << G4endl
+           << " |--< time per step [ns] >-------: " << ( ( steps > 0 ) ? time_run_ns / steps      : 0 )               << G4endl;
+
+    G4GeometryManager::GetInstance()->OpenGeometry();
+    delete detectorConstruction;
+    ConstructionMessenger::delete_instance();
+    Materials            ::delete_instance();
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include "EventAction.hh"
 #include "SteppingAction.hh"
 #include "StackingAction.hh"
+#include "TrackingAction.hh"
 #include "OutputMessenger.hh"
 #include "DetectorConstruction.hh"
 #include "ParticleGunMessenger.hh"
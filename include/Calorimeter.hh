@@ -18,11 +18,15 @@
 #include "GeometricObject.hh"
 #include "ConstructionMessenger.hh"
 #include "CalorimeterSensitiveDetector.hh"
+#include "Wall.hh"
 
+// With merged walls the calorimeters only record where their CalorimeterLattice placed
+// them; they share the solid and logical volume of another calorimeter.
 class Calorimeter
 {
     public:
         Calorimeter( G4String, G4String, G4ThreeVector );
+        Calorimeter( G4String, G4String, Calorimeter*  );
        ~Calorimeter();
 
         static G4ThreeVector get_size  ();
@@ -31,6 +35,7 @@ class Calorimeter
         static G4double      get_depth ();
         
         G4String                      get_name             ();
+        G4Box                       * get_solid            ();
         G4LogicalVolume             * get_logicalVolume    ();
         CalorimeterSensitiveDetector* get_sensitiveDetector();
         G4ThreeVector                 get_position         ();
@@ -38,12 +43,15 @@ class Calorimeter
 
         void set_sensitiveDetector( CalorimeterSensitiveDetector* );
 
-        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool );
+        void place ( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool, G4int = -1 );
+        void place ( G4RotationMatrix*, G4ThreeVector, Wall*                                );
+        void locate( G4RotationMatrix*, G4ThreeVector                                       );
 
     protected:
         ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
 
         GeometricObjectBox* m_calorimeter{ nullptr };
+        G4bool              m_isShared   { false   };
         CalorimeterSensitiveDetector* m_calorimeterSensitiveDetector{ nullptr };
 
         G4String          m_name;
@@ -14,7 +14,6 @@
 
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Transform3D.hh"
@@ -25,6 +24,7 @@
 #include "G4VisAttributes.hh"
 
 #include "ConstructionMessenger.hh"
+#include "EventArena.hh"
 
 class CalorimeterHit : public G4VHit
 {
@@ -64,14 +64,14 @@ class CalorimeterHit : public G4VHit
 
         G4ThreeVector     get_calorimeter_position       ();
         G4RotationMatrix* get_calorimeter_rotationMatrix ();
-        G4String          get_calorimeter_name           ();
+        const G4String&   get_calorimeter_name           ();
         G4int             get_calorimeter_ID             ();
         G4ThreeVector     get_hit_position_absolute      ();
         G4ThreeVector     get_hit_position_relative      ();
         G4double          get_hit_time                   ();
         G4double          get_hit_energy                 ();
         G4ThreeVector     get_hit_momentum               ();
-        G4String          get_hit_process                ();
+        const G4String&   get_hit_process                ();
         G4double          get_particle_energy            ();
         G4ThreeVector     get_particle_momentum          ();
         G4ThreeVector     get_particle_position_initial  ();
@@ -80,14 +80,14 @@ class CalorimeterHit : public G4VHit
 
     protected:
         G4ThreeVector     m_calorimeter_position      ;
-        G4RotationMatrix* m_calorimeter_rotationMatrix;
-        G4String          m_calorimeter_name          ;
+        G4RotationMatrix* m_calorimeter_rotationMatrix{ nullptr };
+        const G4String*   m_calorimeter_name          { nullptr };
         G4int             m_calorimeter_ID            ;
         G4ThreeVector     m_hit_position              ;
         G4double          m_hit_time                  ;
         G4double          m_hit_energy                ;
         G4ThreeVector     m_hit_momentum              ;
-        G4String          m_hit_process               ;
+        const G4String*   m_hit_process               { nullptr };
         G4double          m_particle_energy           ;
         G4ThreeVector     m_particle_momentum         ;
         G4ThreeVector     m_particle_position_initial ;
@@ -97,17 +97,12 @@ class CalorimeterHit : public G4VHit
 
 using CalorimeterHitsCollection = G4THitsCollection< CalorimeterHit >;
 
-extern G4ThreadLocal G4Allocator< CalorimeterHit >* CalorimeterHitAllocator;
-
 inline void* CalorimeterHit::operator new( size_t ) {
-    if( CalorimeterHitAllocator == nullptr )
-        CalorimeterHitAllocator = new G4Allocator< CalorimeterHit >;
-
-    return ( void* )CalorimeterHitAllocator->MallocSingle();
+    return EventArena::get_instance()->allocate( sizeof( CalorimeterHit ), alignof( CalorimeterHit ) );
 }
 
-inline void CalorimeterHit::operator delete( void* t_hit ) {
-    CalorimeterHitAllocator->FreeSingle( ( CalorimeterHit* ) t_hit );
+// Memory is reclaimed all at once by EventArena::reset().
+inline void CalorimeterHit::operator delete( void* ) {
 }
 
 #endif
\ No newline at end of file
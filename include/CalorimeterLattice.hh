@@ -0,0 +1,70 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef CalorimeterLattice_hh
+#define CalorimeterLattice_hh
+
+#include "globals.hh"
+#include "G4MultiUnion.hh"
+#include "G4Transform3D.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+
+#include "GeometricObject.hh"
+#include "ConstructionMessenger.hh"
+#include "Wall.hh"
+
+// All calorimeters of one wall merged into a single G4MultiUnion, so the navigator sees
+// one volume per wall instead of one per calorimeter. The calorimeter that was hit is
+// recovered from the position in the wall frame (see get_ID()): the middle calorimeters
+// sit on the corners of the DSPD grid, the horizontal ones between two middle ones along
+// x and the vertical ones between two middle ones along y (see place_surface). The IDs
+// of the horizontal, vertical and middle calorimeters follow each other in the order of
+// the loops in place_surface, starting at the ID given to the constructor.
+class CalorimeterLattice
+{
+    public:
+        CalorimeterLattice( const G4String&, G4int, G4int, G4int );
+       ~CalorimeterLattice();
+
+        void add_calorimeter( G4VSolid*, G4RotationMatrix*, G4ThreeVector );
+        void set_grid       ( G4ThreeVector, G4ThreeVector, G4ThreeVector, G4ThreeVector );
+        void place          ( Wall*, G4int );
+
+        G4int             get_ID           ( G4ThreeVector ) const;
+        G4String          get_name         (               ) const;
+        G4LogicalVolume * get_logicalVolume(               ) const;
+
+        void set_sensitiveDetector( G4VSensitiveDetector* );
+
+    protected:
+        ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
+
+        GeometricObjectVSolid* m_lattice{ new GeometricObjectVSolid() };
+        G4MultiUnion         * m_solid  { nullptr                     };
+
+        G4String      m_name           ;
+        G4int         m_amount_x       ;
+        G4int         m_amount_y       ;
+        G4int         m_ID_horizontal  ;
+        G4int         m_ID_vertical    ;
+        G4int         m_ID_middle      ;
+        G4ThreeVector m_position_middle;
+        G4ThreeVector m_step_x         ;
+        G4ThreeVector m_step_y         ;
+        G4double      m_offset_x       ; // DSPD column relative to the middle calorimeter column, in steps
+        G4double      m_offset_y       ;
+        G4double      m_halfHeight_x   ; // half height of the middle calorimeters, in steps
+        G4double      m_halfHeight_y   ;
+};
+
+#endif
@@ -22,9 +22,20 @@
 #include "OutputManager.hh"
 #include "CalorimeterHit.hh"
 #include "Track.hh"
+#include "CopyNumberMap.hh"
+#include "CalorimeterLattice.hh"
+#include "SurfaceLattice.hh"
 
 using std::to_string;
+using std::vector;
+using std::pair;
 
+// Either attached to a single calorimeter (ID and placement given here), or shared by
+// the calorimeters of parameterised or merged walls: then the ID follows from the copy
+// numbers of the touched volume with the map added for its logical volume, or from the
+// hit position in the touched calorimeter lattice. The copies are added in ID order
+// (add_copy()), or are the calorimeters of the surface lattices of parameterised faces
+// (add_surfaceLattice()), named only when hit.
 class CalorimeterSensitiveDetector : public G4VSensitiveDetector 
 {
     public:
@@ -34,10 +45,13 @@ class CalorimeterSensitiveDetector : public G4VSensitiveDetector
         void Initialize( G4HCofThisEvent* ) override;
         G4bool ProcessHits( G4Step*, G4TouchableHistory* ) override;
 
-        G4String                   get_name               (                );
+        const G4String           & get_name               (                );
+        const G4String           & get_name               ( G4int          );
         G4int                      get_ID                 (                );
         G4ThreeVector              get_position           (                );
+        G4ThreeVector              get_position           ( G4int          );
         G4RotationMatrix         * get_rotationMatrix     (                );
+        G4RotationMatrix         * get_rotationMatrix     ( G4int          );
         CalorimeterHitsCollection* get_hitsCollection     ( const G4Event* );
         G4String                   get_hitsCollection_name(                );
         G4int                      get_hitsCollection_ID  (                );
@@ -45,16 +59,32 @@ class CalorimeterSensitiveDetector : public G4VSensitiveDetector
         void set_position         ( G4ThreeVector     );
         void set_rotationMatrix   ( G4RotationMatrix* );
         void set_hitsCollection_ID( G4int             );
+
+        void add_copy              ( const G4String&          , G4ThreeVector, G4RotationMatrix* );
+        void add_copyNumberMap     ( G4LogicalVolume*         , const CopyNumberMap&             );
+        void add_calorimeterLattice( const CalorimeterLattice*                                   );
+        void add_surfaceLattice    ( const SurfaceLattice*                                       );
     
     protected:
         G4String          m_name;
         G4ThreeVector     m_position;
         G4RotationMatrix* m_rotationMatrix;
 
+        vector< G4String                                > m_copy_names           ;
+        vector< G4ThreeVector                           > m_copy_positions       ;
+        vector< G4RotationMatrix*                       > m_copy_rotationMatrices;
+        vector< pair< G4LogicalVolume*, CopyNumberMap > > m_copyNumberMaps       ;
+        vector< const CalorimeterLattice*               > m_calorimeterLattices  ;
+        vector< const SurfaceLattice*                   > m_surfaceLattices      ;
+        vector< G4String                                > m_surfaceLattice_names ; // by ID, made when asked for
+
         CalorimeterHitsCollection* m_calorimeterHitsCollection   { nullptr };
         G4int                      m_calorimeterHitsCollection_ID{ -1      };
 
         G4int m_ID;
+
+    private:
+        G4int find_ID( const G4StepPoint* ) const;
 };
 
 #endif
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "G4UIcmdWith3VectorAndUnit.hh"
 #include "G4UIcmdWith3Vector.hh"
 #include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UImessenger.hh"
 #include "G4SystemOfUnits.hh"
@@ -28,6 +29,8 @@
 
 using std::vector;
 
+class DetectorConstruction;
+
 class  ConstructionMessenger : public G4UImessenger
 {
     public:
@@ -61,6 +64,8 @@ class  ConstructionMessenger : public G4UImessenger
         G4String         get_detector_medium_color                   ();
         G4double         get_detector_medium_alpha                   ();
         G4bool           get_detector_medium_forceSolid              ();
+        G4double         get_detector_medium_smartless               ();
+        G4bool           get_detector_medium_optimise                ();
 
         G4ThreeVector    get_calorimeter_size                        ();
         G4double         get_calorimeter_size_width                  ();
@@ -96,6 +101,8 @@ class  ConstructionMessenger : public G4UImessenger
         G4String         get_photoSensor_body_color                  ();
         G4double         get_photoSensor_body_alpha                  ();
         G4bool           get_photoSensor_body_forceSolid             ();
+        G4String         get_photoSensor_efficiency                  ();
+        G4bool           get_photoSensor_efficiency_prescale         ();
 
         G4int            get_lens_amount                             ();
         G4double         get_lens_surface_1_radius_x                 ( G4int );
@@ -121,6 +128,39 @@ class  ConstructionMessenger : public G4UImessenger
         G4int            get_directionSensitivePhotoDetector_amount_total();
 
         G4bool           get_checkOverlaps                           ();
+        G4bool           get_hierarchical                            ();
+        G4bool           get_parameterised                           ();
+        G4bool           get_calorimeters_merged                     ();
+        G4bool           get_cache                                   ();
+        G4String         get_cache_directory                         ();
+        G4int            get_voxels_max                              ();
+        G4bool           get_lensScan                                ();
+        G4ThreeVector    get_lensScan_medium_size                    ();
+        G4bool           get_fastSimulation                          ();
+        G4bool           get_fastSimulation_table                    ();
+        G4int            get_fastSimulation_table_nBins_position     ();
+        G4int            get_fastSimulation_table_nBins_direction    ();
+        G4int            get_fastSimulation_table_nBins_energy       ();
+        G4double         get_fastSimulation_table_energy_min         ();
+        G4double         get_fastSimulation_table_energy_max         ();
+        G4int            get_fastSimulation_table_nSamples           ();
+        G4bool           get_fastSimulation_medium                   ();
+        G4String         get_fastSimulation_visibility               ();
+        G4String         get_fastSimulation_visibility_fileName      ();
+        G4bool           get_fastSimulation_overlay                  ();
+        G4String         get_fastSimulation_overlay_fileName         ();
+        G4double         get_fastSimulation_overlay_energy           ();
+        G4double         get_fastSimulation_overlay_position         ();
+        G4double         get_fastSimulation_overlay_angle            ();
+        G4double         get_fastSimulation_prescale                 ();
+        G4double         get_fastSimulation_acceptance               ();
+        G4double         get_fastSimulation_acceptance_survival      ();
+        G4double         get_fastSimulation_timeWindow               ();
+        G4int            get_fastSimulation_stackChunk               ();
+        G4int            get_fastSimulation_stackBuffer              ();
+        G4double         get_detector_wall_productionCut             ();
+        G4double         get_detector_medium_productionCut           ();
+        DetectorConstruction* get_detectorConstruction               ();
 
         void set_world_size                              ( G4ThreeVector );
         void set_world_size_x                            ( G4double      );
@@ -144,6 +184,8 @@ class  ConstructionMessenger : public G4UImessenger
         void set_detector_medium_color                   ( G4String      );
         void set_detector_medium_alpha                   ( G4double      );
         void set_detector_medium_forceSolid              ( G4bool        );
+        void set_detector_medium_smartless               ( G4double      );
+        void set_detector_medium_optimise                ( G4bool        );
 
         void set_calorimeter_size                        ( G4ThreeVector );
         void set_calorimeter_size_width                  ( G4double      );
@@ -176,6 +218,8 @@ class  ConstructionMessenger : public G4UImessenger
         void set_photoSensor_body_color                  ( G4String      );
         void set_photoSensor_body_alpha                  ( G4double      );
         void set_photoSensor_body_forceSolid             ( G4bool        );
+        void set_photoSensor_efficiency                  ( G4String      );
+        void set_photoSensor_efficiency_prescale         ( G4bool        );
 
         void set_lens_incramentCurrentLens               ();
         void set_lens_surface_1_radius_x                 ( G4int, G4double );
@@ -198,13 +242,46 @@ class  ConstructionMessenger : public G4UImessenger
         void set_directionSensitivePhotoDetector_amount_y( G4double      );
         void set_directionSensitivePhotoDetector_amount_z( G4double      );
         void set_checkOverlaps                           ( G4bool        );
+        void set_hierarchical                            ( G4bool        );
+        void set_parameterised                           ( G4bool        );
+        void set_calorimeters_merged                     ( G4bool        );
+        void set_cache                                   ( G4bool        );
+        void set_cache_directory                         ( G4String      );
+        void set_voxels_max                              ( G4int         );
+        void set_lensScan                                ( G4bool        );
+        void set_lensScan_medium_size                    ( G4ThreeVector );
+        void set_fastSimulation                          ( G4bool        );
+        void set_fastSimulation_table                    ( G4bool        );
+        void set_fastSimulation_table_nBins_position     ( G4int         );
+        void set_fastSimulation_table_nBins_direction    ( G4int         );
+        void set_fastSimulation_table_nBins_energy       ( G4int         );
+        void set_fastSimulation_table_energy_min         ( G4double      );
+        void set_fastSimulation_table_energy_max         ( G4double      );
+        void set_fastSimulation_table_nSamples           ( G4int         );
+        void set_fastSimulation_medium                   ( G4bool        );
+        void set_fastSimulation_visibility               ( G4String      );
+        void set_fastSimulation_visibility_fileName      ( G4String      );
+        void set_fastSimulation_overlay                  ( G4bool        );
+        void set_fastSimulation_overlay_fileName         ( G4String      );
+        void set_fastSimulation_overlay_energy           ( G4double      );
+        void set_fastSimulation_overlay_position         ( G4double      );
+        void set_fastSimulation_overlay_angle            ( G4double      );
+        void set_fastSimulation_prescale                 ( G4double      );
+        void set_fastSimulation_acceptance               ( G4double      );
+        void set_fastSimulation_acceptance_survival      ( G4double      );
+        void set_fastSimulation_timeWindow               ( G4double      );
+        void set_fastSimulation_stackChunk               ( G4int         );
+        void set_fastSimulation_stackBuffer              ( G4int         );
+        void set_detector_wall_productionCut             ( G4double      );
+        void set_detector_medium_productionCut           ( G4double      );
+        void set_detectorConstruction                    ( DetectorConstruction* );
 
         void set_visAttributes_visibility                ( G4bool  , G4VisAttributes*& );
         void set_visAttributes_color                     ( G4String, G4VisAttributes*& );
         void set_visAttributes_alpha                     ( G4double, G4VisAttributes*& );
         void set_visAttributes_forceSolid                ( G4bool  , G4VisAttributes*& );
 
-        void print_parameters();
+        void print_parameters( std::ostream& = G4cout );
 
     protected:
         ConstructionMessenger();
@@ -231,6 +308,8 @@ class  ConstructionMessenger : public G4UImessenger
         G4UIcmdWithAString       * m_command_detector_medium_color                 { nullptr }; G4String      m_variable_detector_medium_color                 { "" };
         G4UIcmdWithADouble       * m_command_detector_medium_alpha                 { nullptr }; G4double      m_variable_detector_medium_alpha                 { 0.0 };
         G4UIcmdWithABool         * m_command_detector_medium_forceSolid            { nullptr }; G4bool        m_variable_detector_medium_forceSolid            { true };
+        G4UIcmdWithADouble       * m_command_detector_medium_smartless             { nullptr }; G4double      m_variable_detector_medium_smartless             { 2.0 };
+        G4UIcmdWithABool         * m_command_detector_medium_optimise              { nullptr }; G4bool        m_variable_detector_medium_optimise              { true };
 
         G4UIcmdWith3VectorAndUnit* m_command_calorimeter_size                      { nullptr }; G4ThreeVector m_variable_calorimeter_size                      { 100.0 * mm, 100.0 * mm, 100.0 * mm };
         G4UIcmdWithAString       * m_command_calorimeter_material                  { nullptr }; G4String      m_variable_calorimeter_material                  { "G4Air" };
@@ -252,6 +331,8 @@ class  ConstructionMessenger : public G4UImessenger
         G4UIcmdWithAString       * m_command_photoSensor_body_color                { nullptr }; G4String      m_variable_photoSensor_body_color                { "" };
         G4UIcmdWithADouble       * m_command_photoSensor_body_alpha                { nullptr }; G4double      m_variable_photoSensor_body_alpha                { 0.0 };
         G4UIcmdWithABool         * m_command_photoSensor_body_forceSolid           { nullptr }; G4bool        m_variable_photoSensor_body_forceSolid           { true };
+        G4UIcmdWithAString       * m_command_photoSensor_efficiency                { nullptr }; G4String      m_variable_photoSensor_efficiency                { "none" };
+        G4UIcmdWithABool         * m_command_photoSensor_efficiency_prescale       { nullptr }; G4bool        m_variable_photoSensor_efficiency_prescale       { true };
 
         G4UIcmdWithoutParameter  * m_command_lens_incramentCurrentLens             { nullptr }; G4int         m_variable_lens_currentLens                      { 0 };
         G4UIcmdWithADoubleAndUnit* m_command_lens_surface_1_radius_x               { nullptr }; G4double      m_variable_lens_surface_1_radius_x               { 0.0 * mm };
@@ -271,6 +352,48 @@ class  ConstructionMessenger : public G4UImessenger
 
         G4UIcmdWith3Vector       * m_command_directionSensitivePhotoDetector_amount{ nullptr }; G4ThreeVector m_variable_directionSensitivePhotoDetector_amount{ 1, 1, 1 };
         G4UIcmdWithABool         * m_command_checkOverlaps                         { nullptr }; G4bool        m_variable_checkOverlaps                         { true };
+        G4UIcmdWithABool         * m_command_hierarchical                          { nullptr }; G4bool        m_variable_hierarchical                          { true };
+        G4UIcmdWithABool         * m_command_parameterised                         { nullptr }; G4bool        m_variable_parameterised                         { true };
+        G4UIcmdWithABool         * m_command_calorimeters_merged                   { nullptr }; G4bool        m_variable_calorimeters_merged                   { false };
+        G4UIcmdWithABool         * m_command_cache                                 { nullptr }; G4bool        m_variable_cache                                 { false };
+        G4UIcmdWithAString       * m_command_cache_directory                       { nullptr }; G4String      m_variable_cache_directory                       { "geometry_cache" };
+        G4UIcmdWithAnInteger     * m_command_voxels_max                            { nullptr }; G4int         m_variable_voxels_max                            { -1 };
+        G4UIcmdWithABool         * m_command_lensScan                              { nullptr }; G4bool        m_variable_lensScan                              { false };
+        G4UIcmdWith3VectorAndUnit* m_command_lensScan_medium_size                  { nullptr }; G4ThreeVector m_variable_lensScan_medium_size                  { 1000.0 * mm, 1000.0 * mm, 1000.0 * mm };
+        G4UIcmdWithoutParameter  * m_command_rebuild                               { nullptr };
+        G4UIcmdWithABool         * m_command_fastSimulation                        { nullptr }; G4bool        m_variable_fastSimulation                        { false };
+        G4UIcmdWithABool         * m_command_fastSimulation_table                  { nullptr }; G4bool        m_variable_fastSimulation_table                  { false };
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_table_nBins_position   { nullptr }; G4int         m_variable_fastSimulation_table_nBins_position   { 16 };
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_table_nBins_direction  { nullptr }; G4int         m_variable_fastSimulation_table_nBins_direction  { 16 };
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_table_nBins_energy     { nullptr }; G4int         m_variable_fastSimulation_table_nBins_energy     { 1 };
+        G4UIcmdWithADoubleAndUnit* m_command_fastSimulation_table_energy_min       { nullptr }; G4double      m_variable_fastSimulation_table_energy_min       { 6.9 * eV };
+        G4UIcmdWithADoubleAndUnit* m_command_fastSimulation_table_energy_max       { nullptr }; G4double      m_variable_fastSimulation_table_energy_max       { 7.1 * eV };
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_table_nSamples         { nullptr }; G4int         m_variable_fastSimulation_table_nSamples         { 16 };
+        G4UIcmdWithABool         * m_command_fastSimulation_medium                 { nullptr }; G4bool        m_variable_fastSimulation_medium                 { false };
+        G4UIcmdWithAString       * m_command_fastSimulation_visibility             { nullptr }; G4String      m_variable_fastSimulation_visibility             { "none" };
+        G4UIcmdWithAString       * m_command_fastSimulation_visibility_fileName    { nullptr }; G4String      m_variable_fastSimulation_visibility_fileName    { "visibility.vis" };
+        // primaries replaced by library hits (see HitLibrary::find): relative energy, distance and angle tolerances
+        G4UIcmdWithABool         * m_command_fastSimulation_overlay                { nullptr }; G4bool        m_variable_fastSimulation_overlay                { false };
+        G4UIcmdWithAString       * m_command_fastSimulation_overlay_fileName       { nullptr }; G4String      m_variable_fastSimulation_overlay_fileName       { "hits.hlb" };
+        G4UIcmdWithADouble       * m_command_fastSimulation_overlay_energy         { nullptr }; G4double      m_variable_fastSimulation_overlay_energy         { 0.05 };
+        G4UIcmdWithADoubleAndUnit* m_command_fastSimulation_overlay_position       { nullptr }; G4double      m_variable_fastSimulation_overlay_position       { 10 * cm };
+        G4UIcmdWithADoubleAndUnit* m_command_fastSimulation_overlay_angle          { nullptr }; G4double      m_variable_fastSimulation_overlay_angle          { 10 * deg };
+        // fraction of the scintillation and Cerenkov photons kept (see StackingAction), saved in the metadata tuple
+        G4UIcmdWithADouble       * m_command_fastSimulation_prescale               { nullptr }; G4double      m_variable_fastSimulation_prescale               { 1.0 };
+        // optical photons less likely than this to reach a DSPD are kept with the survival probability (see GeometricAcceptance)
+        G4UIcmdWithADouble       * m_command_fastSimulation_acceptance             { nullptr }; G4double      m_variable_fastSimulation_acceptance             { 0.0 };
+        G4UIcmdWithADouble       * m_command_fastSimulation_acceptance_survival    { nullptr }; G4double      m_variable_fastSimulation_acceptance_survival    { 0.1 };
+        // readout window after the event start, 0 for none: later optical photons are killed (see SteppingAction)
+        G4UIcmdWithADoubleAndUnit* m_command_fastSimulation_timeWindow             { nullptr }; G4double      m_variable_fastSimulation_timeWindow             { 0 * ns };
+        // optical photons tracked at a time, the rest wait in a compact buffer (see StackingAction), 0 for all
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_stackChunk             { nullptr }; G4int         m_variable_fastSimulation_stackChunk             { 0 };
+        // waiting photons kept in memory, the rest are written to a temporary file (see StackingAction)
+        G4UIcmdWithAnInteger     * m_command_fastSimulation_stackBuffer            { nullptr }; G4int         m_variable_fastSimulation_stackBuffer            { 1000000 };
+        // production cuts of the wall and medium regions, 0 for the default of `/run/setCut' (see DetectorConstruction::make_regions)
+        G4UIcmdWithADoubleAndUnit* m_command_detector_wall_productionCut           { nullptr }; G4double      m_variable_detector_wall_productionCut           { 0 * mm };
+        G4UIcmdWithADoubleAndUnit* m_command_detector_medium_productionCut         { nullptr }; G4double      m_variable_detector_medium_productionCut         { 0 * mm };
+
+        DetectorConstruction* m_detectorConstruction{ nullptr }; // rebuilt by `/geometry/rebuild'
 
         G4VisAttributes* m_variable_world_visAttributes              { nullptr };
         G4VisAttributes* m_variable_detector_wall_visAttributes      { nullptr };
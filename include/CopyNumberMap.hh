@@ -0,0 +1,42 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef CopyNumberMap_hh
+#define CopyNumberMap_hh
+
+#include "globals.hh"
+#include "G4VTouchable.hh"
+
+#include <vector>
+#include <utility>
+
+using std::vector;
+using std::pair;
+
+// Recovers the ID of a detector from the touchable of a hit in one of its shared
+// volumes, as a weighted sum of copy numbers along the volume hierarchy. A single
+// term ( depth, 1 ) is the plain copy number of the volume at that depth; with
+// parameterised walls the ID is e.g. the cell index plus the first ID of the wall.
+class CopyNumberMap
+{
+    public:
+        CopyNumberMap( G4int = 0 );
+       ~CopyNumberMap() = default;
+
+        void  add   ( G4int, G4int = 1 );
+        G4int get_ID( const G4VTouchable* ) const;
+
+    protected:
+        vector< pair< G4int, G4int > > m_terms; // ( depth, weight )
+};
+
+#endif
@@ -0,0 +1,84 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef DSPDFastSimulationModel_hh
+#define DSPDFastSimulationModel_hh
+
+#include "G4VFastSimulationModel.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Region.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4AutoLock.hh"
+#include "G4Timer.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include "ConstructionMessenger.hh"
+#include "LensSystem.hh"
+#include "PhotoSensorSensitiveDetector.hh"
+#include "CopyNumberMap.hh"
+#include "RayTracer.hh"
+#include "LensResponseTable.hh"
+
+#include <memory>
+#include <filesystem>
+#include <stdexcept>
+
+// Fast simulation of the optical photons entering a DSPD envelope (hierarchical geometry):
+// instead of tracking them through the lenses, they are traced analytically to the
+// photosensor (see RayTracer) and either deposit a PhotoSensorHit or are killed, with the
+// traced Fresnel transmission and absorption as detection probability. Photons the ray
+// tracer cannot follow (total internal reflection, through a lens side or a DSPD wall) are
+// left to the full simulation. Enabled per run by `/geometry/fastSimulation'.
+//
+// With `/geometry/fastSimulation_table true' photons entering through the front face of the
+// envelope are not traced but drawn from a LensResponseTable, made once per lens configuration
+// and cached in `/geometry/cache_directory'. The threads share one table.
+class DSPDFastSimulationModel : public G4VFastSimulationModel
+{
+    public:
+        DSPDFastSimulationModel( const G4String&, G4Region*, LensSystem*, PhotoSensorSensitiveDetector*, const CopyNumberMap&, G4double, G4double );
+       ~DSPDFastSimulationModel() override;
+
+        G4bool IsApplicable( const G4ParticleDefinition&   ) override;
+        G4bool ModelTrigger( const G4FastTrack&            ) override;
+        void   DoIt        ( const G4FastTrack&, G4FastStep& ) override;
+
+    protected:
+        G4String                      m_name                                   ;
+        LensSystem                  * m_lensSystem                  { nullptr };
+        PhotoSensorSensitiveDetector* m_photoSensorSensitiveDetector{ nullptr }; // nullptr without photosensor hits
+        CopyNumberMap                 m_copyNumberMap                          ; // DSPD ID from the envelope touchable
+        G4double                      m_photoSensor_z                          ; // photosensor surface in the envelope frame
+        G4double                      m_entrance_z                             ; // front face of the envelope in the envelope frame
+
+        // rebuilt once per run, the lenses can change between runs (see `/geometry/rebuild')
+        RayTracer                   * m_rayTracer                   { nullptr };
+        G4int                         m_rayTracer_runID             { -1      };
+        RayTracerBatch                m_batch                       { 1       }; // traced in ModelTrigger, used in DoIt
+
+        std::shared_ptr< const LensResponseTable > m_lensResponseTable; // nullptr without `/geometry/fastSimulation_table'
+
+        ConstructionMessenger       * m_constructionMessenger       { ConstructionMessenger::get_instance() };
+
+    private:
+        void update_rayTracer();
+
+        std::shared_ptr< const LensResponseTable > get_lensResponseTable( const RayTracer& );
+};
+
+#endif
@@ -0,0 +1,71 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef DSPDSymmetries_hh
+#define DSPDSymmetries_hh
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+
+#include <vector>
+
+using std::vector;
+
+class PhotoSensorSensitiveDetector;
+
+// A symmetry of the cube centred on the origin: component k of the image is
+// m_signs[ k ] * component m_axes[ k ] of the vector (48 with the reflections).
+struct CubeSymmetry
+{
+    G4int m_axes [ 3 ];
+    G4int m_signs[ 3 ];
+
+    G4ThreeVector apply  ( const G4ThreeVector& ) const;
+    G4ThreeVector inverse( const G4ThreeVector& ) const;
+
+    G4bool operator==( const CubeSymmetry& ) const;
+
+    static vector< CubeSymmetry > get_all(); // identity first
+};
+
+// The symmetries of the cube that map the position of every DSPD onto that of a DSPD (all 48
+// for a cube of DSPDs with the same lattice on every face), with the DSPD each DSPD is mapped
+// onto. Directions relative to a DSPD (see PhotoSensorHit::get_particle_direction_relative)
+// are mapped to directions relative to its image.
+class DSPDSymmetries
+{
+    public:
+        DSPDSymmetries() = default;
+       ~DSPDSymmetries() = default;
+
+        void set( PhotoSensorSensitiveDetector*, const vector< CubeSymmetry >& = CubeSymmetry::get_all() );
+
+        size_t              get_nSymmetries(        ) const;
+        const CubeSymmetry& get_symmetry   ( size_t ) const;
+
+        G4int         get_DSPD              ( size_t, G4int                       ) const; // image of a DSPD ID
+        G4int         get_DSPD_inverse      ( size_t, G4int                       ) const; // DSPD ID of which it is the image
+        G4ThreeVector map_direction         ( size_t, G4int, const G4ThreeVector& ) const; // relative to the DSPD, to its image
+        G4ThreeVector map_direction_inverse ( size_t, G4int, const G4ThreeVector& ) const; // relative to the image, to the DSPD
+
+        // the symmetry mapping t_position onto x <= y <= z (the largest z, then y, then x)
+        size_t fold( const G4ThreeVector& ) const;
+
+    protected:
+        vector< CubeSymmetry     > m_symmetries      ;
+        vector< vector< G4int >  > m_DSPDs           ; // per symmetry, the image of each DSPD ID
+        vector< vector< G4int >  > m_DSPDs_inverse   ; // per symmetry, the DSPD ID mapped onto each DSPD
+        vector< G4RotationMatrix > m_rotationMatrices; // per DSPD ID
+};
+
+#endif
@@ -23,9 +23,21 @@
 #include "G4Orb.hh"
 #include "G4Sphere.hh"
 #include "G4Trd.hh"
+#include "G4ExtrudedSolid.hh"
+#include "G4IntersectionSolid.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
 #include "G4GDMLParser.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4SolidStore.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4Threading.hh"
+#include "G4Timer.hh"
+#include "G4AutoLock.hh"
+#include "G4RunManager.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
 
 #include "ConstructionMessenger.hh"
 #include "Materials.hh"
@@ -40,11 +52,21 @@
 #include "OutputManager.hh"
 #include "MediumSensitiveDetector.hh"
 #include "Medium.hh"
+#include "Wall.hh"
+#include "CopyNumberMap.hh"
+#include "GridParameterisation.hh"
+#include "CalorimeterLattice.hh"
+#include "SurfaceLattice.hh"
+#include "GeometryCache.hh"
+#include "DSPDFastSimulationModel.hh"
+#include "MediumFastSimulationModel.hh"
 
 #include <vector>
 #include <string>
+#include <utility>
 
 using std::vector;
+using std::pair;
 using std::to_string;
 using CLHEP::pi;
 
@@ -61,19 +83,33 @@ class DetectorConstruction : public G4VUserDetectorConstruction
         void ConstructSDandField() override;
 
         void print_parameters();
+
+        void rebuild_lensSystem();
         
         void make_GDMLFile( const G4String& );
 
         vector< Calorimeter                    * > get_calorimeters                    () const;
         vector< Calorimeter                    * > get_calorimeters_full               () const;
         vector< Calorimeter                    * > get_calorimeters_middle             () const;
+        vector< CalorimeterSensitiveDetector   * > get_calorimeterSensitiveDetectors   () const;
         vector< DirectionSensitivePhotoDetector* > get_directionSensitivePhotoDetectors() const;
         vector< Medium                         * > get_mediums                         () const;
+        vector< Wall                           * > get_walls                           () const;
+        GeometricObjectVSolid                    * get_DSPD_envelope                   () const;
+        LensSystem                               * get_lensSystem                      () const;
+        PhotoSensor                              * get_photoSensor                     () const;
         G4bool                                     get_make_SDandField                 () const;
+        G4int                                      get_overlaps                        () const;
+
+        // every DSPD by ID, also those of parameterised faces, which have no objects
+        G4int                                      get_nDSPDs                          () const;
+        G4ThreeVector                              get_DSPD_position_front             ( G4int ) const;
+        G4RotationMatrix                         * get_DSPD_rotationMatrix             ( G4int ) const;
 
     protected:
         G4bool m_checkOverlaps  { true };
         G4bool m_make_SDandField{ true };
+        G4int  m_overlaps       { 0    }; // problems found by check_overlaps
 
         G4ThreeVector m_axis_x{ 1.0, 0.0, 0.0 };
         G4ThreeVector m_axis_y{ 0.0, 1.0, 0.0 };
@@ -95,15 +131,67 @@ class DetectorConstruction : public G4VUserDetectorConstruction
         vector< Calorimeter                    * > m_calorimeters_middle;
         vector< DirectionSensitivePhotoDetector* > m_directionSensitivePhotoDetectors;
         vector< Medium                         * > m_mediums;
+        vector< Wall                           * > m_walls;
+
+        // shared by every DSPD (see DirectionSensitivePhotoDetector)
+        LensSystem * m_lensSystem { nullptr };
+        PhotoSensor* m_photoSensor{ nullptr };
+
+        // the lens sensitive detectors of every thread, updated by rebuild_lensSystem
+        vector< pair< Lens*, LensSensitiveDetector* > > m_lensSensitiveDetectors;
+
+        // holds m_lensSystem and m_photoSensor when the geometry is hierarchical, nullptr otherwise
+        GeometricObjectVSolid* m_DSPD_envelope         { nullptr };
+        G4Region             * m_DSPD_envelope_region  { nullptr }; // see DSPDFastSimulationModel
+        G4Region             * m_detector_medium_region{ nullptr }; // see make_regions
+        G4Region             * m_detector_wall_region  { nullptr }; // see make_regions, not in a lens scan
+        G4UserLimits         * m_kill_userLimits       { nullptr }; // of the world and the detector wall
+
+        // walls filled by parameterisations (see place_surface_parameterised) or with merged
+        // calorimeters (see place_surface_merged), only with a hierarchical geometry
+        G4bool m_parameterised      { false };
+        G4bool m_calorimeters_merged{ false };
+
+        // a single DSPD in a bare medium (see make_lensScan)
+        G4bool m_lensScan{ false };
+
+        // shared by the calorimeters of the parameterised or merged walls, nullptr otherwise
+        Calorimeter                 * m_calorimeter_full_shared             { nullptr };
+        Calorimeter                 * m_calorimeter_middle_shared           { nullptr };
+        Calorimeter                 * m_calorimeter_strip_shared            { nullptr };
+        CalorimeterSensitiveDetector* m_calorimeterSensitiveDetector_shared { nullptr };
+        vector< Calorimeter           * > m_calorimeters_located; // of merged walls, in sensitive detector ID order
+        vector< GeometricObjectVSolid * > m_cells;
+        vector< CalorimeterLattice    * > m_calorimeterLattices;
+
+        // layout and IDs of every face (see place_surface); the only record of the components
+        // of parameterised faces
+        vector< const SurfaceLattice* > m_surfaceLattices;
 
     private: 
-        void make_world   ();
-        void make_detector();
+        void make_world        ();
+        void make_detector     ();
+        void make_lensScan     ();
+        void make_regions      ();
+        void set_productionCut ( G4Region*, G4double );
+        void make_DSPD_envelope();
+        G4ThreeVector calculate_DSPD_envelope_halfSize();
+        void make_calorimeters_shared();
+        Wall                           * make_wall                           ( const G4String&, G4RotationMatrix*, G4int );
         Calorimeter                    * make_calorimeter_full               ( const G4String&, const G4String& );
         Calorimeter                    * make_calorimeter_middle             ( const G4String&, const G4String& );
         DirectionSensitivePhotoDetector* make_directionSensitivePhotoDetector( const G4String&, const G4String& );
 
-        void place_surface( G4ThreeVector, G4int );
+        void place_surface              ( G4ThreeVector, G4int );
+        void place_surface_parameterised( Wall*, const SurfaceLattice* );
+        void place_surface_merged       ( Wall*, G4int, G4int, G4int, G4int, G4int );
+
+        void     check_overlaps_cached();
+        uint64_t get_geometry_hash    ();
+        G4int    check_overlaps       ();
+        G4int    check_lattice        ();
+        void place_calorimeter( Calorimeter                    *, G4RotationMatrix*, G4ThreeVector, Wall* );
+        void place_DSPD       ( DirectionSensitivePhotoDetector*, G4RotationMatrix*, G4ThreeVector, Wall* );
 };
 
 #endif
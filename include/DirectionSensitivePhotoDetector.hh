@@ -19,14 +19,20 @@
 #include "LensSystem.hh"
 #include "PhotoSensor.hh"
 #include "ConstructionMessenger.hh"
+#include "Wall.hh"
 
 using std      ::to_string;
 using G4StrUtil::to_lower ;
 
+// One placement of the shared lens system and photosensor. The solids and logical
+// volumes belong to DetectorConstruction; m_ID is the copy number of every
+// physical volume placed for this DSPD. With an envelope (hierarchical geometry) only
+// the envelope is placed here, the lens system and photosensor live inside it.
+// Parameterised walls make no DSPDs (see SurfaceLattice).
 class DirectionSensitivePhotoDetector
 {
     public:
-        DirectionSensitivePhotoDetector( const G4String&, const G4String& );
+        DirectionSensitivePhotoDetector( const G4String&, const G4String&, G4int, LensSystem*, PhotoSensor*, GeometricObjectVSolid* = nullptr );
        ~DirectionSensitivePhotoDetector();
 
         static G4ThreeVector get_size  ();
@@ -35,11 +41,14 @@ class DirectionSensitivePhotoDetector
         static G4double      get_depth ();
         
         G4String          get_name                ();
+        G4int             get_ID                  ();
         G4RotationMatrix* get_rotationMatrix      ();
         G4LogicalVolume * get_parentLogicalVolume ();
         G4bool            get_isMany              ();
+        Wall            * get_wall                ();
         G4ThreeVector     get_position_lensSystem ();
         G4ThreeVector     get_position_photoSensor();
+        G4ThreeVector     get_position_envelope   ();
 
         G4ThreeVector     get_position       ( const char* );
         G4ThreeVector     get_position_front (             );
@@ -56,19 +65,25 @@ class DirectionSensitivePhotoDetector
 
         void set_name( const G4String& );
         
-        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool, const char* );
+        void place ( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool, const char* );
+        void place ( G4RotationMatrix*, G4ThreeVector, Wall*                   , const char* );
 
     protected:
-        LensSystem      * m_lensSystem         { nullptr };
-        PhotoSensor     * m_photoSensor        { nullptr };
+        LensSystem           * m_lensSystem         { nullptr };
+        PhotoSensor          * m_photoSensor        { nullptr };
+        GeometricObjectVSolid* m_envelope           { nullptr };
 
-        G4String          m_name                          ;
-        G4int             m_ID                            ;
-        G4RotationMatrix* m_rotationMatrix     { nullptr };
-        G4ThreeVector     m_position_lensSystem           ;
-        G4ThreeVector     m_position_photoSensor          ;
-        G4LogicalVolume * m_parentLogicalVolume{ nullptr };
-        G4bool            m_isMany                        ;
+        G4String               m_name                          ;
+        G4int                  m_ID                            ;
+        G4RotationMatrix     * m_rotationMatrix     { nullptr };
+        G4ThreeVector          m_position_lensSystem           ;
+        G4ThreeVector          m_position_photoSensor          ;
+        G4LogicalVolume      * m_parentLogicalVolume{ nullptr };
+        G4bool                 m_isMany                        ;
+        Wall                 * m_wall               { nullptr };
+
+    private:
+        void set_positions( G4RotationMatrix*, G4ThreeVector, const char* );
 };
 
 #endif
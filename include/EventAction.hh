@@ -18,6 +18,8 @@
 #include "OutputMessenger.hh"
 #include "ConstructionMessenger.hh"
 #include "RunAction.hh"
+#include "StackingAction.hh"
+#include "EventArena.hh"
 
 #include "cmath"
 
@@ -27,8 +29,8 @@ using std::nan;
 class EventAction : public G4UserEventAction
 {
     public:
-        EventAction( RunAction*, DetectorConstruction* )         ;
-       ~EventAction(                                   ) override;
+        EventAction( RunAction*, DetectorConstruction*, StackingAction* )         ;
+       ~EventAction(                                                    ) override;
 
         void BeginOfEventAction( const G4Event* ) override;
         void EndOfEventAction  ( const G4Event* ) override;
@@ -38,9 +40,11 @@ class EventAction : public G4UserEventAction
         OutputMessenger      * m_outputMessenger      { OutputMessenger      ::get_instance() };
         ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
         DetectorConstruction * m_detectorConstruction { nullptr                               };
+        StackingAction       * m_stackingAction       { nullptr                               };
         OutputManager        * m_outputManager        { nullptr                               };
         G4AnalysisManager    * m_analysisManager      { nullptr                               };
         G4SDManager          * m_SDManager            { nullptr                               };
+        size_t                 m_nKeptEvents          { 0                                     };
 };
 
 #endif
\ No newline at end of file
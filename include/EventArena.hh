@@ -0,0 +1,115 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef EventArena_hh
+#define EventArena_hh
+
+#include "globals.hh"
+#include "G4ios.hh"
+
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+
+using std::vector;
+using std::size_t;
+
+// Per-thread monotonic arena backing every DSPS owned per-event object (hits,
+// the lens hit vectors inside PhotoSensorHit, ...). Allocation is a pointer
+// bump, deallocation is a no-op and reset() rewinds to the first block in O(1).
+// Blocks are kept between events, so once the arena has grown to the size of
+// the largest event the event loop does not touch the heap anymore.
+//
+// Objects are only destroyed by their owners (G4THitsCollection deletes hits when
+// the G4Event is deleted, which happens after EndOfEventAction and before the next
+// event allocates anything), so their memory must not be reused before then.
+// Kept events (e.g. for visualisation) pin the arena until release() at the
+// start of the next run.
+class EventArena
+{
+    public:
+        static EventArena* get_instance   ();
+        static void        delete_instance();
+
+        void* allocate( size_t, size_t );
+        void  reset   (                );
+        void  pin     (                );
+        void  release (                );
+
+        void print_statistics() const;
+
+        size_t get_nAllocations_event() const;
+        size_t get_nBytes_event      () const;
+        size_t get_nMallocs_event    () const;
+        size_t get_nAllocations_total() const;
+        size_t get_nBytes_total      () const;
+        size_t get_nMallocs_total    () const;
+        size_t get_nBytes_peak       () const;
+        size_t get_nBytes_capacity   () const;
+        size_t get_nEvents           () const;
+        size_t get_nEvents_zeroMalloc() const;
+
+    private:
+        EventArena ();
+       ~EventArena ();
+
+        struct Block {
+            char * data;
+            size_t size;
+        };
+
+        static G4ThreadLocal EventArena* m_instance;
+
+        static constexpr size_t m_blockSize_default{ 1 << 20 };
+
+        vector< Block > m_blocks                    ;
+        size_t          m_block_index          { 0 };
+        size_t          m_block_offset         { 0 };
+        size_t          m_block_index_last     { 0 };
+        size_t          m_block_offset_last    { 0 };
+        G4bool          m_pinned               { false };
+
+        size_t          m_nAllocations_event   { 0 };
+        size_t          m_nBytes_event         { 0 };
+        size_t          m_nMallocs_event       { 0 };
+        size_t          m_nAllocations_total   { 0 };
+        size_t          m_nBytes_total         { 0 };
+        size_t          m_nMallocs_total       { 0 };
+        size_t          m_nBytes_peak          { 0 };
+        size_t          m_nBytes_capacity      { 0 };
+        size_t          m_nEvents              { 0 };
+        size_t          m_nEvents_zeroMalloc   { 0 };
+};
+
+// STL allocator handing out arena memory, e.g. for vectors owned by hits.
+template< typename T >
+class EventArenaAllocator
+{
+    public:
+        using value_type = T;
+
+        EventArenaAllocator() = default;
+        template< typename U >
+        EventArenaAllocator( const EventArenaAllocator< U >& ) {}
+
+        T* allocate( size_t t_n ) {
+            return static_cast< T* >( EventArena::get_instance()->allocate( t_n * sizeof( T ), alignof( T ) ) );
+        }
+        void deallocate( T*, size_t ) {}
+
+        template< typename U >
+        G4bool operator==( const EventArenaAllocator< U >& ) const { return true ; }
+        template< typename U >
+        G4bool operator!=( const EventArenaAllocator< U >& ) const { return false; }
+};
+
+#endif
@@ -0,0 +1,73 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef GeometricAcceptance_hh
+#define GeometricAcceptance_hh
+
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+#include "globals.hh"
+
+#include "DirectionSensitivePhotoDetector.hh"
+#include "RayTracer.hh"
+
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using std::map;
+using std::tuple;
+using std::vector;
+
+class DetectorConstruction;
+
+// Estimate of the probability of an optical photon to reach a DSPD aperture, used by
+// StackingAction to Russian-roulette the photons that are unlikely to. The DSPD fronts
+// (photosensor surface width x height) lie on the faces of a box around the open medium.
+// Along its initial straight line a photon reaches the face it points at unscattered with
+// exp( -L / scattering length ) and then counts if it lands on an aperture; scattered photons
+// count with the fraction of the faces covered by apertures. Both are absorbed with
+// exp( -L / absorption length ). Reflections and the lens transmission are ignored, so this
+// is only an importance estimate: the roulette keeps the results unbiased either way.
+class GeometricAcceptance
+{
+    public:
+        GeometricAcceptance( const DetectorConstruction*, const G4ThreeVector&, const RayTracerMaterial& );
+
+        G4double get_probability( const G4ThreeVector&, const G4ThreeVector&, G4double ) const;
+        G4double get_distance   ( const G4ThreeVector&                                 ) const;
+
+        G4ThreeVector get_halfSize() const;
+        G4double      get_coverage() const;
+
+    private:
+        // faces 2 * axis + ( 1 on the + side ), in the coordinates of the other two axes
+        struct Aperture
+        {
+            G4double m_u    ;
+            G4double m_v    ;
+            G4double m_halfU;
+            G4double m_halfV;
+        };
+
+        G4bool is_aperture( G4int, G4double, G4double ) const;
+
+        RayTracerMaterial                                        m_medium             ;
+        G4ThreeVector                                            m_halfSize           ; // of the box through the DSPD fronts
+        G4double                                                 m_coverage{ 0 }      ;
+        G4double                                                 m_cellSize{ 0 }      ; // >= every aperture
+        vector< Aperture >                                       m_apertures          ;
+        map< tuple< G4int, G4long, G4long >, vector< size_t > >  m_cells              ; // apertures overlapping each cell
+};
+
+#endif
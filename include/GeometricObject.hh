@@ -18,6 +18,7 @@
 #include "G4VSensitiveDetector.hh"
 #include "G4PVPlacement.hh"
 #include "G4Box.hh"
+#include "G4Trd.hh"
 #include "G4Ellipsoid.hh"
 #include "G4EllipticalTube.hh"
 #include "G4VisAttributes.hh"
@@ -26,13 +27,17 @@
 #include "G4DisplacedSolid.hh"
 
 #include "ConstructionMessenger.hh"
+#include "LensSolid.hh"
 
+#define GeometricObjectVSolid           GeometricObject< G4VSolid           >
 #define GeometricObjectBox              GeometricObject< G4Box              >
+#define GeometricObjectTrd              GeometricObject< G4Trd              >
 #define GeometricObjectEllipsoid        GeometricObject< G4Ellipsoid        >
 #define GeometricObjectEllipticalTube   GeometricObject< G4EllipticalTube   >
 #define GeometricObjectSubtractionSolid GeometricObject< G4SubtractionSolid >
 #define GeometricObjectUnionSolid       GeometricObject< G4UnionSolid       >
 #define GeometricObjectDisplacedSolid   GeometricObject< G4DisplacedSolid   >
+#define GeometricObjectLensSolid        GeometricObject< LensSolid          >
 
 template< class SolidType >
 class GeometricObject
@@ -56,7 +61,7 @@ class GeometricObject
 
         void make_logicalVolume();
 
-        G4PVPlacement* place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false );
+        G4PVPlacement* place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false, G4int = -1 );
 
         G4Material          * get_material         () const;
         G4String              get_material_name    () const;
@@ -173,12 +173,15 @@ template< class SolidType >
 G4PVPlacement* GeometricObject< SolidType >::place( G4RotationMatrix* t_rotationMatrix     , 
                                                     G4ThreeVector     t_translationVector  , 
                                                     G4LogicalVolume * t_motherLogicalVolume, 
-                                                    G4bool            t_isMany              ) {
+                                                    G4bool            t_isMany             ,
+                                                    G4int             t_copyNumber          ) {
     if( !m_logicalVolume ) 
         make_logicalVolume();
 
     G4int copyNumber = 0;
-    if( t_isMany )
+    if( t_copyNumber >= 0 )
+        copyNumber = t_copyNumber;
+    else if( t_isMany )
         copyNumber = m_copyNumber++;
 
     m_rotationMatrix    = t_rotationMatrix;
@@ -191,7 +194,7 @@ G4PVPlacement* GeometricObject< SolidType >::place( G4RotationMatrix* t_rotation
                               t_motherLogicalVolume, 
                               t_isMany             , 
                               copyNumber           ,
-                              m_constructionMessenger->get_checkOverlaps() );
+                              false                 ); // see DetectorConstruction::check_overlaps
 }
 
 template< class SolidType >
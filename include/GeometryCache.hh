@@ -0,0 +1,61 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef GeometryCache_hh
+#define GeometryCache_hh
+
+#include "globals.hh"
+#include "G4Exception.hh"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <cstdint>
+
+using std::ifstream;
+using std::ofstream;
+using std::stringstream;
+
+// Remembers the result of the overlap check of a geometry, keyed by a hash of the full
+// construction parameter set (see ConstructionMessenger::print_parameters) and a hash of the
+// geometry that was built from it (see DetectorConstruction::get_geometry_hash), so a change
+// of the construction code that moves or reshapes a volume misses the cache. Each entry is a
+// text file in the cache directory holding the number of overlaps followed by the parameters
+// and the geometry hash, which are compared on lookup so a hash collision of the key cannot
+// return the result of another geometry.
+class GeometryCache
+{
+    public:
+        GeometryCache( const G4String&, const G4String&, uint64_t );
+       ~GeometryCache() = default;
+
+        // 64 bit FNV-1a of t_string continued from t_hash, stable across compilers and runs (unlike std::hash)
+        static constexpr uint64_t m_hash_initial{ 14695981039346656037ull };
+        static uint64_t get_hash( const std::string&, uint64_t = m_hash_initial );
+
+        G4bool   get_isHit   () const;
+        G4int    get_overlaps() const;
+        G4String get_hash    () const;
+        G4String get_fileName() const;
+
+        void set_overlaps( G4int );
+
+    protected:
+        G4String m_directory ;
+        G4String m_parameters;
+        G4String m_hash      ;
+        G4bool   m_isHit     { false };
+        G4int    m_overlaps  { -1    };
+};
+
+#endif
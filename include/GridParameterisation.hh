@@ -0,0 +1,54 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef GridParameterisation_hh
+#define GridParameterisation_hh
+
+#include "globals.hh"
+#include "G4VPVParameterisation.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+
+#include <vector>
+
+using std::vector;
+
+// Places copies on a regular grid: copy n sits at position + i * step_x + j * step_y with
+// i = n / amount_y and j = n % amount_y, i.e. in the same order as the loops over the
+// DSPDs in DetectorConstruction::place_surface. Copies can cycle through several solids
+// and rotations (e.g. the middle and full calorimeters along a row); copy n uses entry
+// n % size. Without solids the logical volume's own solid is used.
+class GridParameterisation : public G4VPVParameterisation
+{
+    public:
+        GridParameterisation( G4ThreeVector, G4ThreeVector, G4ThreeVector, G4int );
+       ~GridParameterisation() override = default;
+
+        void      ComputeTransformation( const G4int, G4VPhysicalVolume* ) const override;
+        G4VSolid* ComputeSolid         ( const G4int, G4VPhysicalVolume* )       override;
+
+        void add_solid         ( G4VSolid*         );
+        void add_rotationMatrix( G4RotationMatrix* );
+
+    protected:
+        G4ThreeVector               m_position        ;
+        G4ThreeVector               m_step_x          ;
+        G4ThreeVector               m_step_y          ;
+        G4int                       m_amount_y        ;
+        vector< G4VSolid        * > m_solids          ;
+        vector< G4RotationMatrix* > m_rotationMatrices;
+};
+
+#endif
@@ -0,0 +1,104 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef HitLibrary_hh
+#define HitLibrary_hh
+
+#include "globals.hh"
+#include "G4Exception.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+#include "DSPDSymmetries.hh"
+
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+
+// One photosensor hit of a library event, in the global frame, the time after the primary
+struct HitLibraryHit
+{
+    G4int         m_DSPD     ;
+    G4ThreeVector m_position ;
+    G4ThreeVector m_direction;
+    G4double      m_time     ;
+    G4double      m_energy   ;
+};
+
+// The photosensor hits of one single-particle event
+struct HitLibraryEvent
+{
+    G4int                   m_PDG      ;
+    G4double                m_energy   ;
+    G4ThreeVector           m_position ;
+    G4ThreeVector           m_direction;
+    vector< HitLibraryHit > m_hits     ;
+};
+
+// Photosensor hits of single-particle events, keyed by particle, energy and vertex, to
+// overlay several of them into one multi-particle event without tracking its optical photons.
+//
+// The library is built from events of one primary (see macros/hitLibrary.mac): with
+// `/output/hitLibrary/save true' each thread adds its events to its own library, merge()
+// appends them to the run total (get_instance()) and the master writes it at the end of the
+// run. The file is, in native byte order:
+//   char[8]  "DSPSHIT"
+//   int32    version
+//   uint64   number of events
+//   per event:
+//     int32  PDG code
+//     double energy [MeV], vertex x, y, z [mm], direction x, y, z
+//     uint64 number of hits
+//     per hit: int32 DSPD ID, double position x, y, z [mm], direction x, y, z, time [ns], energy [MeV]
+//
+// With `/geometry/fastSimulation_overlay true' StackingAction replaces every primary by the
+// hits of the library event closest to it (find()), mapped by the symmetry of the cube that
+// brings the library vertex and direction onto the primary's. Only the symmetries that map
+// every DSPD onto a DSPD are used (see DSPDSymmetries), so that the DSPDs of the mapped hits exist.
+class HitLibrary
+{
+    public:
+        HitLibrary() = default;
+       ~HitLibrary() = default;
+
+        static HitLibrary      * get_instance   (                                                  );
+        static void              delete_instance(                                                  );
+        static const HitLibrary* get_library    ( const G4String&, PhotoSensorSensitiveDetector* );
+
+        void reset    (                                 );
+        void add_event( const HitLibraryEvent&          );
+        void merge    ( const HitLibrary&               );
+        void write    ( const G4String&                 ) const;
+        void read     ( const G4String&                 );
+        void set_symmetries( PhotoSensorSensitiveDetector* );
+
+        // the closest event within the tolerances and the index of its symmetry, nullptr if none
+        const HitLibraryEvent* find( G4int, G4double, const G4ThreeVector&, const G4ThreeVector&,
+                                     G4double, G4double, G4double, size_t& ) const;
+
+        size_t                get_nEvents    () const;
+        const DSPDSymmetries& get_symmetries () const;
+
+    protected:
+        static HitLibrary* m_instance;
+
+        static constexpr char  m_magic[ 8 ]{ "DSPSHIT" };
+        static constexpr G4int m_version   { 1 };
+
+        vector< HitLibraryEvent > m_events    ;
+        DSPDSymmetries            m_symmetries;
+};
+
+#endif
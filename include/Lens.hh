@@ -15,11 +15,11 @@
 #include "globals.hh"
 #include "G4ThreeVector.hh"
 #include "G4RotationMatrix.hh"
-#include "G4EllipticalTube.hh"
 
 #include "GeometricObject.hh"
 #include "ConstructionMessenger.hh"
 #include "LensSensitiveDetector.hh"
+#include "RayTracer.hh"
 
 #include <vector>
 #include <iostream>
@@ -45,12 +45,15 @@ class Lens
         friend ostream& operator<<( ostream&,       Lens* );
         friend ostream& operator<<( ostream&, const Lens& );
 
-        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false );
+        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false, G4int = -1 );
+        void rebuild();
+
+        RayTracerLens make_rayTracerLens();
 
         G4String                         get_name             ();
+        G4int                            get_index            ();
         G4LogicalVolume                * get_logicalVolume    ();
-        // GeometricObjectSubtractionSolid* get_geometricObject  ();
-        GeometricObjectDisplacedSolid  * get_geometricObject  ();
+        GeometricObjectLensSolid       * get_geometricObject  ();
         LensSensitiveDetector          * get_sensitiveDetector();
         G4int                            get_shape_int        ();
         G4String                         get_shape_string     ();
@@ -60,6 +63,7 @@ class Lens
         G4ThreeVector get_position_front  (                   );
         G4ThreeVector get_position_center (                   );
         G4ThreeVector get_position_back   (                   );
+        G4ThreeVector get_position_center ( G4RotationMatrix*, G4ThreeVector );
         static G4ThreeVector get_position        ( const char      *, 
                                                    G4RotationMatrix*, 
                                                    G4ThreeVector    , 
@@ -82,18 +86,18 @@ class Lens
         void set_sensitiveDetector( LensSensitiveDetector* );
 
     protected:
-        // GeometricObjectSubtractionSolid* m_lens                 { new GeometricObjectSubtractionSolid() };
-        // GeometricObjectUnionSolid      * m_lens                 { new GeometricObjectUnionSolid      () };
-        GeometricObjectDisplacedSolid  * m_lens                 { new GeometricObjectDisplacedSolid  () };
+        GeometricObjectLensSolid       * m_lens                 { new GeometricObjectLensSolid       () };
         LensSensitiveDetector          * m_lensSensitiveDetector{ nullptr };
         ConstructionMessenger          * m_constructionMessenger{ ConstructionMessenger::get_instance() };
         G4ThreeVector                    m_size;
         G4String                         m_name;
+        G4int                            m_index;
         G4int                            m_shape;
         G4int                            m_surface_1_shape;
         G4int                            m_surface_2_shape;
         G4RotationMatrix               * m_rotationMatrix       { nullptr };
         G4ThreeVector                    m_translation;
+        vector< G4VPhysicalVolume* >     m_physicalVolumes; // every placement (see rebuild())
 
         G4double         m_surface_1_radius_x;
         G4double         m_surface_1_radius_y;
@@ -117,10 +121,10 @@ class Lens
         G4double m_pi_2 = 0.5 * pi;
         G4double m_pi   =       pi;
 
-        G4SubtractionSolid* subtract_circular   ( G4VSolid* );
-        G4SubtractionSolid* subtract_rectangular( G4VSolid* );
+        LensSolid* make_solid();
 
-        static G4double get_surfaceX( G4double, G4double, G4double, G4double );
+        static G4double get_surfaceZ       ( G4double, G4double, G4double, G4double );
+        static G4double calculate_thickness( G4int                                  );
 
         enum m_lensShape_enum {
             m_biconvex,
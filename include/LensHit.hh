@@ -14,7 +14,6 @@
 
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Transform3D.hh"
@@ -25,6 +24,7 @@
 #include "G4VisAttributes.hh"
 
 #include "ConstructionMessenger.hh"
+#include "EventArena.hh"
 
 class LensHit : public G4VHit
 {
@@ -62,12 +62,12 @@ class LensHit : public G4VHit
 
         G4ThreeVector     get_lens_position              ();
         G4RotationMatrix* get_lens_rotationMatrix        ();
-        G4String          get_lens_name                  ();
+        const G4String&   get_lens_name                  ();
         G4int             get_lens_ID                    ();
         G4ThreeVector     get_hit_position_absolute      ();
         G4ThreeVector     get_hit_position_relative      ();
         G4double          get_hit_time                   ();
-        G4String          get_hit_process                ();
+        const G4String&   get_hit_process                ();
         G4double          get_particle_energy            ();
         G4ThreeVector     get_particle_momentum          ();
         G4ThreeVector     get_particle_position_initial  ();
@@ -77,12 +77,12 @@ class LensHit : public G4VHit
 
     protected:
         G4ThreeVector     m_lens_position             ;
-        G4RotationMatrix* m_lens_rotationMatrix       ;
-        G4String          m_lens_name                 ;
+        G4RotationMatrix* m_lens_rotationMatrix       { nullptr };
+        const G4String*   m_lens_name                 { nullptr };
         G4int             m_lens_ID                   ;
         G4ThreeVector     m_hit_position              ;
         G4double          m_hit_time                  ;
-        G4String          m_hit_process               ;
+        const G4String*   m_hit_process               { nullptr };
         G4double          m_particle_energy           ;
         G4ThreeVector     m_particle_momentum         ;
         G4ThreeVector     m_particle_position_initial ;
@@ -93,17 +93,12 @@ class LensHit : public G4VHit
 
 using LensHitsCollection = G4THitsCollection< LensHit >;
 
-extern G4ThreadLocal G4Allocator< LensHit >* LensHitAllocator;
-
 inline void* LensHit::operator new( size_t ) {
-    if( LensHitAllocator == nullptr )
-        LensHitAllocator = new G4Allocator< LensHit >;
-
-    return ( void* )LensHitAllocator->MallocSingle();
+    return EventArena::get_instance()->allocate( sizeof( LensHit ), alignof( LensHit ) );
 }
 
-inline void LensHit::operator delete( void* t_hit ) {
-    LensHitAllocator->FreeSingle( ( LensHit* ) t_hit );
+// Memory is reclaimed all at once by EventArena::reset().
+inline void LensHit::operator delete( void* ) {
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef LensResponseTable_hh
+#define LensResponseTable_hh
+
+// Built without Geant4 like RayTracer (see CMakeLists.txt). Lengths are in mm and
+// energies in MeV, the Geant4 internal units.
+
+#include "RayTracer.hh"
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+using std::vector;
+using std::size_t;
+
+// One photon traced through a cell of the LensResponseTable. The weight is the probability
+// of reaching the photosensor, or -1 if the ray tracer could not follow the photon.
+struct LensResponseTableSample
+{
+    float m_x         , m_y             ; // on the photosensor
+    float m_dx        , m_dy            ; // direction on the photosensor, dz > 0
+    float m_pathLength, m_groupPathLength; // group path length, c_light times the travel time
+    float m_weight                      ;
+};
+
+// Precomputed response of the lens system for the fast simulation (see
+// DSPDFastSimulationModel). Photons entering through the plane z = z_entrance of the ray
+// tracer frame are binned by
+//   - entry position x, y in [-halfWidth, halfWidth] (nBins_position per side),
+//   - entry direction cosines dx, dy in [-1, 1] (nBins_direction per side, dz > 0),
+//   - energy in [energy_min, energy_max] (nBins_energy, i.e. wavelength bins),
+// and every cell holds nSamples photons traced from random points of the cell (see make).
+// A photon is looked up in O(1) by drawing one sample of its cell (see get_sample).
+//
+// Tables are cached per lens configuration in files named after the hash of get_key(),
+// which lists the ray tracer (materials, lenses, photosensor) and the binning. The key is
+// stored in the file and compared by read(), so a hash collision cannot return another
+// table. The file is, in native byte order:
+//   char[8]  "DSPSLRT"
+//   int32    version
+//   uint64   key length, char[] key
+//   int32    nBins_position, nBins_direction, nBins_energy, nSamples
+//   double   z_entrance, halfWidth, energy_min, energy_max
+//   LensResponseTableSample[ nCells * nSamples ], cell
+//     ( ( n_energy * nBins_position + n_x ) * nBins_position + n_y ) * nBins_direction^2 + n_dx * nBins_direction + n_dy
+class LensResponseTable
+{
+    public:
+        LensResponseTable( int, int, int, int, double, double, double );
+
+        void make ( const RayTracer&                        );
+        bool read ( const std::string&, const std::string&  ); // false if missing or made for another key
+        void write( const std::string&, const std::string&  ) const;
+
+        std::string        get_key ( const RayTracer&   ) const;
+        static std::string get_hash( const std::string& );
+
+        bool                           get_cell  ( double, double, double, double, double, size_t& ) const;
+        const LensResponseTableSample& get_sample( size_t, double                                  ) const;
+        size_t                         get_nCells(                                                  ) const;
+        double                         get_z_entrance(                                              ) const;
+
+    private:
+        static constexpr char m_magic[ 8 ]{ "DSPSLRT" };
+        static constexpr int  m_version   { 2 };
+
+        int    m_nBins_position ;
+        int    m_nBins_direction;
+        int    m_nBins_energy   ;
+        int    m_nSamples       ;
+        double m_z_entrance     ;
+        double m_halfWidth      { 0 };
+        double m_energy_min     ;
+        double m_energy_max     ;
+
+        vector< LensResponseTableSample > m_samples;
+};
+
+#endif
@@ -22,41 +22,59 @@
 #include "OutputManager.hh"
 #include "LensHit.hh"
 #include "Track.hh"
+#include "CopyNumberMap.hh"
+#include "SurfaceLattice.hh"
+
+#include <vector>
 
 using std::to_string;
+using std::vector;
 
+// Attached to one lens of the lens system shared by all DSPDs. The DSPD is identified
+// by the copy numbers of the touched volume and its mothers (see set_copyNumberMap()).
+// Its copies are either added one by one in DSPD ID order (add_copy()), or taken from the
+// surface lattices of parameterised faces (add_copies()), as for PhotoSensorSensitiveDetector.
 class LensSensitiveDetector : public G4VSensitiveDetector 
 {
     public:
-        LensSensitiveDetector( G4String, G4int );
+        LensSensitiveDetector( G4String );
        ~LensSensitiveDetector() override = default;
 
         void Initialize( G4HCofThisEvent* ) override;
         G4bool ProcessHits( G4Step*, G4TouchableHistory* ) override;
 
-        G4String            get_name               (                );
-        G4int               get_ID                 (                );
-        G4ThreeVector       get_position           (                );
-        G4RotationMatrix  * get_rotationMatrix     (                );
+        const G4String    & get_name               (                );
+        const G4String    & get_name               ( G4int          );
+        G4ThreeVector       get_position           ( G4int          );
+        G4RotationMatrix  * get_rotationMatrix     ( G4int          );
+        G4int               get_nCopies            (                );
         LensHitsCollection* get_hitsCollection     ( const G4Event* );
         G4String            get_hitsCollection_name(                );
         G4int               get_hitsCollection_ID  (                );
-        LensHit*            get_firstHit           (                );
+        LensHit*            get_firstHit           ( G4int          );
 
-        void set_position         ( G4ThreeVector     );
-        void set_rotationMatrix   ( G4RotationMatrix* );
-        void set_hitsCollection_ID( G4int             );
+        void add_copy             ( const G4String&      , G4ThreeVector  , G4RotationMatrix* );
+        void add_copies           ( const SurfaceLattice*, const G4String&, G4ThreeVector     );
+        void set_position         ( G4int                , G4ThreeVector                      );
+        void set_copies_offset    ( G4ThreeVector                                             );
+        void set_hitsCollection_ID( G4int                                                     );
+        void set_copyNumberMap    ( const CopyNumberMap&                                      );
     
     protected:
-        G4String          m_name;
-        G4ThreeVector     m_position;
-        G4RotationMatrix* m_rotationMatrix;
+        G4String                        m_name                 ;
+        vector< G4String              > m_copy_names           ;
+        vector< G4ThreeVector         > m_copy_positions       ;
+        vector< G4RotationMatrix*     > m_copy_rotationMatrices;
+        vector< LensHit             * > m_copy_firstHits       ;
+        vector< G4int                 > m_copy_hit             ; // copies with a first hit this event
+        vector< const SurfaceLattice* > m_surfaceLattices      ;
+        G4String                        m_surfaceLattice_suffix; // of the names of their copies
+        vector< G4String              > m_surfaceLattice_names ; // by ID, made when asked for
+        G4ThreeVector                   m_surfaceLattice_offset; // of their copies, see add_copies()
+        CopyNumberMap                   m_copyNumberMap        ;
 
         LensHitsCollection* m_lensHitsCollection   { nullptr };
         G4int               m_lensHitsCollection_ID{ -1      };
-        LensHit           * m_firstHit             { nullptr };
-
-        G4int m_ID;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef LensSolid_hh
+#define LensSolid_hh
+
+#include "globals.hh"
+#include "G4VSolid.hh"
+#include "G4ThreeVector.hh"
+#include "G4VoxelLimits.hh"
+#include "G4AffineTransform.hh"
+#include "G4Polyhedron.hh"
+
+#include <iostream>
+
+using std::ostream;
+
+// Two surface ellipsoidal lens, evaluated in closed form instead of as a tree of
+// boolean solids. The optical axis is z; surface 1 is the back (-z) surface and
+// surface 2 the front (+z) surface. Following the lens commands, radius_x is the
+// signed semi-axis along the optical axis and radius_y the lateral semi-axis.
+// Each surface is
+//     z_i( rho ) = vertex_i - radius_x_i * ( 1 - sqrt( 1 - rho^2 / radius_y_i^2 ) )
+// evaluated at min( rho, yLimits ), i.e. flat outside the clear aperture. The
+// vertices sit at -/+ thickness / 2 and the lens is trimmed laterally by either a
+// circle of radius yLimits or a square of half width halfWidth.
+class LensSolid : public G4VSolid
+{
+    public:
+        LensSolid( const G4String&,
+                   G4double, G4double,
+                   G4double, G4double,
+                   G4double, G4double,
+                   G4bool  , G4double  );
+        LensSolid( const LensSolid& );
+       ~LensSolid() override;
+
+        LensSolid& operator=( const LensSolid& );
+
+        EInside       Inside        ( const G4ThreeVector& ) const override;
+        G4ThreeVector SurfaceNormal ( const G4ThreeVector& ) const override;
+        G4double      DistanceToIn  ( const G4ThreeVector&, const G4ThreeVector& ) const override;
+        G4double      DistanceToIn  ( const G4ThreeVector& ) const override;
+        G4double      DistanceToOut ( const G4ThreeVector&, const G4ThreeVector&, 
+                                      const G4bool = false, G4bool* = nullptr, G4ThreeVector* = nullptr ) const override;
+        G4double      DistanceToOut ( const G4ThreeVector& ) const override;
+
+        void   BoundingLimits ( G4ThreeVector&, G4ThreeVector& ) const override;
+        G4bool CalculateExtent( const EAxis, const G4VoxelLimits&, const G4AffineTransform&, G4double&, G4double& ) const override;
+
+        G4double      GetCubicVolume   () override;
+        G4ThreeVector GetPointOnSurface() const override;
+
+        G4GeometryType GetEntityType() const override;
+        G4VSolid     * Clone        () const override;
+        ostream      & StreamInfo   ( ostream& ) const override;
+
+        void          DescribeYourselfTo( G4VGraphicsScene& ) const override;
+        G4Polyhedron* CreatePolyhedron  (                   ) const override;
+        G4Polyhedron* GetPolyhedron     (                   ) const override;
+
+        G4double get_surface_z    ( G4int, G4double ) const;
+        G4double get_surface_slope( G4int, G4double ) const;
+        G4double get_zMin         (                 ) const;
+        G4double get_zMax         (                 ) const;
+        G4double get_thickness    (                 ) const;
+        G4double get_yLimits      (                 ) const;
+        G4bool   get_circular     (                 ) const;
+        G4double get_halfWidth    (                 ) const;
+
+    private:
+        G4bool   is_inside             ( const G4ThreeVector&           ) const;
+        G4double get_distance_aperture ( G4double, G4double             ) const;
+        G4double get_distance_surface  ( G4int, const G4ThreeVector&    ) const;
+        G4int    get_crossings         ( const G4ThreeVector&, const G4ThreeVector&, G4double* ) const;
+        G4double get_rho_max           (                                ) const;
+        G4ThreeVector get_aperture_point( G4double, G4double            ) const;
+
+        // index 0 is surface 1 (back), index 1 is surface 2 (front)
+        G4double m_surface_radius_x  [ 2 ];
+        G4double m_surface_radius_y  [ 2 ];
+        G4double m_surface_vertex    [ 2 ];
+        G4double m_surface_center    [ 2 ];
+        G4double m_surface_slope_max [ 2 ];
+        G4double m_surface_z_yLimits [ 2 ];
+        G4double m_thickness                ;
+        G4double m_yLimits                  ;
+        G4bool   m_circular                 ;
+        G4double m_halfWidth                ;
+        G4double m_zMin                     ;
+        G4double m_zMax                     ;
+        G4double m_diagonal                 ;
+        G4double m_halfTolerance            ;
+
+        G4double              m_cubicVolume{ 0.       };
+        mutable G4Polyhedron* m_polyhedron { nullptr  };
+
+        static constexpr G4int m_polyhedron_nDivisions{ 24 };
+        static constexpr G4int m_crossings_max        { 12 };
+};
+
+#endif
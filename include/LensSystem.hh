@@ -30,7 +30,10 @@ class LensSystem
 
         void add_lens( Lens* );
 
-        void place( G4RotationMatrix*, G4ThreeVector , G4LogicalVolume*, G4bool = false );
+        void place( G4RotationMatrix*, G4ThreeVector , G4LogicalVolume*, G4bool = false, G4int = -1 );
+        void rebuild();
+
+        RayTracer make_rayTracer();
 
         vector< Lens* >  get_lenses(       ) const;
         Lens           * get_lens  ( G4int ) const;
@@ -43,6 +46,8 @@ class LensSystem
         G4ThreeVector get_position_center(              );
         G4ThreeVector get_position_back  (              );
 
+        G4ThreeVector get_relativePosition_front();
+
         // static G4ThreeVector get_position       ( const char      *, 
         //                                           G4RotationMatrix*, 
         //                                           G4ThreeVector    , 
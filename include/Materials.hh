@@ -20,6 +20,7 @@
 #include "G4NistManager.hh"
 
 #include "ConstructionMessenger.hh"
+#include "RayTracer.hh"
 
 #include <vector>
 #include <cmath>
@@ -40,6 +41,8 @@ class Materials
 
         void print_materials();
 
+        static RayTracerMaterial get_rayTracerMaterial( const G4String& );
+
     protected:
         Materials();
        ~Materials() {}
@@ -0,0 +1,65 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef MediumFastSimulationModel_hh
+#define MediumFastSimulationModel_hh
+
+#include "G4VFastSimulationModel.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Region.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include "ConstructionMessenger.hh"
+#include "PhotonTransport.hh"
+
+#include <random>
+
+// Fast simulation of the optical photons in the open detector medium (hierarchical geometry):
+// instead of stepping through the medium volume, PhotonTransport samples their Rayleigh
+// scatterings and absorption and moves them straight to the inner face of the walls. From
+// there Geant4 tracks them again, so photons reaching a DSPD envelope get its response (or
+// DSPDFastSimulationModel) and photons reaching a calorimeter are absorbed as usual. Enabled
+// per run by `/geometry/fastSimulation_medium'.
+class MediumFastSimulationModel : public G4VFastSimulationModel
+{
+    public:
+        MediumFastSimulationModel( const G4String&, G4Region*, const RayTracerMaterial&, const G4ThreeVector& );
+
+        G4bool IsApplicable( const G4ParticleDefinition&   ) override;
+        G4bool ModelTrigger( const G4FastTrack&            ) override;
+        void   DoIt        ( const G4FastTrack&, G4FastStep& ) override;
+
+    protected:
+        PhotonTransport        m_photonTransport                    ; // inside the walls, in the medium frame
+        RayTracerBatch         m_batch                 { 1 }        ;
+
+        // reseeded from the Geant4 engine at the first photon of each event, so that events
+        // are reproducible whichever thread simulates them
+        std::mt19937_64        m_generator                          ;
+        G4int                  m_generator_runID       { -1 }       ;
+        G4int                  m_generator_eventID     { -1 }       ;
+
+        ConstructionMessenger* m_constructionMessenger { ConstructionMessenger::get_instance() };
+
+    private:
+        void update_generator();
+};
+
+#endif
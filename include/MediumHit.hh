@@ -14,7 +14,6 @@
 
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Transform3D.hh"
@@ -25,6 +24,7 @@
 #include "G4VisAttributes.hh"
 
 #include "ConstructionMessenger.hh"
+#include "EventArena.hh"
 
 class MediumHit : public G4VHit
 {
@@ -63,11 +63,11 @@ class MediumHit : public G4VHit
 
         G4ThreeVector     get_medium_position          ();
         G4RotationMatrix* get_medium_rotationMatrix    ();
-        G4String          get_medium_name              ();
+        const G4String&   get_medium_name              ();
         G4int             get_medium_ID                ();
         G4ThreeVector     get_hit_position_absolute    ();
         G4double          get_hit_time                 ();
-        G4String          get_hit_process              ();
+        const G4String&   get_hit_process              ();
         G4double          get_particle_energy          ();
         G4ThreeVector     get_particle_momentum        ();
         G4ThreeVector     get_particle_position_initial();
@@ -75,12 +75,12 @@ class MediumHit : public G4VHit
 
     protected:
         G4ThreeVector     m_medium_position          ;
-        G4RotationMatrix* m_medium_rotationMatrix    ;
-        G4String          m_medium_name              ;
+        G4RotationMatrix* m_medium_rotationMatrix    { nullptr };
+        const G4String*   m_medium_name              { nullptr };
         G4int             m_medium_ID                ;
         G4ThreeVector     m_hit_position_absolute    ;
         G4double          m_hit_time                 ;
-        G4String          m_hit_process              ;
+        const G4String*   m_hit_process              { nullptr };
         G4double          m_particle_energy          ;
         G4ThreeVector     m_particle_momentum        ;
         G4ThreeVector     m_particle_position_initial;
@@ -91,17 +91,12 @@ class MediumHit : public G4VHit
 
 using MediumHitsCollection = G4THitsCollection< MediumHit >;
 
-extern G4ThreadLocal G4Allocator< MediumHit >* MediumHitAllocator;
-
 inline void* MediumHit::operator new( size_t ) {
-    if( MediumHitAllocator == nullptr )
-        MediumHitAllocator = new G4Allocator< MediumHit >;
-
-    return ( void* )MediumHitAllocator->MallocSingle();
+    return EventArena::get_instance()->allocate( sizeof( MediumHit ), alignof( MediumHit ) );
 }
 
-inline void MediumHit::operator delete( void* t_hit ) {
-    MediumHitAllocator->FreeSingle( ( MediumHit* ) t_hit );
+// Memory is reclaimed all at once by EventArena::reset().
+inline void MediumHit::operator delete( void* ) {
 }
 
 #endif
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWith3VectorAndUnit.hh"
 #include "G4UIcmdWithAnInteger.hh"
@@ -43,6 +44,17 @@ class OutputMessenger : public G4UImessenger
         G4String        get_GDML_fileName                                     (       ) const;
         G4bool          get_photoSensor_hits_position_binned_save             (       ) const;
         G4int           get_photoSensor_hits_position_binned_nBinsPerSide     (       ) const;
+        G4int           get_photoSensor_hits_position_binned_memoryMax        (       ) const;
+        G4String        get_lensScan_fileName                                 (       ) const;
+        G4bool          get_visibility_save                                   (       ) const;
+        G4String        get_visibility_fileName                               (       ) const;
+        G4ThreeVector   get_visibility_size                                   (       ) const;
+        G4int           get_visibility_nVoxelsPerSide                         (       ) const;
+        G4int           get_visibility_direction_nBinsPerSide                 (       ) const;
+        G4double        get_visibility_threshold                              (       ) const;
+        G4bool          get_visibility_fold                                   (       ) const;
+        G4bool          get_hitLibrary_save                                   (       ) const;
+        G4String        get_hitLibrary_fileName                               (       ) const;
         G4bool          get_photoSensor_hits_position_absolute_save           (       ) const;
         G4bool          get_photoSensor_hits_position_relative_save           (       ) const;
         G4bool          get_photoSensor_hits_position_relative_lens_save      ( G4int ) const;
@@ -57,6 +69,7 @@ class OutputMessenger : public G4UImessenger
         G4bool          get_photoSensor_hits_process_save                     (       ) const;
         G4bool          get_photoSensor_hits_photoSensorID_save               (       ) const;
         G4bool          get_photoSensor_hits_energy_save                      (       ) const;
+        G4bool          get_photoSensor_hits_weight_save                      (       ) const;
         G4bool          get_calorimeter_hits_position_absolute_save           (       ) const;
         G4bool          get_calorimeter_hits_position_relative_save           (       ) const;
         G4bool          get_calorimeter_hits_position_initial_save            (       ) const;
@@ -115,6 +128,17 @@ class OutputMessenger : public G4UImessenger
         void set_GDML_fileName                                     ( G4String value );
         void set_photoSensor_hits_position_binned_save             ( G4bool   value );
         void set_photoSensor_hits_position_binned_nBinsPerSide     ( G4int    value );
+        void set_photoSensor_hits_position_binned_memoryMax        ( G4int    value );
+        void set_lensScan_fileName                                 ( G4String value );
+        void set_visibility_save                                   ( G4bool   value );
+        void set_visibility_fileName                               ( G4String value );
+        void set_visibility_size                                   ( G4ThreeVector value );
+        void set_visibility_nVoxelsPerSide                         ( G4int    value );
+        void set_visibility_direction_nBinsPerSide                 ( G4int    value );
+        void set_visibility_threshold                              ( G4double value );
+        void set_visibility_fold                                   ( G4bool   value );
+        void set_hitLibrary_save                                   ( G4bool   value );
+        void set_hitLibrary_fileName                               ( G4String value );
         void set_photoSensor_hits_position_absolute_save           ( G4bool   value );
         void set_photoSensor_hits_position_relative_save           ( G4bool   value );
         void set_photoSensor_hits_position_relative_lens_save      ( G4String value );
@@ -129,6 +153,7 @@ class OutputMessenger : public G4UImessenger
         void set_photoSensor_hits_process_save                     ( G4bool   value );
         void set_photoSensor_hits_photoSensorID_save               ( G4bool   value );
         void set_photoSensor_hits_energy_save                      ( G4bool   value );
+        void set_photoSensor_hits_weight_save                      ( G4bool   value );
         void set_calorimeter_hits_position_absolute_save           ( G4bool   value );
         void set_calorimeter_hits_position_relative_save           ( G4bool   value );
         void set_calorimeter_hits_position_initial_save            ( G4bool   value );
@@ -184,6 +209,17 @@ class OutputMessenger : public G4UImessenger
         G4UIcmdWithAString  * m_command_GDML_fileName                                  { nullptr };
         G4UIcmdWithABool    * m_command_photoSensor_hits_position_binned_save          { nullptr };
         G4UIcmdWithAnInteger* m_command_photoSensor_hits_position_binned_nBinsPerSide  { nullptr };
+        G4UIcmdWithAnInteger* m_command_photoSensor_hits_position_binned_memoryMax     { nullptr };
+        G4UIcmdWithAString  * m_command_lensScan_fileName                              { nullptr };
+        G4UIcmdWithABool    * m_command_visibility_save                              { nullptr };
+        G4UIcmdWithAString  * m_command_visibility_fileName                          { nullptr };
+        G4UIcmdWith3VectorAndUnit* m_command_visibility_size                        { nullptr };
+        G4UIcmdWithAnInteger* m_command_visibility_nVoxelsPerSide                    { nullptr };
+        G4UIcmdWithAnInteger* m_command_visibility_direction_nBinsPerSide            { nullptr };
+        G4UIcmdWithADouble  * m_command_visibility_threshold                         { nullptr };
+        G4UIcmdWithABool    * m_command_visibility_fold                              { nullptr };
+        G4UIcmdWithABool    * m_command_hitLibrary_save                              { nullptr };
+        G4UIcmdWithAString  * m_command_hitLibrary_fileName                          { nullptr };
         G4UIcmdWithABool    * m_command_photoSensor_hits_position_absolute_save        { nullptr };
         G4UIcmdWithABool    * m_command_photoSensor_hits_position_relative_save        { nullptr };
         G4UIcmdWithAString  * m_command_photoSensor_hits_position_relative_lens_save   { nullptr };
@@ -198,6 +234,7 @@ class OutputMessenger : public G4UImessenger
         G4UIcmdWithABool    * m_command_photoSensor_hits_process_save                  { nullptr };
         G4UIcmdWithABool    * m_command_photoSensor_hits_photoSensorID_save            { nullptr };
         G4UIcmdWithABool    * m_command_photoSensor_hits_energy_save                   { nullptr };
+        G4UIcmdWithABool    * m_command_photoSensor_hits_weight_save                   { nullptr };
         G4UIcmdWithABool    * m_command_calorimeter_hits_position_absolute_save        { nullptr };
         G4UIcmdWithABool    * m_command_calorimeter_hits_position_relative_save        { nullptr };
         G4UIcmdWithABool    * m_command_calorimeter_hits_position_initial_save         { nullptr };
@@ -249,6 +286,17 @@ class OutputMessenger : public G4UImessenger
         G4String         m_variable_GDML_fileName                                { "output.gdml" };
         G4bool           m_variable_photoSensor_hits_position_binned_save        { false         };
         G4int            m_variable_photoSensor_hits_position_binned_nBinsPerSide{ 1             };
+        G4int            m_variable_photoSensor_hits_position_binned_memoryMax   { 2048          }; // MB
+        G4String         m_variable_lensScan_fileName                            { "lensScan.psf" }; // see PointSpreadFunction
+        G4bool           m_variable_visibility_save                              { false };
+        G4String         m_variable_visibility_fileName                          { "visibility.vis" };
+        G4ThreeVector    m_variable_visibility_size                              { G4ThreeVector( 2 * m, 2 * m, 2 * m ) };
+        G4int            m_variable_visibility_nVoxelsPerSide                    { 10 };
+        G4int            m_variable_visibility_direction_nBinsPerSide            { 4 };
+        G4double         m_variable_visibility_threshold                         { 1e-6 };
+        G4bool           m_variable_visibility_fold                              { false }; // by the symmetries of the cube
+        G4bool           m_variable_hitLibrary_save                              { false }; // see HitLibrary
+        G4String         m_variable_hitLibrary_fileName                          { "hits.hlb" };
         G4bool           m_variable_photoSensor_hits_position_absolute_save      { false         };
         G4bool           m_variable_photoSensor_hits_position_relative_save      { false         };
         vector< G4bool > m_variable_photoSensor_hits_position_relative_lens_save { {}            };
@@ -261,6 +309,7 @@ class OutputMessenger : public G4UImessenger
         G4bool           m_variable_photoSensor_hits_process_save                { false         };
         G4bool           m_variable_photoSensor_hits_photoSensorID_save          { false         };
         G4bool           m_variable_photoSensor_hits_energy_save                 { false         };
+        G4bool           m_variable_photoSensor_hits_weight_save                 { false         };
         G4bool           m_variable_calorimeter_hits_position_absolute_save      { false         };
         G4bool           m_variable_calorimeter_hits_position_relative_save      { false         };
         G4bool           m_variable_calorimeter_hits_position_initial_save       { false         };
@@ -20,6 +20,15 @@
 #include "G4SystemOfUnits.hh"
 
 #include "ParticleGunMessenger.hh"
+#include "ConstructionMessenger.hh"
+#include "DirectionSensitivePhotoDetector.hh"
+#include "PointSpreadFunction.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using std::min;
+using std::max;
 
 class ParticleGun : public G4ParticleGun 
 {
@@ -34,6 +43,8 @@ class ParticleGun : public G4ParticleGun
         G4double      get_position_random( G4double, G4double, G4int );
         G4ThreeVector get_momentum_random( G4double, G4double, G4double, G4double, G4double, G4double );
 
+        void generate_lensScan( G4Event* );
+
         ParticleGunMessenger* m_particleGunMessenger{ ParticleGunMessenger::get_instance() };
 };
 
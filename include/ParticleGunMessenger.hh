@@ -33,47 +33,69 @@ class ParticleGunMessenger : public G4UImessenger
     
         void SetNewValue( G4UIcommand* command, G4String newValue );
 
-        G4bool   get_momentum_random      ();
-        G4double get_momentum_x_random_min();
-        G4double get_momentum_y_random_min();
-        G4double get_momentum_z_random_min();
-        G4double get_momentum_x_random_max();
-        G4double get_momentum_y_random_max();
-        G4double get_momentum_z_random_max();
-        G4bool   get_position_x_random    ();
-        G4bool   get_position_y_random    ();
-        G4bool   get_position_z_random    ();
-        G4int    get_position_x_nSteps    ();
-        G4int    get_position_y_nSteps    ();
-        G4int    get_position_z_nSteps    ();
-        G4double get_position_x_random_min();
-        G4double get_position_y_random_min();
-        G4double get_position_z_random_min();
-        G4double get_position_x_random_max();
-        G4double get_position_y_random_max();
-        G4double get_position_z_random_max();
-        G4int    get_nParticles           ();
-
-        void set_momentum_random      ( G4bool   );
-        void set_momentum_x_random_min( G4double );
-        void set_momentum_y_random_min( G4double );
-        void set_momentum_z_random_min( G4double );
-        void set_momentum_x_random_max( G4double );
-        void set_momentum_y_random_max( G4double );
-        void set_momentum_z_random_max( G4double );
-        void set_position_x_random    ( G4bool   );
-        void set_position_y_random    ( G4bool   );
-        void set_position_z_random    ( G4bool   );
-        void set_position_x_nSteps    ( G4int    );
-        void set_position_y_nSteps    ( G4int    );
-        void set_position_z_nSteps    ( G4int    );
-        void set_position_x_random_min( G4double );
-        void set_position_y_random_min( G4double );
-        void set_position_z_random_min( G4double );
-        void set_position_x_random_max( G4double );
-        void set_position_y_random_max( G4double );
-        void set_position_z_random_max( G4double );
-        void set_nParticles           ( G4int    );
+        G4bool   get_momentum_random        ();
+        G4double get_momentum_x_random_min  ();
+        G4double get_momentum_y_random_min  ();
+        G4double get_momentum_z_random_min  ();
+        G4double get_momentum_x_random_max  ();
+        G4double get_momentum_y_random_max  ();
+        G4double get_momentum_z_random_max  ();
+        G4bool   get_position_x_random      ();
+        G4bool   get_position_y_random      ();
+        G4bool   get_position_z_random      ();
+        G4int    get_position_x_nSteps      ();
+        G4int    get_position_y_nSteps      ();
+        G4int    get_position_z_nSteps      ();
+        G4double get_position_x_random_min  ();
+        G4double get_position_y_random_min  ();
+        G4double get_position_z_random_min  ();
+        G4double get_position_x_random_max  ();
+        G4double get_position_y_random_max  ();
+        G4double get_position_z_random_max  ();
+        G4bool   get_position_fold          ();
+        G4int    get_nParticles             ();
+        G4int    get_nVertices              ();
+        G4double get_lensScan_angle_x_min   ();
+        G4double get_lensScan_angle_x_max   ();
+        G4int    get_lensScan_angle_x_nSteps();
+        G4double get_lensScan_angle_y_min   ();
+        G4double get_lensScan_angle_y_max   ();
+        G4int    get_lensScan_angle_y_nSteps();
+        G4double get_lensScan_offset_max    ();
+        G4int    get_lensScan_offset_nSteps ();
+        G4double get_lensScan_distance      ();
+
+        void set_momentum_random        ( G4bool   );
+        void set_momentum_x_random_min  ( G4double );
+        void set_momentum_y_random_min  ( G4double );
+        void set_momentum_z_random_min  ( G4double );
+        void set_momentum_x_random_max  ( G4double );
+        void set_momentum_y_random_max  ( G4double );
+        void set_momentum_z_random_max  ( G4double );
+        void set_position_x_random      ( G4bool   );
+        void set_position_y_random      ( G4bool   );
+        void set_position_z_random      ( G4bool   );
+        void set_position_x_nSteps      ( G4int    );
+        void set_position_y_nSteps      ( G4int    );
+        void set_position_z_nSteps      ( G4int    );
+        void set_position_x_random_min  ( G4double );
+        void set_position_y_random_min  ( G4double );
+        void set_position_z_random_min  ( G4double );
+        void set_position_x_random_max  ( G4double );
+        void set_position_y_random_max  ( G4double );
+        void set_position_z_random_max  ( G4double );
+        void set_position_fold          ( G4bool   );
+        void set_nParticles             ( G4int    );
+        void set_nVertices              ( G4int    );
+        void set_lensScan_angle_x_min   ( G4double );
+        void set_lensScan_angle_x_max   ( G4double );
+        void set_lensScan_angle_x_nSteps( G4int    );
+        void set_lensScan_angle_y_min   ( G4double );
+        void set_lensScan_angle_y_max   ( G4double );
+        void set_lensScan_angle_y_nSteps( G4int    );
+        void set_lensScan_offset_max    ( G4double );
+        void set_lensScan_offset_nSteps ( G4int    );
+        void set_lensScan_distance      ( G4double );
 
         void add_primaryGeneratorAction( PrimaryGeneratorAction* );
         void add_particleGun           ( ParticleGun           * );
@@ -104,7 +126,20 @@ class ParticleGunMessenger : public G4UImessenger
         G4UIcmdWithADoubleAndUnit* m_parameter_position_x_random_max{ nullptr };
         G4UIcmdWithADoubleAndUnit* m_parameter_position_y_random_max{ nullptr };
         G4UIcmdWithADoubleAndUnit* m_parameter_position_z_random_max{ nullptr };
+        G4UIcmdWithABool         * m_parameter_position_fold        { nullptr };
         G4UIcmdWithAnInteger     * m_parameter_nParticles           { nullptr };
+        G4UIcmdWithAnInteger     * m_parameter_nVertices            { nullptr };
+
+        // parallel beams of a lens scan (see /geometry/lensScan and ParticleGun::generate_lensScan)
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_angle_x_min   { nullptr };
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_angle_x_max   { nullptr };
+        G4UIcmdWithAnInteger     * m_parameter_lensScan_angle_x_nSteps{ nullptr };
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_angle_y_min   { nullptr };
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_angle_y_max   { nullptr };
+        G4UIcmdWithAnInteger     * m_parameter_lensScan_angle_y_nSteps{ nullptr };
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_offset_max    { nullptr };
+        G4UIcmdWithAnInteger     * m_parameter_lensScan_offset_nSteps { nullptr };
+        G4UIcmdWithADoubleAndUnit* m_parameter_lensScan_distance      { nullptr };
 
         G4bool   m_variable_momentum_random      { false };
         G4double m_variable_momentum_x_random_min{ -10   };
@@ -125,7 +160,19 @@ class ParticleGunMessenger : public G4UImessenger
         G4double m_variable_position_x_random_max{ 0     };
         G4double m_variable_position_y_random_max{ 0     };
         G4double m_variable_position_z_random_max{ 0     };
+        G4bool   m_variable_position_fold        { false }; // into 0 <= x <= y <= z
         G4int    m_variable_nParticles           { 1     };
+        G4int    m_variable_nVertices            { 1     }; // each with its own random position
+
+        G4double m_variable_lensScan_angle_x_min   { 0       };
+        G4double m_variable_lensScan_angle_x_max   { 0       };
+        G4int    m_variable_lensScan_angle_x_nSteps{ 1       };
+        G4double m_variable_lensScan_angle_y_min   { 0       };
+        G4double m_variable_lensScan_angle_y_max   { 0       };
+        G4int    m_variable_lensScan_angle_y_nSteps{ 1       };
+        G4double m_variable_lensScan_offset_max    { 7  * cm };
+        G4int    m_variable_lensScan_offset_nSteps { 15      };
+        G4double m_variable_lensScan_distance      { 30 * cm };
 
         vector< PrimaryGeneratorAction* > m_primaryGeneratorActions;
         vector< ParticleGun           * > m_particleGuns           ;
@@ -27,7 +27,7 @@ class PhotoSensor
         PhotoSensor( G4String );
        ~PhotoSensor();
 
-        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false );
+        void place( G4RotationMatrix*, G4ThreeVector, G4LogicalVolume*, G4bool = false, G4int = -1 );
 
         G4String                      get_name             ();
         GeometricObjectBox          * get_surface          ();
@@ -14,7 +14,6 @@
 
 #include "G4VHit.hh"
 #include "G4THitsCollection.hh"
-#include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Transform3D.hh"
@@ -25,12 +24,15 @@
 #include "G4VisAttributes.hh"
 
 #include "ConstructionMessenger.hh"
+#include "EventArena.hh"
 #include "LensHit.hh"
 
 #include <vector>
 
 using std::vector;
 
+using LensHitVector = vector< LensHit*, EventArenaAllocator< LensHit* > >;
+
 class PhotoSensorHit : public G4VHit
 {
     public:
@@ -62,23 +64,27 @@ class PhotoSensorHit : public G4VHit
         void set_hit_position_absolute     (       G4ThreeVector       );
         void set_hit_time                  (       G4double            );
         void set_hit_energy                (       G4double            );
+        void set_hit_weight                (       G4double            );
         void set_hit_momentum              (       G4ThreeVector       );
         void set_hit_process               ( const G4String&           );
         void set_particle_energy           (       G4double            );
         void set_particle_momentum         (       G4ThreeVector       );
         void set_particle_position_initial (       G4ThreeVector       );
         void set_lensHits                  ( const vector< LensHit* >& );
+        void reserve_lensHits              (       size_t              );
+        void add_lensHit                   (       LensHit*            );
 
         G4ThreeVector     get_photoSensor_position       (       );
         G4RotationMatrix* get_photoSensor_rotationMatrix (       );
-        G4String          get_photoSensor_name           (       );
+        const G4String&   get_photoSensor_name           (       );
         G4int             get_photoSensor_ID             (       );
         G4ThreeVector     get_hit_position_absolute      (       );
         G4ThreeVector     get_hit_position_relative      (       );
         G4double          get_hit_time                   (       );
         G4double          get_hit_energy                 (       );
+        G4double          get_hit_weight                 (       ); // of the track, see StackingAction
         G4ThreeVector     get_hit_momentum               (       );
-        G4String          get_hit_process                (       );
+        const G4String&   get_hit_process                (       );
         G4double          get_particle_energy            (       );
         G4ThreeVector     get_particle_momentum          (       );
         G4ThreeVector     get_particle_position_initial  (       );
@@ -87,36 +93,34 @@ class PhotoSensorHit : public G4VHit
         LensHit         * get_lensHit                    ( G4int );
 
     protected:
+        // Names point at strings owned by the sensitive detector and the process,
+        // so hits do not copy strings (hits live in the EventArena).
         G4ThreeVector      m_photoSensor_position      ;
-        G4RotationMatrix*  m_photoSensor_rotationMatrix;
-        G4String           m_photoSensor_name          ;
+        G4RotationMatrix*  m_photoSensor_rotationMatrix{ nullptr };
+        const G4String*    m_photoSensor_name          { nullptr };
         G4int              m_photoSensor_ID            ;
         G4ThreeVector      m_hit_position              ;
         G4double           m_hit_time                  ;
         G4double           m_hit_energy                ;
+        G4double           m_hit_weight                { 1. };
         G4ThreeVector      m_hit_momentum              ;
-        G4String           m_hit_process               ;
+        const G4String*    m_hit_process               { nullptr };
         G4double           m_particle_energy           ;
         G4ThreeVector      m_particle_momentum         ;
         G4ThreeVector      m_particle_position_initial ;
-        vector< LensHit* > m_lensHits                  ;
+        LensHitVector      m_lensHits                  ;
 
         ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
 };
 
 using PhotoSensorHitsCollection = G4THitsCollection< PhotoSensorHit >;
 
-extern G4ThreadLocal G4Allocator< PhotoSensorHit >* PhotoSensorHitAllocator;
-
 inline void* PhotoSensorHit::operator new( size_t ) {
-    if( PhotoSensorHitAllocator == nullptr )
-        PhotoSensorHitAllocator = new G4Allocator< PhotoSensorHit >;
-
-    return ( void* )PhotoSensorHitAllocator->MallocSingle();
+    return EventArena::get_instance()->allocate( sizeof( PhotoSensorHit ), alignof( PhotoSensorHit ) );
 }
 
-inline void PhotoSensorHit::operator delete( void* t_hit ) {
-    PhotoSensorHitAllocator->FreeSingle( ( PhotoSensorHit* ) t_hit );
+// Memory is reclaimed all at once by EventArena::reset().
+inline void PhotoSensorHit::operator delete( void* ) {
 }
 
 #endif
\ No newline at end of file
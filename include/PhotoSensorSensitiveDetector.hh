@@ -17,47 +17,90 @@
 #include "G4Step.hh"
 #include "G4SDManager.hh"
 #include "G4Event.hh"
+#include "G4MaterialPropertyVector.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tokenizer.hh"
+#include "Randomize.hh"
 
+#include "ConstructionMessenger.hh"
 #include "OutputMessenger.hh"
 #include "OutputManager.hh"
 #include "PhotoSensorHit.hh"
 #include "Track.hh"
+#include "CopyNumberMap.hh"
 #include "LensSensitiveDetector.hh"
+#include "SurfaceLattice.hh"
+
+#include <algorithm>
 
 using std::to_string;
+using std::max      ;
+using std::sort     ;
+using std::pair     ;
 
+// Attached to the photosensor surface shared by all DSPDs. The DSPD is identified by
+// the copy numbers of the touched volume and its mothers (see set_copyNumberMap()). Its
+// copies are either added one by one in DSPD ID order (add_copy()), or taken from the
+// surface lattices of parameterised faces (add_copies()), whose names and positions are
+// only made for the DSPDs asked for.
+//
+// With `/geometry/photoSensor/efficiency' an optical photon is only recorded with the
+// detection efficiency at its energy. With `/geometry/photoSensor/efficiency/prescale true'
+// StackingAction already kills photons at birth with the peak efficiency (see
+// get_efficiency_prescale()), and only the remaining efficiency / peak is drawn here.
 class PhotoSensorSensitiveDetector : public G4VSensitiveDetector 
 {
     public:
-        PhotoSensorSensitiveDetector( G4String, G4int );
-       ~PhotoSensorSensitiveDetector() override = default;
+        PhotoSensorSensitiveDetector( G4String );
+       ~PhotoSensorSensitiveDetector() override;
 
         void Initialize( G4HCofThisEvent* ) override;
         G4bool ProcessHits( G4Step*, G4TouchableHistory* ) override;
 
-        G4String                   get_name               (                );
-        G4int                      get_ID                 (                );
-        G4ThreeVector              get_position           (                );
-        G4RotationMatrix         * get_rotationMatrix     (                );
+        void add_hit( G4int, const G4ThreeVector&, G4double, G4double, const G4ThreeVector&, const G4String&, G4double, const G4ThreeVector& );
+
+        void     update_efficiency      (          );
+        G4double get_efficiency         ( G4double );
+        G4bool   draw_efficiency        ( G4double );
+        G4double get_efficiency_prescale(          );
+
+        const G4String           & get_name               (                );
+        const G4String           & get_name               ( G4int          );
+        G4ThreeVector              get_position           ( G4int          );
+        G4RotationMatrix         * get_rotationMatrix     ( G4int          );
+        G4int                      get_nCopies            (                );
         PhotoSensorHitsCollection* get_hitsCollection     ( const G4Event* );
         G4String                   get_hitsCollection_name(                );
         G4int                      get_hitsCollection_ID  (                );
 
-        void set_position              ( G4ThreeVector                     );
-        void set_rotationMatrix        ( G4RotationMatrix                * );
-        void set_hitsCollection_ID     ( G4int                             );
-        void set_lensSensitiveDetectors( vector< LensSensitiveDetector* >  );
+        void add_copy                  ( const G4String&      , G4ThreeVector  , G4RotationMatrix* );
+        void add_copies                ( const SurfaceLattice*, const G4String&, G4ThreeVector     );
+        void set_hitsCollection_ID     ( G4int                                                     );
+        void set_lensSensitiveDetectors( vector< LensSensitiveDetector* >                          );
+        void set_copyNumberMap         ( const CopyNumberMap&                                      );
     
     protected:
-        G4String                          m_name                             ;
-        G4ThreeVector                     m_position                         ;
-        G4RotationMatrix                * m_rotationMatrix        { nullptr };
-        vector< LensSensitiveDetector* >  m_lensSensitiveDetectors           ;
+        G4String                          m_name                  ;
+        vector< G4String          >       m_copy_names            ;
+        vector< G4ThreeVector     >       m_copy_positions        ;
+        vector< G4RotationMatrix* >       m_copy_rotationMatrices ;
+        vector< const SurfaceLattice* >   m_surfaceLattices       ;
+        G4String                          m_surfaceLattice_suffix ; // of the names of their copies
+        vector< G4String          >       m_surfaceLattice_names  ; // by ID, made when asked for
+        G4ThreeVector                     m_surfaceLattice_offset ; // of their copies, see add_copies()
+        vector< LensSensitiveDetector* >  m_lensSensitiveDetectors;
+        CopyNumberMap                     m_copyNumberMap         ;
 
         PhotoSensorHitsCollection* m_photoSensorHitsCollection   { nullptr };
         G4int                      m_photoSensorHitsCollection_ID{ -1      };
 
-        G4int m_ID;
+        // from `/geometry/photoSensor/efficiency', nullptr if none (every photon is recorded)
+        G4MaterialPropertyVector * m_efficiency                  { nullptr };
+        G4String                   m_efficiency_string           { "none"  };
+        G4double                   m_efficiency_max              { 1.      };
+        G4double                   m_efficiency_prescale         { 1.      }; // survival probability at birth
 };
 
 #endif
\ No newline at end of file
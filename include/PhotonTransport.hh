@@ -0,0 +1,50 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef PhotonTransport_hh
+#define PhotonTransport_hh
+
+// Built without Geant4 like RayTracer (see CMakeLists.txt). Lengths are in mm and
+// energies in MeV, the Geant4 internal units.
+
+#include "RayTracer.hh"
+
+#include <random>
+
+// Transport of optical photons through a box of homogeneous medium centred on the origin
+// (the detector medium inside the DSPD walls, see MediumFastSimulationModel). Photons fly
+// straight between Rayleigh scatterings; the scattering and absorption points are sampled
+// from exponential distributions and the box faces are intersected analytically. A photon
+// stops when it is absorbed (status m_absorbed) or reaches a face (m_boundary), where the
+// caller takes over. Every step loops over the whole batch (see RayTracerBatch); photons
+// still alive after m_nSteps_max steps are returned where they are.
+class PhotonTransport
+{
+    public:
+        PhotonTransport( const RayTracerMaterial&, double, double, double );
+
+        void transport( RayTracerBatch&, double, std::mt19937_64& ) const;
+
+        bool contains( double, double, double, double, double, double ) const; // inside, or on a face and moving inwards
+
+        const RayTracerMaterial& get_medium  (     ) const;
+        double                   get_halfSize( int ) const;
+
+    private:
+        static constexpr int    m_nSteps_max{ 10000 };
+        static constexpr double m_tolerance { 1e-9  }; // on the faces, as kCarTolerance
+
+        RayTracerMaterial m_medium        ;
+        double            m_halfSize[ 3 ] ;
+};
+
+#endif
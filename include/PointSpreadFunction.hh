@@ -0,0 +1,90 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef PointSpreadFunction_hh
+#define PointSpreadFunction_hh
+
+#include "globals.hh"
+#include "G4Exception.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+
+// Photosensor hit positions of a lens scan (see /geometry/lensScan), binned per incidence
+// direction of the parallel beams (see ParticleGun::generate_lensScan). Direction
+// n = n_x * nAngles_y + n_y has the angles
+//   angle_x = angle_x_min + n_x * ( angle_x_max - angle_x_min ) / ( nAngles_x - 1 )
+// (and the same for y) between the beam and the DSPD axis in the x-z and y-z planes.
+//
+// Each thread fills its own table; merge() adds it to the run total (get_instance()),
+// which the master writes at the end of the run. The file is, in native byte order:
+//   char[8]  "DSPSPSF"
+//   int32    version
+//   int32    nAngles_x, nAngles_y
+//   double   angle_x_min, angle_x_max, angle_y_min, angle_y_max [rad]
+//   int32    nBins (per side)
+//   double   width [mm] (binned range is [-width/2, width/2] in x and y)
+//   per direction:
+//     uint64 photons fired
+//     uint32 hits[ nBins * nBins ] (bin n_x * nBins + n_y)
+class PointSpreadFunction
+{
+    public:
+        PointSpreadFunction();
+       ~PointSpreadFunction() = default;
+
+        static PointSpreadFunction* get_instance   ();
+        static void                 delete_instance();
+
+        void reset      (                                );
+        void fill       ( G4int, G4double, G4double      );
+        void add_photons( G4int, G4long                  );
+        void merge      ( const PointSpreadFunction&     );
+        void write      ( const G4String&                ) const;
+        void read       ( const G4String&                );
+
+        G4int    get_nDirections(              ) const;
+        G4int    get_nAngles_x  (              ) const;
+        G4int    get_nAngles_y  (              ) const;
+        G4int    get_nBins      (              ) const;
+        G4double get_width      (              ) const;
+        G4long   get_nPhotons   ( G4int        ) const;
+        G4long   get_nHits      ( G4int        ) const;
+        G4double get_probability( G4int, G4int ) const;
+
+        static G4ThreeVector get_direction( G4double, G4double );
+
+    protected:
+        static PointSpreadFunction* m_instance;
+
+        static constexpr char  m_magic[ 8 ]{ "DSPSPSF" };
+        static constexpr G4int m_version   { 1 };
+
+        G4int    m_nAngles_x  { 1 };
+        G4int    m_nAngles_y  { 1 };
+        G4double m_angle_x_min{ 0 };
+        G4double m_angle_x_max{ 0 };
+        G4double m_angle_y_min{ 0 };
+        G4double m_angle_y_max{ 0 };
+        G4int    m_nBins      { 1 };
+        G4double m_width      { 0 };
+
+        vector< uint64_t > m_nPhotons;
+        vector< uint32_t > m_hits    ;
+};
+
+#endif
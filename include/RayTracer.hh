@@ -0,0 +1,143 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef RayTracer_hh
+#define RayTracer_hh
+
+// Built without Geant4 (see CMakeLists.txt), so only standard types are used here.
+// Lengths are in mm and energies in MeV, the Geant4 internal units.
+
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+using std::vector;
+using std::size_t;
+
+// Refractive index, absorption length and Rayleigh scattering length against photon energy, linearly
+// interpolated and clamped at the ends like G4MaterialPropertyVector. The tables
+// are copied from the Geant4 materials (see Materials::get_rayTracerMaterial). The group
+// index c / GROUPVEL, which sets the speed of the photons, is made from the refractive
+// index table the way Geant4 makes GROUPVEL.
+class RayTracerMaterial
+{
+    public:
+        RayTracerMaterial( double = 1 );
+        RayTracerMaterial( const vector< double >&, const vector< double >&,
+                           const vector< double >& = {}, const vector< double >& = {},
+                           const vector< double >& = {}, const vector< double >& = {} );
+
+        double get_rindex          ( double ) const;
+        double get_groupIndex      ( double ) const;
+        double get_absorptionLength( double ) const; // infinite without an absorption length table
+        double get_scatteringLength( double ) const; // infinite without a Rayleigh table
+
+        void print( std::ostream& ) const;
+
+    private:
+        static double interpolate( const vector< double >&, const vector< double >&, double );
+        void          make_groupIndex();
+
+        vector< double > m_rindex_energies          ;
+        vector< double > m_rindex_values            ;
+        vector< double > m_groupIndex_energies      ;
+        vector< double > m_groupIndex_values        ;
+        vector< double > m_absorptionLength_energies;
+        vector< double > m_absorptionLength_values  ;
+        vector< double > m_scatteringLength_energies;
+        vector< double > m_scatteringLength_values  ;
+};
+
+// One lens of the lens system, with the surfaces of LensSolid: surface 1 (back, -z)
+// and surface 2 (front, +z) have their vertices at position -/+ thickness / 2 and
+//     z_i( rho ) = vertex_i - radius_x_i * ( 1 - sqrt( 1 - min( rho, yLimits )^2 / radius_y_i^2 ) ).
+// Circular lenses end at rho = yLimits, square ones at the DSPD walls.
+class RayTracerLens
+{
+    public:
+        RayTracerLens( double, double, double, double, double, double, double, bool, 
+                       const RayTracerMaterial& );
+
+        double get_position () const;
+        double get_surface_z( int, double ) const;
+
+        double            m_surface_radius_x[ 2 ];
+        double            m_surface_radius_y[ 2 ];
+        double            m_surface_vertex  [ 2 ];
+        double            m_yLimits              ;
+        bool              m_circular             ;
+        double            m_position             ;
+        RayTracerMaterial m_material             ;
+};
+
+// Photons traced together, one array per component so that the loops over a batch
+// vectorise. The weight is the probability that the photon got this far (Fresnel
+// transmission and absorption), the group path length is the sum of group index times
+// distance (c_light times the travel time); status says why tracing stopped.
+class RayTracerBatch
+{
+    public:
+        enum status {
+            m_alive        , // still being traced
+            m_detected     , // reached the photosensor
+            m_wall         , // left the DSPD through its side (calorimeter)
+            m_reflected    , // total internal reflection
+            m_lensSide     , // left a circular lens through its side
+            m_missed       , // started past a surface or not moving towards the photosensor
+            m_absorbed     , // absorbed in the medium (PhotonTransport)
+            m_boundary       // reached a face of the medium box (PhotonTransport)
+        };
+
+        RayTracerBatch( size_t = 0 );
+
+        void   resize( size_t );
+        size_t size  (        ) const;
+        void   set   ( size_t, double, double, double, double, double, double );
+
+        vector< double > m_x     , m_y        , m_z        ;
+        vector< double > m_dx    , m_dy       , m_dz       ;
+        vector< double > m_weight, m_pathLength, m_groupPathLength;
+        vector< int    > m_status;
+};
+
+// Sequential ray tracer of the lens system of one DSPD, in the lens system frame of
+// LensSystem: the photons move towards +z through every lens in order of position
+// and end on the photosensor plane. Each surface refracts (Snell) and weights by the
+// unpolarised Fresnel transmission; the medium and lenses weight by their
+// absorption. Photons are traced once per surface, so reflected photons, rays
+// entering a lens through its side and scattering are not followed (use the full
+// Geant4 simulation for those).
+class RayTracer
+{
+    public:
+        RayTracer( const RayTracerMaterial&, double, double );
+
+        void add_lens( const RayTracerLens& );
+
+        void trace( RayTracerBatch&, double ) const;
+
+        const RayTracerMaterial      & get_medium       () const;
+        const vector< RayTracerLens >& get_lenses       () const;
+        double                         get_photoSensor_z() const;
+        double                         get_halfWidth    () const;
+
+    private:
+        void move_to_surface( RayTracerBatch&, const RayTracerLens&, int, double, double, const vector< char >& ) const;
+        void move_to_plane  ( RayTracerBatch&, double, double, double                                            ) const;
+        void refract        ( RayTracerBatch&, const RayTracerLens&, int, double, double, const vector< char >& ) const;
+
+        RayTracerMaterial       m_medium       ;
+        double                  m_photoSensor_z; // plane of the photosensor surface
+        double                  m_halfWidth    ; // of the DSPD
+        vector< RayTracerLens > m_lenses       ; // in order of position
+};
+
+#endif
@@ -14,16 +14,24 @@
 
 #include "G4UserRunAction.hh"
 #include "G4Accumulable.hh"
+#include "G4AccumulableManager.hh"
 #include "globals.hh"
 #include "G4AnalysisManager.hh"
+#include "G4Timer.hh"
 
 #include "OutputMessenger.hh"
 #include "OutputManager.hh"
 #include "DetectorConstruction.hh"
 #include "ConstructionMessenger.hh"
+#include "EventArena.hh"
+#include "PointSpreadFunction.hh"
+#include "VisibilityLibrary.hh"
+#include "HitLibrary.hh"
 
 using std::to_string;
 
+class SteppingAction;
+
 class RunAction : public G4UserRunAction
 {
     public:
@@ -33,15 +41,46 @@ class RunAction : public G4UserRunAction
         void BeginOfRunAction( const G4Run* ) override;
         void   EndOfRunAction( const G4Run* ) override;
 
-        OutputManager* get_outputManager();
+        OutputManager      * get_outputManager      ();
+        PointSpreadFunction* get_pointSpreadFunction();
+        VisibilityLibrary  * get_visibilityLibrary  ();
+        HitLibrary         * get_hitLibrary         ();
+
+        void count_steps       ( G4int );
+        void count_photon_late ();
+        void record_stack_peak ( G4long, G4long, G4long );
+        void set_steppingAction( SteppingAction* );
 
     private:
+        void check_library();
+
         G4AnalysisManager    * m_analysisManager      { G4AnalysisManager    ::Instance    () };
         OutputMessenger      * m_outputMessenger      { OutputMessenger      ::get_instance() };
         // OutputManager        * m_outputManager        { OutputManager        ::get_instance() };
         OutputManager        * m_outputManager        { new OutputManager()                   };
         DetectorConstruction * m_detectorConstruction { nullptr                               };
+        SteppingAction       * m_steppingAction       { nullptr                               }; // of this worker, nullptr on the master
         ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
+
+        // m_steppingAction is registered with the run manager, which then deletes it
+        G4bool                 m_steppingAction_registered{ false };
+
+        // hits of this thread during a lens scan (see /geometry/lensScan), nullptr otherwise
+        PointSpreadFunction  * m_pointSpreadFunction  { nullptr                               };
+        // hits of this thread per voxel of the photon origin (see /output/visibility/save), nullptr otherwise
+        VisibilityLibrary    * m_visibilityLibrary    { nullptr                               };
+        // single-particle events of this thread (see /output/hitLibrary/save), nullptr otherwise
+        HitLibrary           * m_hitLibrary           { nullptr                               };
+
+        // time per step of the run (see macros/benchmark_navigation.mac), steps counted by TrackingAction
+        G4Timer                m_timer                ;
+        G4long                 m_nSteps               { 0                                     };
+        // optical photons killed after the readout window (see SteppingAction), merged over the threads
+        G4Accumulable< G4long > m_nPhotons_late       { "nPhotons_late", 0                    };
+        // largest photon stacks of an event (see StackingAction::get_stack_peak), over the threads
+        G4Accumulable< G4long > m_stack_peak          { "stack_peak"       , 0, G4MergeMode::kMaximum };
+        G4Accumulable< G4long > m_stack_buffer_peak   { "stack_buffer_peak", 0, G4MergeMode::kMaximum };
+        G4Accumulable< G4long > m_stack_spill_peak    { "stack_spill_peak" , 0, G4MergeMode::kMaximum };
 };
 
 #endif
\ No newline at end of file
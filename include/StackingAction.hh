@@ -9,19 +9,139 @@
 //*//                                                                     //*//
 //*/////////////////////////////////////////////////////////////////////////*//
 
+
 #ifndef StackingAction_hh
 #define StackingAction_hh
 
 #include "G4UserStackingAction.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
 #include "globals.hh"
 
 #include "NESTStackingAction.hh"
 
+#include "ConstructionMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "Materials.hh"
+#include "VisibilityLibrary.hh"
+#include "HitLibrary.hh"
+#include "GeometricAcceptance.hh"
+#include "RayTracer.hh"
+
+#include <map>
+#include <vector>
+#include <cstdio>
+
+using std::map;
+using std::vector;
+
+// An optical photon waiting to be tracked, kept instead of its G4Track (see StackingAction).
+// Written as is to the spill file, which is only read back by the same process.
+struct StackedPhoton
+{
+    G4ThreeVector     m_position      ;
+    G4ThreeVector     m_direction     ;
+    G4ThreeVector     m_polarization  ;
+    G4double          m_energy        ;
+    G4double          m_time          ;
+    G4double          m_weight        ;
+    G4int             m_trackID       ;
+    G4int             m_parentID      ;
+    G4int             m_creatorModelID;
+    const G4VProcess* m_creatorProcess;
+};
+
+// With `/geometry/fastSimulation_visibility expected' or `sampled', optical photons born
+// inside the voxels of the VisibilityLibrary are not tracked. Expected: the photons of the
+// event are counted per voxel and EventAction saves the expected hits per DSPD
+// (get_visibility_expected()). Sampled: each photon is drawn to reach a DSPD or not, and a
+// photosensor hit is added at the centre of the photosensor with a direction drawn from the
+// library and the time of the straight path. Photons outside the voxels are tracked in full.
+//
+// With `/geometry/fastSimulation_overlay true' each primary is replaced by the photosensor hits
+// of the closest single-particle event of the HitLibrary, mapped onto it by a symmetry of the
+// cube and delayed by its time. Primaries without a library event within the tolerances are
+// tracked in full.
+//
+// With a photosensor efficiency curve (`/geometry/photoSensor/efficiency') and its prescale,
+// every optical photon survives its birth only with the peak efficiency, before any of the
+// above. Expected hits count each photon with its efficiency / peak instead.
+//
+// With `/geometry/fastSimulation_prescale' only that fraction of the secondary optical photons
+// (scintillation, Cerenkov) is kept. The hits are not reweighted: RunAction saves the prescale
+// of the run in the metadata tuple to rescale them.
+//
+// With `/geometry/fastSimulation_acceptance' the optical photons less likely than that to reach
+// a DSPD along their initial direction (see GeometricAcceptance) are kept with the probability
+// `/geometry/fastSimulation_acceptance_survival', and the survivors get its inverse as track
+// weight, saved with their hits (see PhotoSensorHit::get_hit_weight()).
+//
+// With `/geometry/fastSimulation_stackChunk' only that many optical photons are on the urgent
+// stack at a time. The others are kept as StackedPhoton in a buffer, and one photon in the
+// waiting stack makes G4StackManager call NewStage(), which pushes the next chunk back. The
+// buffer holds at most `/geometry/fastSimulation_stackBuffer' photons; beyond that they are
+// written to a temporary file of this thread and read back in blocks when the buffer runs low,
+// so the memory taken by waiting photons does not grow with the number of photons.
 class StackingAction : public NESTStackingAction
 {
     public:
-        StackingAction();
+        StackingAction( DetectorConstruction* );
        ~StackingAction() override;
+
+        G4ClassificationOfNewTrack ClassifyNewTrack( const G4Track* ) override;
+        void                       PrepareNewEvent (                ) override;
+        void                       NewStage        (                ) override;
+
+        map< G4int, G4double > get_visibility_expected() const;
+        G4long                 get_stack_peak         () const;
+        G4long                 get_stack_buffer_peak  () const;
+        G4long                 get_stack_spill_peak   () const;
+
+    protected:
+        DetectorConstruction   * m_detectorConstruction  { nullptr                               };
+        ConstructionMessenger  * m_constructionMessenger { ConstructionMessenger::get_instance() };
+
+        // set per event from `/geometry/photoSensor/efficiency', nullptr without photosensor hits
+        PhotoSensorSensitiveDetector* m_efficiency_sensitiveDetector{ nullptr };
+        G4double                      m_efficiency_prescale         { 1.      }; // survival probability at birth
+
+        G4double                      m_prescale                    { 1.      }; // `/geometry/fastSimulation_prescale'
+        G4double                      m_acceptance_threshold        { 0.      }; // 0 for no roulette
+        G4double                      m_acceptance_survival         { 1.      };
+        GeometricAcceptance         * m_acceptance                  { nullptr }; // made at the first event of each run with a roulette
+        G4int                         m_acceptance_runID            { -1      };
+
+        // set per event from `/geometry/fastSimulation_visibility', nullptr if none
+        const VisibilityLibrary* m_visibilityLibrary     { nullptr                               };
+        G4bool                   m_visibility_sampled    { false                                 };
+        RayTracerMaterial        m_visibility_medium                                              ; // for the arrival time
+        map< G4int, G4double >   m_visibility_nPhotons                                            ; // per voxel, in this event
+
+        const G4String           m_visibility_process    { "VisibilityLibrary"                   };
+
+        // set per event from `/geometry/fastSimulation_overlay', nullptr if false
+        const HitLibrary       * m_hitLibrary            { nullptr                               };
+        const G4String           m_hitLibrary_process    { "HitLibrary"                          };
+
+        // set per event from `/geometry/fastSimulation_stackChunk', 0 to track all photons at once
+        G4int                    m_stack_chunk           { 0                                     };
+        vector< StackedPhoton >  m_stack_buffer                                                   ;
+        G4int                    m_stack_buffer_max      { 0                                     }; // `/geometry/fastSimulation_stackBuffer'
+        std::FILE              * m_stack_spill           { nullptr                               }; // photons beyond it, opened when needed
+        G4long                   m_stack_spilled         { 0                                     }; // photons in the spill file
+        G4bool                   m_stack_waiting         { false                                 }; // a photon is in the waiting stack
+        G4bool                   m_stack_releasing       { false                                 }; // in NewStage()
+        G4ClassificationOfNewTrack m_stack_release       { fUrgent                               }; // of the photon being pushed back
+        G4long                   m_stack_peak            { 0                                     }; // tracks in the stacks, in this event
+        G4long                   m_stack_buffer_peak     { 0                                     };
+        G4long                   m_stack_spill_peak      { 0                                     };
+
+    private:
+        G4ClassificationOfNewTrack classify_photon( const G4Track* );
+        void                       release_photon ( G4ClassificationOfNewTrack );
+        void                       write_spill    ( const StackedPhoton&       );
+        void                       read_spill     (                            );
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -25,6 +25,8 @@
 #include "G4LogicalVolume.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4ProcessTable.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4PhysicalConstants.hh"
 
 #include "OutputManager.hh"
 #include "OutputMessenger.hh"
@@ -32,6 +34,7 @@
 #include "EventAction.hh"
 #include "DetectorConstruction.hh"
 #include "ConstructionMessenger.hh"
+#include "GeometricAcceptance.hh"
 
 using std::string;
 using G4StrUtil::to_lower;
@@ -39,10 +42,12 @@ using G4StrUtil::to_lower;
 class SteppingAction : public G4UserSteppingAction
 {
     public:
-        SteppingAction( RunAction* )         ;
-       ~SteppingAction(            ) override;
+        SteppingAction( RunAction*, DetectorConstruction* )         ;
+       ~SteppingAction(                                   ) override;
 
-        void UserSteppingAction( const G4Step* ) override;
+        void   UserSteppingAction( const G4Step* ) override;
+        void   prepare_run       (               )         ;
+        G4bool get_active        (               ) const   ;
         
     private:
         RunAction            * m_runAction            { nullptr                               };
@@ -50,8 +55,14 @@ class SteppingAction : public G4UserSteppingAction
         OutputMessenger      * m_outputMessenger      { OutputMessenger      ::get_instance() };
         ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
         G4AnalysisManager    * m_analysisManager      { nullptr                               };
+        DetectorConstruction * m_detectorConstruction { nullptr                               };
+        GeometricAcceptance  * m_acceptance           { nullptr                               }; // box of the DSPD fronts, made at the first late photon check of a run
 
-        G4ThreeVector m_world_size{ m_constructionMessenger->get_world_size() / 2 };
+        // set per run by prepare_run()
+        G4bool   m_photon_save { false };
+        G4bool   m_primary_save{ false };
+        G4double m_timeWindow  { 0.    };
+        G4bool   m_active      { false }; // any of the above
 
         G4int m_index_photon { -1 };
         G4int m_index_primary{ -1 };
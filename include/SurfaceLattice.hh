@@ -0,0 +1,83 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef SurfaceLattice_hh
+#define SurfaceLattice_hh
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+
+#include <vector>
+
+using std::vector;
+
+// Layout of the calorimeters and DSPDs on one face of the medium, as place_surface lays it
+// out: the position, rotation and name of every component follow from its indices, so a
+// parameterised face (see DetectorConstruction::place_surface_parameterised) needs no object
+// per component and its names are only made when asked for.
+//
+// The DSPD IDs of a face follow the loops of place_surface, starting at the ID given to
+// set_IDs. The calorimeter IDs of a parameterised face go per cell (horizontal, vertical and
+// middle calorimeter with the indices of the DSPD) and then along the row and the column
+// left at the edges, starting at the other ID given to set_IDs (see get_calorimeter).
+class SurfaceLattice
+{
+    public:
+        enum Component { horizontal, vertical, middle, DSPD };
+
+        // a component with its indices along x and y
+        struct Element
+        {
+            Component m_component;
+            G4int     m_x        ;
+            G4int     m_y        ;
+        };
+
+        SurfaceLattice( const G4String&, G4RotationMatrix*, G4RotationMatrix*, G4RotationMatrix*, G4ThreeVector, G4int, G4int );
+
+        static G4String get_prefix( Component );
+
+        void set_IDs( G4int, G4int );
+
+        G4int             get_amount_x      ( Component               ) const;
+        G4int             get_amount_y      ( Component               ) const;
+        G4int             get_amount        ( Component               ) const;
+        G4ThreeVector     get_position      ( Component, G4int, G4int ) const;
+        G4ThreeVector     get_position      ( const Element&          ) const;
+        G4RotationMatrix* get_rotationMatrix( Component               ) const;
+        G4String          get_index         ( Component, G4int, G4int ) const;
+        G4String          get_name          ( const Element&          ) const;
+
+        G4int   get_DSPD_ID_begin       (       ) const;
+        G4int   get_calorimeter_ID_begin(       ) const;
+        G4int   get_calorimeter_amount  (       ) const;
+        Element get_DSPD                ( G4int ) const;
+        Element get_calorimeter         ( G4int ) const;
+
+        static const SurfaceLattice* find_DSPD       ( const vector< const SurfaceLattice* >&, G4int );
+        static const SurfaceLattice* find_calorimeter( const vector< const SurfaceLattice* >&, G4int );
+
+    protected:
+        G4String          m_index                         ;
+        G4RotationMatrix* m_rotationMatrix                ; // of the face, turns every position
+        G4RotationMatrix* m_rotationMatrix_calorimeterFull; // of the vertical calorimeters
+        G4RotationMatrix* m_rotationMatrix_DSPD           ;
+        G4ThreeVector     m_translations_initial[ 4 ]     ; // per component, before the rotation
+        G4double          m_calorimeter_width             ; // half sizes, as in place_surface
+        G4double          m_calorimeter_height            ;
+        G4int             m_amount_x                      ; // DSPDs along x and y
+        G4int             m_amount_y                      ;
+        G4int             m_DSPD_ID_begin       { 0 }     ;
+        G4int             m_calorimeter_ID_begin{ 0 }     ;
+};
+
+#endif
@@ -0,0 +1,35 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef TrackingAction_hh
+#define TrackingAction_hh
+
+#include "G4UserTrackingAction.hh"
+#include "G4Track.hh"
+#include "globals.hh"
+
+#include "RunAction.hh"
+
+// Counts the steps of every track at its end for the time per step of the RunAction
+// statistics, so that no SteppingAction is needed without step output.
+class TrackingAction : public G4UserTrackingAction
+{
+    public:
+        TrackingAction( RunAction* )         ;
+       ~TrackingAction(            ) override;
+
+        void PostUserTrackingAction( const G4Track* ) override;
+
+    private:
+        RunAction* m_runAction{ nullptr };
+};
+
+#endif
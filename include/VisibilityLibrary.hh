@@ -0,0 +1,120 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#ifndef VisibilityLibrary_hh
+#define VisibilityLibrary_hh
+
+#include "globals.hh"
+#include "G4Exception.hh"
+#include "G4ThreeVector.hh"
+
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <cstdint>
+
+#include "DSPDSymmetries.hh"
+
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+
+// Photons of one voxel that reached one DSPD, with their direction on arrival at the
+// photosensor (relative to the DSPD, dz > 0) binned in dx, dy over [-1, 1]
+struct VisibilityLibraryEntry
+{
+    G4int              m_DSPD      ;
+    uint64_t           m_nHits     ;
+    vector< uint32_t > m_directions; // bin n_x * nBins + n_y
+};
+
+// Probability that an optical photon emitted in a voxel of the medium reaches each DSPD, and
+// its arrival direction there. The voxels divide the box `/output/visibility/size' centred on
+// the origin into nVoxelsPerSide^3, voxel ( n_x * nVoxelsPerSide + n_y ) * nVoxelsPerSide + n_z.
+//
+// The library is built from PhotonCreator events (see macros/visibility.mac): every event adds
+// its photons to the voxel of its first vertex and its photosensor hits to the DSPDs they hit.
+// Each thread fills its own library; merge() adds it to the run total (get_instance()), which
+// the master writes at the end of the run. Only the DSPDs seen with at least `threshold'
+// probability are written, so a voxel holds a short list of DSPDs.
+//
+// With `/output/visibility/fold true' the library is folded by the symmetries of the cube
+// that map the voxels onto voxels and the DSPDs onto DSPDs (see DSPDSymmetries): every event
+// is mapped into x <= y <= z (fold()) with its hits, so only those voxels are filled and
+// written, and a lookup elsewhere maps its voxel in and the DSPD and direction back out. The
+// events only need to be fired there (see `/particleGun/position/fold'). The file is, in
+// native byte order:
+//   char[8]  "DSPSVIS"
+//   int32    version
+//   int32    nVoxelsPerSide
+//   double   size_x, size_y, size_z [mm]
+//   int32    nBins (direction, per side)
+//   int32    nSymmetries, per symmetry int32 axes[ 3 ], signs[ 3 ] (see CubeSymmetry)
+//   per voxel:
+//     uint64 photons fired
+//     uint32 number of DSPDs
+//     per DSPD: int32 DSPD ID, uint32 hits[ nBins * nBins ]
+// with the DSPD IDs and directions of a voxel outside x <= y <= z of a folded library empty.
+//
+// The fast mode (see StackingAction) reads a library once (get_library()) and draws the
+// DSPD and direction of each photon from it instead of tracking it.
+class VisibilityLibrary
+{
+    public:
+        VisibilityLibrary();
+       ~VisibilityLibrary() = default;
+
+        static VisibilityLibrary      * get_instance   (                 );
+        static void                     delete_instance(                 );
+        static const VisibilityLibrary* get_library    ( const G4String&, PhotoSensorSensitiveDetector* );
+
+        void reset      (                                    );
+        void add_photons( G4int, G4long                      );
+        void fill       ( G4int, G4int, const G4ThreeVector& );
+        void merge      ( const VisibilityLibrary&           );
+        void write      ( const G4String&, G4double          ) const;
+        void read       ( const G4String&                    );
+
+        void                  set_symmetries( PhotoSensorSensitiveDetector* );
+        const DSPDSymmetries& get_symmetries(                               ) const;
+        G4int                 fold          ( G4int, size_t&                ) const; // the folded voxel and its symmetry
+
+        G4int                                   get_voxel      ( const G4ThreeVector& ) const; // -1 outside
+        G4int                                   get_nVoxels    (                      ) const;
+        G4int                                   get_nBins      (                      ) const;
+        G4long                                  get_nPhotons   ( G4int                ) const;
+        const vector< VisibilityLibraryEntry >& get_entries    ( G4int                ) const;
+        G4double                                get_probability( G4int, size_t        ) const;
+
+        const VisibilityLibraryEntry* sample_entry    ( G4int                        , G4double                     ) const; // nullptr if not detected
+        G4ThreeVector                 sample_direction( const VisibilityLibraryEntry&, G4double, G4double, G4double ) const;
+
+    protected:
+        static VisibilityLibrary* m_instance;
+
+        static constexpr char  m_magic[ 8 ]{ "DSPSVIS" };
+        static constexpr G4int m_version   { 2 };
+
+        G4int         m_nVoxelsPerSide{ 1 };
+        G4ThreeVector m_size              ;
+        G4int         m_nBins         { 1 };
+
+        vector< CubeSymmetry > m_symmetries_candidates; // the identity unless folded, or those of the file
+        DSPDSymmetries         m_symmetries           ; // of the candidates, those of the DSPDs
+
+        vector< uint64_t                            > m_nPhotons  ;
+        vector< vector< VisibilityLibraryEntry >    > m_entries   ;
+        vector< std::unordered_map< G4int, size_t > > m_index     ; // DSPD to entry, while filling
+        vector< vector< G4double >                  > m_cumulative; // of the DSPD probabilities, after read
+};
+
+#endif
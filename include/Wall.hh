@@ -0,0 +1,75 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#ifndef Wall_hh
+#define Wall_hh
+
+#include "globals.hh"
+#include "G4Trd.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+#include "G4VisAttributes.hh"
+#include "G4PVParameterised.hh"
+
+#include "GeometricObject.hh"
+#include "ConstructionMessenger.hh"
+#include "GridParameterisation.hh"
+
+#include <map>
+
+using std::map;
+using std::vector;
+
+// Mother volume for everything mounted on one face of the detector medium. The six
+// walls are frusta with 45 degree edges, so together they tile a shell of the medium
+// without overlapping. Daughters are given in the medium frame and converted here.
+// With parameterised walls the daughters are containers, each filled by one
+// parameterised volume (Geant4 requires it to be the only daughter of its mother).
+class Wall
+{
+    public:
+        Wall( const G4String&, G4RotationMatrix*, G4ThreeVector, G4double );
+       ~Wall();
+
+        void place             ( G4LogicalVolume*, G4bool = false, G4int = -1 );
+        void place_parameterised( const G4String&, G4VSolid*, G4ThreeVector, G4int, 
+                                  G4LogicalVolume*, GridParameterisation*, G4int );
+
+        G4String            get_name           ();
+        G4LogicalVolume   * get_logicalVolume  ();
+        GeometricObjectTrd* get_geometricObject();
+        G4RotationMatrix  * get_rotationMatrix ();
+        G4ThreeVector       get_position       ();
+        G4double            get_thickness      ();
+        vector< GeometricObjectVSolid* > get_containers();
+
+        G4ThreeVector     get_position_local      ( G4ThreeVector     );
+        G4RotationMatrix* get_rotationMatrix_local( G4RotationMatrix* );
+
+        void set_sensitiveDetector( G4VSensitiveDetector* );
+
+    protected:
+        GeometricObjectTrd   * m_wall                 { new GeometricObjectTrd()              };
+        ConstructionMessenger* m_constructionMessenger{ ConstructionMessenger::get_instance() };
+
+        G4String          m_name;
+        G4RotationMatrix* m_rotationMatrix{ nullptr };
+        G4ThreeVector     m_position;
+        G4double          m_thickness;
+
+        // daughter rotations in the wall frame, keyed by their rotation in the medium frame
+        map< G4RotationMatrix*, G4RotationMatrix* > m_rotationMatrices_local;
+
+        vector< GeometricObjectVSolid* > m_containers       ;
+        vector< GridParameterisation * > m_parameterisations;
+};
+
+#endif
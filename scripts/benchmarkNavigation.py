@@ -0,0 +1,69 @@
+# Navigation benchmark of the geometry modes. For every mode it runs NavigationBenchmark
+# on the default detector and DSPS with its macros/benchmark_navigation*.mac, and collects
+#   - the construction and close geometry (voxelisation) time,
+#   - the memory taken by the voxels and in total,
+#   - the steps per ray and the time per navigation step (NavigationBenchmark),
+#   - the time per step of the optical photons with full physics (RunAction statistics).
+# Run from the build directory:
+#   python3 ../scripts/benchmarkNavigation.py
+# The results are written to benchmarkNavigation.csv.
+
+import re
+import subprocess
+
+nRays = 100000
+
+# geometry commands of every mode, run after macros/parameters_detector.mac
+modes = {
+    'flat': ['/geometry/hierarchical false'],
+    'placed': ['/geometry/parameterised false'],
+    'merged': ['/geometry/calorimeters_merged true'],
+    'parameterised': [],
+}
+
+# event macro of every mode, with the same seed and photons
+events = {
+    'flat': 'macros/benchmark_navigation_flat.mac',
+    'placed': 'macros/benchmark_navigation_placed.mac',
+    'merged': 'macros/benchmark_navigation_merged.mac',
+    'parameterised': 'macros/benchmark_navigation.mac',
+}
+
+statistics = {
+    'construction_time': r'construction \[s\] >-+: (\S+)',
+    'close_geometry_time': r'voxelisation \[s\] >-+: (\S+)',
+    'voxel_memory': r'voxel memory \[MB\] >-+: (\S+)',
+    'memory': r'total memory \[MB\] >-+: (\S+)',
+    'steps_per_ray': r'steps per ray >-+: (\S+)',
+    'step_time': r'time per step \[ns\] >-+: (\S+)',
+    'tracking_step_time': r'time per step \[us\]-+: (\S+)',
+}
+
+def write_macro(mode):
+    geometry = 'benchmarkNavigation_geometry_{}.mac'.format(mode)
+    with open(geometry, 'w') as f:
+        for command in modes[mode]:
+            f.write(command + '\n')
+    return geometry
+
+def run(command):
+    print(' '.join(command))
+    return subprocess.run(command, capture_output=True, text=True).stdout
+
+results = []
+for mode in modes:
+    geometry = write_macro(mode)
+    output = run(['./NavigationBenchmark', str(nRays), geometry]) \
+           + run(['./DSPS', '-e', events[mode]])
+
+    result = {'mode': mode}
+    for name, pattern in statistics.items():
+        match = re.search(pattern, output)
+        result[name] = match.group(1) if match else 'nan'
+    results.append(result)
+    print(result)
+
+with open('benchmarkNavigation.csv', 'w') as f:
+    f.write(','.join(results[0].keys()) + '\n')
+    for result in results:
+        f.write(','.join(str(value) for value in result.values()) + '\n')
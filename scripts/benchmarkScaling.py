@@ -0,0 +1,103 @@
+# Scaling benchmark of the detector construction. For every number of DSPDs per side it
+# runs DSPS with one fixed calibration event and NavigationBenchmark, and collects
+#   - the construction and overlap check time and peak memory (DetectorConstruction statistics),
+#   - the close geometry (voxelisation) time (NavigationBenchmark),
+#   - the time per event (RunAction statistics).
+# Run from the build directory:
+#   python3 ../scripts/benchmarkScaling.py
+# The results are written to benchmarkScaling.csv. The script fails if the largest grid
+# misses the construction time or memory target.
+
+import math
+import re
+import subprocess
+
+grid_sizes = [15, 25, 50, 75, 100] # DSPDs per side
+nEvents = 3
+nParticles = 10000 # optical photons per event (PhotonCreator)
+nRays = 10000 # NavigationBenchmark
+
+# targets of the largest grid
+construction_time_max = 60 # s, construction and overlap check
+memory_max = 4096 # MB, peak resident memory of the construction
+
+# as in macros/parameters_detector.mac
+detector_wall_thickness = 10 # cm
+calorimeter_size = (14, 2, 47) # cm
+
+statistics = {
+    'construction_time': r'construction time \[s\]-+: (\S+)',
+    'overlap_check_time': r'overlap check time \[s\]-+: (\S+)',
+    'construction_memory': r'DetectorConstruction statistics:(?:\n.*)*?\n\s*peak memory \[MB\]-+: (\S+)',
+    'close_geometry_time': r'voxelisation \[s\] >-+: (\S+)',
+    'event_time': r'time per event \[s\]-+: (\S+)',
+    'memory': r'RunAction statistics:(?:\n.*)*?\n\s*peak memory \[MB\]-+: (\S+)',
+}
+
+def write_macros(grid_size):
+    world_size = grid_size * (calorimeter_size[0] + calorimeter_size[1]) + calorimeter_size[1] \
+               + 2 * (detector_wall_thickness + calorimeter_size[2]) + 100
+
+    geometry = 'benchmarkScaling_geometry_{}.mac'.format(grid_size)
+    with open(geometry, 'w') as f:
+        f.write("/control/execute macros/parameters_detector.mac\n")
+        f.write("/geometry/world/size {0} {0} {0} cm\n".format(world_size))
+        f.write("/geometry/directionSensitivePhotoDetector/amount {0} {0} {0}\n".format(grid_size))
+
+    event = 'benchmarkScaling_event_{}.mac'.format(grid_size)
+    with open(event, 'w') as f:
+        f.write("/geometry/checkOverlaps true\n")
+        f.write("/run/initialize\n")
+        f.write("\n")
+        f.write("/control/verbose 0\n")
+        f.write("/run/verbose 0\n")
+        f.write("/event/verbose 0\n")
+        f.write("/tracking/verbose 0\n")
+        f.write("\n")
+        f.write("/random/setSeeds 12345 67890\n")
+        f.write("/gun/particle PhotonCreator\n")
+        f.write("/analysis/setFileName benchmarkScaling_{}.root\n".format(grid_size))
+        f.write("\n")
+        f.write("/particleGun/momentum/random true\n")
+        f.write("/particleGun/nParticles {}\n".format(nParticles))
+        for axis in ['x', 'y', 'z']:
+            f.write("/particleGun/position/{}/random true\n".format(axis))
+            f.write("/particleGun/position/{}/nSteps 0\n".format(axis))
+            f.write("/particleGun/position/{}/min 0 m\n".format(axis))
+            f.write("/particleGun/position/{}/max 0 m\n".format(axis))
+        f.write("\n")
+        f.write("/run/beamOn {}\n".format(nEvents))
+
+    return geometry, event
+
+def run(command):
+    print(' '.join(command))
+    return subprocess.run(command, capture_output=True, text=True).stdout
+
+results = []
+for grid_size in grid_sizes:
+    geometry, event = write_macros(grid_size)
+    output = run(['./DSPS', '-d', geometry, '-e', event]) \
+           + run(['./NavigationBenchmark', str(nRays), geometry])
+
+    result = {'grid_size': grid_size, 'DSPDs': 6 * grid_size**2}
+    for name, pattern in statistics.items():
+        match = re.search(pattern, output)
+        result[name] = match.group(1) if match else 'nan'
+    results.append(result)
+    print(result)
+
+with open('benchmarkScaling.csv', 'w') as f:
+    f.write(','.join(results[0].keys()) + '\n')
+    for result in results:
+        f.write(','.join(str(value) for value in result.values()) + '\n')
+
+largest = results[-1]
+construction_time = float(largest['construction_time']) + float(largest['overlap_check_time'])
+memory = float(largest['construction_memory'])
+if math.isnan(construction_time) or math.isnan(memory):
+    raise SystemExit('{} DSPDs per side: no DetectorConstruction statistics'.format(largest['grid_size']))
+print('{} DSPDs per side: construction {:.1f} s (target {} s), memory {:.0f} MB (target {} MB)'.format(
+      largest['grid_size'], construction_time, construction_time_max, memory, memory_max))
+if construction_time > construction_time_max or memory > memory_max:
+    raise SystemExit('target missed')
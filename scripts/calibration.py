@@ -4,6 +4,10 @@ calorimeter_size = (0.2, 0.02, 0.5) # m
 photoSensor_size = (0.2, 0.2, 0.05) # m
 buffer_room = 0.0 # m
 nParticles = 1
+nEvents = 300
+# Fire only in 0 <= x <= y <= z, 1/48 of the detector, which the symmetries of the cube
+# of DSPDs map onto the rest (see /particleGun/position/fold and /output/visibility/fold)
+fold = False
 
 PS = photoSensor_size[0]
 CS = calorimeter_size[1]
@@ -37,10 +41,14 @@ with open('calibration.mac', 'w') as f:
     f.write("/particleGun/position/z/random true\n")
     f.write("/particleGun/position/z/min -{:.5f} m\n".format(FV_size[2] / 2))
     f.write("/particleGun/position/z/max  {:.5f} m\n".format(FV_size[2] / 2))
+    if fold:
+        f.write("/particleGun/position/fold true\n")
+        f.write("/output/visibility/save true\n")
+        f.write("/output/visibility/fold true\n")
     f.write("\n")
     f.write("/analysis/setHistoDirName photoSensor_hits_histograms\n")
     f.write("\n")
-    f.write("/run/beamOn 300")
+    f.write("/run/beamOn {}".format(nEvents // 48 if fold else nEvents))
 
 # with open('calibration.mac', 'w') as f:
 #     f.write("##########################\n")
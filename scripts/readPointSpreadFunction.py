@@ -0,0 +1,42 @@
+# Reads a lens scan table written by DSPS (see include/PointSpreadFunction.hh and
+# macros/lensScan.mac) into numpy arrays:
+#   angles_x[nAngles_x], angles_y[nAngles_y] [rad]
+#   photons[nAngles_x, nAngles_y]              photons fired per direction
+#   hits[nAngles_x, nAngles_y, nBins, nBins]   photosensor hits per bin (x, y)
+# and the probability of a photon of a direction to reach each bin.
+#   python3 scripts/readPointSpreadFunction.py lensScan.psf
+
+import sys
+import numpy as np
+
+def readPointSpreadFunction(fileName):
+    with open(fileName, 'rb') as f:
+        magic = f.read(8)
+        if magic != b'DSPSPSF\0':
+            raise ValueError('{} is not a lens scan table'.format(fileName))
+        version, nAngles_x, nAngles_y = np.fromfile(f, np.int32, 3)
+        if version != 1:
+            raise ValueError('{} has version {}, expected 1'.format(fileName, version))
+        angle_x_min, angle_x_max, angle_y_min, angle_y_max = np.fromfile(f, np.float64, 4)
+        nBins = np.fromfile(f, np.int32, 1)[0]
+        width = np.fromfile(f, np.float64, 1)[0]
+
+        photons = np.zeros((nAngles_x, nAngles_y), np.uint64)
+        hits = np.zeros((nAngles_x, nAngles_y, nBins, nBins), np.uint32)
+        for n_x in range(nAngles_x):
+            for n_y in range(nAngles_y):
+                photons[n_x, n_y] = np.fromfile(f, np.uint64, 1)[0]
+                hits[n_x, n_y] = np.fromfile(f, np.uint32, nBins * nBins).reshape(nBins, nBins)
+
+    angles_x = np.linspace(angle_x_min, angle_x_max, nAngles_x)
+    angles_y = np.linspace(angle_y_min, angle_y_max, nAngles_y)
+    return angles_x, angles_y, width, photons, hits
+
+if __name__ == '__main__':
+    angles_x, angles_y, width, photons, hits = readPointSpreadFunction(sys.argv[1])
+    probability = hits / np.maximum(photons, 1)[:, :, None, None]
+    print('{} x {} directions, {} x {} bins over {} mm'.format(len(angles_x), len(angles_y), hits.shape[2], hits.shape[3], width))
+    for n_x, angle_x in enumerate(angles_x):
+        for n_y, angle_y in enumerate(angles_y):
+            print('angle_x = {:7.2f} deg, angle_y = {:7.2f} deg: {} photons, acceptance {:.4f}'.format(
+                np.degrees(angle_x), np.degrees(angle_y), photons[n_x, n_y], probability[n_x, n_y].sum()))
@@ -31,15 +31,19 @@ void ActionInitialization::Build() const {
 
     RunAction* runAction = new RunAction( m_detectorConstruction );
 
-    EventAction* eventAction = new EventAction( runAction, m_detectorConstruction );
+    StackingAction* stackingAction = new StackingAction( m_detectorConstruction );
+    SetUserAction( stackingAction );
+
+    EventAction* eventAction = new EventAction( runAction, m_detectorConstruction, stackingAction );
     SetUserAction( static_cast< G4UserEventAction* >( eventAction ) );
     SetUserAction( static_cast< G4UserRunAction* >( runAction ) );
 
-    SteppingAction* steppingAction = new SteppingAction( runAction );
-    SetUserAction( steppingAction );
+    TrackingAction* trackingAction = new TrackingAction( runAction );
+    SetUserAction( trackingAction );
 
-    StackingAction* stackingAction = new StackingAction();
-    SetUserAction( stackingAction );
+    // registered by RunAction::BeginOfRunAction only for runs with step output or a readout window
+    SteppingAction* steppingAction = new SteppingAction( runAction, m_detectorConstruction );
+    runAction->set_steppingAction( steppingAction );
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
\ No newline at end of file
@@ -26,15 +26,38 @@ Calorimeter::Calorimeter( G4String t_name, G4String t_index, G4ThreeVector t_siz
     m_calorimeter->make_logicalVolume   (                                                                              );
 }
 
+Calorimeter::Calorimeter( G4String t_name, G4String t_index, Calorimeter* t_calorimeter ) {
+    m_name = t_name + "_" + t_index;
+
+    m_calorimeter = t_calorimeter->m_calorimeter;
+    m_isShared    = true;
+}
+
 Calorimeter::~Calorimeter() {
-    if( m_calorimeter ) delete m_calorimeter;
+    if( m_calorimeter && !m_isShared ) delete m_calorimeter;
 }
 
-void Calorimeter::place( G4RotationMatrix* t_rotationMatrix, G4ThreeVector t_translationVector, G4LogicalVolume* t_parentLogicalVolume, G4bool t_isMany ) {
+void Calorimeter::place( G4RotationMatrix* t_rotationMatrix, G4ThreeVector t_translationVector, G4LogicalVolume* t_parentLogicalVolume, G4bool t_isMany, G4int t_copyNumber ) {
     m_position = t_translationVector;
     m_rotationMatrix = t_rotationMatrix;
 
-    m_calorimeter->place( t_rotationMatrix, t_translationVector, t_parentLogicalVolume, t_isMany );
+    m_calorimeter->place( t_rotationMatrix, t_translationVector, t_parentLogicalVolume, t_isMany, t_copyNumber );
+}
+
+// t_rotationMatrix and t_translationVector are in the medium frame, as for the other overload.
+void Calorimeter::place( G4RotationMatrix* t_rotationMatrix, G4ThreeVector t_translationVector, Wall* t_wall ) {
+    m_position = t_translationVector;
+    m_rotationMatrix = t_rotationMatrix;
+
+    m_calorimeter->place( t_wall->get_rotationMatrix_local( t_rotationMatrix    ), 
+                          t_wall->get_position_local      ( t_translationVector ), 
+                          t_wall->get_logicalVolume       (                     ) );
+}
+
+// Only records the placement, the volume itself is placed by a CalorimeterLattice.
+void Calorimeter::locate( G4RotationMatrix* t_rotationMatrix, G4ThreeVector t_translationVector ) {
+    m_position = t_translationVector;
+    m_rotationMatrix = t_rotationMatrix;
 }
 
 G4ThreeVector Calorimeter::get_size() {
@@ -57,6 +80,10 @@ G4String Calorimeter::get_name() {
     return m_name;
 }
 
+G4Box* Calorimeter::get_solid() {
+    return m_calorimeter->get_solid();
+}
+
 G4LogicalVolume* Calorimeter::get_logicalVolume() {
     return m_calorimeter->get_logicalVolume();
 }
@@ -11,8 +11,6 @@
 
 #include "CalorimeterHit.hh"
 
-G4ThreadLocal G4Allocator< CalorimeterHit >* CalorimeterHitAllocator;
-
 CalorimeterHit::CalorimeterHit() {
 }
 
@@ -28,7 +26,7 @@ CalorimeterHit::CalorimeterHit( const G4ThreeVector    & t_calorimeter_position
                                 const G4ThreeVector    & t_particle_momentum          ) {
     m_calorimeter_position       = t_calorimeter_position      ;
     m_calorimeter_rotationMatrix = t_calorimeter_rotationMatrix;
-    m_calorimeter_name           = t_calorimeter_name          ;
+    m_calorimeter_name           = &t_calorimeter_name         ;
     m_calorimeter_ID             = t_calorimeter_ID            ;
     m_hit_position               = t_hit_position              ;
     m_hit_time                   = t_hit_time                  ;
@@ -72,7 +70,7 @@ void CalorimeterHit::Print() {
 std::ostream& operator<<( std::ostream& t_os, const CalorimeterHit& t_calorimeterHit ) {
     t_os << "[" << "calorimeter_position="       <<  t_calorimeterHit.m_calorimeter_position       << ", \n"
                 << "calorimeter_rotationMatrix=" << *t_calorimeterHit.m_calorimeter_rotationMatrix << ", \n"
-                << "calorimeter_name="           <<  t_calorimeterHit.m_calorimeter_name           << ", \n"
+                << "calorimeter_name="           << *t_calorimeterHit.m_calorimeter_name           << ", \n"
                 << "calorimeter_ID="             <<  t_calorimeterHit.m_calorimeter_ID             << ", \n"
                 << "hit_position="               <<  t_calorimeterHit.m_hit_position               << ", \n"
                 << "hit_time="                   <<  t_calorimeterHit.m_hit_time                   << ", \n"
@@ -103,7 +101,7 @@ void CalorimeterHit::set_calorimeter_rotationMatrix( G4RotationMatrix* t_calorim
 }
 
 void CalorimeterHit::set_calorimeter_name( const G4String& t_calorimeter_name ) {
-    m_calorimeter_name = t_calorimeter_name;
+    m_calorimeter_name = &t_calorimeter_name;
 }
 
 void CalorimeterHit::set_calorimeter_ID( G4int t_calorimeter_ID ) {
@@ -135,7 +133,7 @@ void CalorimeterHit::set_particle_position_initial( G4ThreeVector t_particle_pos
 }
 
 void CalorimeterHit::set_hit_process( const G4String& t_hit_process ) {
-    m_hit_process = t_hit_process;
+    m_hit_process = &t_hit_process;
 }
 
 G4ThreeVector CalorimeterHit::get_hit_position_absolute() {
@@ -152,7 +150,7 @@ G4ThreeVector CalorimeterHit::get_hit_position_relative() {
     //     abs( rotated_relative_position.x() ) > m_constructionMessenger->get_calorimeter_size_height() / 2 + epsilon ||
     //     abs( rotated_relative_position.y() ) > m_constructionMessenger->get_calorimeter_size_width () / 2 + epsilon   ) {
     //     G4cout << G4endl;
-    //     G4cout << "calorimeter = " << m_calorimeter_name << G4endl;
+    //     G4cout << "calorimeter = " << *m_calorimeter_name << G4endl;
     //     G4cout << "calorimeter position = " << m_calorimeter_position << G4endl;
     //     G4cout << "calorimeter size = " << m_constructionMessenger->get_calorimeter_size_depth() << " x " << m_constructionMessenger->get_calorimeter_size_height() << " x " << m_constructionMessenger->get_calorimeter_size_width() << G4endl;
     //     G4cout << "hit position = " << m_hit_position << G4endl;
@@ -171,8 +169,8 @@ G4RotationMatrix* CalorimeterHit::get_calorimeter_rotationMatrix() {
     return m_calorimeter_rotationMatrix;
 }
 
-G4String CalorimeterHit::get_calorimeter_name() {
-    return m_calorimeter_name;
+const G4String& CalorimeterHit::get_calorimeter_name() {
+    return *m_calorimeter_name;
 }
 
 G4int CalorimeterHit::get_calorimeter_ID() {
@@ -203,8 +201,8 @@ G4ThreeVector CalorimeterHit::get_particle_position_initial() {
     return m_particle_position_initial;
 }
 
-G4String CalorimeterHit::get_hit_process() {
-    return m_hit_process;
+const G4String& CalorimeterHit::get_hit_process() {
+    return *m_hit_process;
 }
 
 G4ThreeVector CalorimeterHit::get_particle_direction() {
@@ -0,0 +1,111 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "CalorimeterLattice.hh"
+
+#include <algorithm>
+
+using std::clamp;
+using std::lround;
+
+// t_amount_x and t_amount_y are the number of DSPDs along x and y, t_ID the ID of the first
+// horizontal calorimeter.
+CalorimeterLattice::CalorimeterLattice( const G4String& t_name    , 
+                                        G4int           t_amount_x, 
+                                        G4int           t_amount_y, 
+                                        G4int           t_ID       ) {
+    m_name          = t_name;
+    m_amount_x      = t_amount_x;
+    m_amount_y      = t_amount_y;
+    m_ID_horizontal = t_ID;
+    m_ID_vertical   = m_ID_horizontal + m_amount_x * ( m_amount_y + 1 );
+    m_ID_middle     = m_ID_vertical   + ( m_amount_x + 1 ) * m_amount_y;
+    m_solid         = new G4MultiUnion( m_name );
+}
+
+CalorimeterLattice::~CalorimeterLattice() {
+    if( m_lattice ) delete m_lattice;
+}
+
+// t_rotationMatrix and t_position as for a placement in the wall, in ID order.
+void CalorimeterLattice::add_calorimeter( G4VSolid* t_solid, G4RotationMatrix* t_rotationMatrix, G4ThreeVector t_position ) {
+    G4RotationMatrix rotationMatrix = ( t_rotationMatrix ) ? t_rotationMatrix->inverse() : G4RotationMatrix();
+    m_solid->AddNode( *t_solid, G4Transform3D( rotationMatrix, t_position ) );
+}
+
+// Positions (wall frame) of the middle calorimeter with indices (0,0), of its neighbours
+// (1,0) and (0,1), and of the DSPD with indices (0,0).
+void CalorimeterLattice::set_grid( G4ThreeVector t_position_middle  , 
+                                   G4ThreeVector t_position_middle_x, 
+                                   G4ThreeVector t_position_middle_y, 
+                                   G4ThreeVector t_position_DSPD     ) {
+    m_position_middle = t_position_middle;
+    m_step_x          = t_position_middle_x - t_position_middle;
+    m_step_y          = t_position_middle_y - t_position_middle;
+    m_offset_x        = ( t_position_DSPD - t_position_middle ).dot( m_step_x ) / m_step_x.mag2();
+    m_offset_y        = ( t_position_DSPD - t_position_middle ).dot( m_step_y ) / m_step_y.mag2();
+    m_halfHeight_x    = m_constructionMessenger->get_calorimeter_size_height() / 2 / m_step_x.mag();
+    m_halfHeight_y    = m_constructionMessenger->get_calorimeter_size_height() / 2 / m_step_y.mag();
+}
+
+void CalorimeterLattice::place( Wall* t_wall, G4int t_copyNumber ) {
+    // by default Geant4 chooses the number of voxels from the number of calorimeters
+    if( m_constructionMessenger->get_voxels_max() > 0 )
+        m_solid->GetVoxels().SetMaxVoxels( m_constructionMessenger->get_voxels_max() );
+    m_solid->Voxelize();
+
+    m_lattice->set_solid        ( m_solid                                                  );
+    m_lattice->set_material     ( m_constructionMessenger->get_calorimeter_material     () );
+    m_lattice->set_visAttributes( m_constructionMessenger->get_calorimeter_visAttributes() );
+    m_lattice->set_visibility   ( m_constructionMessenger->get_calorimeter_visibility   () );
+    m_lattice->make_logicalVolume();
+    m_lattice->place( nullptr, G4ThreeVector(), t_wall->get_logicalVolume(), false, t_copyNumber );
+}
+
+// t_position in the wall frame, e.g. from the touchable's top transform. Points between
+// calorimeters (only possible within the tolerance) go to the closest one.
+G4int CalorimeterLattice::get_ID( G4ThreeVector t_position ) const {
+    G4double x = ( t_position - m_position_middle ).dot( m_step_x ) / m_step_x.mag2();
+    G4double y = ( t_position - m_position_middle ).dot( m_step_y ) / m_step_y.mag2();
+
+    G4int index_middle_x = clamp< G4int >( lround( x              ), 0, m_amount_x     );
+    G4int index_middle_y = clamp< G4int >( lround( y              ), 0, m_amount_y     );
+    G4int index_DSPD_x   = clamp< G4int >( lround( x - m_offset_x ), 0, m_amount_x - 1 );
+    G4int index_DSPD_y   = clamp< G4int >( lround( y - m_offset_y ), 0, m_amount_y - 1 );
+
+    // how far the point is outside the column and row of the middle calorimeters
+    G4double outside_x = std::abs( x - index_middle_x ) - m_halfHeight_x;
+    G4double outside_y = std::abs( y - index_middle_y ) - m_halfHeight_y;
+    if( outside_x > 0 && outside_y > 0 ) {
+        if( outside_x < outside_y ) outside_x = 0;
+        else                        outside_y = 0;
+    }
+
+    if( outside_x <= 0 && outside_y <= 0 )
+        return m_ID_middle     + index_middle_x * ( m_amount_y + 1 ) + index_middle_y;
+    else if( outside_y <= 0 )
+        return m_ID_horizontal + index_DSPD_x   * ( m_amount_y + 1 ) + index_middle_y;
+    else
+        return m_ID_vertical   + index_middle_x * m_amount_y         + index_DSPD_y  ;
+}
+
+G4String CalorimeterLattice::get_name() const {
+    return m_name;
+}
+
+G4LogicalVolume* CalorimeterLattice::get_logicalVolume() const {
+    return m_lattice->get_logicalVolume();
+}
+
+void CalorimeterLattice::set_sensitiveDetector( G4VSensitiveDetector* t_sensitiveDetector ) {
+    m_lattice->set_sensitiveDetector( t_sensitiveDetector );
+}
@@ -11,6 +11,8 @@
 
 #include "CalorimeterSensitiveDetector.hh"
 
+#include <algorithm>
+
 CalorimeterSensitiveDetector::CalorimeterSensitiveDetector( G4String t_name, G4int t_ID )
     : G4VSensitiveDetector( t_name ) {
     m_name = t_name;
@@ -28,10 +30,18 @@ void CalorimeterSensitiveDetector::Initialize( G4HCofThisEvent* t_hitCollectionO
 G4bool CalorimeterSensitiveDetector::ProcessHits( G4Step* t_step, G4TouchableHistory* t_hist ) {
     CalorimeterHit* hit = new CalorimeterHit();
 
-    hit->set_calorimeter_position      ( m_position                                                            );
-    hit->set_calorimeter_rotationMatrix( m_rotationMatrix                                                      );
-    hit->set_calorimeter_name          ( m_name                                                                );
-    hit->set_calorimeter_ID            ( m_ID                                                                  );
+    if( m_copyNumberMaps.empty() && m_calorimeterLattices.empty() ) {
+        hit->set_calorimeter_position      ( m_position       );
+        hit->set_calorimeter_rotationMatrix( m_rotationMatrix );
+        hit->set_calorimeter_name          ( m_name           );
+        hit->set_calorimeter_ID            ( m_ID             );
+    } else {
+        G4int ID = find_ID( t_step->GetPreStepPoint() );
+        hit->set_calorimeter_position      ( get_position      ( ID ) );
+        hit->set_calorimeter_rotationMatrix( get_rotationMatrix( ID ) );
+        hit->set_calorimeter_name          ( get_name          ( ID ) );
+        hit->set_calorimeter_ID            ( ID                       );
+    }
     hit->set_hit_position_absolute     ( t_step->GetPostStepPoint()->GetPosition      ()                       );
     hit->set_hit_time                  ( t_step->GetPostStepPoint()->GetGlobalTime    ()                       );
     hit->set_hit_energy                ( t_step->GetPostStepPoint()->GetKineticEnergy ()                       );
@@ -48,10 +58,39 @@ G4bool CalorimeterSensitiveDetector::ProcessHits( G4Step* t_step, G4TouchableHis
     return true;
 }
 
-G4String CalorimeterSensitiveDetector::get_name() {
+G4int CalorimeterSensitiveDetector::find_ID( const G4StepPoint* t_stepPoint ) const {
+    const G4VTouchable* touchable     = t_stepPoint->GetTouchable();
+    G4LogicalVolume   * logicalVolume = touchable->GetVolume()->GetLogicalVolume();
+
+    for( const auto& copyNumberMap : m_copyNumberMaps )
+        if( copyNumberMap.first == logicalVolume )
+            return copyNumberMap.second.get_ID( touchable );
+
+    for( const auto& calorimeterLattice : m_calorimeterLattices )
+        if( calorimeterLattice->get_logicalVolume() == logicalVolume )
+            return calorimeterLattice->get_ID( touchable->GetHistory()->GetTopTransform().TransformPoint( t_stepPoint->GetPosition() ) );
+
+    G4Exception( "CalorimeterSensitiveDetector::find_ID", "InvalidSetup", FatalException, 
+                 ( "No copy number map or calorimeter lattice for `" + logicalVolume->GetName() + "'." ).c_str() );
+    return -1;
+}
+
+const G4String& CalorimeterSensitiveDetector::get_name() {
     return m_name;
 }
 
+// Hits keep a reference to the name, so the name of a surface lattice copy is made when
+// it is first asked for and kept until the sensitive detector is deleted
+const G4String& CalorimeterSensitiveDetector::get_name( G4int t_ID ) {
+    if( t_ID < G4int( m_copy_names.size() ) )
+        return m_copy_names[ t_ID ];
+    if( t_ID >= G4int( m_surfaceLattice_names.size() ) || m_surfaceLattice_names[ t_ID ].empty() ) {
+        const SurfaceLattice* surfaceLattice = SurfaceLattice::find_calorimeter( m_surfaceLattices, t_ID );
+        m_surfaceLattice_names.at( t_ID ) = surfaceLattice->get_name( surfaceLattice->get_calorimeter( t_ID ) ) + "_sensitiveDetector";
+    }
+    return m_surfaceLattice_names[ t_ID ];
+}
+
 
 void CalorimeterSensitiveDetector::set_position( G4ThreeVector t_position ) {
     m_position = t_position;
@@ -61,14 +100,51 @@ void CalorimeterSensitiveDetector::set_rotationMatrix( G4RotationMatrix* t_rotat
     m_rotationMatrix = t_rotationMatrix;
 }
 
+void CalorimeterSensitiveDetector::add_copy( const G4String  & t_name          , 
+                                             G4ThreeVector     t_position      , 
+                                             G4RotationMatrix* t_rotationMatrix ) {
+    m_copy_names           .push_back( t_name           );
+    m_copy_positions       .push_back( t_position       );
+    m_copy_rotationMatrices.push_back( t_rotationMatrix );
+}
+
+void CalorimeterSensitiveDetector::add_copyNumberMap( G4LogicalVolume* t_logicalVolume, const CopyNumberMap& t_copyNumberMap ) {
+    m_copyNumberMaps.push_back( { t_logicalVolume, t_copyNumberMap } );
+}
+
+void CalorimeterSensitiveDetector::add_calorimeterLattice( const CalorimeterLattice* t_calorimeterLattice ) {
+    m_calorimeterLattices.push_back( t_calorimeterLattice );
+}
+
+// Every calorimeter of t_surfaceLattice, after the copies added so far
+void CalorimeterSensitiveDetector::add_surfaceLattice( const SurfaceLattice* t_surfaceLattice ) {
+    m_surfaceLattices.push_back( t_surfaceLattice );
+    m_surfaceLattice_names.resize( std::max( G4int( m_surfaceLattice_names.size() ), 
+                                             t_surfaceLattice->get_calorimeter_ID_begin() + t_surfaceLattice->get_calorimeter_amount() ) );
+}
+
 G4ThreeVector CalorimeterSensitiveDetector::get_position() {
     return m_position;
 }
 
+G4ThreeVector CalorimeterSensitiveDetector::get_position( G4int t_ID ) {
+    if( t_ID < G4int( m_copy_positions.size() ) )
+        return m_copy_positions[ t_ID ];
+    const SurfaceLattice* surfaceLattice = SurfaceLattice::find_calorimeter( m_surfaceLattices, t_ID );
+    return surfaceLattice->get_position( surfaceLattice->get_calorimeter( t_ID ) );
+}
+
 G4RotationMatrix* CalorimeterSensitiveDetector::get_rotationMatrix() {
     return m_rotationMatrix;
 }
 
+G4RotationMatrix* CalorimeterSensitiveDetector::get_rotationMatrix( G4int t_ID ) {
+    if( t_ID < G4int( m_copy_rotationMatrices.size() ) )
+        return m_copy_rotationMatrices[ t_ID ];
+    const SurfaceLattice* surfaceLattice = SurfaceLattice::find_calorimeter( m_surfaceLattices, t_ID );
+    return surfaceLattice->get_rotationMatrix( surfaceLattice->get_calorimeter( t_ID ).m_component );
+}
+
 CalorimeterHitsCollection* CalorimeterSensitiveDetector::get_hitsCollection( const G4Event* t_event ) {
     G4HCofThisEvent* hitCollectionOfThisEvent = t_event->GetHCofThisEvent();
     m_calorimeterHitsCollection_ID = G4SDManager::GetSDMpointer()->GetCollectionID( SensitiveDetectorName + "/" + collectionName[ 0 ] );
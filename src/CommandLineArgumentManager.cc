@@ -16,7 +16,7 @@ CommandLineArgumentManager::CommandLineArgumentManager( int t_argc, char** t_arg
     : m_argc( t_argc ), m_argv( t_argv ), m_arguments( t_arguments ) {
     m_argLocations.resize( m_arguments.size() );
     for( int i{ 0 }; i < m_arguments.size(); i++ )
-        m_argLocations[ i ] = findArgumentLocation( m_arguments[ i ] );
+        m_argLocations[ i ] = findArgumentLocation_argv( m_arguments[ i ] );
 }
 
 CommandLineArgumentManager::~CommandLineArgumentManager() {
@@ -24,7 +24,7 @@ CommandLineArgumentManager::~CommandLineArgumentManager() {
 }
 
 G4bool CommandLineArgumentManager::findArgument( const G4String& t_argument ) const {
-    return ( findArgumentLocation( t_argument ) ) ? true : false;
+    return ( findArgumentLocation( t_argument ) != -1 ) ? true : false;
 }
 
 G4bool CommandLineArgumentManager::findArgument_string( const G4String& t_argument ) const {
@@ -10,6 +10,7 @@
 //*/////////////////////////////////////////////////////////////////////////*//
 
 #include "ConstructionMessenger.hh"
+#include "DetectorConstruction.hh"
 
 ConstructionMessenger* ConstructionMessenger::m_instance{ nullptr };
 
@@ -33,6 +34,8 @@ ConstructionMessenger::ConstructionMessenger() {
     m_command_detector_medium_color                  = new G4UIcmdWithAString       ( "/geometry/detector/medium/color"                 , this );
     m_command_detector_medium_alpha                  = new G4UIcmdWithADouble       ( "/geometry/detector/medium/alpha"                 , this );
     m_command_detector_medium_forceSolid             = new G4UIcmdWithABool         ( "/geometry/detector/medium/forceSolid"            , this );
+    m_command_detector_medium_smartless              = new G4UIcmdWithADouble       ( "/geometry/detector/medium/smartless"             , this );
+    m_command_detector_medium_optimise               = new G4UIcmdWithABool         ( "/geometry/detector/medium/optimise"              , this );
 
     m_command_calorimeter_size                       = new G4UIcmdWith3VectorAndUnit( "/geometry/calorimeter/size"                      , this );
     m_command_calorimeter_material                   = new G4UIcmdWithAString       ( "/geometry/calorimeter/material"                  , this );
@@ -54,6 +57,8 @@ ConstructionMessenger::ConstructionMessenger() {
     m_command_photoSensor_body_color                 = new G4UIcmdWithAString       ( "/geometry/photoSensor/body/color"                , this );
     m_command_photoSensor_body_alpha                 = new G4UIcmdWithADouble       ( "/geometry/photoSensor/body/alpha"                , this );
     m_command_photoSensor_body_forceSolid            = new G4UIcmdWithABool         ( "/geometry/photoSensor/body/forceSolid"           , this );
+    m_command_photoSensor_efficiency                 = new G4UIcmdWithAString       ( "/geometry/photoSensor/efficiency"                , this );
+    m_command_photoSensor_efficiency_prescale        = new G4UIcmdWithABool         ( "/geometry/photoSensor/efficiency/prescale"       , this );
 
     m_command_lens_incramentCurrentLens              = new G4UIcmdWithoutParameter  ( "/geometry/lens/incramentCurrentLens"             , this );
     m_command_lens_surface_1_radius_x                = new G4UIcmdWithADoubleAndUnit( "/geometry/lens/surfaces/1/radius/x"              , this );
@@ -74,6 +79,43 @@ ConstructionMessenger::ConstructionMessenger() {
     m_command_directionSensitivePhotoDetector_amount = new G4UIcmdWith3Vector       ( "/geometry/directionSensitivePhotoDetector/amount", this );
 
     m_command_checkOverlaps                          = new G4UIcmdWithABool         ( "/geometry/checkOverlaps"                         , this );
+    m_command_hierarchical                           = new G4UIcmdWithABool         ( "/geometry/hierarchical"                          , this );
+    m_command_parameterised                          = new G4UIcmdWithABool         ( "/geometry/parameterised"                         , this );
+    m_command_calorimeters_merged                    = new G4UIcmdWithABool         ( "/geometry/calorimeters_merged"                   , this );
+    m_command_cache                                  = new G4UIcmdWithABool         ( "/geometry/cache"                                 , this );
+    m_command_cache_directory                        = new G4UIcmdWithAString       ( "/geometry/cache_directory"                       , this );
+    m_command_voxels_max                             = new G4UIcmdWithAnInteger     ( "/geometry/voxels_max"                            , this );
+    m_command_lensScan                               = new G4UIcmdWithABool         ( "/geometry/lensScan"                              , this );
+    m_command_lensScan_medium_size                   = new G4UIcmdWith3VectorAndUnit( "/geometry/lensScan_medium_size"                  , this );
+    m_command_rebuild                                = new G4UIcmdWithoutParameter  ( "/geometry/rebuild"                               , this );
+    m_command_fastSimulation                         = new G4UIcmdWithABool         ( "/geometry/fastSimulation"                        , this );
+    m_command_fastSimulation_table                   = new G4UIcmdWithABool         ( "/geometry/fastSimulation_table"                  , this );
+    m_command_fastSimulation_table_nBins_position    = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_table_nBins_position"   , this );
+    m_command_fastSimulation_table_nBins_direction   = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_table_nBins_direction"  , this );
+    m_command_fastSimulation_table_nBins_energy      = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_table_nBins_energy"     , this );
+    m_command_fastSimulation_table_energy_min        = new G4UIcmdWithADoubleAndUnit( "/geometry/fastSimulation_table_energy_min"       , this );
+    m_command_fastSimulation_table_energy_max        = new G4UIcmdWithADoubleAndUnit( "/geometry/fastSimulation_table_energy_max"       , this );
+    m_command_fastSimulation_table_nSamples          = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_table_nSamples"         , this );
+    m_command_fastSimulation_medium                  = new G4UIcmdWithABool         ( "/geometry/fastSimulation_medium"                 , this );
+    m_command_fastSimulation_visibility              = new G4UIcmdWithAString       ( "/geometry/fastSimulation_visibility"             , this );
+    m_command_fastSimulation_visibility_fileName     = new G4UIcmdWithAString       ( "/geometry/fastSimulation_visibility_fileName"    , this );
+    m_command_fastSimulation_overlay                 = new G4UIcmdWithABool         ( "/geometry/fastSimulation_overlay"                , this );
+    m_command_fastSimulation_overlay_fileName        = new G4UIcmdWithAString       ( "/geometry/fastSimulation_overlay_fileName"       , this );
+    m_command_fastSimulation_overlay_energy          = new G4UIcmdWithADouble       ( "/geometry/fastSimulation_overlay_energy"         , this );
+    m_command_fastSimulation_overlay_position        = new G4UIcmdWithADoubleAndUnit( "/geometry/fastSimulation_overlay_position"       , this );
+    m_command_fastSimulation_overlay_angle           = new G4UIcmdWithADoubleAndUnit( "/geometry/fastSimulation_overlay_angle"          , this );
+    m_command_fastSimulation_prescale                = new G4UIcmdWithADouble       ( "/geometry/fastSimulation_prescale"               , this );
+    m_command_fastSimulation_acceptance              = new G4UIcmdWithADouble       ( "/geometry/fastSimulation_acceptance"             , this );
+    m_command_fastSimulation_acceptance_survival     = new G4UIcmdWithADouble       ( "/geometry/fastSimulation_acceptance_survival"    , this );
+    m_command_fastSimulation_timeWindow              = new G4UIcmdWithADoubleAndUnit( "/geometry/fastSimulation_timeWindow"             , this );
+    m_command_fastSimulation_stackChunk              = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_stackChunk"             , this );
+    m_command_fastSimulation_stackBuffer             = new G4UIcmdWithAnInteger     ( "/geometry/fastSimulation_stackBuffer"            , this );
+    m_command_detector_wall_productionCut            = new G4UIcmdWithADoubleAndUnit( "/geometry/detector/wall/productionCut"           , this );
+    m_command_detector_medium_productionCut          = new G4UIcmdWithADoubleAndUnit( "/geometry/detector/medium/productionCut"         , this );
+
+    // between runs on the master thread only (see DetectorConstruction::rebuild_lensSystem)
+    m_command_rebuild->AvailableForStates( G4State_Idle );
+    m_command_rebuild->SetToBeBroadcasted( false        );
 }
 
 ConstructionMessenger::~ConstructionMessenger() {
@@ -96,6 +138,8 @@ ConstructionMessenger::~ConstructionMessenger() {
     if( m_command_detector_medium_color                  ) delete m_command_detector_medium_color                 ;
     if( m_command_detector_medium_alpha                  ) delete m_command_detector_medium_alpha                 ;
     if( m_command_detector_medium_forceSolid             ) delete m_command_detector_medium_forceSolid            ;
+    if( m_command_detector_medium_smartless              ) delete m_command_detector_medium_smartless             ;
+    if( m_command_detector_medium_optimise               ) delete m_command_detector_medium_optimise              ;
 
     if( m_command_calorimeter_size                       ) delete m_command_calorimeter_size                      ;
     if( m_command_calorimeter_material                   ) delete m_command_calorimeter_material                  ;
@@ -117,6 +161,8 @@ ConstructionMessenger::~ConstructionMessenger() {
     if( m_command_photoSensor_body_color                 ) delete m_command_photoSensor_body_color                ;
     if( m_command_photoSensor_body_alpha                 ) delete m_command_photoSensor_body_alpha                ;
     if( m_command_photoSensor_body_forceSolid            ) delete m_command_photoSensor_body_forceSolid           ;
+    if( m_command_photoSensor_efficiency                 ) delete m_command_photoSensor_efficiency                ;
+    if( m_command_photoSensor_efficiency_prescale        ) delete m_command_photoSensor_efficiency_prescale       ;
 
     if( m_command_lens_incramentCurrentLens              ) delete m_command_lens_incramentCurrentLens             ;
     if( m_command_lens_surface_1_radius_x                ) delete m_command_lens_surface_1_radius_x               ;
@@ -137,6 +183,39 @@ ConstructionMessenger::~ConstructionMessenger() {
     if( m_command_directionSensitivePhotoDetector_amount ) delete m_command_directionSensitivePhotoDetector_amount;
 
     if( m_command_checkOverlaps                          ) delete m_command_checkOverlaps                         ;
+    if( m_command_hierarchical                           ) delete m_command_hierarchical                          ;
+    if( m_command_parameterised                          ) delete m_command_parameterised                         ;
+    if( m_command_calorimeters_merged                    ) delete m_command_calorimeters_merged                   ;
+    if( m_command_cache                                  ) delete m_command_cache                                 ;
+    if( m_command_cache_directory                        ) delete m_command_cache_directory                       ;
+    if( m_command_voxels_max                             ) delete m_command_voxels_max                            ;
+    if( m_command_lensScan                               ) delete m_command_lensScan                              ;
+    if( m_command_lensScan_medium_size                   ) delete m_command_lensScan_medium_size                  ;
+    if( m_command_rebuild                                ) delete m_command_rebuild                               ;
+    if( m_command_fastSimulation                         ) delete m_command_fastSimulation                        ;
+    if( m_command_fastSimulation_table                   ) delete m_command_fastSimulation_table                  ;
+    if( m_command_fastSimulation_table_nBins_position    ) delete m_command_fastSimulation_table_nBins_position   ;
+    if( m_command_fastSimulation_table_nBins_direction   ) delete m_command_fastSimulation_table_nBins_direction  ;
+    if( m_command_fastSimulation_table_nBins_energy      ) delete m_command_fastSimulation_table_nBins_energy     ;
+    if( m_command_fastSimulation_table_energy_min        ) delete m_command_fastSimulation_table_energy_min       ;
+    if( m_command_fastSimulation_table_energy_max        ) delete m_command_fastSimulation_table_energy_max       ;
+    if( m_command_fastSimulation_table_nSamples          ) delete m_command_fastSimulation_table_nSamples         ;
+    if( m_command_fastSimulation_medium                  ) delete m_command_fastSimulation_medium                 ;
+    if( m_command_fastSimulation_visibility              ) delete m_command_fastSimulation_visibility             ;
+    if( m_command_fastSimulation_visibility_fileName     ) delete m_command_fastSimulation_visibility_fileName    ;
+    if( m_command_fastSimulation_overlay                 ) delete m_command_fastSimulation_overlay                ;
+    if( m_command_fastSimulation_overlay_fileName        ) delete m_command_fastSimulation_overlay_fileName       ;
+    if( m_command_fastSimulation_overlay_energy          ) delete m_command_fastSimulation_overlay_energy         ;
+    if( m_command_fastSimulation_overlay_position        ) delete m_command_fastSimulation_overlay_position       ;
+    if( m_command_fastSimulation_overlay_angle           ) delete m_command_fastSimulation_overlay_angle          ;
+    if( m_command_fastSimulation_prescale                ) delete m_command_fastSimulation_prescale               ;
+    if( m_command_fastSimulation_acceptance              ) delete m_command_fastSimulation_acceptance             ;
+    if( m_command_fastSimulation_acceptance_survival     ) delete m_command_fastSimulation_acceptance_survival    ;
+    if( m_command_fastSimulation_timeWindow              ) delete m_command_fastSimulation_timeWindow             ;
+    if( m_command_fastSimulation_stackChunk              ) delete m_command_fastSimulation_stackChunk             ;
+    if( m_command_fastSimulation_stackBuffer             ) delete m_command_fastSimulation_stackBuffer            ;
+    if( m_command_detector_wall_productionCut            ) delete m_command_detector_wall_productionCut           ;
+    if( m_command_detector_medium_productionCut          ) delete m_command_detector_medium_productionCut         ;
 
     if( m_variable_world_visAttributes                   ) delete m_variable_world_visAttributes                  ;
     if( m_variable_detector_wall_visAttributes           ) delete m_variable_detector_wall_visAttributes          ;
@@ -229,6 +308,14 @@ void ConstructionMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newV
         set_detector_medium_forceSolid( m_command_detector_medium_forceSolid->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `detector_medium_forceSolid' to " 
                << t_newValue << G4endl;
+    } else if( t_command == m_command_detector_medium_smartless ) { 
+        set_detector_medium_smartless( m_command_detector_medium_smartless->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `detector_medium_smartless' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_detector_medium_optimise ) {
+        set_detector_medium_optimise( m_command_detector_medium_optimise->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `detector_medium_optimise' to " 
+               << t_newValue << G4endl;
     } else if( t_command == m_command_calorimeter_size ) { 
         set_calorimeter_size( m_command_calorimeter_size->GetNew3VectorValue( t_newValue ) );
         G4cout << "Setting `calorimeter_size' to " 
@@ -301,6 +388,14 @@ void ConstructionMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newV
         set_photoSensor_body_forceSolid( m_command_photoSensor_body_forceSolid->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `photoSensor_body_forceSolid' to " 
                << t_newValue << G4endl;
+    } else if( t_command == m_command_photoSensor_efficiency ) {
+        set_photoSensor_efficiency( t_newValue );
+        G4cout << "Setting `photoSensor_efficiency' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_photoSensor_efficiency_prescale ) {
+        set_photoSensor_efficiency_prescale( m_command_photoSensor_efficiency_prescale->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `photoSensor_efficiency_prescale' to " 
+               << t_newValue << G4endl;
     } else if( t_command == m_command_lens_incramentCurrentLens ) {
         set_lens_incramentCurrentLens();
         G4cout << "Setting `lens_incramentCurrentLens' to " 
@@ -369,85 +464,255 @@ void ConstructionMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newV
         set_checkOverlaps( m_command_checkOverlaps->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `checkOverlaps' to " 
                << t_newValue << G4endl;
+    } else if( t_command == m_command_hierarchical ) {
+        set_hierarchical( m_command_hierarchical->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `hierarchical' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_parameterised ) {
+        set_parameterised( m_command_parameterised->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `parameterised' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_calorimeters_merged ) {
+        set_calorimeters_merged( m_command_calorimeters_merged->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `calorimeters_merged' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_cache ) {
+        set_cache( m_command_cache->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `cache' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_cache_directory ) {
+        set_cache_directory( t_newValue );
+        G4cout << "Setting `cache_directory' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_voxels_max ) {
+        set_voxels_max( m_command_voxels_max->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `voxels_max' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_lensScan ) {
+        set_lensScan( m_command_lensScan->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `lensScan' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_lensScan_medium_size ) {
+        set_lensScan_medium_size( m_command_lensScan_medium_size->GetNew3VectorValue( t_newValue ) );
+        G4cout << "Setting `lensScan_medium_size' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation ) {
+        set_fastSimulation( m_command_fastSimulation->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table ) {
+        set_fastSimulation_table( m_command_fastSimulation_table->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_nBins_position ) {
+        set_fastSimulation_table_nBins_position( m_command_fastSimulation_table_nBins_position->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_nBins_position' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_nBins_direction ) {
+        set_fastSimulation_table_nBins_direction( m_command_fastSimulation_table_nBins_direction->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_nBins_direction' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_nBins_energy ) {
+        set_fastSimulation_table_nBins_energy( m_command_fastSimulation_table_nBins_energy->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_nBins_energy' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_energy_min ) {
+        set_fastSimulation_table_energy_min( m_command_fastSimulation_table_energy_min->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_energy_min' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_energy_max ) {
+        set_fastSimulation_table_energy_max( m_command_fastSimulation_table_energy_max->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_energy_max' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_table_nSamples ) {
+        set_fastSimulation_table_nSamples( m_command_fastSimulation_table_nSamples->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_table_nSamples' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_medium ) {
+        set_fastSimulation_medium( m_command_fastSimulation_medium->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_medium' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_visibility ) {
+        set_fastSimulation_visibility( t_newValue );
+        G4cout << "Setting `fastSimulation_visibility' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_visibility_fileName ) {
+        set_fastSimulation_visibility_fileName( t_newValue );
+        G4cout << "Setting `fastSimulation_visibility_fileName' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_overlay ) {
+        set_fastSimulation_overlay( m_command_fastSimulation_overlay->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_overlay' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_overlay_fileName ) {
+        set_fastSimulation_overlay_fileName( t_newValue );
+        G4cout << "Setting `fastSimulation_overlay_fileName' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_overlay_energy ) {
+        set_fastSimulation_overlay_energy( m_command_fastSimulation_overlay_energy->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_overlay_energy' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_overlay_position ) {
+        set_fastSimulation_overlay_position( m_command_fastSimulation_overlay_position->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_overlay_position' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_overlay_angle ) {
+        set_fastSimulation_overlay_angle( m_command_fastSimulation_overlay_angle->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_overlay_angle' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_prescale ) {
+        set_fastSimulation_prescale( m_command_fastSimulation_prescale->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_prescale' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_acceptance ) {
+        set_fastSimulation_acceptance( m_command_fastSimulation_acceptance->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_acceptance' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_acceptance_survival ) {
+        set_fastSimulation_acceptance_survival( m_command_fastSimulation_acceptance_survival->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_acceptance_survival' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_timeWindow ) {
+        set_fastSimulation_timeWindow( m_command_fastSimulation_timeWindow->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_timeWindow' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_stackChunk ) {
+        set_fastSimulation_stackChunk( m_command_fastSimulation_stackChunk->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_stackChunk' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_fastSimulation_stackBuffer ) {
+        set_fastSimulation_stackBuffer( m_command_fastSimulation_stackBuffer->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `fastSimulation_stackBuffer' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_detector_wall_productionCut ) {
+        set_detector_wall_productionCut( m_command_detector_wall_productionCut->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `detector_wall_productionCut' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_detector_medium_productionCut ) {
+        set_detector_medium_productionCut( m_command_detector_medium_productionCut->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `detector_medium_productionCut' to " 
+               << t_newValue << G4endl;
+    } else if( t_command == m_command_rebuild ) {
+        if( !m_detectorConstruction )
+            G4Exception( "ConstructionMessenger::SetNewValue", "InvalidSetup", JustWarning, 
+                         "There is no detector construction to rebuild." );
+        else
+            m_detectorConstruction->rebuild_lensSystem();
     } else {
         G4cerr << "ERROR: ConstructionMessenger::SetNewValue: Unknown command" << G4endl;
     }
 }
 
-void ConstructionMessenger::print_parameters() {
-    G4cout << "[-]==: Attempting to use the following parameters" << G4endl
-           << " |=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=" << G4endl
-           << " |--< world_x >----------------------------------: " << get_world_size_x                            () << G4endl
-           << " |--< world_y >----------------------------------: " << get_world_size_y                            () << G4endl
-           << " |--< world_z >----------------------------------: " << get_world_size_z                            () << G4endl
-           << " |--< world_material >---------------------------: " << get_world_material                          () << G4endl
-           << " |--< world_visibility >-------------------------: " << get_world_visibility                        () << G4endl
-           << " |--< world_color >------------------------------: " << get_world_color                             () << G4endl
-           << " |--< world_alpha >------------------------------: " << get_world_alpha                             () << G4endl
-           << " |--< world_forceSolid >-------------------------: " << get_world_forceSolid                        () << G4endl
-           << " |                                                 "                                                   << G4endl
-           << " |--< detector_wall_thickness >------------------: " << get_detector_wall_thickness                 () << G4endl
-           << " |--< detector_wall_material >-------------------: " << get_detector_wall_material                  () << G4endl
-           << " |--< detector_wall_visibility >-----------------: " << get_detector_wall_visibility                () << G4endl
-           << " |--< detector_wall_color >----------------------: " << get_detector_wall_color                     () << G4endl
-           << " |--< detector_wall_alpha >----------------------: " << get_detector_wall_alpha                     () << G4endl
-           << " |--< detector_wall_forceSolid >-----------------: " << get_detector_wall_forceSolid                () << G4endl
-           << " |                                                 "                                                   << G4endl
-           << " |--< detector_medium_material >-----------------: " << get_detector_medium_material                () << G4endl
-           << " |--< detector_medium_visibility >---------------: " << get_detector_medium_visibility              () << G4endl
-           << " |--< detector_medium_color >--------------------: " << get_detector_medium_color                   () << G4endl
-           << " |--< detector_medium_alpha >--------------------: " << get_detector_medium_alpha                   () << G4endl
-           << " |--< detector_medium_forceSolid >---------------: " << get_detector_medium_forceSolid              () << G4endl
-           << " |                                                 "                                                   << G4endl
-           << " |--< calorimeter_size_width >-------------------: " << get_calorimeter_size_width                  () << G4endl
-           << " |--< calorimeter_size_height >------------------: " << get_calorimeter_size_height                 () << G4endl
-           << " |--< calorimeter_size_depth >-------------------: " << get_calorimeter_size_depth                  () << G4endl
-           << " |--< calorimeter_material >---------------------: " << get_calorimeter_material                    () << G4endl
-           << " |--< calorimeter_visibility >-------------------: " << get_calorimeter_visibility                  () << G4endl
-           << " |--< calorimeter_color >------------------------: " << get_calorimeter_color                       () << G4endl
-           << " |--< calorimeter_alpha >------------------------: " << get_calorimeter_alpha                       () << G4endl
-           << " |--< calorimeter_forceSolid >-------------------: " << get_calorimeter_forceSolid                  () << G4endl
-           << " |                                                 "                                                   << G4endl
-           << " |--< photoSensor_surface_size_width >-----------: " << get_photoSensor_surface_size_width          () << G4endl
-           << " |--< photoSensor_surface_size_height >----------: " << get_photoSensor_surface_size_height         () << G4endl
-           << " |--< photoSensor_surface_size_depth >-----------: " << get_photoSensor_surface_size_depth          () << G4endl
-           << " |--< photoSensor_surface_material >-------------: " << get_photoSensor_surface_material            () << G4endl
-           << " |--< photoSensor_surface_visibility >-----------: " << get_photoSensor_surface_visibility          () << G4endl
-           << " |--< photoSensor_surface_color >----------------: " << get_photoSensor_surface_color               () << G4endl
-           << " |--< photoSensor_surface_alpha >----------------: " << get_photoSensor_surface_alpha               () << G4endl
-           << " |--< photoSensor_surface_forceSolid >-----------: " << get_photoSensor_surface_forceSolid          () << G4endl
-           << " |                                                 "                                                   << G4endl
-           << " |--< photoSensor_body_size_width >--------------: " << get_photoSensor_body_size_width             () << G4endl
-           << " |--< photoSensor_body_size_height >-------------: " << get_photoSensor_body_size_height            () << G4endl
-           << " |--< photoSensor_body_size_depth >--------------: " << get_photoSensor_body_size_depth             () << G4endl
-           << " |--< photoSensor_body_material >----------------: " << get_photoSensor_body_material               () << G4endl
-           << " |--< photoSensor_body_visibility >--------------: " << get_photoSensor_body_visibility             () << G4endl
-           << " |--< photoSensor_body_color >-------------------: " << get_photoSensor_body_color                  () << G4endl
-           << " |--< photoSensor_body_alpha >-------------------: " << get_photoSensor_body_alpha                  () << G4endl
-           << " |--< photoSensor_body_forceSolid >--------------: " << get_photoSensor_body_forceSolid             () << G4endl
-           << " |                                                 "                                                   << G4endl;
+void ConstructionMessenger::print_parameters( std::ostream& t_ostream ) {
+    t_ostream << "[-]==: Attempting to use the following parameters" << G4endl
+              << " |=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=" << G4endl
+              << " |--< world_x >----------------------------------: " << get_world_size_x                            () << G4endl
+              << " |--< world_y >----------------------------------: " << get_world_size_y                            () << G4endl
+              << " |--< world_z >----------------------------------: " << get_world_size_z                            () << G4endl
+              << " |--< world_material >---------------------------: " << get_world_material                          () << G4endl
+              << " |--< world_visibility >-------------------------: " << get_world_visibility                        () << G4endl
+              << " |--< world_color >------------------------------: " << get_world_color                             () << G4endl
+              << " |--< world_alpha >------------------------------: " << get_world_alpha                             () << G4endl
+              << " |--< world_forceSolid >-------------------------: " << get_world_forceSolid                        () << G4endl
+              << " |                                                 "                                                   << G4endl
+              << " |--< detector_wall_thickness >------------------: " << get_detector_wall_thickness                 () << G4endl
+              << " |--< detector_wall_material >-------------------: " << get_detector_wall_material                  () << G4endl
+              << " |--< detector_wall_visibility >-----------------: " << get_detector_wall_visibility                () << G4endl
+              << " |--< detector_wall_color >----------------------: " << get_detector_wall_color                     () << G4endl
+              << " |--< detector_wall_alpha >----------------------: " << get_detector_wall_alpha                     () << G4endl
+              << " |--< detector_wall_forceSolid >-----------------: " << get_detector_wall_forceSolid                () << G4endl
+              << " |                                                 "                                                   << G4endl
+              << " |--< detector_medium_material >-----------------: " << get_detector_medium_material                () << G4endl
+              << " |--< detector_medium_visibility >---------------: " << get_detector_medium_visibility              () << G4endl
+              << " |--< detector_medium_color >--------------------: " << get_detector_medium_color                   () << G4endl
+              << " |--< detector_medium_alpha >--------------------: " << get_detector_medium_alpha                   () << G4endl
+              << " |--< detector_medium_forceSolid >---------------: " << get_detector_medium_forceSolid              () << G4endl
+              << " |--< detector_medium_smartless >----------------: " << get_detector_medium_smartless               () << G4endl
+              << " |--< detector_medium_optimise >-----------------: " << get_detector_medium_optimise                () << G4endl
+              << " |                                                 "                                                   << G4endl
+              << " |--< calorimeter_size_width >-------------------: " << get_calorimeter_size_width                  () << G4endl
+              << " |--< calorimeter_size_height >------------------: " << get_calorimeter_size_height                 () << G4endl
+              << " |--< calorimeter_size_depth >-------------------: " << get_calorimeter_size_depth                  () << G4endl
+              << " |--< calorimeter_material >---------------------: " << get_calorimeter_material                    () << G4endl
+              << " |--< calorimeter_visibility >-------------------: " << get_calorimeter_visibility                  () << G4endl
+              << " |--< calorimeter_color >------------------------: " << get_calorimeter_color                       () << G4endl
+              << " |--< calorimeter_alpha >------------------------: " << get_calorimeter_alpha                       () << G4endl
+              << " |--< calorimeter_forceSolid >-------------------: " << get_calorimeter_forceSolid                  () << G4endl
+              << " |                                                 "                                                   << G4endl
+              << " |--< photoSensor_surface_size_width >-----------: " << get_photoSensor_surface_size_width          () << G4endl
+              << " |--< photoSensor_surface_size_height >----------: " << get_photoSensor_surface_size_height         () << G4endl
+              << " |--< photoSensor_surface_size_depth >-----------: " << get_photoSensor_surface_size_depth          () << G4endl
+              << " |--< photoSensor_surface_material >-------------: " << get_photoSensor_surface_material            () << G4endl
+              << " |--< photoSensor_surface_visibility >-----------: " << get_photoSensor_surface_visibility          () << G4endl
+              << " |--< photoSensor_surface_color >----------------: " << get_photoSensor_surface_color               () << G4endl
+              << " |--< photoSensor_surface_alpha >----------------: " << get_photoSensor_surface_alpha               () << G4endl
+              << " |--< photoSensor_surface_forceSolid >-----------: " << get_photoSensor_surface_forceSolid          () << G4endl
+              << " |                                                 "                                                   << G4endl
+              << " |--< photoSensor_body_size_width >--------------: " << get_photoSensor_body_size_width             () << G4endl
+              << " |--< photoSensor_body_size_height >-------------: " << get_photoSensor_body_size_height            () << G4endl
+              << " |--< photoSensor_body_size_depth >--------------: " << get_photoSensor_body_size_depth             () << G4endl
+              << " |--< photoSensor_body_material >----------------: " << get_photoSensor_body_material               () << G4endl
+              << " |--< photoSensor_body_visibility >--------------: " << get_photoSensor_body_visibility             () << G4endl
+              << " |--< photoSensor_body_color >-------------------: " << get_photoSensor_body_color                  () << G4endl
+              << " |--< photoSensor_body_alpha >-------------------: " << get_photoSensor_body_alpha                  () << G4endl
+              << " |--< photoSensor_body_forceSolid >--------------: " << get_photoSensor_body_forceSolid             () << G4endl
+              << " |--< photoSensor_efficiency >-------------------: " << get_photoSensor_efficiency                  () << G4endl
+              << " |--< photoSensor_efficiency_prescale >----------: " << get_photoSensor_efficiency_prescale         () << G4endl
+              << " |                                                 "                                                   << G4endl;
     for( G4int nLens{ 0 }; nLens <= m_variable_lens_currentLens; nLens++ ) {
-    G4cout << " |--< lens_currentLens >-------------------------: " << nLens                                                 << G4endl
-           << " |--< lens_surface_1_radius_x >------------------: " << get_lens_surface_1_radius_x                 ( nLens ) << G4endl
-           << " |--< lens_surface_1_radius_y >------------------: " << get_lens_surface_1_radius_y                 ( nLens ) << G4endl
-           << " |--< lens_surface_1_yLimits >-------------------: " << get_lens_surface_1_yLimits                  ( nLens ) << G4endl
-           << " |--< lens_surface_2_radius_x >------------------: " << get_lens_surface_2_radius_x                 ( nLens ) << G4endl
-           << " |--< lens_surface_2_radius_y >------------------: " << get_lens_surface_2_radius_y                 ( nLens ) << G4endl
-           << " |--< lens_surface_2_yLimits >-------------------: " << get_lens_surface_2_yLimits                  ( nLens ) << G4endl
-           << " |--< lens_distance >----------------------------: " << get_lens_distance                           ( nLens ) << G4endl
-           << " |--< lens_position >----------------------------: " << get_lens_position                           ( nLens ) << G4endl
-           << " |--< lens_material >----------------------------: " << get_lens_material                           ( nLens ) << G4endl
-           << " |--< lens_visibility >--------------------------: " << get_lens_visibility                         ( nLens ) << G4endl
-           << " |--< lens_color >-------------------------------: " << get_lens_color                              ( nLens ) << G4endl
-           << " |--< lens_alpha >-------------------------------: " << get_lens_alpha                              ( nLens ) << G4endl
-           << " |--< lens_forceSolid >--------------------------: " << get_lens_forceSolid                         ( nLens ) << G4endl
-           << " |--< lens_circular >----------------------------: " << get_lens_circular                           ( nLens ) << G4endl
-           << " |                                                 "                                                          << G4endl;
+    t_ostream << " |--< lens_currentLens >-------------------------: " << nLens                                                 << G4endl
+              << " |--< lens_surface_1_radius_x >------------------: " << get_lens_surface_1_radius_x                 ( nLens ) << G4endl
+              << " |--< lens_surface_1_radius_y >------------------: " << get_lens_surface_1_radius_y                 ( nLens ) << G4endl
+              << " |--< lens_surface_1_yLimits >-------------------: " << get_lens_surface_1_yLimits                  ( nLens ) << G4endl
+              << " |--< lens_surface_2_radius_x >------------------: " << get_lens_surface_2_radius_x                 ( nLens ) << G4endl
+              << " |--< lens_surface_2_radius_y >------------------: " << get_lens_surface_2_radius_y                 ( nLens ) << G4endl
+              << " |--< lens_surface_2_yLimits >-------------------: " << get_lens_surface_2_yLimits                  ( nLens ) << G4endl
+              << " |--< lens_distance >----------------------------: " << get_lens_distance                           ( nLens ) << G4endl
+              << " |--< lens_position >----------------------------: " << get_lens_position                           ( nLens ) << G4endl
+              << " |--< lens_material >----------------------------: " << get_lens_material                           ( nLens ) << G4endl
+              << " |--< lens_visibility >--------------------------: " << get_lens_visibility                         ( nLens ) << G4endl
+              << " |--< lens_color >-------------------------------: " << get_lens_color                              ( nLens ) << G4endl
+              << " |--< lens_alpha >-------------------------------: " << get_lens_alpha                              ( nLens ) << G4endl
+              << " |--< lens_forceSolid >--------------------------: " << get_lens_forceSolid                         ( nLens ) << G4endl
+              << " |--< lens_circular >----------------------------: " << get_lens_circular                           ( nLens ) << G4endl
+              << " |                                                 "                                                          << G4endl;
     }
-    G4cout << " |--< directionSensitivePhotoDetector_amount_x >-: " << get_directionSensitivePhotoDetector_amount_x() << G4endl
-           << " |--< directionSensitivePhotoDetector_amount_y >-: " << get_directionSensitivePhotoDetector_amount_y() << G4endl
-           << " |--< directionSensitivePhotoDetector_amount_z >-: " << get_directionSensitivePhotoDetector_amount_z() << G4endl
-           << " |--< checkOverlaps >----------------------------: " << get_checkOverlaps                           () << G4endl;
+    t_ostream << " |--< directionSensitivePhotoDetector_amount_x >-: " << get_directionSensitivePhotoDetector_amount_x() << G4endl
+              << " |--< directionSensitivePhotoDetector_amount_y >-: " << get_directionSensitivePhotoDetector_amount_y() << G4endl
+              << " |--< directionSensitivePhotoDetector_amount_z >-: " << get_directionSensitivePhotoDetector_amount_z() << G4endl
+              << " |--< checkOverlaps >----------------------------: " << get_checkOverlaps                           () << G4endl
+              << " |--< hierarchical >-----------------------------: " << get_hierarchical                            () << G4endl
+              << " |--< parameterised >----------------------------: " << get_parameterised                           () << G4endl
+              << " |--< calorimeters_merged >----------------------: " << get_calorimeters_merged                     () << G4endl
+              << " |--< cache >------------------------------------: " << get_cache                                   () << G4endl
+              << " |--< cache_directory >--------------------------: " << get_cache_directory                         () << G4endl
+              << " |--< voxels_max >-------------------------------: " << get_voxels_max                              () << G4endl
+              << " |--< lensScan >---------------------------------: " << get_lensScan                                () << G4endl
+              << " |--< lensScan_medium_size >---------------------: " << get_lensScan_medium_size                    () << G4endl
+              << " |--< fastSimulation >---------------------------: " << get_fastSimulation                          () << G4endl
+              << " |--< fastSimulation_table >---------------------: " << get_fastSimulation_table                    () << G4endl
+              << " |--< fastSimulation_table_nBins_position >------: " << get_fastSimulation_table_nBins_position     () << G4endl
+              << " |--< fastSimulation_table_nBins_direction >-----: " << get_fastSimulation_table_nBins_direction    () << G4endl
+              << " |--< fastSimulation_table_nBins_energy >--------: " << get_fastSimulation_table_nBins_energy       () << G4endl
+              << " |--< fastSimulation_table_energy_min >----------: " << get_fastSimulation_table_energy_min         () << G4endl
+              << " |--< fastSimulation_table_energy_max >----------: " << get_fastSimulation_table_energy_max         () << G4endl
+              << " |--< fastSimulation_table_nSamples >------------: " << get_fastSimulation_table_nSamples           () << G4endl
+              << " |--< fastSimulation_medium >--------------------: " << get_fastSimulation_medium                   () << G4endl
+              << " |--< fastSimulation_visibility >----------------: " << get_fastSimulation_visibility               () << G4endl
+              << " |--< fastSimulation_visibility_fileName >-------: " << get_fastSimulation_visibility_fileName      () << G4endl
+              << " |--< fastSimulation_overlay >-------------------: " << get_fastSimulation_overlay                  () << G4endl
+              << " |--< fastSimulation_overlay_fileName >----------: " << get_fastSimulation_overlay_fileName         () << G4endl
+              << " |--< fastSimulation_overlay_energy >------------: " << get_fastSimulation_overlay_energy           () << G4endl
+              << " |--< fastSimulation_overlay_position >----------: " << get_fastSimulation_overlay_position         () << G4endl
+              << " |--< fastSimulation_overlay_angle >-------------: " << get_fastSimulation_overlay_angle            () << G4endl
+              << " |--< fastSimulation_prescale >------------------: " << get_fastSimulation_prescale                 () << G4endl
+              << " |--< fastSimulation_acceptance >----------------: " << get_fastSimulation_acceptance               () << G4endl
+              << " |--< fastSimulation_acceptance_survival >-------: " << get_fastSimulation_acceptance_survival      () << G4endl
+              << " |--< fastSimulation_timeWindow >----------------: " << get_fastSimulation_timeWindow               () << G4endl
+              << " |--< fastSimulation_stackChunk >----------------: " << get_fastSimulation_stackChunk               () << G4endl
+              << " |--< fastSimulation_stackBuffer >---------------: " << get_fastSimulation_stackBuffer              () << G4endl
+              << " |--< detector_wall_productionCut >--------------: " << get_detector_wall_productionCut             () << G4endl
+              << " |--< detector_medium_productionCut >------------: " << get_detector_medium_productionCut           () << G4endl;
 }
 
 G4ThreeVector ConstructionMessenger::get_world_size() { 
@@ -538,6 +803,14 @@ G4bool ConstructionMessenger::get_detector_medium_forceSolid() {
     return m_variable_detector_medium_forceSolid;
 }
 
+G4double ConstructionMessenger::get_detector_medium_smartless() { 
+    return m_variable_detector_medium_smartless;
+}
+
+G4bool ConstructionMessenger::get_detector_medium_optimise() { 
+    return m_variable_detector_medium_optimise;
+}
+
 G4VisAttributes* ConstructionMessenger::get_detector_medium_visAttributes() {
     return m_variable_detector_medium_visAttributes;
 }
@@ -680,6 +953,14 @@ G4bool ConstructionMessenger::get_photoSensor_body_forceSolid() {
     return m_variable_photoSensor_body_forceSolid;
 }
 
+G4String ConstructionMessenger::get_photoSensor_efficiency() {
+    return m_variable_photoSensor_efficiency;
+}
+
+G4bool ConstructionMessenger::get_photoSensor_efficiency_prescale() {
+    return m_variable_photoSensor_efficiency_prescale;
+}
+
 G4VisAttributes* ConstructionMessenger::get_photoSensor_body_visAttributes() {
     return m_variable_photoSensor_body_visAttributes;
 }
@@ -816,6 +1097,138 @@ G4bool ConstructionMessenger::get_checkOverlaps() {
     return m_variable_checkOverlaps;
 }
 
+G4bool ConstructionMessenger::get_hierarchical() {
+    return m_variable_hierarchical;
+}
+
+G4bool ConstructionMessenger::get_parameterised() {
+    return m_variable_parameterised;
+}
+
+G4bool ConstructionMessenger::get_calorimeters_merged() {
+    return m_variable_calorimeters_merged;
+}
+
+G4bool ConstructionMessenger::get_cache() {
+    return m_variable_cache;
+}
+
+G4String ConstructionMessenger::get_cache_directory() {
+    return m_variable_cache_directory;
+}
+
+G4int ConstructionMessenger::get_voxels_max() {
+    return m_variable_voxels_max;
+}
+
+G4bool ConstructionMessenger::get_lensScan() {
+    return m_variable_lensScan;
+}
+
+G4ThreeVector ConstructionMessenger::get_lensScan_medium_size() {
+    return m_variable_lensScan_medium_size;
+}
+
+G4bool ConstructionMessenger::get_fastSimulation() {
+    return m_variable_fastSimulation;
+}
+
+G4bool ConstructionMessenger::get_fastSimulation_table() {
+    return m_variable_fastSimulation_table;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_table_nBins_position() {
+    return m_variable_fastSimulation_table_nBins_position;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_table_nBins_direction() {
+    return m_variable_fastSimulation_table_nBins_direction;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_table_nBins_energy() {
+    return m_variable_fastSimulation_table_nBins_energy;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_table_energy_min() {
+    return m_variable_fastSimulation_table_energy_min;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_table_energy_max() {
+    return m_variable_fastSimulation_table_energy_max;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_table_nSamples() {
+    return m_variable_fastSimulation_table_nSamples;
+}
+
+G4bool ConstructionMessenger::get_fastSimulation_medium() {
+    return m_variable_fastSimulation_medium;
+}
+
+G4String ConstructionMessenger::get_fastSimulation_visibility() {
+    return m_variable_fastSimulation_visibility;
+}
+
+G4String ConstructionMessenger::get_fastSimulation_visibility_fileName() {
+    return m_variable_fastSimulation_visibility_fileName;
+}
+
+G4bool ConstructionMessenger::get_fastSimulation_overlay() {
+    return m_variable_fastSimulation_overlay;
+}
+
+G4String ConstructionMessenger::get_fastSimulation_overlay_fileName() {
+    return m_variable_fastSimulation_overlay_fileName;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_overlay_energy() {
+    return m_variable_fastSimulation_overlay_energy;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_overlay_position() {
+    return m_variable_fastSimulation_overlay_position;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_overlay_angle() {
+    return m_variable_fastSimulation_overlay_angle;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_prescale() {
+    return m_variable_fastSimulation_prescale;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_acceptance() {
+    return m_variable_fastSimulation_acceptance;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_acceptance_survival() {
+    return m_variable_fastSimulation_acceptance_survival;
+}
+
+G4double ConstructionMessenger::get_fastSimulation_timeWindow() {
+    return m_variable_fastSimulation_timeWindow;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_stackChunk() {
+    return m_variable_fastSimulation_stackChunk;
+}
+
+G4int ConstructionMessenger::get_fastSimulation_stackBuffer() {
+    return m_variable_fastSimulation_stackBuffer;
+}
+
+G4double ConstructionMessenger::get_detector_wall_productionCut() {
+    return m_variable_detector_wall_productionCut;
+}
+
+G4double ConstructionMessenger::get_detector_medium_productionCut() {
+    return m_variable_detector_medium_productionCut;
+}
+
+DetectorConstruction* ConstructionMessenger::get_detectorConstruction() {
+    return m_detectorConstruction;
+}
+
 void ConstructionMessenger::set_world_size( G4ThreeVector t_variable_world_size ) { 
     m_variable_world_size=t_variable_world_size; 
 }
@@ -908,6 +1321,14 @@ void ConstructionMessenger::set_detector_medium_forceSolid( G4bool t_variable_de
     set_visAttributes_forceSolid( t_variable_detector_medium_forceSolid, m_variable_detector_medium_visAttributes );
 }
 
+void ConstructionMessenger::set_detector_medium_smartless( G4double t_variable_detector_medium_smartless ) { 
+    m_variable_detector_medium_smartless = t_variable_detector_medium_smartless;
+}
+
+void ConstructionMessenger::set_detector_medium_optimise( G4bool t_variable_detector_medium_optimise ) { 
+    m_variable_detector_medium_optimise = t_variable_detector_medium_optimise;
+}
+
 void ConstructionMessenger::set_calorimeter_size( G4ThreeVector t_variable_calorimeter_size ) { 
     m_variable_calorimeter_size = t_variable_calorimeter_size;
 }
@@ -1038,6 +1459,14 @@ void ConstructionMessenger::set_photoSensor_body_forceSolid( G4bool t_variable_p
     set_visAttributes_forceSolid( t_variable_photoSensor_body_forceSolid, m_variable_photoSensor_body_visAttributes );
 }
 
+void ConstructionMessenger::set_photoSensor_efficiency( G4String t_variable_photoSensor_efficiency ) {
+    m_variable_photoSensor_efficiency = t_variable_photoSensor_efficiency;
+}
+
+void ConstructionMessenger::set_photoSensor_efficiency_prescale( G4bool t_variable_photoSensor_efficiency_prescale ) {
+    m_variable_photoSensor_efficiency_prescale = t_variable_photoSensor_efficiency_prescale;
+}
+
 void ConstructionMessenger::set_lens_incramentCurrentLens() {
     if( m_variable_lens_surface_1_radii_x.size() != 0 )
         m_variable_lens_currentLens++;
@@ -1138,6 +1567,138 @@ void ConstructionMessenger::set_checkOverlaps( G4bool t_variable_checkOverlaps )
     m_variable_checkOverlaps = t_variable_checkOverlaps;
 }
 
+void ConstructionMessenger::set_hierarchical( G4bool t_variable_hierarchical ) {
+    m_variable_hierarchical = t_variable_hierarchical;
+}
+
+void ConstructionMessenger::set_parameterised( G4bool t_variable_parameterised ) {
+    m_variable_parameterised = t_variable_parameterised;
+}
+
+void ConstructionMessenger::set_calorimeters_merged( G4bool t_variable_calorimeters_merged ) {
+    m_variable_calorimeters_merged = t_variable_calorimeters_merged;
+}
+
+void ConstructionMessenger::set_cache( G4bool t_variable_cache ) {
+    m_variable_cache = t_variable_cache;
+}
+
+void ConstructionMessenger::set_cache_directory( G4String t_variable_cache_directory ) {
+    m_variable_cache_directory = t_variable_cache_directory;
+}
+
+void ConstructionMessenger::set_voxels_max( G4int t_variable_voxels_max ) {
+    m_variable_voxels_max = t_variable_voxels_max;
+}
+
+void ConstructionMessenger::set_lensScan( G4bool t_variable_lensScan ) {
+    m_variable_lensScan = t_variable_lensScan;
+}
+
+void ConstructionMessenger::set_lensScan_medium_size( G4ThreeVector t_variable_lensScan_medium_size ) {
+    m_variable_lensScan_medium_size = t_variable_lensScan_medium_size;
+}
+
+void ConstructionMessenger::set_fastSimulation( G4bool t_variable_fastSimulation ) {
+    m_variable_fastSimulation = t_variable_fastSimulation;
+}
+
+void ConstructionMessenger::set_fastSimulation_table( G4bool t_variable_fastSimulation_table ) {
+    m_variable_fastSimulation_table = t_variable_fastSimulation_table;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_nBins_position( G4int t_variable_fastSimulation_table_nBins_position ) {
+    m_variable_fastSimulation_table_nBins_position = t_variable_fastSimulation_table_nBins_position;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_nBins_direction( G4int t_variable_fastSimulation_table_nBins_direction ) {
+    m_variable_fastSimulation_table_nBins_direction = t_variable_fastSimulation_table_nBins_direction;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_nBins_energy( G4int t_variable_fastSimulation_table_nBins_energy ) {
+    m_variable_fastSimulation_table_nBins_energy = t_variable_fastSimulation_table_nBins_energy;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_energy_min( G4double t_variable_fastSimulation_table_energy_min ) {
+    m_variable_fastSimulation_table_energy_min = t_variable_fastSimulation_table_energy_min;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_energy_max( G4double t_variable_fastSimulation_table_energy_max ) {
+    m_variable_fastSimulation_table_energy_max = t_variable_fastSimulation_table_energy_max;
+}
+
+void ConstructionMessenger::set_fastSimulation_table_nSamples( G4int t_variable_fastSimulation_table_nSamples ) {
+    m_variable_fastSimulation_table_nSamples = t_variable_fastSimulation_table_nSamples;
+}
+
+void ConstructionMessenger::set_fastSimulation_medium( G4bool t_variable_fastSimulation_medium ) {
+    m_variable_fastSimulation_medium = t_variable_fastSimulation_medium;
+}
+
+void ConstructionMessenger::set_fastSimulation_visibility( G4String t_variable_fastSimulation_visibility ) {
+    m_variable_fastSimulation_visibility = t_variable_fastSimulation_visibility;
+}
+
+void ConstructionMessenger::set_fastSimulation_visibility_fileName( G4String t_variable_fastSimulation_visibility_fileName ) {
+    m_variable_fastSimulation_visibility_fileName = t_variable_fastSimulation_visibility_fileName;
+}
+
+void ConstructionMessenger::set_fastSimulation_overlay( G4bool t_variable_fastSimulation_overlay ) {
+    m_variable_fastSimulation_overlay = t_variable_fastSimulation_overlay;
+}
+
+void ConstructionMessenger::set_fastSimulation_overlay_fileName( G4String t_variable_fastSimulation_overlay_fileName ) {
+    m_variable_fastSimulation_overlay_fileName = t_variable_fastSimulation_overlay_fileName;
+}
+
+void ConstructionMessenger::set_fastSimulation_overlay_energy( G4double t_variable_fastSimulation_overlay_energy ) {
+    m_variable_fastSimulation_overlay_energy = t_variable_fastSimulation_overlay_energy;
+}
+
+void ConstructionMessenger::set_fastSimulation_overlay_position( G4double t_variable_fastSimulation_overlay_position ) {
+    m_variable_fastSimulation_overlay_position = t_variable_fastSimulation_overlay_position;
+}
+
+void ConstructionMessenger::set_fastSimulation_overlay_angle( G4double t_variable_fastSimulation_overlay_angle ) {
+    m_variable_fastSimulation_overlay_angle = t_variable_fastSimulation_overlay_angle;
+}
+
+void ConstructionMessenger::set_fastSimulation_prescale( G4double t_variable_fastSimulation_prescale ) {
+    m_variable_fastSimulation_prescale = t_variable_fastSimulation_prescale;
+}
+
+void ConstructionMessenger::set_fastSimulation_acceptance( G4double t_variable_fastSimulation_acceptance ) {
+    m_variable_fastSimulation_acceptance = t_variable_fastSimulation_acceptance;
+}
+
+void ConstructionMessenger::set_fastSimulation_acceptance_survival( G4double t_variable_fastSimulation_acceptance_survival ) {
+    m_variable_fastSimulation_acceptance_survival = t_variable_fastSimulation_acceptance_survival;
+}
+
+void ConstructionMessenger::set_fastSimulation_timeWindow( G4double t_variable_fastSimulation_timeWindow ) {
+    m_variable_fastSimulation_timeWindow = t_variable_fastSimulation_timeWindow;
+}
+
+void ConstructionMessenger::set_fastSimulation_stackChunk( G4int t_variable_fastSimulation_stackChunk ) {
+    m_variable_fastSimulation_stackChunk = t_variable_fastSimulation_stackChunk;
+}
+
+void ConstructionMessenger::set_fastSimulation_stackBuffer( G4int t_variable_fastSimulation_stackBuffer ) {
+    m_variable_fastSimulation_stackBuffer = t_variable_fastSimulation_stackBuffer;
+}
+
+void ConstructionMessenger::set_detector_wall_productionCut( G4double t_variable_detector_wall_productionCut ) {
+    m_variable_detector_wall_productionCut = t_variable_detector_wall_productionCut;
+}
+
+void ConstructionMessenger::set_detector_medium_productionCut( G4double t_variable_detector_medium_productionCut ) {
+    m_variable_detector_medium_productionCut = t_variable_detector_medium_productionCut;
+}
+
+void ConstructionMessenger::set_detectorConstruction( DetectorConstruction* t_detectorConstruction ) {
+    m_detectorConstruction = t_detectorConstruction;
+}
+
 void ConstructionMessenger::set_visAttributes_visibility( G4bool t_variable_visibility, G4VisAttributes*& t_variable_visAttributes ) {
     if( !t_variable_visAttributes )
         t_variable_visAttributes = new G4VisAttributes( t_variable_visibility );
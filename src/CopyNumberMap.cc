@@ -0,0 +1,28 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "CopyNumberMap.hh"
+
+CopyNumberMap::CopyNumberMap( G4int t_depth ) {
+    add( t_depth );
+}
+
+void CopyNumberMap::add( G4int t_depth, G4int t_weight ) {
+    m_terms.push_back( { t_depth, t_weight } );
+}
+
+G4int CopyNumberMap::get_ID( const G4VTouchable* t_touchable ) const {
+    G4int ID{ 0 };
+    for( const auto& term : m_terms )
+        ID += term.second * t_touchable->GetCopyNumber( term.first );
+    return ID;
+}
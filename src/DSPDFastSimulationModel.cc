@@ -0,0 +1,173 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "DSPDFastSimulationModel.hh"
+
+using std::sqrt;
+using std::max;
+
+namespace {
+    G4Mutex                                    lensResponseTableMutex = G4MUTEX_INITIALIZER;
+    std::shared_ptr< const LensResponseTable > lensResponseTable_shared; // of the last lens configuration
+    std::string                                lensResponseTable_shared_key;
+}
+
+DSPDFastSimulationModel::DSPDFastSimulationModel( const G4String                    & t_name                        , 
+                                                        G4Region                    * t_region                      , 
+                                                        LensSystem                  * t_lensSystem                  , 
+                                                        PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector, 
+                                                  const CopyNumberMap               & t_copyNumberMap               , 
+                                                        G4double                      t_photoSensor_z               , 
+                                                        G4double                      t_entrance_z                   ) 
+    : G4VFastSimulationModel( t_name, t_region ) {
+    m_name                         = t_name                        ;
+    m_lensSystem                   = t_lensSystem                  ;
+    m_photoSensorSensitiveDetector = t_photoSensorSensitiveDetector;
+    m_copyNumberMap                = t_copyNumberMap               ;
+    m_photoSensor_z                = t_photoSensor_z               ;
+    m_entrance_z                   = t_entrance_z                  ;
+}
+
+DSPDFastSimulationModel::~DSPDFastSimulationModel() {
+    if( m_rayTracer ) 
+        delete m_rayTracer;
+}
+
+G4bool DSPDFastSimulationModel::IsApplicable( const G4ParticleDefinition& t_particleDefinition ) {
+    return &t_particleDefinition == G4OpticalPhoton::Definition();
+}
+
+// Triggers on photons that just entered the envelope through its outer surface and reach the
+// photosensor in the ray tracer. Photons coming out of a lens or the photosensor are
+// inside the envelope, not on its surface, so a photon handed to the full simulation stays there.
+G4bool DSPDFastSimulationModel::ModelTrigger( const G4FastTrack& t_fastTrack ) {
+    if( !m_constructionMessenger->get_fastSimulation() )
+        return false;
+
+    const G4Track* track = t_fastTrack.GetPrimaryTrack();
+    if( track->GetStep()->GetPreStepPoint()->GetStepStatus() != fGeomBoundary )
+        return false;
+
+    G4ThreeVector position = t_fastTrack.GetPrimaryTrackLocalPosition();
+    if( t_fastTrack.GetEnvelopeLogicalVolume()->GetSolid()->Inside( position ) != kSurface )
+        return false;
+
+    update_rayTracer();
+
+    G4ThreeVector direction = t_fastTrack.GetPrimaryTrackLocalDirection();
+
+    // O(1) lookup for photons through the front face inside the table, tracing otherwise
+    size_t cell;
+    if( m_lensResponseTable && position.z() - m_entrance_z < G4GeometryTolerance::GetInstance()->GetSurfaceTolerance() &&
+        m_lensResponseTable->get_cell( position.x(), position.y(), direction.x(), direction.y(), track->GetKineticEnergy(), cell ) ) {
+        const LensResponseTableSample& sample = m_lensResponseTable->get_sample( cell, G4UniformRand() );
+        if( sample.m_weight < 0 )
+            return false;
+
+        m_batch.set( 0, sample.m_x , sample.m_y , m_rayTracer->get_photoSensor_z(), 
+                        sample.m_dx, sample.m_dy, sqrt( max( 0., 1. - sample.m_dx * sample.m_dx - sample.m_dy * sample.m_dy ) ) );
+        m_batch.m_weight         [ 0 ] = sample.m_weight         ;
+        m_batch.m_pathLength     [ 0 ] = sample.m_pathLength     ;
+        m_batch.m_groupPathLength[ 0 ] = sample.m_groupPathLength;
+        return true;
+    }
+
+    m_batch.set( 0, position .x(), position .y(), position .z() - m_photoSensor_z, 
+                    direction.x(), direction.y(), direction.z()                   );
+    m_rayTracer->trace( m_batch, track->GetKineticEnergy() );
+
+    return m_batch.m_status[ 0 ] == RayTracerBatch::m_detected;
+}
+
+// Kills the photon; with the traced transmission probability it deposits a hit on the photosensor first.
+void DSPDFastSimulationModel::DoIt( const G4FastTrack& t_fastTrack, G4FastStep& t_fastStep ) {
+    const G4Track* track = t_fastTrack.GetPrimaryTrack();
+
+    t_fastStep.KillPrimaryTrack();
+    t_fastStep.ProposePrimaryTrackPathLength( m_batch.m_pathLength[ 0 ] );
+
+    if( !m_photoSensorSensitiveDetector || G4UniformRand() >= m_batch.m_weight[ 0 ] )
+        return;
+
+    const G4AffineTransform* transform_global = t_fastTrack.GetInverseAffineTransformation();
+    G4ThreeVector position  = transform_global->TransformPoint( G4ThreeVector( m_batch.m_x [ 0 ], m_batch.m_y [ 0 ], m_batch.m_z [ 0 ] + m_photoSensor_z ) );
+    G4ThreeVector direction = transform_global->TransformAxis ( G4ThreeVector( m_batch.m_dx[ 0 ], m_batch.m_dy[ 0 ], m_batch.m_dz[ 0 ]                   ) );
+    G4double      time      = track->GetGlobalTime() + m_batch.m_groupPathLength[ 0 ] / c_light;
+
+    G4double energy = track->GetKineticEnergy();
+    if( !m_photoSensorSensitiveDetector->draw_efficiency( energy ) )
+        return;
+    m_photoSensorSensitiveDetector->add_hit( m_copyNumberMap.get_ID( track->GetTouchable() ), position, time, energy, energy * direction, 
+                                             m_name, track->GetWeight(), track->GetVertexPosition() );
+}
+
+// The lenses only change between runs, so the ray tracer is made again at the first photon of each run.
+void DSPDFastSimulationModel::update_rayTracer() {
+    G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+    if( m_rayTracer && runID == m_rayTracer_runID )
+        return;
+
+    if( m_rayTracer )
+        delete m_rayTracer;
+    m_rayTracer       = new RayTracer( m_lensSystem->make_rayTracer() );
+    m_rayTracer_runID = runID;
+
+    m_lensResponseTable = ( m_constructionMessenger->get_fastSimulation_table() ) ? get_lensResponseTable( *m_rayTracer ) : nullptr;
+}
+
+// The table of t_rayTracer from the cache directory, or made and written there. The first thread
+// of a run gets it and the others reuse it while the lens configuration stays the same.
+std::shared_ptr< const LensResponseTable > DSPDFastSimulationModel::get_lensResponseTable( const RayTracer& t_rayTracer ) {
+    std::shared_ptr< LensResponseTable > lensResponseTable;
+    try {
+        lensResponseTable = std::make_shared< LensResponseTable >( m_constructionMessenger->get_fastSimulation_table_nBins_position (),
+                                                                   m_constructionMessenger->get_fastSimulation_table_nBins_direction(),
+                                                                   m_constructionMessenger->get_fastSimulation_table_nBins_energy   (),
+                                                                   m_constructionMessenger->get_fastSimulation_table_nSamples       (),
+                                                                   m_entrance_z - m_photoSensor_z                                     ,
+                                                                   m_constructionMessenger->get_fastSimulation_table_energy_min     (),
+                                                                   m_constructionMessenger->get_fastSimulation_table_energy_max     () );
+    } catch( const std::invalid_argument& exception ) {
+        G4Exception( "DSPDFastSimulationModel::get_lensResponseTable", "InvalidArgument", FatalException, exception.what() );
+    }
+    std::string key = lensResponseTable->get_key( t_rayTracer );
+
+    G4AutoLock lock( &lensResponseTableMutex );
+    if( lensResponseTable_shared && key == lensResponseTable_shared_key )
+        return lensResponseTable_shared;
+
+    G4String directory = m_constructionMessenger->get_cache_directory();
+    G4String fileName  = directory + "/" + LensResponseTable::get_hash( key ) + ".lrt";
+    if( lensResponseTable->read( fileName, key ) )
+        G4cout << "DSPDFastSimulationModel::get_lensResponseTable: read " << fileName << G4endl;
+    else {
+        G4Timer timer;
+        timer.Start();
+        lensResponseTable->make( t_rayTracer );
+        timer.Stop();
+        G4cout << "DSPDFastSimulationModel::get_lensResponseTable: made " << lensResponseTable->get_nCells() 
+               << " cells in " << timer.GetRealElapsed() << " s, writing " << fileName << G4endl;
+
+        std::error_code error;
+        std::filesystem::create_directories( std::string( directory ), error );
+        try {
+            lensResponseTable->write( fileName, key );
+        } catch( const std::runtime_error& exception ) {
+            G4Exception( "DSPDFastSimulationModel::get_lensResponseTable", "InvalidSetup", JustWarning, 
+                         ( G4String( exception.what() ) + ", the table will be made again next time." ).c_str() );
+        }
+    }
+
+    lensResponseTable_shared     = lensResponseTable;
+    lensResponseTable_shared_key = key;
+    return lensResponseTable_shared;
+}
@@ -0,0 +1,136 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "DSPDSymmetries.hh"
+#include "PhotoSensorSensitiveDetector.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <tuple>
+
+namespace {
+    // DSPD positions are compared to this precision when looking for the symmetries
+    const G4double positionPrecision{ 1e-3 * mm };
+
+    std::array< long long, 3 > get_positionKey( const G4ThreeVector& t_position ) {
+        return { std::llround( t_position.x() / positionPrecision ), 
+                 std::llround( t_position.y() / positionPrecision ), 
+                 std::llround( t_position.z() / positionPrecision ) };
+    }
+}
+
+G4ThreeVector CubeSymmetry::apply( const G4ThreeVector& t_vector ) const {
+    return G4ThreeVector( m_signs[ 0 ] * t_vector[ m_axes[ 0 ] ], 
+                          m_signs[ 1 ] * t_vector[ m_axes[ 1 ] ], 
+                          m_signs[ 2 ] * t_vector[ m_axes[ 2 ] ] );
+}
+
+G4ThreeVector CubeSymmetry::inverse( const G4ThreeVector& t_vector ) const {
+    G4ThreeVector vector;
+    for( G4int axis{ 0 }; axis < 3; axis++ )
+        vector[ m_axes[ axis ] ] = m_signs[ axis ] * t_vector[ axis ];
+    return vector;
+}
+
+G4bool CubeSymmetry::operator==( const CubeSymmetry& t_symmetry ) const {
+    return std::equal( m_axes , m_axes  + 3, t_symmetry.m_axes  ) && 
+           std::equal( m_signs, m_signs + 3, t_symmetry.m_signs );
+}
+
+vector< CubeSymmetry > CubeSymmetry::get_all() {
+    vector< CubeSymmetry > symmetries;
+    G4int axes[ 3 ]{ 0, 1, 2 };
+    do {
+        for( G4int signs{ 0 }; signs < 8; signs++ )
+            symmetries.push_back( { { axes[ 0 ], axes[ 1 ], axes[ 2 ] }, 
+                                    { signs & 1 ? -1 : 1, signs & 2 ? -1 : 1, signs & 4 ? -1 : 1 } } );
+    } while( std::next_permutation( axes, axes + 3 ) );
+    return symmetries;
+}
+
+// Keeps the symmetries of t_candidates that map the position of every DSPD of
+// t_photoSensorSensitiveDetector onto that of a DSPD, in their order
+void DSPDSymmetries::set( PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector, const vector< CubeSymmetry >& t_candidates ) {
+    G4int nDSPDs = t_photoSensorSensitiveDetector->get_nCopies();
+    std::map< std::array< long long, 3 >, G4int > DSPDs;
+    m_rotationMatrices.clear();
+    for( G4int DSPD{ 0 }; DSPD < nDSPDs; DSPD++ ) {
+        DSPDs[ get_positionKey( t_photoSensorSensitiveDetector->get_position( DSPD ) ) ] = DSPD;
+        G4RotationMatrix* rotationMatrix = t_photoSensorSensitiveDetector->get_rotationMatrix( DSPD );
+        m_rotationMatrices.push_back( rotationMatrix ? *rotationMatrix : G4RotationMatrix() );
+    }
+
+    m_symmetries   .clear();
+    m_DSPDs        .clear();
+    m_DSPDs_inverse.clear();
+    for( const CubeSymmetry& symmetry : t_candidates ) {
+        vector< G4int > images( nDSPDs ), preimages( nDSPDs );
+        G4bool valid{ true };
+        for( G4int DSPD{ 0 }; DSPD < nDSPDs && valid; DSPD++ ) {
+            auto image = DSPDs.find( get_positionKey( symmetry.apply( t_photoSensorSensitiveDetector->get_position( DSPD ) ) ) );
+            valid = image != DSPDs.end();
+            if( valid ) {
+                images   [ DSPD          ] = image->second;
+                preimages[ image->second ] = DSPD;
+            }
+        }
+        if( valid ) {
+            m_symmetries   .push_back( symmetry               );
+            m_DSPDs        .push_back( std::move( images    ) );
+            m_DSPDs_inverse.push_back( std::move( preimages ) );
+        }
+    }
+}
+
+size_t DSPDSymmetries::get_nSymmetries() const {
+    return m_symmetries.size();
+}
+
+const CubeSymmetry& DSPDSymmetries::get_symmetry( size_t t_symmetry ) const {
+    return m_symmetries.at( t_symmetry );
+}
+
+G4int DSPDSymmetries::get_DSPD( size_t t_symmetry, G4int t_DSPD ) const {
+    return m_DSPDs[ t_symmetry ].at( t_DSPD );
+}
+
+G4int DSPDSymmetries::get_DSPD_inverse( size_t t_symmetry, G4int t_DSPD ) const {
+    return m_DSPDs_inverse[ t_symmetry ].at( t_DSPD );
+}
+
+G4ThreeVector DSPDSymmetries::map_direction( size_t t_symmetry, G4int t_DSPD, const G4ThreeVector& t_direction ) const {
+    G4ThreeVector direction = m_symmetries[ t_symmetry ].apply( m_rotationMatrices[ t_DSPD ] * t_direction );
+    return m_rotationMatrices[ get_DSPD( t_symmetry, t_DSPD ) ].inverse() * direction;
+}
+
+G4ThreeVector DSPDSymmetries::map_direction_inverse( size_t t_symmetry, G4int t_DSPD, const G4ThreeVector& t_direction ) const {
+    G4ThreeVector direction = m_symmetries[ t_symmetry ].inverse( m_rotationMatrices[ t_DSPD ] * t_direction );
+    return m_rotationMatrices[ get_DSPD_inverse( t_symmetry, t_DSPD ) ].inverse() * direction;
+}
+
+size_t DSPDSymmetries::fold( const G4ThreeVector& t_position ) const {
+    size_t        folded{ 0 };
+    G4ThreeVector position_max;
+    for( size_t symmetry{ 0 }; symmetry < m_symmetries.size(); symmetry++ ) {
+        G4ThreeVector position = m_symmetries[ symmetry ].apply( t_position );
+        if( symmetry == 0 || 
+            std::make_tuple( position.z(), position.y(), position.x() ) > std::make_tuple( position_max.z(), position_max.y(), position_max.x() ) ) {
+            folded       = symmetry;
+            position_max = position;
+        }
+    }
+    return folded;
+}
@@ -22,6 +22,8 @@
 
 #include "FTFP_BERT.hh"
 #include "G4EmStandardPhysics_option4.hh"
+#include "G4FastSimulationPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
 #include "G4OpticalParameters.hh"
 #include "G4OpticalPhysics.hh"
 #include "G4RunManagerFactory.hh"
@@ -88,6 +90,17 @@ int main(int argc, char** argv)
     opticalParams->SetCerenkovMaxBetaChange( 10.0 );
     opticalParams->SetCerenkovTrackSecondariesFirst( true );
     physicsList->RegisterPhysics( opticalPhysics );
+
+    // Fast simulation of the optical photons in the DSPD envelopes (see DSPDFastSimulationModel)
+    G4FastSimulationPhysics* fastSimulationPhysics = new G4FastSimulationPhysics();
+    fastSimulationPhysics->ActivateFastSimulation( "opticalphoton" );
+    physicsList->RegisterPhysics( fastSimulationPhysics );
+
+    // Kills the tracks entering the world or the detector wall (see DetectorConstruction::make_regions),
+    // for every particle: by default only charged particles and neutrons get G4UserSpecialCuts
+    G4StepLimiterPhysics* stepLimiterPhysics = new G4StepLimiterPhysics();
+    stepLimiterPhysics->SetApplyToAll( true );
+    physicsList->RegisterPhysics( stepLimiterPhysics );
     runManager->SetUserInitialization( physicsList );
 
     // Make photonCreator particle
@@ -114,7 +127,8 @@ int main(int argc, char** argv)
     if( outputMessenger->get_GDML_save() )
         detectorConstruction->make_GDMLFile( outputMessenger->get_GDML_fileName() );
 
-    // Terminate job
+    // Terminate job (a geometry that fails the overlap check gives a nonzero exit code)
+    G4int overlaps = detectorConstruction->get_overlaps();
     if( visManager )
         delete visManager;
     if( runManager )
@@ -129,5 +143,5 @@ int main(int argc, char** argv)
            << '\n' << "### Job done! (: ###"
            << '\n' << "### Goodbye!     ###"
            << '\n' << "####################" << G4endl;
-    return 0;
+    return ( overlaps > 0 ) ? 1 : 0;
 }
\ No newline at end of file
@@ -12,17 +12,33 @@
 #include "DetectorConstruction.hh"
 
 #include<string>
+#include<algorithm>
+#include<cfloat>
+#include<sstream>
+#include<map>
+#include<set>
+#include<sys/resource.h>
 using std::to_string;
 using std::string;
+using std::max;
+using std::min;
+using std::map;
+
+namespace { G4Mutex lensSensitiveDetectorsMutex = G4MUTEX_INITIALIZER; }
 
 DetectorConstruction::DetectorConstruction( G4bool t_make_SDandField ) :
     m_make_SDandField( t_make_SDandField ) {
+    m_constructionMessenger->set_detectorConstruction( this );
 }
     
 DetectorConstruction::~DetectorConstruction() {
+    if( m_constructionMessenger->get_detectorConstruction() == this )
+        m_constructionMessenger->set_detectorConstruction( nullptr );
+
     if( m_world           ) delete m_world              ;
     if( m_detector_wall   ) delete m_detector_wall      ;
     if( m_GDMLParser      ) delete m_GDMLParser         ;
+    if( m_kill_userLimits ) delete m_kill_userLimits    ;
 
     for( auto& calorimeter : m_calorimeters_full )
         if( calorimeter ) 
@@ -36,6 +52,27 @@ DetectorConstruction::~DetectorConstruction() {
     for( auto& medium : m_mediums )
         if( medium ) 
             delete medium;
+    for( auto& wall : m_walls )
+        if( wall ) 
+            delete wall;
+
+    for( auto& cell : m_cells )
+        if( cell ) 
+            delete cell;
+
+    for( auto& calorimeterLattice : m_calorimeterLattices )
+        if( calorimeterLattice ) 
+            delete calorimeterLattice;
+    for( auto& surfaceLattice : m_surfaceLattices )
+        if( surfaceLattice ) 
+            delete surfaceLattice;
+
+    if( m_lensSystem                ) delete m_lensSystem               ;
+    if( m_photoSensor               ) delete m_photoSensor              ;
+    if( m_DSPD_envelope             ) delete m_DSPD_envelope            ;
+    if( m_calorimeter_full_shared   ) delete m_calorimeter_full_shared  ;
+    if( m_calorimeter_middle_shared ) delete m_calorimeter_middle_shared;
+    if( m_calorimeter_strip_shared  ) delete m_calorimeter_strip_shared ;
 }
 
 G4VPhysicalVolume* DetectorConstruction::Construct()
@@ -44,26 +81,370 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     m_constructionMessenger->print_parameters();
 
     m_checkOverlaps = m_constructionMessenger->get_checkOverlaps();
+    m_lensScan      = m_constructionMessenger->get_lensScan     ();
 
-    make_world   ();
-    make_detector();
-    
+    G4Timer timer_construction;
+    G4Timer timer_overlaps;
+    timer_construction.Start();
+
+    make_world();
     m_world_physicalVolume = 
-    m_world        ->place( nullptr, G4ThreeVector(0,0,0), nullptr                              );
-    m_detector_wall->place( nullptr, G4ThreeVector(0,0,0), m_world        ->get_logicalVolume() );
-    m_mediums.at(0)->place( nullptr, G4ThreeVector(0,0,0), m_detector_wall->get_logicalVolume() );
-
-    G4int countIndex { 0 };
-    place_surface(  m_axis_x, countIndex++ );
-    place_surface( -m_axis_x, countIndex++ );
-    place_surface(  m_axis_y, countIndex++ );
-    place_surface( -m_axis_y, countIndex++ );
-    place_surface(  m_axis_z, countIndex++ );
-    place_surface( -m_axis_z, countIndex++ );
+    m_world->place( nullptr, G4ThreeVector(0,0,0), nullptr );
+
+    if( m_lensScan )
+        make_lensScan();
+    else {
+        make_detector();
+        m_detector_wall->place( nullptr, G4ThreeVector(0,0,0), m_world        ->get_logicalVolume() );
+        m_mediums.at(0)->place( nullptr, G4ThreeVector(0,0,0), m_detector_wall->get_logicalVolume() );
+
+        // one record per calorimeter and DSPD of the six faces (see place_surface), none when
+        // parameterised
+        if( !m_parameterised ) {
+            G4int amount_x = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_x();
+            G4int amount_y = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_y();
+            m_calorimeters_full               .reserve( 6 * ( amount_x * ( amount_y + 1 ) + ( amount_x + 1 ) * amount_y ) );
+            m_calorimeters_middle             .reserve( 6 * ( amount_x + 1 ) * ( amount_y + 1 ) );
+            m_directionSensitivePhotoDetectors.reserve( 6 * amount_x * amount_y );
+        }
+        m_surfaceLattices.reserve( 6 );
+
+        G4int countIndex { 0 };
+        place_surface(  m_axis_x, countIndex++ );
+        place_surface( -m_axis_x, countIndex++ );
+        place_surface(  m_axis_y, countIndex++ );
+        place_surface( -m_axis_y, countIndex++ );
+        place_surface(  m_axis_z, countIndex++ );
+        place_surface( -m_axis_z, countIndex++ );
+    }
+
+    make_regions();
+
+    // Optical photons in the medium are navigated through the voxels of the medium and the
+    // walls around it, which hold every DSPD and calorimeter (see /geometry/detector/medium/).
+    G4double smartless = m_constructionMessenger->get_detector_medium_smartless();
+    m_mediums.at(0)->get_logicalVolume()->SetSmartless   ( smartless                                              );
+    m_mediums.at(0)->get_logicalVolume()->SetOptimisation( m_constructionMessenger->get_detector_medium_optimise() );
+    for( Wall* wall : m_walls )
+        wall->get_logicalVolume()->SetSmartless( smartless );
+
+    timer_construction.Stop();
+
+    if( m_checkOverlaps ) {
+        timer_overlaps.Start();
+        check_overlaps_cached();
+        timer_overlaps.Stop();
+    }
+
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage ); // ru_maxrss in kB on Linux
+
+    size_t calorimeters = m_calorimeters_full.size() + m_calorimeters_middle.size();
+    if( m_parameterised )
+        for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+            calorimeters += surfaceLattice->get_calorimeter_amount();
+
+    G4cout << "DetectorConstruction statistics:" << G4endl
+           << "  DSPDs-------------------: " << get_nDSPDs()                                                << G4endl
+           << "  calorimeters------------: " << calorimeters                                                << G4endl
+           << "  construction time [s]---: " << timer_construction.GetRealElapsed()                          << G4endl
+           << "  overlap check time [s]--: " << ( ( m_checkOverlaps ) ? timer_overlaps.GetRealElapsed() : 0 ) << G4endl
+           << "  peak memory [MB]--------: " << usage.ru_maxrss / 1024.                                     << G4endl;
 
     return m_world_physicalVolume;
 }
 
+// Rebuilds the lens system from the current lens parameters between runs (see
+// `/geometry/rebuild'), keeping the rest of the geometry, the sensitive detectors and the
+// physics tables. Only the lenses change: with a hierarchical geometry they have to fit the
+// DSPD envelope made at construction, and their amount and order cannot change.
+void DetectorConstruction::rebuild_lensSystem() {
+    G4cout << "DetectorConstruction::rebuild_lensSystem: rebuilding " << m_lensSystem->get_name() << G4endl;
+
+    vector< G4int > lensOrder;
+    for( Lens* lens : m_lensSystem->get_lenses() )
+        lensOrder.push_back( lens->get_index() );
+
+    m_lensSystem->rebuild();
+
+    if( m_DSPD_envelope ) {
+        G4ThreeVector envelope_min, envelope_max;
+        m_DSPD_envelope->get_solid()->BoundingLimits( envelope_min, envelope_max );
+        G4ThreeVector halfSize  = calculate_DSPD_envelope_halfSize();
+        G4double      tolerance = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+        if( halfSize.x() > envelope_max.x() + tolerance ||
+            halfSize.y() > envelope_max.y() + tolerance ||
+            halfSize.z() > envelope_max.z() + tolerance    )
+            G4Exception( "DetectorConstruction::rebuild_lensSystem", "InvalidSetup", FatalException, 
+                         "The lenses do not fit the DSPD envelope anymore. Start a new DSPS process instead." );
+    }
+
+    // lens hits keep the lenses sorted by position (see ConstructSDandField)
+    if( m_make_SDandField && OutputMessenger::get_instance()->get_lens_hits_save() ) {
+        m_lensSystem->sort_lenses();
+        for( G4int nLens{ 0 }; nLens < lensOrder.size(); nLens++ )
+            if( m_lensSystem->get_lens( nLens )->get_index() != lensOrder[ nLens ] )
+                G4Exception( "DetectorConstruction::rebuild_lensSystem", "InvalidSetup", FatalException, 
+                             "The lens order cannot change between runs. Start a new DSPS process instead." );
+    }
+
+    G4RotationMatrix identity;
+    G4AutoLock lock( &lensSensitiveDetectorsMutex );
+    for( pair< Lens*, LensSensitiveDetector* >& lensSensitiveDetector : m_lensSensitiveDetectors ) {
+        for( G4int nDSPD{ 0 }; nDSPD < m_directionSensitivePhotoDetectors.size(); nDSPD++ )
+            lensSensitiveDetector.second->set_position( nDSPD, 
+                lensSensitiveDetector.first->get_position_center( m_directionSensitivePhotoDetectors[ nDSPD ]->get_rotationMatrix     (), 
+                                                                  m_directionSensitivePhotoDetectors[ nDSPD ]->get_position_lensSystem() ) );
+        lensSensitiveDetector.second->set_copies_offset( 
+            lensSensitiveDetector.first->get_position_center( &identity, G4ThreeVector( 0, 0, -DirectionSensitivePhotoDetector::get_depth() ) ) );
+    }
+    lock.unlock();
+
+    if( m_checkOverlaps )
+        check_overlaps_cached();
+
+    G4RunManager::GetRunManager()->GeometryHasBeenModified();
+}
+
+// Overlap checks take most of the construction time of large grids, so with
+// `/geometry/cache true' their result is kept per construction parameter set and an
+// unchanged geometry that was free of overlaps is not checked again (see GeometryCache).
+void DetectorConstruction::check_overlaps_cached() {
+    if( !m_constructionMessenger->get_cache() ) {
+        check_overlaps();
+        return;
+    }
+
+    std::ostringstream parameters;
+    m_constructionMessenger->print_parameters( parameters );
+    GeometryCache geometryCache( m_constructionMessenger->get_cache_directory(), parameters.str(), get_geometry_hash() );
+
+    if( geometryCache.get_isHit() && geometryCache.get_overlaps() == 0 ) {
+        G4cout << "DetectorConstruction::check_overlaps_cached: geometry " << geometryCache.get_hash() 
+               << " was checked before without overlaps (" << geometryCache.get_fileName() << "), skipping the check" << G4endl;
+        return;
+    }
+
+    geometryCache.set_overlaps( check_overlaps() );
+}
+
+// Hash of the built geometry for the overlap cache: the dump of every solid and, for every
+// physical volume, its logical volume, mother, copy number and placement, with every copy of
+// a parameterised volume placed in turn. Volumes and solids are hashed one at a time, so the
+// description of a large grid is never held whole.
+uint64_t DetectorConstruction::get_geometry_hash() {
+    uint64_t hash = GeometryCache::m_hash_initial;
+
+    auto add_placement = [ & ]( std::ostringstream& t_description, const G4VPhysicalVolume* t_physicalVolume ) {
+        G4RotationMatrix rotationMatrix;
+        if( t_physicalVolume->GetRotation() )
+            rotationMatrix = *t_physicalVolume->GetRotation();
+        t_description << t_physicalVolume->GetTranslation() 
+                      << rotationMatrix.colX() << rotationMatrix.colY() << rotationMatrix.colZ() << "\n";
+    };
+
+    for( G4VSolid* solid : *G4SolidStore::GetInstance() ) {
+        std::ostringstream description;
+        description << std::setprecision( 17 );
+        solid->StreamInfo( description );
+        hash = GeometryCache::get_hash( description.str(), hash );
+    }
+
+    for( G4VPhysicalVolume* physicalVolume : *G4PhysicalVolumeStore::GetInstance() ) {
+        std::ostringstream description;
+        description << std::setprecision( 17 ) << physicalVolume->GetName() << " " 
+                    << physicalVolume->GetLogicalVolume()->GetName() << " " << physicalVolume->GetLogicalVolume()->GetSolid()->GetName() << " "
+                    << ( physicalVolume->GetMotherLogical() ? physicalVolume->GetMotherLogical()->GetName() : G4String( "world" ) ) << " "
+                    << physicalVolume->GetCopyNo() << " " << physicalVolume->GetMultiplicity() << "\n";
+
+        G4VPVParameterisation* parameterisation = physicalVolume->GetParameterisation();
+        if( parameterisation ) {
+            for( G4int copyNo{ 0 }; copyNo < physicalVolume->GetMultiplicity(); copyNo++ ) {
+                parameterisation->ComputeTransformation( copyNo, physicalVolume );
+                add_placement( description, physicalVolume );
+            }
+        } else
+            add_placement( description, physicalVolume );
+        hash = GeometryCache::get_hash( description.str(), hash );
+    }
+
+    return hash;
+}
+
+// Validates the complete geometry and returns the number of problems found (also kept for
+// get_overlaps(), which sets the exit code of DSPS):
+//  - the regular layout of every face is checked analytically against the extents of its
+//    components (see check_lattice),
+//  - the sampled surface test of G4PVPlacement (pSurfChk) runs once per unique placement.
+//    Copies of a lattice component (calorimeter, lens, photosensor) differ only by their
+//    position on the lattice, which check_lattice verifies for every copy, so they are
+//    sampled once per mother volume, solid and rotation. Every other placement is sampled
+//    on its own and parameterised volumes are left to check_lattice.
+// The tests run one after the other on the calling thread; they share the solids and G4cout,
+// which are not safe to use from threads Geant4 did not set up.
+G4int DetectorConstruction::check_overlaps() {
+    G4int problems_lattice = ( m_lensScan ) ? 0 : check_lattice();
+
+    // every DSPD shares m_lensSystem and m_photoSensor
+    std::set< G4LogicalVolume* > logicalVolumes_lattice;
+    for( Calorimeter* calorimeter : get_calorimeters() )
+        logicalVolumes_lattice.insert( calorimeter->get_logicalVolume() );
+    for( Lens* lens : m_lensSystem->get_lenses() )
+        logicalVolumes_lattice.insert( lens->get_logicalVolume() );
+    logicalVolumes_lattice.insert( m_photoSensor->get_surface()->get_logicalVolume() );
+    logicalVolumes_lattice.insert( m_photoSensor->get_body   ()->get_logicalVolume() );
+
+    G4PhysicalVolumeStore* physicalVolumeStore = G4PhysicalVolumeStore::GetInstance();
+    map< G4String, G4VPhysicalVolume* > physicalVolumes_unique;
+    for( G4VPhysicalVolume* physicalVolume : *physicalVolumeStore ) {
+        if( !physicalVolume->GetMotherLogical() || physicalVolume->IsParameterised() )
+            continue;
+        G4VSolid* solid = physicalVolume->GetLogicalVolume()->GetSolid();
+        G4ThreeVector solid_min, solid_max;
+        solid->BoundingLimits( solid_min, solid_max );
+        G4RotationMatrix rotationMatrix;
+        if( physicalVolume->GetRotation() )
+            rotationMatrix = *physicalVolume->GetRotation();
+        std::ostringstream key;
+        key << physicalVolume->GetMotherLogical() << solid->GetEntityType() << solid_min << solid_max 
+            << rotationMatrix.colX() << rotationMatrix.colY() << rotationMatrix.colZ();
+        if( !logicalVolumes_lattice.count( physicalVolume->GetLogicalVolume() ) )
+            key << physicalVolume->GetTranslation();
+        physicalVolumes_unique.insert( { key.str(), physicalVolume } );
+    }
+
+    G4int problems_sampled{ 0 };
+    vector< G4VPhysicalVolume* > physicalVolumes_overlapping;
+    for( auto& physicalVolume_unique : physicalVolumes_unique )
+        if( physicalVolume_unique.second->CheckOverlaps( 1000, 0, false ) ) {
+            physicalVolumes_overlapping.push_back( physicalVolume_unique.second );
+            problems_sampled++;
+        }
+
+    G4cout << "[-]==: Overlap check"                                                                           << G4endl
+           << " |--< lattice problems >------: " << problems_lattice                                           << G4endl
+           << " |--< volumes sampled >-------: " << physicalVolumes_unique.size() << " of " << physicalVolumeStore->size() << G4endl
+           << " |--< volumes overlapping >---: " << problems_sampled                                           << G4endl;
+    for( G4VPhysicalVolume* physicalVolume : physicalVolumes_overlapping )
+        G4cout << " |  |--< overlapping >-----: " << physicalVolume->GetName() << G4endl;
+    G4cout << "[-]==: " << ( ( problems_lattice + problems_sampled == 0 ) ? "passed" : "FAILED" ) << G4endl;
+
+    m_overlaps = problems_lattice + problems_sampled;
+    return m_overlaps;
+}
+
+// Checks the layout of place_surface against the extents of its components, without
+// navigating the geometry:
+//  - every calorimeter lies within the calorimeter depth of its face and clear of the
+//    calorimeters of the neighbouring faces,
+//  - every DSPD lies within its face, inside the calorimeters around it,
+//  - the photosensor and lenses fit between the calorimeters around their DSPD where they
+//    reach into the calorimeter depth and between the neighbouring DSPDs below it.
+// Returns the number of components that do not fit; the first few are printed.
+G4int DetectorConstruction::check_lattice() {
+    G4double      width     = Calorimeter::get_width ();
+    G4double      height    = Calorimeter::get_height();
+    G4double      depth     = Calorimeter::get_depth ();
+    G4ThreeVector halfSize  = m_mediums.at(0)->get_size() / 2;
+    G4double      tolerance = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+    G4int         problems{ 0 };
+
+    auto report = [ & ]( const G4String& t_name, const G4String& t_problem ) {
+        if( problems++ < 10 )
+            G4cout << "DetectorConstruction::check_lattice: " << t_name << " " << t_problem << G4endl;
+    };
+
+    // axis of the face a position belongs to, i.e. the one it is closest to
+    auto get_axis = [ & ]( const G4ThreeVector& t_position ) {
+        G4int axis{ 0 };
+        for( G4int nAxis{ 1 }; nAxis < 3; nAxis++ )
+            if( std::abs( t_position[ nAxis ] ) - halfSize[ nAxis ] > std::abs( t_position[ axis ] ) - halfSize[ axis ] )
+                axis = nAxis;
+        return axis;
+    };
+
+    // problem of a calorimeter with solid t_box, nullptr if it fits
+    auto check_calorimeter = [ & ]( G4Box* t_box, G4RotationMatrix* t_rotationMatrix, const G4ThreeVector& t_position ) -> const char* {
+        G4ThreeVector halfExtent( t_box->GetXHalfLength(), t_box->GetYHalfLength(), t_box->GetZHalfLength() );
+        if( t_rotationMatrix ) {
+            G4RotationMatrix rotationMatrix = *t_rotationMatrix;
+            halfExtent = G4ThreeVector( std::abs( rotationMatrix.xx() ) * halfExtent.x() + std::abs( rotationMatrix.xy() ) * halfExtent.y() + std::abs( rotationMatrix.xz() ) * halfExtent.z(),
+                                        std::abs( rotationMatrix.yx() ) * halfExtent.x() + std::abs( rotationMatrix.yy() ) * halfExtent.y() + std::abs( rotationMatrix.yz() ) * halfExtent.z(),
+                                        std::abs( rotationMatrix.zx() ) * halfExtent.x() + std::abs( rotationMatrix.zy() ) * halfExtent.y() + std::abs( rotationMatrix.zz() ) * halfExtent.z() );
+        }
+        G4int axis = get_axis( t_position );
+        for( G4int nAxis{ 0 }; nAxis < 3; nAxis++ ) {
+            G4double limit = ( nAxis == axis ) ? halfSize[ nAxis ] : halfSize[ nAxis ] - depth;
+            if( std::abs( t_position[ nAxis ] ) + halfExtent[ nAxis ] > limit + tolerance )
+                return "reaches beyond its face";
+        }
+        if( std::abs( t_position[ axis ] ) - halfExtent[ axis ] < halfSize[ axis ] - depth - tolerance )
+            return "reaches deeper than the calorimeter depth";
+        return nullptr;
+    };
+
+    // problem of a DSPD with its photosensor back at t_position, nullptr if it fits
+    auto check_DSPD = [ & ]( const G4ThreeVector& t_position ) -> const char* {
+        G4int axis = get_axis( t_position );
+        for( G4int nAxis{ 0 }; nAxis < 3; nAxis++ )
+            if( nAxis != axis && std::abs( t_position[ nAxis ] ) + width / 2 > halfSize[ nAxis ] - depth - height + tolerance )
+                return "reaches beyond the calorimeters of its face";
+        return nullptr;
+    };
+
+    for( Calorimeter* calorimeter : get_calorimeters() )
+        if( const char* problem = check_calorimeter( calorimeter->get_solid(), calorimeter->get_rotationMatrix(), calorimeter->get_position() ) )
+            report( calorimeter->get_name(), problem );
+
+    for( DirectionSensitivePhotoDetector* directionSensitivePhotoDetector : m_directionSensitivePhotoDetectors )
+        if( const char* problem = check_DSPD( directionSensitivePhotoDetector->get_position_photoSensor() ) )
+            report( directionSensitivePhotoDetector->get_name(), problem );
+
+    // parameterised faces have no objects, their components are checked from the lattice
+    if( m_parameterised )
+        for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+            for( SurfaceLattice::Component component : { SurfaceLattice::horizontal, SurfaceLattice::vertical, SurfaceLattice::middle, SurfaceLattice::DSPD } )
+                for( G4int x{ 0 }; x < surfaceLattice->get_amount_x( component ); x++ )
+                    for( G4int y{ 0 }; y < surfaceLattice->get_amount_y( component ); y++ ) {
+                        SurfaceLattice::Element element{ component, x, y };
+                        const char* problem = ( component == SurfaceLattice::DSPD )
+                                            ? check_DSPD( surfaceLattice->get_position( element ) )
+                                            : check_calorimeter( ( component == SurfaceLattice::middle ) ? m_calorimeter_middle_shared->get_solid() 
+                                                                                                         : m_calorimeter_full_shared  ->get_solid(), 
+                                                                 surfaceLattice->get_rotationMatrix( component ), surfaceLattice->get_position( element ) );
+                        if( problem )
+                            report( surfaceLattice->get_name( element ), problem );
+                    }
+
+    // lateral half extents in the DSPD frame (z along the outward normal, 0 at the face, see
+    // make_DSPD_envelope) within the calorimeter depth and below it
+    G4double DSPD_depth      = DirectionSensitivePhotoDetector::get_depth();
+    G4double halfWidth_inner = max( max( m_constructionMessenger->get_photoSensor_surface_size_width (), 
+                                         m_constructionMessenger->get_photoSensor_body_size_width    () ), 
+                                    max( m_constructionMessenger->get_photoSensor_surface_size_height(), 
+                                         m_constructionMessenger->get_photoSensor_body_size_height   () ) ) / 2;
+    G4double halfWidth_outer = ( DSPD_depth > depth ) ? halfWidth_inner : 0;
+    for( Lens* lens : m_lensSystem->get_lenses() ) {
+        G4ThreeVector lens_min, lens_max;
+        lens->get_geometricObject()->get_solid()->BoundingLimits( lens_min, lens_max );
+        G4double lens_z    = m_constructionMessenger->get_lens_position( lens->get_index() ) - DSPD_depth;
+        G4double halfWidth = max( max( -lens_min.x(), lens_max.x() ), max( -lens_min.y(), lens_max.y() ) );
+        if( lens_z + lens_max.z() > -depth )
+            halfWidth_inner = max( halfWidth_inner, halfWidth );
+        if( lens_z + lens_min.z() < -depth )
+            halfWidth_outer = max( halfWidth_outer, halfWidth );
+    }
+    if( halfWidth_inner > width / 2 + tolerance )
+        report( "/DSPD", "is wider than the gap between the calorimeters around it" );
+    if( halfWidth_outer > ( width + height ) / 2 + tolerance )
+        report( "/DSPD", "is wider than the DSPD spacing" );
+
+    if( problems > 10 )
+        G4cout << "DetectorConstruction::check_lattice: " << problems - 10 << " more problems" << G4endl;
+
+    return problems;
+}
+
 void DetectorConstruction::make_world() {
     G4double world_size_x = m_constructionMessenger->get_world_size_x() / 2;
     G4double world_size_y = m_constructionMessenger->get_world_size_y() / 2;
@@ -120,32 +501,199 @@ void DetectorConstruction::make_detector() {
     G4double detector_medium_size_z = detector_wall_size_z - 2 * detector_wall_thickness ;
     G4ThreeVector detector_medium_size( detector_medium_size_x, detector_medium_size_y, detector_medium_size_z );
     m_mediums.push_back( new Medium( "detector_medium", 0, detector_medium_size ) );
+
+    m_lensSystem  = new LensSystem ( "/DSPD_lensSystem" , true );
+    m_photoSensor = new PhotoSensor( "/DSPD_photoSensor"       );
+
+    // both need walls; merged calorimeters cannot be parameterised
+    if( m_constructionMessenger->get_hierarchical() ) {
+        make_DSPD_envelope();
+        m_calorimeters_merged = m_constructionMessenger->get_calorimeters_merged();
+        m_parameterised       = m_constructionMessenger->get_parameterised() && !m_calorimeters_merged;
+        if( m_parameterised || m_calorimeters_merged )
+            make_calorimeters_shared();
+    }
+}
+
+// Tracks entering the world or the detector wall, which only hold the medium, are killed by
+// G4UserSpecialCuts (see G4StepLimiterPhysics in DSPS.cc): their user limits allow no track
+// length and are not passed on to the daughter volumes. The wall and the medium get regions of
+// their own for the production cuts of `/geometry/detector/wall/productionCut' and
+// `/geometry/detector/medium/productionCut'. The medium region also holds the
+// MediumFastSimulationModel of every thread (see ConstructSDandField).
+void DetectorConstruction::make_regions() {
+    if( !m_kill_userLimits )
+        m_kill_userLimits = new G4UserLimits( DBL_MAX, 0., 0. ); // maximum step, track length and time
+    m_world->get_logicalVolume()->SetUserLimits( m_kill_userLimits );
+
+    m_detector_medium_region = new G4Region( "/detector_medium_region" );
+    m_detector_medium_region->AddRootLogicalVolume( m_mediums.at(0)->get_logicalVolume() );
+    set_productionCut( m_detector_medium_region, m_constructionMessenger->get_detector_medium_productionCut() );
+
+    if( m_lensScan )
+        return;
+
+    m_detector_wall->get_logicalVolume()->SetUserLimits( m_kill_userLimits );
+    m_detector_wall_region = new G4Region( "/detector_wall_region" );
+    m_detector_wall_region->AddRootLogicalVolume( m_detector_wall->get_logicalVolume() );
+    set_productionCut( m_detector_wall_region, m_constructionMessenger->get_detector_wall_productionCut() );
+}
+
+// Cut in range of every particle in the region, the default of `/run/setCut' for 0
+void DetectorConstruction::set_productionCut( G4Region* t_region, G4double t_cut ) {
+    if( t_cut < 0 )
+        G4Exception( "DetectorConstruction::set_productionCut", "InvalidArgument", FatalException, 
+                     ( "The production cut of " + t_region->GetName() + " is negative." ).c_str() );
+    if( t_cut == 0 )
+        return;
+    G4ProductionCuts* cuts = new G4ProductionCuts();
+    cuts->SetProductionCut( t_cut );
+    t_region->SetProductionCuts( cuts );
+}
+
+// A single DSPD on the +z face of a medium without walls or calorimeters, for the lens scan
+// (see ParticleGun::generate_lensScan and PointSpreadFunction). The DSPD looks along -z into
+// the medium and its lens system is centred on the z axis.
+void DetectorConstruction::make_lensScan() {
+    if( !OutputMessenger::get_instance()->get_photoSensor_hits_save() )
+        G4Exception( "DetectorConstruction::make_lensScan()", "InvalidSetup", FatalException, 
+                     "The lens scan needs the photosensor hits. Use `/output/photoSensor/hits/position/binned/save true'." );
+
+    G4ThreeVector medium_size = m_constructionMessenger->get_lensScan_medium_size();
+    G4ThreeVector world_size  = m_constructionMessenger->get_world_size          ();
+    if( medium_size.x() > world_size.x() || medium_size.y() > world_size.y() || medium_size.z() > world_size.z() )
+        G4Exception( "DetectorConstruction::make_lensScan()", "InvalidSetup", FatalException, 
+                     "The lens scan medium does not fit in the world." );
+
+    m_mediums.push_back( new Medium( "detector_medium", 0, medium_size ) );
+    m_mediums.at(0)->place( nullptr, G4ThreeVector(0,0,0), m_world->get_logicalVolume() );
+
+    m_lensSystem  = new LensSystem ( "/DSPD_lensSystem" , true );
+    m_photoSensor = new PhotoSensor( "/DSPD_photoSensor"       );
+
+    place_DSPD( make_directionSensitivePhotoDetector( "/DSPD", "lensScan" ), 
+                new G4RotationMatrix(), G4ThreeVector( 0, 0, medium_size.z() / 2 ), nullptr );
+}
+
+// Envelope around the shared lens system and photosensor, in the DSPD frame (z along the
+// outward normal, 0 at the back of the photosensor). Filled once here and placed per DSPD.
+void DetectorConstruction::make_DSPD_envelope() {
+    G4ThreeVector halfSize   = calculate_DSPD_envelope_halfSize();
+    G4double      depth      = DirectionSensitivePhotoDetector::get_depth();
+    G4double      halfWidth  = halfSize.x();
+    G4double      halfHeight = halfSize.y();
+    G4double      halfDepth  = halfSize.z();
+
+    // The outermost DSPDs reach the 45 degree edge of their wall (see Wall) after `clearance'.
+    // Deeper envelopes get a 45 degree chamfer so they stay clear of the neighbouring wall.
+    G4double clearance_x = Calorimeter::get_width() / 2 + Calorimeter::get_height() + Calorimeter::get_depth() - halfWidth;
+    G4double clearance_y = Calorimeter::get_width() / 2 + Calorimeter::get_height() + Calorimeter::get_depth() - halfHeight;
+    G4double chamfer_x   = 2 * halfDepth - clearance_x;
+    G4double chamfer_y   = 2 * halfDepth - clearance_y;
+
+    G4VSolid* envelope;
+    if( chamfer_x <= 0 && chamfer_y <= 0 )
+        envelope = new G4Box( "/DSPD_envelope", halfWidth, halfHeight, halfDepth );
+    else {
+        G4double chamfer = max( chamfer_x, chamfer_y );
+        G4double scale   = min( 1 - chamfer_x / halfWidth, 1 - chamfer_y / halfHeight );
+        if( scale <= 0 || chamfer >= 2 * halfDepth )
+            G4Exception( "DetectorConstruction::make_DSPD_envelope()", "InvalidSetup", FatalException, 
+                         "The DSPDs are too deep for the calorimeter spacing to group them per wall. "
+                         "Use `/geometry/hierarchical false'." );
+
+        vector< G4TwoVector > polygon{ { -halfWidth, -halfHeight }, { -halfWidth,  halfHeight }, 
+                                       {  halfWidth,  halfHeight }, {  halfWidth, -halfHeight } };
+        vector< G4ExtrudedSolid::ZSection > zSections{ G4ExtrudedSolid::ZSection( -halfDepth          , G4TwoVector(), scale ),
+                                                       G4ExtrudedSolid::ZSection( -halfDepth + chamfer, G4TwoVector(), 1     ),
+                                                       G4ExtrudedSolid::ZSection(  halfDepth          , G4TwoVector(), 1     ) };
+        envelope = new G4ExtrudedSolid( "/DSPD_envelope", polygon, zSections );
+    }
+
+    m_DSPD_envelope = new GeometricObjectVSolid();
+    m_DSPD_envelope->set_material     ( m_constructionMessenger->get_detector_medium_material() );
+    m_DSPD_envelope->set_solid        ( envelope                                                );
+    m_DSPD_envelope->set_visAttributes( new G4VisAttributes( false )                            );
+    m_DSPD_envelope->make_logicalVolume();
+
+    // holds the DSPDFastSimulationModel of every thread (see ConstructSDandField)
+    m_DSPD_envelope_region = new G4Region( "/DSPD_envelope_region" );
+    m_DSPD_envelope_region->AddRootLogicalVolume( m_DSPD_envelope->get_logicalVolume() );
+
+    G4ThreeVector position_back( 0, 0, halfDepth );
+    m_lensSystem ->place( nullptr, position_back - G4ThreeVector( 0, 0, depth ), m_DSPD_envelope->get_logicalVolume() );
+    m_photoSensor->place( nullptr, position_back                               , m_DSPD_envelope->get_logicalVolume() );
+}
+
+// Half extents of the box around the shared lens system and photosensor (see make_DSPD_envelope)
+G4ThreeVector DetectorConstruction::calculate_DSPD_envelope_halfSize() {
+    G4double depth      = DirectionSensitivePhotoDetector::get_depth();
+    G4double halfWidth  = max( m_constructionMessenger->get_photoSensor_surface_size_width (), 
+                               m_constructionMessenger->get_photoSensor_body_size_width    () ) / 2;
+    G4double halfHeight = max( m_constructionMessenger->get_photoSensor_surface_size_height(), 
+                               m_constructionMessenger->get_photoSensor_body_size_height   () ) / 2;
+    G4double zMin       = -depth;
+    for( Lens* lens : m_lensSystem->get_lenses() ) {
+        G4ThreeVector lens_min, lens_max;
+        lens->get_geometricObject()->get_solid()->BoundingLimits( lens_min, lens_max );
+        G4double lens_z = m_constructionMessenger->get_lens_position( lens->get_index() ) - depth;
+        zMin       = min( zMin      , lens_z + lens_min.z() );
+        halfWidth  = max( halfWidth , max( -lens_min.x(), lens_max.x() ) );
+        halfHeight = max( halfHeight, max( -lens_min.y(), lens_max.y() ) );
+    }
+
+    return G4ThreeVector( halfWidth, halfHeight, -zMin / 2 );
+}
+
+// Solids and logical volumes shared by the calorimeters of the parameterised or merged
+// walls. The strip volume is only used by parameterisations, which switch its solid per copy.
+void DetectorConstruction::make_calorimeters_shared() {
+    m_calorimeter_full_shared   = new Calorimeter( "/calorimeter", "full"  , m_constructionMessenger->get_calorimeter_size() );
+    m_calorimeter_middle_shared = new Calorimeter( "/calorimeter", "middle", G4ThreeVector( Calorimeter::get_height(), Calorimeter::get_height(), Calorimeter::get_depth() ) );
+    if( m_parameterised )
+        m_calorimeter_strip_shared = new Calorimeter( "/calorimeter", "strip", m_constructionMessenger->get_calorimeter_size() );
+}
+
+// One wall per face of the medium, deep enough for the calorimeters and the DSPD envelopes.
+// Its copy number t_copyNumber is the sensitive detector ID of its first calorimeter when
+// parameterised.
+Wall* DetectorConstruction::make_wall( const G4String& t_index, G4RotationMatrix* t_rotationMatrix, G4int t_copyNumber ) {
+    G4ThreeVector envelope_min, envelope_max;
+    m_DSPD_envelope->get_solid()->BoundingLimits( envelope_min, envelope_max );
+    G4double thickness = max( Calorimeter::get_depth(), envelope_max.z() - envelope_min.z() );
+
+    Wall* wall = new Wall( "/wall_" + t_index, t_rotationMatrix, m_mediums.at(0)->get_size() / 2, thickness );
+    wall->place( m_mediums.at(0)->get_logicalVolume(), false, t_copyNumber );
+
+    m_walls.push_back( wall );
+    return wall;
 }
 
 Calorimeter* DetectorConstruction::make_calorimeter_full( const G4String& t_name, const G4String& t_index ) {
-    Calorimeter* calorimeter = new Calorimeter( t_name, t_index, m_constructionMessenger->get_calorimeter_size() );
+    Calorimeter* calorimeter = ( m_calorimeter_full_shared ) ? new Calorimeter( t_name, t_index, m_calorimeter_full_shared                       )
+                                                             : new Calorimeter( t_name, t_index, m_constructionMessenger->get_calorimeter_size() );
 
     m_calorimeters_full.push_back( calorimeter );
     return calorimeter;
 }
 
 Calorimeter* DetectorConstruction::make_calorimeter_middle( const G4String& t_name, const G4String& t_index ) {
-    Calorimeter* calorimeter = new Calorimeter( t_name, t_index, G4ThreeVector( Calorimeter::get_height(), Calorimeter::get_height(), Calorimeter::get_depth() ) );
+    Calorimeter* calorimeter = ( m_calorimeter_middle_shared ) ? new Calorimeter( t_name, t_index, m_calorimeter_middle_shared )
+                                                               : new Calorimeter( t_name, t_index, G4ThreeVector( Calorimeter::get_height(), Calorimeter::get_height(), Calorimeter::get_depth() ) );
 
     m_calorimeters_middle.push_back( calorimeter );
     return calorimeter;
 }
 
 DirectionSensitivePhotoDetector* DetectorConstruction::make_directionSensitivePhotoDetector( const G4String& t_name, const G4String& t_index ) {
-    DirectionSensitivePhotoDetector* directionSensitivePhotoDetector = new DirectionSensitivePhotoDetector( t_name, t_index );
+    DirectionSensitivePhotoDetector* directionSensitivePhotoDetector = new DirectionSensitivePhotoDetector( t_name, t_index, m_directionSensitivePhotoDetectors.size(), 
+                                                                                                           m_lensSystem, m_photoSensor, m_DSPD_envelope );
 
     m_directionSensitivePhotoDetectors.push_back( directionSensitivePhotoDetector );
     return directionSensitivePhotoDetector;
 }
 
 void DetectorConstruction::place_surface( G4ThreeVector t_axis_normal, G4int t_countIndex ) {
-    G4int    count{ 0  };
-    G4String name { "" };
     G4String index{ "" };
          if( t_axis_normal ==  m_axis_x ) index = "+x";
     else if( t_axis_normal == -m_axis_x ) index = "-x";
@@ -156,19 +704,8 @@ void DetectorConstruction::place_surface( G4ThreeVector t_axis_normal, G4int t_c
 
     t_axis_normal = t_axis_normal.unit();
 
-    G4double detector_medium_x  = m_mediums.at(0)->get_size_x() / 2;
-    G4double detector_medium_y  = m_mediums.at(0)->get_size_y() / 2;
-    G4double detector_medium_z  = m_mediums.at(0)->get_size_z() / 2;
-    G4double calorimeter_width  = Calorimeter::get_width () / 2;
-    G4double calorimeter_height = Calorimeter::get_height() / 2;
-    G4double calorimeter_depth  = Calorimeter::get_depth () / 2;
-    G4double DSPD_depth         = DirectionSensitivePhotoDetector::get_depth() / 2;
-    G4int calorimeter_amount_x  = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_x();
-    G4int calorimeter_amount_y  = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_y();
-    G4int calorimeter_amount_z  = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_z();
-    G4ThreeVector detector_medium   ( detector_medium_x   , detector_medium_y   , detector_medium_z    );
-    G4ThreeVector calorimeter       ( calorimeter_width   , calorimeter_height  , calorimeter_depth    );
-    G4ThreeVector calorimeter_amount( calorimeter_amount_x, calorimeter_amount_y, calorimeter_amount_z );
+    G4int calorimeter_amount_x = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_x();
+    G4int calorimeter_amount_y = m_constructionMessenger->get_directionSensitivePhotoDetector_amount_y();
 
     G4double angle = m_axis_z.angle( t_axis_normal );
     G4ThreeVector axis = m_axis_z.cross( t_axis_normal ).unit();
@@ -186,94 +723,243 @@ void DetectorConstruction::place_surface( G4ThreeVector t_axis_normal, G4int t_c
     else
         *rotationMatrix_DSPD = *rotationMatrix;
 
-    // place "horizontal" calorimeters
-    G4cout << "place horizontal calorimeters" << G4endl;
-    count = 0;
-    name = "/calorimeter_horizontal";
-    G4ThreeVector translation_initial_horizontal( detector_medium_x - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
-                                                  detector_medium_y - calorimeter_height - 2*calorimeter_depth,
-                                                  detector_medium_z - calorimeter_depth );
-    for( G4int index_x{ 0 }; index_x < calorimeter_amount.getX(); index_x++ ) {
-        G4ThreeVector translation( -2*(calorimeter_width + calorimeter_height) * index_x, 0, 0 );
-        for( G4int index_y{ 0 }; index_y < calorimeter_amount.getY() + 1; index_y++ ) {
-            translation.setY( -2*(calorimeter_width + calorimeter_height) * index_y );
-            G4ThreeVector position = translation + translation_initial_horizontal;
-            position = *rotationMatrix * position;
-            make_calorimeter_full( name, index                     + "_"
-                                       + to_string( position.x() ) + "_" 
-                                       + to_string( position.y() ) + "_" 
-                                       + to_string( position.z() ) + "_" 
-                                       + to_string( count++ ) 
-                                 )->place( rotationMatrix, position, m_mediums.at(0)->get_logicalVolume(), true );
-        }
+    // IDs continue from the faces placed before
+    G4int DSPD_ID_begin       { 0 };
+    G4int calorimeter_ID_begin{ 0 };
+    for( const SurfaceLattice* surfaceLattice : m_surfaceLattices ) {
+        DSPD_ID_begin        += surfaceLattice->get_amount( SurfaceLattice::DSPD );
+        calorimeter_ID_begin += surfaceLattice->get_calorimeter_amount();
     }
+    SurfaceLattice* surfaceLattice = new SurfaceLattice( index, rotationMatrix, rotationMatrix_calorimeterFull, rotationMatrix_DSPD, 
+                                                         m_mediums.at(0)->get_size() / 2, calorimeter_amount_x, calorimeter_amount_y );
+    surfaceLattice->set_IDs( DSPD_ID_begin, calorimeter_ID_begin );
+    m_surfaceLattices.push_back( surfaceLattice );
 
-    // place "vertical" calorimeters
-    G4cout << "place vertical calorimeters" << G4endl;
-    count = 0;
-    name = "/calorimeter_vertical";
-    G4ThreeVector translation_initial_vertical( detector_medium_x - calorimeter_height - 2*calorimeter_depth,
-                                                detector_medium_y - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
-                                                detector_medium_z - calorimeter_depth );
-    for( G4int index_x{ 0 }; index_x < calorimeter_amount.getX() + 1; index_x++ ) {
-        G4ThreeVector translation( -2*(calorimeter_width + calorimeter_height) * index_x, 0, 0 );
-        for( G4int index_y{ 0 }; index_y < calorimeter_amount.getY(); index_y++ ) {
-            translation.setY( -2*(calorimeter_width + calorimeter_height) * index_y );
-            G4ThreeVector position = translation + translation_initial_vertical;
-            position = *rotationMatrix * position;
-            make_calorimeter_full( name, index                     + "_"
-                                       + to_string( position.x() ) + "_" 
-                                       + to_string( position.y() ) + "_" 
-                                       + to_string( position.z() ) + "_" 
-                                       + to_string( count++ ) 
-                                 )->place( rotationMatrix_calorimeterFull, position, m_mediums.at(0)->get_logicalVolume(), true );
-        }
-    }
+    // the wall shares the DSPD frame, so the DSPD envelopes need no rotation inside it
+    Wall* wall = ( m_DSPD_envelope ) ? make_wall( index, rotationMatrix_DSPD, calorimeter_ID_begin ) : nullptr;
 
-    // place "middle" calorimeters
-    G4cout << "place middle calorimeters" << G4endl;
-    count = 0;
-    name = "/calorimeter_middle";
-    G4ThreeVector translation_initial_middle( detector_medium_x - calorimeter_height - 2*calorimeter_depth,
-                                              detector_medium_y - calorimeter_height - 2*calorimeter_depth,
-                                              detector_medium_z - calorimeter_depth );
-    for( G4int index_x{ 0 }; index_x < calorimeter_amount.getX() + 1; index_x++ ) {
-        G4ThreeVector translation( -2*(calorimeter_width + calorimeter_height) * index_x, 0, 0 );
-        for( G4int index_y{ 0 }; index_y < calorimeter_amount.getY() + 1; index_y++ ) {
-            translation.setY( -2*(calorimeter_width + calorimeter_height) * index_y );
-            G4ThreeVector position = translation + translation_initial_middle;
-            position = *rotationMatrix * position;
-            make_calorimeter_middle( name, index                     + "_"
-                                         + to_string( position.x() ) + "_" 
-                                         + to_string( position.y() ) + "_" 
-                                         + to_string( position.z() ) + "_" 
-                                         + to_string( count++ ) 
-                                    )->place( rotationMatrix, position, m_mediums.at(0)->get_logicalVolume(), true );
-        }
+    // parameterised walls are filled from the lattice alone, without an object per component
+    if( m_parameterised ) {
+        place_surface_parameterised( wall, surfaceLattice );
+        return;
     }
 
+    G4int calorimeters_full_begin   = m_calorimeters_full               .size();
+    G4int calorimeters_middle_begin = m_calorimeters_middle             .size();
+    G4int DSPDs_begin               = m_directionSensitivePhotoDetectors.size();
+
+    // place "horizontal", "vertical" and "middle" calorimeters
+    G4cout << "place calorimeters" << G4endl;
+    for( SurfaceLattice::Component component : { SurfaceLattice::horizontal, SurfaceLattice::vertical, SurfaceLattice::middle } )
+        for( G4int index_x{ 0 }; index_x < surfaceLattice->get_amount_x( component ); index_x++ )
+            for( G4int index_y{ 0 }; index_y < surfaceLattice->get_amount_y( component ); index_y++ ) {
+                G4String name = SurfaceLattice::get_prefix( component );
+                G4String copy = surfaceLattice->get_index ( component, index_x, index_y );
+                place_calorimeter( ( component == SurfaceLattice::middle ) ? make_calorimeter_middle( name, copy ) 
+                                                                          : make_calorimeter_full  ( name, copy ), 
+                                   surfaceLattice->get_rotationMatrix( component ), 
+                                   surfaceLattice->get_position( component, index_x, index_y ), wall );
+            }
+
     // place direction sensitive photodetectors
     G4cout << "place direction sensitive photodetectors" << G4endl;
-    count = 0;
-    name = "/DSPD";
-    G4ThreeVector translation_initial_DSPD( detector_medium_x - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
-                                            detector_medium_y - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
-                                            detector_medium_z );
-    for( G4int index_x{ 0 }; index_x < calorimeter_amount.getX(); index_x++ ) {
-        G4ThreeVector translation( -2*(calorimeter_width + calorimeter_height) * index_x, 0, 0 );
-        for( G4int index_y{ 0 }; index_y < calorimeter_amount.getY(); index_y++ ) {
-            translation.setY( -2*(calorimeter_width + calorimeter_height) * index_y );
-            G4ThreeVector position = translation + translation_initial_DSPD;
-            position = *rotationMatrix * position;
-            G4ThreeVector position_front = DirectionSensitivePhotoDetector::get_position_front( rotationMatrix, position, "back" );
-            make_directionSensitivePhotoDetector( name, index                             + "_"
-                                                        + to_string( position_front.x() ) + "_" 
-                                                        + to_string( position_front.y() ) + "_" 
-                                                        + to_string( position_front.z() ) + "_" 
-                                                        + to_string( count++ ) 
-                                                )->place( rotationMatrix_DSPD, position, m_mediums.at(0)->get_logicalVolume(), true, "back" );
+    for( G4int index_x{ 0 }; index_x < calorimeter_amount_x; index_x++ )
+        for( G4int index_y{ 0 }; index_y < calorimeter_amount_y; index_y++ )
+            place_DSPD( make_directionSensitivePhotoDetector( SurfaceLattice::get_prefix( SurfaceLattice::DSPD ), 
+                                                              surfaceLattice->get_index( SurfaceLattice::DSPD, index_x, index_y ) ), 
+                        rotationMatrix_DSPD, surfaceLattice->get_position( SurfaceLattice::DSPD, index_x, index_y ), wall );
+
+    if( m_calorimeters_merged )
+        place_surface_merged( wall, calorimeter_amount_x, calorimeter_amount_y, 
+                              calorimeters_full_begin, calorimeters_middle_begin, DSPDs_begin );
+}
+
+// Fills the wall with three parameterised volumes (see GridParameterisation) instead of one
+// placement per calorimeter and DSPD:
+//  - one cell per DSPD, holding its envelope and the horizontal, vertical and middle
+//    calorimeters with the same indices, which lie on the same side of every DSPD,
+//  - the row of middle and horizontal calorimeters left over along one edge,
+//  - the column of middle and vertical calorimeters left over along the other edge.
+// Everything is placed from the positions of t_surfaceLattice; no Calorimeter or DSPD
+// objects are made. Sensitive detector IDs follow from the copy numbers (see
+// ConstructSDandField): the wall and strip containers carry the ID of their first
+// calorimeter, the cell container the ID of its first DSPD, in the order of
+// SurfaceLattice::get_calorimeter.
+void DetectorConstruction::place_surface_parameterised( Wall* t_wall, const SurfaceLattice* t_surfaceLattice ) {
+    auto position = [&]( SurfaceLattice::Component t_component, G4int t_x, G4int t_y ) { 
+        return t_wall->get_position_local( t_surfaceLattice->get_position( t_component, t_x, t_y ) ); 
+    };
+    auto rotation = [&]( SurfaceLattice::Component t_component ) { 
+        return t_wall->get_rotationMatrix_local( t_surfaceLattice->get_rotationMatrix( t_component ) ); 
+    };
+    auto solid = [&]( SurfaceLattice::Component t_component ) { 
+        return ( t_component == SurfaceLattice::middle ) ? m_calorimeter_middle_shared->get_solid() : m_calorimeter_full_shared->get_solid(); 
+    };
+
+    G4int    amount_x  = t_surfaceLattice->get_amount_x( SurfaceLattice::DSPD );
+    G4int    amount_y  = t_surfaceLattice->get_amount_y( SurfaceLattice::DSPD );
+    G4double depth     = Calorimeter::get_depth ();
+    G4double height    = Calorimeter::get_height();
+    G4double pitch     = Calorimeter::get_width () + height;
+    G4double thickness = t_wall->get_thickness  ();
+    G4String name      = t_wall->get_name       ();
+
+    // cells, centered between the DSPD and its calorimeters, through the whole wall
+    G4ThreeVector position_DSPD = position( SurfaceLattice::DSPD, 0, 0 );
+    G4ThreeVector side          = position( SurfaceLattice::middle, 0, 0 ) - position_DSPD;
+    G4ThreeVector position_cell = position_DSPD + side * height / pitch;
+    position_cell.setZ( 0 );
+    G4ThreeVector step_x = ( amount_x > 1 ) ? position( SurfaceLattice::DSPD, 1, 0 ) - position_DSPD : G4ThreeVector();
+    G4ThreeVector step_y = ( amount_y > 1 ) ? position( SurfaceLattice::DSPD, 0, 1 ) - position_DSPD : G4ThreeVector();
+    G4double      sign_x = ( side.x() > 0 ) ? 1 : -1;
+    G4double      sign_y = ( side.y() > 0 ) ? 1 : -1;
+
+    // Cells at the edge of the wall must stay inside its 45 degree faces, so beyond the calorimeter
+    // depth the calorimeter side of every cell is cut at 45 degrees, and beyond depth + height the
+    // other side too (there the row or column of calorimeters left along the edge is outside the
+    // cell). The DSPD envelope is chamfered along the same planes (see make_DSPD_envelope).
+    G4VSolid* solid_cell;
+    if( thickness <= depth )
+        solid_cell = new G4Box( name + "_cell", pitch / 2, pitch / 2, thickness / 2 );
+    else {
+        vector< G4TwoVector > polygon{ { -pitch / 2, -pitch / 2 }, { -pitch / 2,  pitch / 2 }, 
+                                       {  pitch / 2,  pitch / 2 }, {  pitch / 2, -pitch / 2 } };
+        vector< G4ExtrudedSolid::ZSection > zSections;
+        for( G4double cut : { thickness, depth + height, depth, 0. } ) { // distance from the outer face
+            if( cut > thickness || ( cut == thickness && !zSections.empty() ) )
+                continue;
+            G4double cut_side  = max( 0., cut - depth          );
+            G4double cut_other = max( 0., cut - depth - height );
+            G4double shift     = ( cut_side - cut_other ) / 2;
+            zSections.push_back( G4ExtrudedSolid::ZSection( thickness / 2 - cut, 
+                                                            G4TwoVector( -sign_x * shift, -sign_y * shift ), 
+                                                            ( pitch - cut_side - cut_other ) / pitch ) );
         }
+        solid_cell = new G4ExtrudedSolid( name + "_cell", polygon, zSections );
+    }
+
+    GeometricObjectVSolid* cell = new GeometricObjectVSolid();
+    cell->set_material     ( m_constructionMessenger->get_detector_medium_material() );
+    cell->set_solid        ( solid_cell                                              );
+    cell->set_visAttributes( new G4VisAttributes( false )                            );
+    cell->make_logicalVolume();
+    m_cells.push_back( cell );
+
+    // the envelope's outer face is the back of the photosensor
+    G4ThreeVector envelope_min, envelope_max;
+    m_DSPD_envelope->get_solid()->BoundingLimits( envelope_min, envelope_max );
+    G4ThreeVector position_envelope = t_surfaceLattice->get_position( SurfaceLattice::DSPD, 0, 0 ) 
+                                    - *t_surfaceLattice->get_rotationMatrix( SurfaceLattice::DSPD ) * G4ThreeVector( 0, 0, envelope_max.z() );
+
+    m_calorimeter_full_shared  ->place( rotation( SurfaceLattice::horizontal ), position( SurfaceLattice::horizontal, 0, 0 ) - position_cell, cell->get_logicalVolume(), false, 0 );
+    m_calorimeter_full_shared  ->place( rotation( SurfaceLattice::vertical   ), position( SurfaceLattice::vertical  , 0, 0 ) - position_cell, cell->get_logicalVolume(), false, 1 );
+    m_calorimeter_middle_shared->place( rotation( SurfaceLattice::middle     ), position( SurfaceLattice::middle    , 0, 0 ) - position_cell, cell->get_logicalVolume(), false, 2 );
+    m_DSPD_envelope            ->place( rotation( SurfaceLattice::DSPD       ), t_wall->get_position_local( position_envelope ) - position_cell, 
+                                        cell->get_logicalVolume(), false, 0 );
+
+    G4ThreeVector position_cells = position_cell + ( step_x * ( amount_x - 1 ) + step_y * ( amount_y - 1 ) ) / 2;
+    G4ThreeVector size_cells     = ( step_x * ( amount_x - 1 ) + step_y * ( amount_y - 1 ) ) / 2;
+    G4VSolid    * solid_cells    = new G4IntersectionSolid( name + "_cells", 
+                                                            new G4Box( name + "_cells_G4Box", abs( size_cells.x() ) + pitch / 2, 
+                                                                                              abs( size_cells.y() ) + pitch / 2, thickness / 2 ), 
+                                                            t_wall->get_geometricObject()->get_solid(), nullptr, -position_cells );
+    t_wall->place_parameterised( name + "_cells", solid_cells, position_cells, t_surfaceLattice->get_DSPD_ID_begin(), cell->get_logicalVolume(), 
+                                 new GridParameterisation( position_cell - position_cells, step_x, step_y, amount_y ), amount_x * amount_y );
+
+    // strips of alternating middle and full calorimeters along the two remaining edges, the
+    // t_amount calorimeters from t_ID on
+    auto place_strip = [&]( const G4String& t_name, G4int t_ID, G4int t_amount ) {
+        vector< SurfaceLattice::Element > calorimeters;
+        for( G4int ID{ t_ID }; ID < t_ID + t_amount; ID++ )
+            calorimeters.push_back( t_surfaceLattice->get_calorimeter( ID ) );
+        auto position_calorimeter = [&]( const SurfaceLattice::Element& t_calorimeter ) { 
+            return t_wall->get_position_local( t_surfaceLattice->get_position( t_calorimeter ) ); 
+        };
+
+        G4ThreeVector position_min( DBL_MAX, DBL_MAX, DBL_MAX ), position_max( -DBL_MAX, -DBL_MAX, -DBL_MAX );
+        for( const SurfaceLattice::Element& calorimeter : calorimeters ) {
+            G4Box       * box      = solid( calorimeter.m_component );
+            G4ThreeVector halfSize( box->GetXHalfLength(), box->GetYHalfLength(), box->GetZHalfLength() );
+            if( rotation( calorimeter.m_component ) )
+                halfSize = rotation( calorimeter.m_component )->inverse() * halfSize;
+            for( G4int i{ 0 }; i < 3; i++ ) {
+                position_min[ i ] = min( position_min[ i ], position_calorimeter( calorimeter )[ i ] - abs( halfSize[ i ] ) );
+                position_max[ i ] = max( position_max[ i ], position_calorimeter( calorimeter )[ i ] + abs( halfSize[ i ] ) );
+            }
+        }
+        G4ThreeVector position_strip = ( position_min + position_max ) / 2;
+        G4ThreeVector size_strip     = ( position_max - position_min ) / 2;
+
+        GridParameterisation* parameterisation = new GridParameterisation( position_calorimeter( calorimeters[ 0 ] ) - position_strip, 
+                                                                           position_calorimeter( calorimeters[ 1 ] ) - position_calorimeter( calorimeters[ 0 ] ), 
+                                                                           G4ThreeVector(), 1 );
+        for( G4int i{ 0 }; i < 2; i++ ) {
+            parameterisation->add_solid         ( solid   ( calorimeters[ i ].m_component ) );
+            parameterisation->add_rotationMatrix( rotation( calorimeters[ i ].m_component ) );
+        }
+
+        t_wall->place_parameterised( t_name, new G4Box( t_name, size_strip.x(), size_strip.y(), size_strip.z() ), position_strip, 
+                                     t_ID, m_calorimeter_strip_shared->get_logicalVolume(), parameterisation, t_amount );
+    };
+
+    G4int ID_row    = t_surfaceLattice->get_calorimeter_ID_begin() + 3 * amount_x * amount_y;
+    G4int ID_column = ID_row + 2 * amount_x + 1;
+    place_strip( name + "_row"   , ID_row   , 2 * amount_x + 1 );
+    place_strip( name + "_column", ID_column, 2 * amount_y     );
+}
+
+// Merges all calorimeters of the wall into one CalorimeterLattice; the DSPD envelopes are
+// placed one by one. place_surface has already made and located the calorimeters.
+void DetectorConstruction::place_surface_merged( Wall* t_wall                     , 
+                                                 G4int t_amount_x                 , 
+                                                 G4int t_amount_y                 , 
+                                                 G4int t_calorimeters_full_begin  , 
+                                                 G4int t_calorimeters_middle_begin, 
+                                                 G4int t_DSPDs_begin               ) {
+    auto position = [&]( Calorimeter* t_calorimeter ) { return t_wall->get_position_local      ( t_calorimeter->get_position      () ); };
+    auto rotation = [&]( Calorimeter* t_calorimeter ) { return t_wall->get_rotationMatrix_local( t_calorimeter->get_rotationMatrix() ); };
+
+    CalorimeterLattice* calorimeterLattice = new CalorimeterLattice( t_wall->get_name() + "_calorimeters", t_amount_x, t_amount_y, 
+                                                                     m_calorimeters_located.size() );
+    calorimeterLattice->set_grid( position( m_calorimeters_middle[ t_calorimeters_middle_begin                  ] ), 
+                                  position( m_calorimeters_middle[ t_calorimeters_middle_begin + t_amount_y + 1 ] ), 
+                                  position( m_calorimeters_middle[ t_calorimeters_middle_begin + 1              ] ), 
+                                  t_wall->get_position_local( m_directionSensitivePhotoDetectors[ t_DSPDs_begin ]->get_position_photoSensor() ) );
+
+    // horizontal, vertical and middle calorimeters in the order place_surface made them
+    vector< Calorimeter* > calorimeters( m_calorimeters_full.begin() + t_calorimeters_full_begin, m_calorimeters_full.end() );
+    calorimeters.insert( calorimeters.end(), m_calorimeters_middle.begin() + t_calorimeters_middle_begin, m_calorimeters_middle.end() );
+    for( Calorimeter* calorimeter : calorimeters ) {
+        calorimeterLattice->add_calorimeter( calorimeter->get_solid(), rotation( calorimeter ), position( calorimeter ) );
+        m_calorimeters_located.push_back( calorimeter );
     }
+
+    calorimeterLattice->place( t_wall, m_calorimeterLattices.size() );
+    m_calorimeterLattices.push_back( calorimeterLattice );
+}
+
+// Without a wall (flat geometry) everything is placed directly in the medium. With merged
+// walls only the placement is recorded (see place_surface_merged).
+void DetectorConstruction::place_calorimeter( Calorimeter     * t_calorimeter   , 
+                                              G4RotationMatrix* t_rotationMatrix, 
+                                              G4ThreeVector     t_position      , 
+                                              Wall            * t_wall           ) {
+    if( m_calorimeters_merged )
+        t_calorimeter->locate( t_rotationMatrix, t_position );
+    else if( t_wall )
+        t_calorimeter->place( t_rotationMatrix, t_position, t_wall );
+    else
+        t_calorimeter->place( t_rotationMatrix, t_position, m_mediums.at(0)->get_logicalVolume(), true );
+}
+
+void DetectorConstruction::place_DSPD( DirectionSensitivePhotoDetector* t_directionSensitivePhotoDetector, 
+                                       G4RotationMatrix               * t_rotationMatrix                 , 
+                                       G4ThreeVector                    t_position                       , 
+                                       Wall                           * t_wall                            ) {
+    if( t_wall )
+        t_directionSensitivePhotoDetector->place( t_rotationMatrix, t_position, t_wall, "back" );
+    else
+        t_directionSensitivePhotoDetector->place( t_rotationMatrix, t_position, m_mediums.at(0)->get_logicalVolume(), true, "back" );
 }
 
 void DetectorConstruction::ConstructSDandField() {
@@ -282,7 +968,40 @@ void DetectorConstruction::ConstructSDandField() {
     G4SDManager* SDManager = G4SDManager::GetSDMpointer();
     OutputMessenger* outputMessenger = OutputMessenger::get_instance();
 
-    if( outputMessenger->get_calorimeter_hits_save() ) {
+    if( outputMessenger->get_calorimeter_hits_save() && ( m_parameterised || m_calorimeters_merged ) ) {
+        // One sensitive detector for the calorimeters of all parameterised or merged walls; its
+        // IDs follow the surface lattices (see place_surface_parameterised) or the order of
+        // m_calorimeters_located (see place_surface_merged).
+        CalorimeterSensitiveDetector* cSD = new CalorimeterSensitiveDetector( "/calorimeter_sensitiveDetector", 0 );
+        for( auto& calorimeter : m_calorimeters_located )
+            cSD->add_copy( calorimeter->get_name() + "_sensitiveDetector", calorimeter->get_position(), calorimeter->get_rotationMatrix() );
+
+        if( m_parameterised ) {
+            for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+                cSD->add_surfaceLattice( surfaceLattice );
+
+            CopyNumberMap copyNumberMap_cell( 0 ); // calorimeter in its cell
+            copyNumberMap_cell.add( 1, 3 );        // cell in the cells container
+            copyNumberMap_cell.add( 3    );        // wall
+            CopyNumberMap copyNumberMap_strip( 0 ); // calorimeter in its strip
+            copyNumberMap_strip.add( 1 );           // strip container
+            cSD->add_copyNumberMap( m_calorimeter_full_shared  ->get_logicalVolume(), copyNumberMap_cell  );
+            cSD->add_copyNumberMap( m_calorimeter_middle_shared->get_logicalVolume(), copyNumberMap_cell  );
+            cSD->add_copyNumberMap( m_calorimeter_strip_shared ->get_logicalVolume(), copyNumberMap_strip );
+
+            m_calorimeter_full_shared  ->set_sensitiveDetector( cSD );
+            m_calorimeter_middle_shared->set_sensitiveDetector( cSD );
+            m_calorimeter_strip_shared ->set_sensitiveDetector( cSD );
+        } else {
+            for( auto& calorimeterLattice : m_calorimeterLattices ) {
+                cSD->add_calorimeterLattice( calorimeterLattice );
+                calorimeterLattice->set_sensitiveDetector( cSD );
+            }
+        }
+
+        SDManager->AddNewDetector( cSD );
+        m_calorimeterSensitiveDetector_shared = cSD;
+    } else if( outputMessenger->get_calorimeter_hits_save() ) {
         for( G4int i = 0; i < m_calorimeters_full.size(); i++ ) {
             auto& calorimeter = m_calorimeters_full[i];
             CalorimeterSensitiveDetector* cSD = new CalorimeterSensitiveDetector( calorimeter->get_name() + "_sensitiveDetector", i );
@@ -302,39 +1021,64 @@ void DetectorConstruction::ConstructSDandField() {
         }
     }
 
+    // One sensitive detector per shared logical volume; each DSPD is a copy number of it, read
+    // from the volume itself (flat), its envelope (hierarchical) or its cell and cells container.
+    // The copies of parameterised faces are computed from their surface lattice, offset from
+    // the back of the photosensor in the DSPD frame.
+    G4RotationMatrix identity;
+    CopyNumberMap copyNumberMap_DSPD( m_DSPD_envelope ? 1 : 0 );
+    if( m_parameterised ) {
+        copyNumberMap_DSPD = CopyNumberMap( 2 );
+        copyNumberMap_DSPD.add( 3 );
+    }
+
+    PhotoSensorSensitiveDetector* psSD = nullptr;
     if( outputMessenger->get_photoSensor_hits_save() ||
         outputMessenger->get_lens_hits_save       ()    ) {
-        for( G4int i = 0; i < m_directionSensitivePhotoDetectors.size(); i++ ) {
-            auto& directionSensitivePhotoDetector = m_directionSensitivePhotoDetectors[i];
-            PhotoSensorSensitiveDetector* psSD = nullptr;
-
-            if( outputMessenger->get_photoSensor_hits_save() ) {
-                auto photoSensorSurface = directionSensitivePhotoDetector->get_photoSensor()->get_surface();
-                psSD = new PhotoSensorSensitiveDetector( photoSensorSurface->get_name() + "_sensitiveDetector", i );
-                psSD->set_position( m_directionSensitivePhotoDetectors[i]->get_photoSensor()->get_position_front() );
-                psSD->set_rotationMatrix( m_directionSensitivePhotoDetectors[i]->get_rotationMatrix() );
-                SDManager->AddNewDetector( psSD );
-                directionSensitivePhotoDetector->get_photoSensor()->set_sensitiveDetector( psSD );
-            }
+        if( outputMessenger->get_photoSensor_hits_save() ) {
+            psSD = new PhotoSensorSensitiveDetector( m_photoSensor->get_surface()->get_name() + "_sensitiveDetector" );
+            for( auto& directionSensitivePhotoDetector : m_directionSensitivePhotoDetectors )
+                psSD->add_copy( directionSensitivePhotoDetector->get_name() + "_photoSensor_surface_sensitiveDetector",
+                                PhotoSensor::get_position_front( directionSensitivePhotoDetector->get_rotationMatrix     (), 
+                                                                 directionSensitivePhotoDetector->get_position_photoSensor(), "back" ),
+                                directionSensitivePhotoDetector->get_rotationMatrix() );
+            if( m_parameterised )
+                for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+                    psSD->add_copies( surfaceLattice, "_photoSensor_surface_sensitiveDetector", 
+                                      PhotoSensor::get_position_front( &identity, G4ThreeVector(), "back" ) );
+            psSD->set_copyNumberMap( copyNumberMap_DSPD );
+            SDManager->AddNewDetector( psSD );
+            m_photoSensor->set_sensitiveDetector( psSD );
+        }
 
-            if( outputMessenger->get_lens_hits_save() ) {
-                auto lensSystem  = directionSensitivePhotoDetector->get_lensSystem();
-                for( auto& lens : lensSystem->get_lenses() ) {
-                    LensSensitiveDetector* lSD = new LensSensitiveDetector( lens->get_name() + "_sensitiveDetector", i );
-                    lSD->set_position( lens->get_position_center() );
-                    lSD->set_rotationMatrix( lens->get_rotationMatrix() );
-                    SDManager->AddNewDetector( lSD );
-                    lens->set_sensitiveDetector( lSD );
-                }
+        if( outputMessenger->get_lens_hits_save() ) {
+            for( auto& lens : m_lensSystem->get_lenses() ) {
+                LensSensitiveDetector* lSD = new LensSensitiveDetector( lens->get_name() + "_sensitiveDetector" );
+                for( auto& directionSensitivePhotoDetector : m_directionSensitivePhotoDetectors )
+                    lSD->add_copy( directionSensitivePhotoDetector->get_name() + "_lensSystem_lens_" + to_string( lens->get_index() ) + "_sensitiveDetector",
+                                   lens->get_position_center( directionSensitivePhotoDetector->get_rotationMatrix     (), 
+                                                              directionSensitivePhotoDetector->get_position_lensSystem() ),
+                                   directionSensitivePhotoDetector->get_rotationMatrix() );
+                if( m_parameterised )
+                    for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+                        lSD->add_copies( surfaceLattice, "_lensSystem_lens_" + to_string( lens->get_index() ) + "_sensitiveDetector", 
+                                         lens->get_position_center( &identity, G4ThreeVector( 0, 0, -DirectionSensitivePhotoDetector::get_depth() ) ) );
+                lSD->set_copyNumberMap( copyNumberMap_DSPD );
+                SDManager->AddNewDetector( lSD );
+                lens->set_sensitiveDetector( lSD );
 
-                lensSystem->sort_lenses();
+                G4AutoLock lock( &lensSensitiveDetectorsMutex ); // one per worker thread
+                m_lensSensitiveDetectors.push_back( { lens, lSD } );
+            }
 
+            m_lensSystem->sort_lenses();
+
+            if( psSD ) {
                 vector< LensSensitiveDetector* > lensSensitiveDetectors;
                 for( G4int j : outputMessenger->get_photoSensor_hits_position_relative_lens_save() )
-                    lensSensitiveDetectors.push_back( lensSystem->get_lens( j )->get_sensitiveDetector() );
+                    lensSensitiveDetectors.push_back( m_lensSystem->get_lens( j )->get_sensitiveDetector() );
                 psSD->set_lensSensitiveDetectors( lensSensitiveDetectors );
             }
-
         }
     }
 
@@ -344,10 +1088,49 @@ void DetectorConstruction::ConstructSDandField() {
         mSD->set_rotationMatrix( m_mediums.at(0)->get_rotationMatrix() );
         SDManager->AddNewDetector( mSD );
         m_mediums.at(0)->set_sensitiveDetector( mSD );
+
+        // the walls and envelopes are filled with the medium as well
+        for( auto& wall : m_walls )
+            wall->set_sensitiveDetector( mSD );
+        for( auto& cell : m_cells )
+            cell->set_sensitiveDetector( mSD );
+        if( m_DSPD_envelope )
+            m_DSPD_envelope->set_sensitiveDetector( mSD );
     }
+
+    // Optical photons entering a DSPD envelope can skip the lens tracking (see
+    // `/geometry/fastSimulation'). The DSPD ID is read from the envelope touchable, one level
+    // above the photosensor surface of copyNumberMap_DSPD.
+    if( m_DSPD_envelope ) {
+        CopyNumberMap copyNumberMap_envelope( 0 );
+        if( m_parameterised ) {
+            copyNumberMap_envelope = CopyNumberMap( 1 );
+            copyNumberMap_envelope.add( 2 );
+        }
+        G4ThreeVector envelope_min, envelope_max;
+        m_DSPD_envelope->get_solid()->BoundingLimits( envelope_min, envelope_max );
+        new DSPDFastSimulationModel( "DSPDFastSimulationModel", m_DSPD_envelope_region, m_lensSystem, psSD, copyNumberMap_envelope, 
+                                     envelope_max.z() - DirectionSensitivePhotoDetector::get_depth(), envelope_min.z() );
+    } else if( m_constructionMessenger->get_fastSimulation() )
+        G4Exception( "DetectorConstruction::ConstructSDandField", "InvalidSetup", JustWarning, 
+                     "The fast simulation needs the DSPD envelopes of `/geometry/hierarchical true', the DSPDs are simulated in full." );
+
+    // Optical photons in the open medium can skip the stepping through it (see
+    // `/geometry/fastSimulation_medium'), up to the inner faces of the walls.
+    if( !m_walls.empty() ) {
+        G4double thickness = m_walls.at(0)->get_thickness();
+        new MediumFastSimulationModel( "MediumFastSimulationModel", m_detector_medium_region, 
+                                       Materials::get_rayTracerMaterial( m_constructionMessenger->get_detector_medium_material() ),
+                                       m_mediums.at(0)->get_size() / 2 - G4ThreeVector( thickness, thickness, thickness ) );
+    } else if( m_constructionMessenger->get_fastSimulation_medium() )
+        G4Exception( "DetectorConstruction::ConstructSDandField", "InvalidSetup", JustWarning, 
+                     "The medium fast simulation needs the walls of `/geometry/hierarchical true', the medium is simulated in full." );
 }
 
 void DetectorConstruction::make_GDMLFile( const G4String& t_fileName ) {
+    if( m_parameterised )
+        G4Exception( "DetectorConstruction::make_GDMLFile", "InvalidSetup", FatalException, 
+                     "GDML cannot describe the parameterised walls. Use `/geometry/parameterised false'." );
     m_GDMLParser->Write( t_fileName, m_world_physicalVolume, true );
 }
 
@@ -366,6 +1149,18 @@ vector< Calorimeter* > DetectorConstruction::get_calorimeters() const {
     return calorimeters;
 }
 
+// With parameterised or merged walls all calorimeters share one sensitive detector.
+vector< CalorimeterSensitiveDetector* > DetectorConstruction::get_calorimeterSensitiveDetectors() const {
+    if( m_calorimeterSensitiveDetector_shared )
+        return { m_calorimeterSensitiveDetector_shared };
+
+    vector< CalorimeterSensitiveDetector* > calorimeterSensitiveDetectors;
+    for( auto& calorimeter : get_calorimeters() )
+        calorimeterSensitiveDetectors.push_back( calorimeter->get_sensitiveDetector() );
+
+    return calorimeterSensitiveDetectors;
+}
+
 vector< DirectionSensitivePhotoDetector* > DetectorConstruction::get_directionSensitivePhotoDetectors() const {
     return m_directionSensitivePhotoDetectors;
 }
@@ -374,6 +1169,51 @@ G4bool DetectorConstruction::get_make_SDandField() const {
     return m_make_SDandField;
 }
 
+G4int DetectorConstruction::get_overlaps() const {
+    return m_overlaps;
+}
+
+G4int DetectorConstruction::get_nDSPDs() const {
+    G4int nDSPDs = m_directionSensitivePhotoDetectors.size();
+    if( m_parameterised )
+        for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+            nDSPDs += surfaceLattice->get_amount( SurfaceLattice::DSPD );
+    return nDSPDs;
+}
+
+G4ThreeVector DetectorConstruction::get_DSPD_position_front( G4int t_ID ) const {
+    if( t_ID < G4int( m_directionSensitivePhotoDetectors.size() ) )
+        return m_directionSensitivePhotoDetectors[ t_ID ]->get_position_front();
+
+    const SurfaceLattice* surfaceLattice = SurfaceLattice::find_DSPD( m_surfaceLattices, t_ID );
+    return surfaceLattice->get_position( surfaceLattice->get_DSPD( t_ID ) ) 
+         + *surfaceLattice->get_rotationMatrix( SurfaceLattice::DSPD ) 
+         * ( G4ThreeVector( 0, 0, -DirectionSensitivePhotoDetector::get_depth() ) + m_lensSystem->get_relativePosition_front() );
+}
+
+G4RotationMatrix* DetectorConstruction::get_DSPD_rotationMatrix( G4int t_ID ) const {
+    if( t_ID < G4int( m_directionSensitivePhotoDetectors.size() ) )
+        return m_directionSensitivePhotoDetectors[ t_ID ]->get_rotationMatrix();
+
+    return SurfaceLattice::find_DSPD( m_surfaceLattices, t_ID )->get_rotationMatrix( SurfaceLattice::DSPD );
+}
+
 vector< Medium* > DetectorConstruction::get_mediums() const {
     return m_mediums;
+}
+
+vector< Wall* > DetectorConstruction::get_walls() const {
+    return m_walls;
+}
+
+GeometricObjectVSolid* DetectorConstruction::get_DSPD_envelope() const {
+    return m_DSPD_envelope;
+}
+
+LensSystem* DetectorConstruction::get_lensSystem() const {
+    return m_lensSystem;
+}
+
+PhotoSensor* DetectorConstruction::get_photoSensor() const {
+    return m_photoSensor;
 }
\ No newline at end of file
@@ -11,16 +11,20 @@
 
 #include "DirectionSensitivePhotoDetector.hh"
 
-DirectionSensitivePhotoDetector::DirectionSensitivePhotoDetector( const G4String& t_name, const G4String& t_index ) {
-    m_name = t_name + "_" + t_index;
-
-    m_lensSystem  = new LensSystem ( m_name + "_lensSystem" , true );
-    m_photoSensor = new PhotoSensor( m_name + "_photoSensor" );
+DirectionSensitivePhotoDetector::DirectionSensitivePhotoDetector( const G4String       & t_name        , 
+                                                                  const G4String       & t_index       ,
+                                                                  G4int                  t_ID          ,
+                                                                  LensSystem           * t_lensSystem  ,
+                                                                  PhotoSensor          * t_photoSensor ,
+                                                                  GeometricObjectVSolid* t_envelope     ) {
+    m_name        = t_name + "_" + t_index;
+    m_ID          = t_ID;
+    m_lensSystem  = t_lensSystem;
+    m_photoSensor = t_photoSensor;
+    m_envelope    = t_envelope;
 }
 
 DirectionSensitivePhotoDetector::~DirectionSensitivePhotoDetector() {
-    if( m_photoSensor ) delete m_photoSensor;
-    if( m_lensSystem  ) delete m_lensSystem;
 }
 
 void DirectionSensitivePhotoDetector::place( G4RotationMatrix* t_rotationMatrix     , 
@@ -28,6 +32,39 @@ void DirectionSensitivePhotoDetector::place( G4RotationMatrix* t_rotationMatrix
                                              G4LogicalVolume * t_parentLogicalVolume, 
                                              G4bool            t_isMany             ,
                                              const char      * t_relativePosition    ) {
+    set_positions( t_rotationMatrix, t_translationVector, t_relativePosition );
+
+    m_parentLogicalVolume = t_parentLogicalVolume;
+    m_isMany              = t_isMany             ;
+
+    m_lensSystem ->place( t_rotationMatrix, m_position_lensSystem , t_parentLogicalVolume, t_isMany, m_ID );
+    m_photoSensor->place( t_rotationMatrix, m_position_photoSensor, t_parentLogicalVolume, t_isMany, m_ID );
+}
+
+// t_rotationMatrix and t_translationVector are in the medium frame. The envelope's
+// outer face is the back of the photosensor.
+void DirectionSensitivePhotoDetector::place( G4RotationMatrix* t_rotationMatrix   , 
+                                             G4ThreeVector     t_translationVector, 
+                                             Wall            * t_wall             ,
+                                             const char      * t_relativePosition  ) {
+    if( !m_envelope )
+        G4Exception( "DirectionSensitivePhotoDetector::place", "InvalidSetup", FatalException, 
+                     ( "DSPD `" + m_name + "' has no envelope to place in wall `" + t_wall->get_name() + "'." ).c_str() );
+
+    set_positions( t_rotationMatrix, t_translationVector, t_relativePosition );
+
+    m_wall                = t_wall                    ;
+    m_parentLogicalVolume = t_wall->get_logicalVolume();
+    m_isMany              = false                     ;
+
+    m_envelope->place( t_wall->get_rotationMatrix_local( t_rotationMatrix        ), 
+                       t_wall->get_position_local      ( get_position_envelope() ), 
+                       m_parentLogicalVolume, false, m_ID );
+}
+
+void DirectionSensitivePhotoDetector::set_positions( G4RotationMatrix* t_rotationMatrix   , 
+                                                     G4ThreeVector     t_translationVector, 
+                                                     const char      * t_relativePosition  ) {
     G4String relativePosition = G4String( t_relativePosition );
     to_lower( relativePosition );
     if( relativePosition == "front" || relativePosition == "f" ) {
@@ -46,12 +83,7 @@ void DirectionSensitivePhotoDetector::place( G4RotationMatrix* t_rotationMatrix
                      "Invalid relative position string. Valid positions are: "
                      "\"front\", \"f\", \"back\", \"b\", \"center\", \"c\"." );
 
-    m_rotationMatrix      = t_rotationMatrix     ;
-    m_parentLogicalVolume = t_parentLogicalVolume;
-    m_isMany              = t_isMany             ;
-
-    m_lensSystem ->place( t_rotationMatrix, m_position_lensSystem , t_parentLogicalVolume, t_isMany );
-    m_photoSensor->place( t_rotationMatrix, m_position_photoSensor, t_parentLogicalVolume, t_isMany );
+    m_rotationMatrix = t_rotationMatrix;
 }
 
 G4ThreeVector DirectionSensitivePhotoDetector::get_size() {
@@ -83,6 +115,10 @@ G4String DirectionSensitivePhotoDetector::get_name() {
     return m_name;
 }
 
+G4int DirectionSensitivePhotoDetector::get_ID() {
+    return m_ID;
+}
+
 G4RotationMatrix* DirectionSensitivePhotoDetector::get_rotationMatrix() {
     return m_rotationMatrix;
 }
@@ -95,6 +131,13 @@ G4ThreeVector DirectionSensitivePhotoDetector::get_position_photoSensor() {
     return m_position_photoSensor;
 }
 
+// Center of the envelope in the medium frame; its outer face is the back of the photosensor.
+G4ThreeVector DirectionSensitivePhotoDetector::get_position_envelope() {
+    G4ThreeVector envelope_min, envelope_max;
+    m_envelope->get_solid()->BoundingLimits( envelope_min, envelope_max );
+    return m_position_photoSensor - *m_rotationMatrix * G4ThreeVector( 0, 0, envelope_max.z() );
+}
+
 G4ThreeVector DirectionSensitivePhotoDetector::get_position( const char* t_relativePosition ) {
     G4String relativePosition = G4String( t_relativePosition );
     to_lower( relativePosition );
@@ -114,11 +157,11 @@ G4ThreeVector DirectionSensitivePhotoDetector::get_position( const char* t_relat
 }
 
 G4ThreeVector DirectionSensitivePhotoDetector::get_position_front() {
-    return m_lensSystem->get_position_front();
+    return m_position_lensSystem + *m_rotationMatrix * m_lensSystem->get_relativePosition_front();
 }
 
 G4ThreeVector DirectionSensitivePhotoDetector::get_position_back() {
-    return m_photoSensor->get_position_back();
+    return m_position_photoSensor;
 }
 
 G4ThreeVector DirectionSensitivePhotoDetector::get_position_center() {
@@ -133,10 +176,12 @@ G4bool DirectionSensitivePhotoDetector::get_isMany() {
     return m_isMany;
 }
 
+Wall* DirectionSensitivePhotoDetector::get_wall() {
+    return m_wall;
+}
+
 void DirectionSensitivePhotoDetector::set_name( const G4String& t_name ) {
     m_name = t_name;
-    m_lensSystem ->set_name( m_name + "_lensSystem"  );
-    m_photoSensor->set_name( m_name + "_photoSensor" );
 }
 
 G4ThreeVector DirectionSensitivePhotoDetector::get_position_front( G4RotationMatrix* t_rotationMatrix   , 
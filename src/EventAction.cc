@@ -14,10 +14,12 @@
 
 #include "G4Event.hh"
 #include "G4RunManager.hh"
+#include "G4Run.hh"
 
-EventAction::EventAction( RunAction* t_runAction, DetectorConstruction* t_detectorConstruction )
+EventAction::EventAction( RunAction* t_runAction, DetectorConstruction* t_detectorConstruction, StackingAction* t_stackingAction )
     : m_runAction           ( t_runAction                      ), 
       m_detectorConstruction( t_detectorConstruction           ), 
+      m_stackingAction      ( t_stackingAction                 ), 
       m_outputManager       ( t_runAction->get_outputManager() ) {
     G4cout << "EventAction::EventAction()" << G4endl;
 
@@ -25,9 +27,17 @@ EventAction::EventAction( RunAction* t_runAction, DetectorConstruction* t_detect
 }
 
 EventAction::~EventAction() {
+    EventArena::delete_instance();
 }
 
 void EventAction::BeginOfEventAction( const G4Event* t_event ) {
+    // The run manager decides to keep an event (e.g. for visualisation) only after
+    // EndOfEventAction, so the previous event's hits are rescued here instead.
+    const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+    size_t nKeptEvents = ( run && run->GetEventVector() ) ? run->GetEventVector()->size() : 0;
+    if( nKeptEvents > m_nKeptEvents )
+        EventArena::get_instance()->pin();
+    m_nKeptEvents = nKeptEvents;
 }
 
 void EventAction::EndOfEventAction( const G4Event* t_event ) {
@@ -35,57 +45,132 @@ void EventAction::EndOfEventAction( const G4Event* t_event ) {
     m_outputMessenger = OutputMessenger::get_instance();
 
     if( m_outputMessenger->get_photoSensor_hits_save() ) {
-        for( DirectionSensitivePhotoDetector* DSPD : m_detectorConstruction->get_directionSensitivePhotoDetectors() ) {
-            PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = DSPD->get_photoSensor()->get_sensitiveDetector();
-            PhotoSensorHitsCollection* photoSensorHitCollection = photoSensorSensitiveDetector->get_hitsCollection( t_event );
-            G4String photoSensorHitHistogramName = "photoSensor_" + to_string( DSPD->get_photoSensor()->get_sensitiveDetector()->get_ID() );
-
-            if( photoSensorHitCollection ) {
-                for( G4int i = 0; i < photoSensorHitCollection->GetSize(); i++ ) {
-                    PhotoSensorHit* photoSensorHit = static_cast< PhotoSensorHit* >( photoSensorHitCollection->GetHit( i ) );
-
-                    m_outputManager->fill_histogram_2D( photoSensorHitHistogramName                    , 
-                                                        photoSensorHit->get_hit_position_relative().x(), 
-                                                        photoSensorHit->get_hit_position_relative().y(), 1 );
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_absolute"           , photoSensorHit->get_hit_position_absolute                          () );
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative"           , photoSensorHit->get_hit_position_relative                          () );
-                    for( G4int i : m_outputMessenger->get_photoSensor_hits_position_relative_lens_save() ) {
-                        if( photoSensorHit->get_lensHit( i ) ) {
-                            m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), photoSensorHit->get_lensHit( i )->get_hit_position_relative() );
-                        } else {
-                            m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), G4ThreeVector( 0, 0, 0 ) );
-                            // m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), G4ThreeVector( nan(""), nan(""), nan("") ) );
-                        }
+        PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+        PhotoSensorHitsCollection* photoSensorHitCollection = photoSensorSensitiveDetector->get_hitsCollection( t_event );
+
+        if( photoSensorHitCollection ) {
+            for( G4int i = 0; i < photoSensorHitCollection->GetSize(); i++ ) {
+                PhotoSensorHit* photoSensorHit = static_cast< PhotoSensorHit* >( photoSensorHitCollection->GetHit( i ) );
+                G4String photoSensorHitHistogramName = "photoSensor_" + to_string( photoSensorHit->get_photoSensor_ID() );
+
+                m_outputManager->fill_histogram_2D( photoSensorHitHistogramName                    , 
+                                                    photoSensorHit->get_hit_position_relative().x(), 
+                                                    photoSensorHit->get_hit_position_relative().y(), photoSensorHit->get_hit_weight() );
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_absolute"           , photoSensorHit->get_hit_position_absolute                          () );
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative"           , photoSensorHit->get_hit_position_relative                          () );
+                for( G4int i : m_outputMessenger->get_photoSensor_hits_position_relative_lens_save() ) {
+                    if( photoSensorHit->get_lensHit( i ) ) {
+                        m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), photoSensorHit->get_lensHit( i )->get_hit_position_relative() );
+                    } else {
+                        m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), G4ThreeVector( 0, 0, 0 ) );
+                        // m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_relative_lens_" + to_string( i ), G4ThreeVector( nan(""), nan(""), nan("") ) );
                     }
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_initial"            , photoSensorHit->get_particle_position_initial                      () );
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_momentum"                    , photoSensorHit->get_particle_momentum                              () );
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction"                   , photoSensorHit->get_particle_direction                             () );
-                    m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative"          , photoSensorHit->get_particle_direction_relative                    () );
-                    for( G4int i : m_outputMessenger->get_photoSensor_hits_direction_relative_lens_save() ) {
-                        if( photoSensorHit->get_lensHit( i ) ) {
-                            m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), photoSensorHit->get_lensHit( i )->get_particle_direction_relative() );
-                        } else {
-                            m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), G4ThreeVector( 0, 0, 0 ) );
-                            // m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), G4ThreeVector( nan(""), nan(""), nan("") ) );
-                        }
+                }
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_position_initial"            , photoSensorHit->get_particle_position_initial                      () );
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_momentum"                    , photoSensorHit->get_particle_momentum                              () );
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction"                   , photoSensorHit->get_particle_direction                             () );
+                m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative"          , photoSensorHit->get_particle_direction_relative                    () );
+                for( G4int i : m_outputMessenger->get_photoSensor_hits_direction_relative_lens_save() ) {
+                    if( photoSensorHit->get_lensHit( i ) ) {
+                        m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), photoSensorHit->get_lensHit( i )->get_particle_direction_relative() );
+                    } else {
+                        m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), G4ThreeVector( 0, 0, 0 ) );
+                        // m_outputManager->fill_tuple_column_3vector( "photoSensor_hits_direction_relative_lens_" + to_string( i ), G4ThreeVector( nan(""), nan(""), nan("") ) );
                     }
-                    m_outputManager->fill_tuple_column_double ( "photoSensor_hits_time"                        , photoSensorHit->get_hit_time                                       () );
-                    m_outputManager->fill_tuple_column_string ( "photoSensor_hits_process"                     , photoSensorHit->get_hit_process                                    () );
-                    m_outputManager->fill_tuple_column_double ( "photoSensor_hits_energy"                      , photoSensorHit->get_particle_energy                                () );
-                    m_outputManager->fill_tuple_column_string ( "photoSensor_hits_photoSensorID"               , photoSensorHit->get_photoSensor_name                               () );
-                    m_outputManager->fill_tuple_column        ( "photoSensor_hits" );
                 }
-            } else {
-                // G4ExceptionDescription description;
-                // description << "photoSensorHitCollection is NULL. Not saving photoSensor hits for photoSensor=" << DSPD->get_photoSensor()->get_name();
-                // G4Exception( "EventAction::EndOfEventAction", "EventAction001", JustWarning, description );
+                m_outputManager->fill_tuple_column_double ( "photoSensor_hits_time"                        , photoSensorHit->get_hit_time                                       () );
+                m_outputManager->fill_tuple_column_string ( "photoSensor_hits_process"                     , photoSensorHit->get_hit_process                                    () );
+                m_outputManager->fill_tuple_column_double ( "photoSensor_hits_energy"                      , photoSensorHit->get_particle_energy                                () );
+                m_outputManager->fill_tuple_column_double ( "photoSensor_hits_weight"                      , photoSensorHit->get_hit_weight                                     () );
+                m_outputManager->fill_tuple_column_string ( "photoSensor_hits_photoSensorID"               , photoSensorHit->get_photoSensor_name                               () );
+                m_outputManager->fill_tuple_column        ( "photoSensor_hits" );
             }
+        } else {
+            // G4ExceptionDescription description;
+            // description << "photoSensorHitCollection is NULL. Not saving photoSensor hits for photoSensor=" << m_detectorConstruction->get_photoSensor()->get_name();
+            // G4Exception( "EventAction::EndOfEventAction", "EventAction001", JustWarning, description );
         }
     } 
 
+    // lens scan: event n is direction n % nDirections (see ParticleGun::generate_lensScan)
+    PointSpreadFunction* pointSpreadFunction = m_runAction->get_pointSpreadFunction();
+    if( pointSpreadFunction ) {
+        G4int  direction = t_event->GetEventID() % pointSpreadFunction->get_nDirections();
+        G4long nPhotons { 0 };
+        for( G4int i = 0; i < t_event->GetNumberOfPrimaryVertex(); i++ )
+            nPhotons += t_event->GetPrimaryVertex( i )->GetNumberOfParticle();
+        pointSpreadFunction->add_photons( direction, nPhotons );
+
+        PhotoSensorHitsCollection* photoSensorHitCollection = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector()->get_hitsCollection( t_event );
+        if( photoSensorHitCollection )
+            for( G4int i = 0; i < photoSensorHitCollection->GetSize(); i++ ) {
+                PhotoSensorHit* photoSensorHit = static_cast< PhotoSensorHit* >( photoSensorHitCollection->GetHit( i ) );
+                pointSpreadFunction->fill( direction, photoSensorHit->get_hit_position_relative().x(), 
+                                                      photoSensorHit->get_hit_position_relative().y() );
+            }
+    }
+
+    // visibility library: every photon of the event is counted in the voxel of the first vertex,
+    // mapped with its hits into x <= y <= z if the library is folded
+    VisibilityLibrary* visibilityLibrary = m_runAction->get_visibilityLibrary();
+    if( visibilityLibrary && t_event->GetNumberOfPrimaryVertex() > 0 ) {
+        G4int voxel = visibilityLibrary->get_voxel( t_event->GetPrimaryVertex( 0 )->GetPosition() );
+        if( voxel >= 0 ) {
+            const DSPDSymmetries& symmetries = visibilityLibrary->get_symmetries();
+            size_t                symmetry { 0 };
+            voxel = visibilityLibrary->fold( voxel, symmetry );
+
+            G4long nPhotons { 0 };
+            for( G4int i = 0; i < t_event->GetNumberOfPrimaryVertex(); i++ )
+                nPhotons += t_event->GetPrimaryVertex( i )->GetNumberOfParticle();
+            visibilityLibrary->add_photons( voxel, nPhotons );
+
+            PhotoSensorHitsCollection* photoSensorHitCollection = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector()->get_hitsCollection( t_event );
+            if( photoSensorHitCollection )
+                for( G4int i = 0; i < photoSensorHitCollection->GetSize(); i++ ) {
+                    PhotoSensorHit* photoSensorHit = static_cast< PhotoSensorHit* >( photoSensorHitCollection->GetHit( i ) );
+                    G4int           DSPD           = photoSensorHit->get_photoSensor_ID();
+                    visibilityLibrary->fill( voxel, symmetries.get_DSPD     ( symmetry, DSPD ), 
+                                                    symmetries.map_direction( symmetry, DSPD, photoSensorHit->get_particle_direction_relative() ) );
+                }
+        }
+    }
+
+    // hit library: events of a single primary only, with the hit times relative to it
+    HitLibrary* hitLibrary = m_runAction->get_hitLibrary();
+    if( hitLibrary && t_event->GetNumberOfPrimaryVertex() == 1 && t_event->GetPrimaryVertex( 0 )->GetNumberOfParticle() == 1 ) {
+        G4PrimaryVertex  * vertex   = t_event->GetPrimaryVertex( 0 );
+        G4PrimaryParticle* primary  = vertex->GetPrimary();
+        HitLibraryEvent    event{ primary->GetPDGcode(), primary->GetKineticEnergy(), 
+                                  vertex->GetPosition(), primary->GetMomentumDirection(), {} };
+
+        PhotoSensorHitsCollection* photoSensorHitCollection = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector()->get_hitsCollection( t_event );
+        if( photoSensorHitCollection ) {
+            event.m_hits.reserve( photoSensorHitCollection->GetSize() );
+            for( G4int i = 0; i < photoSensorHitCollection->GetSize(); i++ ) {
+                PhotoSensorHit* photoSensorHit = static_cast< PhotoSensorHit* >( photoSensorHitCollection->GetHit( i ) );
+                event.m_hits.push_back( { photoSensorHit->get_photoSensor_ID       (), 
+                                          photoSensorHit->get_hit_position_absolute(), 
+                                          photoSensorHit->get_hit_momentum         ().unit(), 
+                                          photoSensorHit->get_hit_time             () - vertex->GetT0(), 
+                                          photoSensorHit->get_hit_energy           () } );
+            }
+        }
+        hitLibrary->add_event( event );
+    }
+
+    if( m_constructionMessenger->get_fastSimulation_visibility() == "expected" )
+        for( const auto& [ photoSensorID, nHits ] : m_stackingAction->get_visibility_expected() ) {
+            m_outputManager->fill_tuple_column_integer( "photoSensor_expected_photoSensorID", photoSensorID );
+            m_outputManager->fill_tuple_column_double ( "photoSensor_expected_nHits"        , nHits         );
+            m_outputManager->fill_tuple_column        ( "photoSensor_expected" );
+        }
+
+    m_runAction->record_stack_peak( m_stackingAction->get_stack_peak(), m_stackingAction->get_stack_buffer_peak(), 
+                                    m_stackingAction->get_stack_spill_peak() );
+
     if( m_outputMessenger->get_calorimeter_hits_save() ) {
-        for( Calorimeter* cal : m_detectorConstruction->get_calorimeters() ) {
-            CalorimeterSensitiveDetector* calorimeterSensitiveDetector = cal->get_sensitiveDetector();
+        for( CalorimeterSensitiveDetector* calorimeterSensitiveDetector : m_detectorConstruction->get_calorimeterSensitiveDetectors() ) {
             CalorimeterHitsCollection* calorimeterHitCollection = calorimeterSensitiveDetector->get_hitsCollection( t_event );
 
             for( G4int i = 0; i < calorimeterHitCollection->GetSize(); i++ ) {
@@ -107,34 +192,32 @@ void EventAction::EndOfEventAction( const G4Event* t_event ) {
     }
 
     if( m_outputMessenger->get_lens_hits_save() ) {
-        for( DirectionSensitivePhotoDetector* DSPD : m_detectorConstruction->get_directionSensitivePhotoDetectors() ) {
-            LensSystem* lensSystem = DSPD->get_lensSystem();
-            for( Lens* lens : lensSystem->get_lenses() ) {
-                LensSensitiveDetector* lensSensitiveDetector = lens->get_sensitiveDetector();
-                LensHitsCollection* lensHitCollection = lensSensitiveDetector->get_hitsCollection( t_event );
-
-                if( lensHitCollection ) {
-                    for( G4int i = 0; i < lensHitCollection->GetSize(); i++ ) {
-                        LensHit* lensHit = static_cast< LensHit* >( lensHitCollection->GetHit( i ) );
-
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_position_absolute" , lensHit->get_hit_position_absolute      () );
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_position_relative" , lensHit->get_hit_position_relative      () );
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_position_initial"  , lensHit->get_particle_position_initial  () );
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_momentum"          , lensHit->get_particle_momentum          () );
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_direction"         , lensHit->get_particle_direction         () );
-                        m_outputManager->fill_tuple_column_3vector( "lens_hits_direction_relative", lensHit->get_particle_direction_relative() );
-                        m_outputManager->fill_tuple_column_double ( "lens_hits_time"              , lensHit->get_hit_time                   () );
-                        m_outputManager->fill_tuple_column_string ( "lens_hits_process"           , lensHit->get_hit_process                () );
-                        m_outputManager->fill_tuple_column_double ( "lens_hits_energy"            , lensHit->get_particle_energy            () );
-                        m_outputManager->fill_tuple_column_string ( "lens_hits_lensID"            , lensHit->get_lens_name                  () );
-                        m_outputManager->fill_tuple_column_boolean( "lens_hits_transmittance"     , lensHit->get_particle_transmittance     () );
-                        m_outputManager->fill_tuple_column        ( "lens_hits" );
-                    }
-                } else {
-                    // G4ExceptionDescription description;
-                    // description << "lensHitCollection is NULL. Not saving lens hits for lens=" << lens->get_name();
-                    // G4Exception( "EventAction::EndOfEventAction", "EventAction002", JustWarning, description );
+        LensSystem* lensSystem = m_detectorConstruction->get_lensSystem();
+        for( Lens* lens : lensSystem->get_lenses() ) {
+            LensSensitiveDetector* lensSensitiveDetector = lens->get_sensitiveDetector();
+            LensHitsCollection* lensHitCollection = lensSensitiveDetector->get_hitsCollection( t_event );
+
+            if( lensHitCollection ) {
+                for( G4int i = 0; i < lensHitCollection->GetSize(); i++ ) {
+                    LensHit* lensHit = static_cast< LensHit* >( lensHitCollection->GetHit( i ) );
+
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_position_absolute" , lensHit->get_hit_position_absolute      () );
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_position_relative" , lensHit->get_hit_position_relative      () );
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_position_initial"  , lensHit->get_particle_position_initial  () );
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_momentum"          , lensHit->get_particle_momentum          () );
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_direction"         , lensHit->get_particle_direction         () );
+                    m_outputManager->fill_tuple_column_3vector( "lens_hits_direction_relative", lensHit->get_particle_direction_relative() );
+                    m_outputManager->fill_tuple_column_double ( "lens_hits_time"              , lensHit->get_hit_time                   () );
+                    m_outputManager->fill_tuple_column_string ( "lens_hits_process"           , lensHit->get_hit_process                () );
+                    m_outputManager->fill_tuple_column_double ( "lens_hits_energy"            , lensHit->get_particle_energy            () );
+                    m_outputManager->fill_tuple_column_string ( "lens_hits_lensID"            , lensHit->get_lens_name                  () );
+                    m_outputManager->fill_tuple_column_boolean( "lens_hits_transmittance"     , lensHit->get_particle_transmittance     () );
+                    m_outputManager->fill_tuple_column        ( "lens_hits" );
                 }
+            } else {
+                // G4ExceptionDescription description;
+                // description << "lensHitCollection is NULL. Not saving lens hits for lens=" << lens->get_name();
+                // G4Exception( "EventAction::EndOfEventAction", "EventAction002", JustWarning, description );
             }
         }
     }
@@ -160,5 +243,8 @@ void EventAction::EndOfEventAction( const G4Event* t_event ) {
         }
     }
 
+    // growth is summed into the run statistics (see EventArena::print_statistics)
+    EventArena::get_instance()->reset();
+
     G4cout << "EndOfEventAction" << G4endl;
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "EventArena.hh"
+
+G4ThreadLocal EventArena* EventArena::m_instance{ nullptr };
+
+EventArena::EventArena() {
+}
+
+EventArena::~EventArena() {
+    for( Block& block : m_blocks )
+        std::free( block.data );
+}
+
+EventArena* EventArena::get_instance() {
+    if( !m_instance ) {
+        m_instance = new EventArena();
+    }
+    return m_instance;
+}
+
+void EventArena::delete_instance() {
+    if( m_instance ) {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+}
+
+void* EventArena::allocate( size_t t_size, size_t t_alignment ) {
+    m_nAllocations_event++;
+    m_nBytes_event += t_size;
+
+    while( m_block_index < m_blocks.size() ) {
+        size_t offset = ( m_block_offset + t_alignment - 1 ) & ~( t_alignment - 1 );
+        if( offset + t_size <= m_blocks[ m_block_index ].size ) {
+            m_block_offset = offset + t_size;
+            return m_blocks[ m_block_index ].data + offset;
+        }
+        m_block_index++;
+        m_block_offset = 0;
+    }
+
+    // Out of blocks: this is the only place the arena goes to the heap.
+    size_t size = t_size + t_alignment > m_blockSize_default ? t_size + t_alignment : m_blockSize_default;
+    char * data = static_cast< char* >( std::malloc( size ) );
+    if( !data )
+        G4Exception( "EventArena::allocate", "OutOfMemory", FatalException, "Failed to allocate arena block." );
+    m_blocks.push_back( { data, size } );
+    m_nMallocs_event++;
+    m_nBytes_capacity += size;
+
+    m_block_index  = m_blocks.size() - 1;
+    size_t offset  = ( reinterpret_cast< std::uintptr_t >( data ) + t_alignment - 1 ) & ~( t_alignment - 1 );
+    offset        -= reinterpret_cast< std::uintptr_t >( data );
+    m_block_offset = offset + t_size;
+    return data + offset;
+}
+
+void EventArena::reset() {
+    m_nEvents++;
+    if( m_nMallocs_event == 0 )
+        m_nEvents_zeroMalloc++;
+    m_nAllocations_total += m_nAllocations_event;
+    m_nBytes_total       += m_nBytes_event;
+    m_nMallocs_total     += m_nMallocs_event;
+    if( m_nBytes_event > m_nBytes_peak )
+        m_nBytes_peak = m_nBytes_event;
+
+    m_nAllocations_event = 0;
+    m_nBytes_event       = 0;
+    m_nMallocs_event     = 0;
+
+    m_block_index_last  = m_block_index ;
+    m_block_offset_last = m_block_offset;
+
+    if( m_pinned )
+        return;
+
+    m_block_index  = 0;
+    m_block_offset = 0;
+}
+
+// Keeps everything allocated up to the last reset() alive until release().
+void EventArena::pin() {
+    m_pinned       = true;
+    m_block_index  = m_block_index_last ;
+    m_block_offset = m_block_offset_last;
+}
+
+void EventArena::release() {
+    m_pinned            = false;
+    m_block_index_last  = 0;
+    m_block_offset_last = 0;
+    m_block_index  = 0;
+    m_block_offset = 0;
+}
+
+void EventArena::print_statistics() const {
+    G4cout << "EventArena statistics:" << G4endl
+           << "  events--------------: " << m_nEvents            << G4endl
+           << "  events_zeroMalloc---: " << m_nEvents_zeroMalloc << G4endl
+           << "  allocations---------: " << m_nAllocations_total << G4endl
+           << "  bytes---------------: " << m_nBytes_total       << G4endl
+           << "  bytes_peak----------: " << m_nBytes_peak        << G4endl
+           << "  mallocs-------------: " << m_nMallocs_total     << G4endl
+           << "  capacity------------: " << m_nBytes_capacity    << G4endl;
+}
+
+size_t EventArena::get_nAllocations_event() const {
+    return m_nAllocations_event;
+}
+
+size_t EventArena::get_nBytes_event() const {
+    return m_nBytes_event;
+}
+
+size_t EventArena::get_nMallocs_event() const {
+    return m_nMallocs_event;
+}
+
+size_t EventArena::get_nAllocations_total() const {
+    return m_nAllocations_total;
+}
+
+size_t EventArena::get_nBytes_total() const {
+    return m_nBytes_total;
+}
+
+size_t EventArena::get_nMallocs_total() const {
+    return m_nMallocs_total;
+}
+
+size_t EventArena::get_nBytes_peak() const {
+    return m_nBytes_peak;
+}
+
+size_t EventArena::get_nBytes_capacity() const {
+    return m_nBytes_capacity;
+}
+
+size_t EventArena::get_nEvents() const {
+    return m_nEvents;
+}
+
+size_t EventArena::get_nEvents_zeroMalloc() const {
+    return m_nEvents_zeroMalloc;
+}
@@ -0,0 +1,139 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "GeometricAcceptance.hh"
+
+#include "DetectorConstruction.hh"
+
+// The apertures are those of every DSPD of t_detectorConstruction; t_halfSize is the half size
+// of the medium, used for the axes without DSPDs
+GeometricAcceptance::GeometricAcceptance( const DetectorConstruction* t_detectorConstruction, 
+                                          const G4ThreeVector       & t_halfSize            , 
+                                          const RayTracerMaterial   & t_medium               )
+    : m_medium( t_medium ), m_halfSize( t_halfSize ) {
+    G4double halfWidth  = DirectionSensitivePhotoDetector::get_width () / 2;
+    G4double halfHeight = DirectionSensitivePhotoDetector::get_height() / 2;
+
+    vector< G4int > faces;
+    G4double        face_positions[ 6 ]{ DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX };
+    G4double        area{ 0 };
+    for( G4int ID{ 0 }; ID < t_detectorConstruction->get_nDSPDs(); ID++ ) {
+        G4RotationMatrix* DSPD_rotationMatrix = t_detectorConstruction->get_DSPD_rotationMatrix( ID );
+        G4RotationMatrix  rotationMatrix      = DSPD_rotationMatrix ? *DSPD_rotationMatrix : G4RotationMatrix();
+        G4ThreeVector normal   = rotationMatrix * G4ThreeVector( 0, 0, 1 );
+        G4ThreeVector extent_x = rotationMatrix * G4ThreeVector( halfWidth, 0, 0 );
+        G4ThreeVector extent_y = rotationMatrix * G4ThreeVector( 0, halfHeight, 0 );
+        G4ThreeVector front    = t_detectorConstruction->get_DSPD_position_front( ID );
+
+        G4int axis{ 0 };
+        for( G4int nAxis{ 1 }; nAxis < 3; nAxis++ )
+            if( std::abs( normal[ nAxis ] ) > std::abs( normal[ axis ] ) )
+                axis = nAxis;
+        G4int axis_u = ( axis + 1 ) % 3;
+        G4int axis_v = ( axis + 2 ) % 3;
+        G4int face   = 2 * axis + ( ( front[ axis ] > 0 ) ? 1 : 0 );
+
+        Aperture aperture;
+        aperture.m_u     = front[ axis_u ];
+        aperture.m_v     = front[ axis_v ];
+        aperture.m_halfU = std::abs( extent_x[ axis_u ] ) + std::abs( extent_y[ axis_u ] );
+        aperture.m_halfV = std::abs( extent_x[ axis_v ] ) + std::abs( extent_y[ axis_v ] );
+        m_apertures.push_back( aperture );
+        faces      .push_back( face     );
+
+        face_positions[ face ] = std::min( face_positions[ face ], std::abs( front[ axis ] ) );
+        area      += 4 * aperture.m_halfU * aperture.m_halfV;
+        m_cellSize = std::max( m_cellSize, 2 * std::max( aperture.m_halfU, aperture.m_halfV ) );
+    }
+
+    for( G4int axis{ 0 }; axis < 3; axis++ ) {
+        G4double position = std::min( face_positions[ 2 * axis ], face_positions[ 2 * axis + 1 ] );
+        if( position < DBL_MAX )
+            m_halfSize[ axis ] = position;
+    }
+
+    G4double area_faces = 8 * ( m_halfSize.x() * m_halfSize.y() + m_halfSize.y() * m_halfSize.z() + m_halfSize.z() * m_halfSize.x() );
+    m_coverage = ( area_faces > 0 ) ? std::min( 1., area / area_faces ) : 0;
+
+    if( m_cellSize <= 0 )
+        return;
+    for( size_t index{ 0 }; index < m_apertures.size(); index++ ) {
+        const Aperture& aperture = m_apertures[ index ];
+        for( G4long u = std::floor( ( aperture.m_u - aperture.m_halfU ) / m_cellSize ); u <= std::floor( ( aperture.m_u + aperture.m_halfU ) / m_cellSize ); u++ )
+            for( G4long v = std::floor( ( aperture.m_v - aperture.m_halfV ) / m_cellSize ); v <= std::floor( ( aperture.m_v + aperture.m_halfV ) / m_cellSize ); v++ )
+                m_cells[ { faces[ index ], u, v } ].push_back( index );
+    }
+}
+
+// Probability of a photon at t_position (inside the box) with t_direction and t_energy to
+// reach an aperture; 1 outside the box, where it is not estimated.
+G4double GeometricAcceptance::get_probability( const G4ThreeVector& t_position , 
+                                               const G4ThreeVector& t_direction, 
+                                                     G4double       t_energy    ) const {
+    for( G4int axis{ 0 }; axis < 3; axis++ )
+        if( std::abs( t_position[ axis ] ) >= m_halfSize[ axis ] )
+            return 1.;
+
+    G4double length{ DBL_MAX };
+    G4int    axis_exit{ -1 };
+    for( G4int axis{ 0 }; axis < 3; axis++ ) {
+        if( t_direction[ axis ] == 0 )
+            continue;
+        G4double distance = ( std::copysign( m_halfSize[ axis ], t_direction[ axis ] ) - t_position[ axis ] ) / t_direction[ axis ];
+        if( distance < length ) {
+            length    = distance;
+            axis_exit = axis;
+        }
+    }
+    if( axis_exit < 0 )
+        return 1.;
+
+    G4ThreeVector exit  = t_position + length * t_direction;
+    G4int         face  = 2 * axis_exit + ( ( t_direction[ axis_exit ] > 0 ) ? 1 : 0 );
+    G4bool        onAperture = is_aperture( face, exit[ ( axis_exit + 1 ) % 3 ], exit[ ( axis_exit + 2 ) % 3 ] );
+
+    G4double unabsorbed  = std::exp( -length / m_medium.get_absorptionLength( t_energy ) );
+    G4double unscattered = std::exp( -length / m_medium.get_scatteringLength( t_energy ) );
+    return unabsorbed * ( unscattered * ( onAperture ? 1. : 0. ) + ( 1 - unscattered ) * m_coverage );
+}
+
+// Lower bound of the path from t_position to a DSPD front: the distance to the closest face
+// of the box, 0 outside of it
+G4double GeometricAcceptance::get_distance( const G4ThreeVector& t_position ) const {
+    G4double distance{ DBL_MAX };
+    for( G4int axis{ 0 }; axis < 3; axis++ )
+        distance = std::min( distance, m_halfSize[ axis ] - std::abs( t_position[ axis ] ) );
+    return std::max( distance, 0. );
+}
+
+G4ThreeVector GeometricAcceptance::get_halfSize() const {
+    return m_halfSize;
+}
+
+// Fraction of the faces of the box covered by apertures
+G4double GeometricAcceptance::get_coverage() const {
+    return m_coverage;
+}
+
+G4bool GeometricAcceptance::is_aperture( G4int t_face, G4double t_u, G4double t_v ) const {
+    if( m_cellSize <= 0 )
+        return false;
+
+    auto cell = m_cells.find( { t_face, G4long( std::floor( t_u / m_cellSize ) ), G4long( std::floor( t_v / m_cellSize ) ) } );
+    if( cell == m_cells.end() )
+        return false;
+
+    for( size_t index : cell->second )
+        if( std::abs( t_u - m_apertures[ index ].m_u ) <= m_apertures[ index ].m_halfU &&
+            std::abs( t_v - m_apertures[ index ].m_v ) <= m_apertures[ index ].m_halfV    )
+            return true;
+    return false;
+}
@@ -0,0 +1,81 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "GeometryCache.hh"
+
+GeometryCache::GeometryCache( const G4String& t_directory, const G4String& t_parameters, uint64_t t_geometry_hash ) {
+    stringstream geometry_hash_hex;
+    geometry_hash_hex << std::hex << std::setw( 16 ) << std::setfill( '0' ) << t_geometry_hash;
+    m_directory  = t_directory;
+    m_parameters = "geometry " + geometry_hash_hex.str() + "\n" + t_parameters;
+
+    stringstream hash_hex;
+    hash_hex << std::hex << std::setw( 16 ) << std::setfill( '0' ) << get_hash( m_parameters );
+    m_hash = hash_hex.str();
+
+    ifstream file( get_fileName() );
+    if( !file.is_open() )
+        return;
+
+    G4String keyword;
+    G4int    overlaps;
+    if( !( file >> keyword >> overlaps ) || keyword != "overlaps" )
+        return;
+    file.ignore( 1 );
+
+    stringstream parameters;
+    parameters << file.rdbuf();
+    if( parameters.str() != m_parameters )
+        return;
+
+    m_isHit    = true;
+    m_overlaps = overlaps;
+}
+
+uint64_t GeometryCache::get_hash( const std::string& t_string, uint64_t t_hash ) {
+    for( unsigned char character : t_string ) {
+        t_hash ^= character;
+        t_hash *= 1099511628211ull;
+    }
+    return t_hash;
+}
+
+G4bool GeometryCache::get_isHit() const {
+    return m_isHit;
+}
+
+G4int GeometryCache::get_overlaps() const {
+    return m_overlaps;
+}
+
+G4String GeometryCache::get_hash() const {
+    return m_hash;
+}
+
+G4String GeometryCache::get_fileName() const {
+    return m_directory + "/" + m_hash + ".txt";
+}
+
+void GeometryCache::set_overlaps( G4int t_overlaps ) {
+    m_overlaps = t_overlaps;
+
+    std::error_code error;
+    std::filesystem::create_directories( std::string( m_directory ), error );
+    ofstream file( get_fileName() );
+    if( error || !file.is_open() ) {
+        G4Exception( "GeometryCache::set_overlaps", "InvalidSetup", JustWarning, 
+                     ( "Cannot write `" + get_fileName() + "', the overlap check will be repeated." ).c_str() );
+        return;
+    }
+
+    file << "overlaps " << m_overlaps << "\n" << m_parameters;
+}
@@ -0,0 +1,48 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "GridParameterisation.hh"
+
+GridParameterisation::GridParameterisation( G4ThreeVector t_position, 
+                                            G4ThreeVector t_step_x  , 
+                                            G4ThreeVector t_step_y  , 
+                                            G4int         t_amount_y ) {
+    if( t_amount_y < 1 )
+        G4Exception( "GridParameterisation::GridParameterisation", "InvalidArgument", FatalErrorInArgument, "amount_y must be at least 1." );
+
+    m_position = t_position;
+    m_step_x   = t_step_x  ;
+    m_step_y   = t_step_y  ;
+    m_amount_y = t_amount_y;
+}
+
+void GridParameterisation::ComputeTransformation( const G4int t_copyNumber, G4VPhysicalVolume* t_physicalVolume ) const {
+    t_physicalVolume->SetTranslation( m_position + m_step_x * ( t_copyNumber / m_amount_y ) 
+                                                 + m_step_y * ( t_copyNumber % m_amount_y ) );
+    if( !m_rotationMatrices.empty() )
+        t_physicalVolume->SetRotation( m_rotationMatrices[ t_copyNumber % m_rotationMatrices.size() ] );
+}
+
+G4VSolid* GridParameterisation::ComputeSolid( const G4int t_copyNumber, G4VPhysicalVolume* t_physicalVolume ) {
+    if( m_solids.empty() )
+        return t_physicalVolume->GetLogicalVolume()->GetSolid();
+    return m_solids[ t_copyNumber % m_solids.size() ];
+}
+
+void GridParameterisation::add_solid( G4VSolid* t_solid ) {
+    m_solids.push_back( t_solid );
+}
+
+// nullptr is a valid entry (no rotation)
+void GridParameterisation::add_rotationMatrix( G4RotationMatrix* t_rotationMatrix ) {
+    m_rotationMatrices.push_back( t_rotationMatrix );
+}
@@ -0,0 +1,209 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "HitLibrary.hh"
+
+#include "G4AutoLock.hh"
+
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace { 
+    G4Mutex hitLibraryMutex = G4MUTEX_INITIALIZER; 
+
+    // libraries read for the overlay, kept until the end so the threads can share them
+    std::map< G4String, std::unique_ptr< HitLibrary > > hitLibraries;
+}
+
+HitLibrary* HitLibrary::m_instance{ nullptr };
+
+HitLibrary* HitLibrary::get_instance() {
+    G4AutoLock lock( &hitLibraryMutex );
+    if( !m_instance ) 
+        m_instance = new HitLibrary();
+    return m_instance;
+}
+
+void HitLibrary::delete_instance() {
+    if( m_instance ) {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+}
+
+// The library in t_fileName, read by the first thread asking for it, with the symmetries of
+// the DSPDs of t_photoSensorSensitiveDetector
+const HitLibrary* HitLibrary::get_library( const G4String& t_fileName, PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector ) {
+    G4AutoLock lock( &hitLibraryMutex );
+    std::unique_ptr< HitLibrary >& library = hitLibraries[ t_fileName ];
+    if( !library ) {
+        library = std::make_unique< HitLibrary >();
+        library->read          ( t_fileName                     );
+        library->set_symmetries( t_photoSensorSensitiveDetector );
+    }
+    return library.get();
+}
+
+void HitLibrary::reset() {
+    m_events.clear();
+}
+
+void HitLibrary::add_event( const HitLibraryEvent& t_event ) {
+    m_events.push_back( t_event );
+}
+
+void HitLibrary::merge( const HitLibrary& t_hitLibrary ) {
+    G4AutoLock lock( &hitLibraryMutex );
+    m_events.insert( m_events.end(), t_hitLibrary.m_events.begin(), t_hitLibrary.m_events.end() );
+}
+
+void HitLibrary::write( const G4String& t_fileName ) const {
+    ofstream file( t_fileName, std::ios::binary );
+    if( !file )
+        G4Exception( "HitLibrary::write", "InvalidSetup", FatalException, 
+                     ( "Cannot open `" + t_fileName + "'." ).c_str() );
+
+    int32_t  version = m_version;
+    uint64_t nEvents = m_events.size();
+    file.write( m_magic                                    , sizeof( m_magic ) );
+    file.write( reinterpret_cast< const char* >( &version ), sizeof( version ) );
+    file.write( reinterpret_cast< const char* >( &nEvents ), sizeof( nEvents ) );
+
+    size_t nHits_total{ 0 };
+    for( const HitLibraryEvent& event : m_events ) {
+        int32_t  PDG     = event.m_PDG;
+        uint64_t nHits   = event.m_hits.size();
+        G4double values[ 7 ]{ event.m_energy, 
+                              event.m_position .x(), event.m_position .y(), event.m_position .z(),
+                              event.m_direction.x(), event.m_direction.y(), event.m_direction.z() };
+        file.write( reinterpret_cast< const char* >( &PDG   ), sizeof( PDG    ) );
+        file.write( reinterpret_cast< const char* >( values ), sizeof( values ) );
+        file.write( reinterpret_cast< const char* >( &nHits ), sizeof( nHits  ) );
+        for( const HitLibraryHit& hit : event.m_hits ) {
+            int32_t  DSPD = hit.m_DSPD;
+            G4double hitValues[ 8 ]{ hit.m_position .x(), hit.m_position .y(), hit.m_position .z(),
+                                     hit.m_direction.x(), hit.m_direction.y(), hit.m_direction.z(),
+                                     hit.m_time, hit.m_energy };
+            file.write( reinterpret_cast< const char* >( &DSPD     ), sizeof( DSPD      ) );
+            file.write( reinterpret_cast< const char* >( hitValues ), sizeof( hitValues ) );
+        }
+        nHits_total += nHits;
+    }
+
+    G4cout << "HitLibrary::write: " << m_events.size() << " events with " << nHits_total 
+           << " photosensor hits written to " << t_fileName << G4endl;
+}
+
+void HitLibrary::read( const G4String& t_fileName ) {
+    ifstream file( t_fileName, std::ios::binary );
+    char     magic[ 8 ];
+    int32_t  version{ 0 };
+    uint64_t nEvents{ 0 };
+    file.read( magic                                , sizeof( magic   ) );
+    file.read( reinterpret_cast< char* >( &version ), sizeof( version ) );
+    if( !file || std::memcmp( magic, m_magic, sizeof( magic ) ) != 0 || version != m_version )
+        G4Exception( "HitLibrary::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is not a hit library of this version." ).c_str() );
+
+    file.read( reinterpret_cast< char* >( &nEvents ), sizeof( nEvents ) );
+    m_events.clear();
+    m_events.reserve( nEvents );
+    for( uint64_t i{ 0 }; i < nEvents && file; i++ ) {
+        int32_t         PDG  { 0 };
+        uint64_t        nHits{ 0 };
+        G4double        values[ 7 ]{};
+        HitLibraryEvent event;
+        file.read( reinterpret_cast< char* >( &PDG   ), sizeof( PDG    ) );
+        file.read( reinterpret_cast< char* >( values ), sizeof( values ) );
+        file.read( reinterpret_cast< char* >( &nHits ), sizeof( nHits  ) );
+        event.m_PDG       = PDG;
+        event.m_energy    = values[ 0 ];
+        event.m_position  = G4ThreeVector( values[ 1 ], values[ 2 ], values[ 3 ] );
+        event.m_direction = G4ThreeVector( values[ 4 ], values[ 5 ], values[ 6 ] );
+        event.m_hits.reserve( nHits );
+        for( uint64_t j{ 0 }; j < nHits && file; j++ ) {
+            int32_t  DSPD{ 0 };
+            G4double hitValues[ 8 ]{};
+            file.read( reinterpret_cast< char* >( &DSPD     ), sizeof( DSPD      ) );
+            file.read( reinterpret_cast< char* >( hitValues ), sizeof( hitValues ) );
+            event.m_hits.push_back( { DSPD, 
+                                      G4ThreeVector( hitValues[ 0 ], hitValues[ 1 ], hitValues[ 2 ] ), 
+                                      G4ThreeVector( hitValues[ 3 ], hitValues[ 4 ], hitValues[ 5 ] ), 
+                                      hitValues[ 6 ], hitValues[ 7 ] } );
+        }
+        m_events.push_back( std::move( event ) );
+    }
+    if( !file )
+        G4Exception( "HitLibrary::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is truncated." ).c_str() );
+
+    // by particle, then energy, for find()
+    std::sort( m_events.begin(), m_events.end(), 
+               []( const HitLibraryEvent& t_a, const HitLibraryEvent& t_b ) { 
+                   return t_a.m_PDG != t_b.m_PDG ? t_a.m_PDG < t_b.m_PDG : t_a.m_energy < t_b.m_energy; } );
+}
+
+void HitLibrary::set_symmetries( PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector ) {
+    m_symmetries.set( t_photoSensorSensitiveDetector );
+
+    G4cout << "HitLibrary: " << m_events.size() << " events, " << m_symmetries.get_nSymmetries() 
+           << " symmetries of the DSPDs" << G4endl;
+}
+
+// The event of particle t_PDG within relative energy t_tolerance_energy of t_energy whose vertex
+// and direction, mapped by symmetry t_symmetry, are closest to t_position and t_direction: the
+// sum of the distance over t_tolerance_position and the angle over t_tolerance_angle, both at
+// most 1, is smallest. The library has to be read and its symmetries set.
+const HitLibraryEvent* HitLibrary::find( G4int                t_PDG               , 
+                                         G4double             t_energy            , 
+                                         const G4ThreeVector& t_position          , 
+                                         const G4ThreeVector& t_direction         , 
+                                         G4double             t_tolerance_energy  , 
+                                         G4double             t_tolerance_position, 
+                                         G4double             t_tolerance_angle   , 
+                                         size_t             & t_symmetry           ) const {
+    auto first = std::lower_bound( m_events.begin(), m_events.end(), std::make_pair( t_PDG, t_energy * ( 1 - t_tolerance_energy ) ), 
+                                   []( const HitLibraryEvent& t_event, const std::pair< G4int, G4double >& t_key ) { 
+                                       return t_event.m_PDG != t_key.first ? t_event.m_PDG < t_key.first : t_event.m_energy < t_key.second; } );
+    auto last  = std::upper_bound( first, m_events.end(), std::make_pair( t_PDG, t_energy * ( 1 + t_tolerance_energy ) ), 
+                                   []( const std::pair< G4int, G4double >& t_key, const HitLibraryEvent& t_event ) { 
+                                       return t_key.first != t_event.m_PDG ? t_key.first < t_event.m_PDG : t_key.second < t_event.m_energy; } );
+
+    const HitLibraryEvent* closest{ nullptr };
+    G4double               cost_min{ 2 };
+    for( size_t symmetry{ 0 }; symmetry < m_symmetries.get_nSymmetries(); symmetry++ ) {
+        G4ThreeVector position  = m_symmetries.get_symmetry( symmetry ).inverse( t_position  );
+        G4ThreeVector direction = m_symmetries.get_symmetry( symmetry ).inverse( t_direction );
+        for( auto event = first; event != last; event++ ) {
+            G4double distance = ( event->m_position - position ).mag() / t_tolerance_position;
+            if( distance > 1 || distance >= cost_min )
+                continue;
+            G4double angle = event->m_direction.angle( direction ) / t_tolerance_angle;
+            if( angle > 1 || distance + angle >= cost_min )
+                continue;
+            closest    = &*event;
+            cost_min   = distance + angle;
+            t_symmetry = symmetry;
+        }
+    }
+    return closest;
+}
+
+size_t HitLibrary::get_nEvents() const {
+    return m_events.size();
+}
+
+const DSPDSymmetries& HitLibrary::get_symmetries() const {
+    return m_symmetries;
+}
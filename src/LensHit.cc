@@ -11,8 +11,6 @@
 
 #include "LensHit.hh"
 
-G4ThreadLocal G4Allocator< LensHit >* LensHitAllocator;
-
 LensHit::LensHit() {
 }
 
@@ -26,7 +24,7 @@ LensHit::LensHit( const G4ThreeVector    & t_lens_position      ,
                   const G4ThreeVector    & t_particle_momentum   ) {
     m_lens_position       = t_lens_position      ;
     m_lens_rotationMatrix = t_lens_rotationMatrix;
-    m_lens_name           = t_lens_name          ;
+    m_lens_name           = &t_lens_name         ;
     m_lens_ID             = t_lens_ID            ;
     m_hit_position        = t_hit_position       ;
     m_hit_time            = t_hit_time           ;
@@ -66,7 +64,7 @@ void LensHit::Print() {
 std::ostream& operator<<( std::ostream& t_os, const LensHit& t_lensHit ) {
     t_os << "[" << "lens_position="       <<  t_lensHit.m_lens_position       << ", \n"
                 << "lens_rotationMatrix=" << *t_lensHit.m_lens_rotationMatrix << ", \n"
-                << "lens_name="           <<  t_lensHit.m_lens_name           << ", \n"
+                << "lens_name="           << *t_lensHit.m_lens_name           << ", \n"
                 << "lens_ID="             <<  t_lensHit.m_lens_ID             << ", \n"
                 << "hit_position="        <<  t_lensHit.m_hit_position        << ", \n"
                 << "hit_time="            <<  t_lensHit.m_hit_time            << ", \n"
@@ -95,7 +93,7 @@ void LensHit::set_lens_rotationMatrix( G4RotationMatrix* t_lens_rotationMatrix )
 }
 
 void LensHit::set_lens_name( const G4String& t_lens_name ) {
-    m_lens_name = t_lens_name;
+    m_lens_name = &t_lens_name;
 }
 
 void LensHit::set_lens_ID( G4int t_lens_ID ) {
@@ -119,7 +117,7 @@ void LensHit::set_particle_position_initial( G4ThreeVector t_particle_position_i
 }
 
 void LensHit::set_hit_process( const G4String& t_hit_process ) {
-    m_hit_process = t_hit_process;
+    m_hit_process = &t_hit_process;
 }
 
 void LensHit::set_particle_transmittance( G4bool t_particle_transmittance ) {
@@ -144,7 +142,7 @@ G4ThreeVector LensHit::get_hit_position_relative() {
     //     abs( rotated_relative_position.x() ) > m_constructionMessenger->get_lens_size_height() / 2 + epsilon ||
     //     abs( rotated_relative_position.y() ) > m_constructionMessenger->get_lens_size_width () / 2 + epsilon   ) {
     //     G4cout << G4endl;
-    //     G4cout << "lens = " << m_lens_name << G4endl;
+    //     G4cout << "lens = " << *m_lens_name << G4endl;
     //     G4cout << "lens position = " << m_lens_position << G4endl;
     //     G4cout << "lens size = " << m_constructionMessenger->get_lens_size_depth() << " x " << m_constructionMessenger->get_lens_size_height() << " x " << m_constructionMessenger->get_lens_size_width() << G4endl;
     //     G4cout << "hit position = " << m_hit_position << G4endl;
@@ -163,8 +161,8 @@ G4RotationMatrix* LensHit::get_lens_rotationMatrix() {
     return m_lens_rotationMatrix;
 }
 
-G4String LensHit::get_lens_name() {
-    return m_lens_name;
+const G4String& LensHit::get_lens_name() {
+    return *m_lens_name;
 }
 
 G4int LensHit::get_lens_ID() {
@@ -187,8 +185,8 @@ G4ThreeVector LensHit::get_particle_position_initial() {
     return m_particle_position_initial;
 }
 
-G4String LensHit::get_hit_process() {
-    return m_hit_process;
+const G4String& LensHit::get_hit_process() {
+    return *m_hit_process;
 }
 
 G4ThreeVector LensHit::get_particle_direction() {
@@ -0,0 +1,228 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "LensResponseTable.hh"
+
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+
+using std::sqrt;
+using std::floor;
+using std::invalid_argument;
+using std::runtime_error;
+
+LensResponseTable::LensResponseTable( int    t_nBins_position , 
+                                      int    t_nBins_direction, 
+                                      int    t_nBins_energy   , 
+                                      int    t_nSamples       , 
+                                      double t_z_entrance     , 
+                                      double t_energy_min     , 
+                                      double t_energy_max      ) 
+    : m_nBins_position ( t_nBins_position  ),
+      m_nBins_direction( t_nBins_direction ),
+      m_nBins_energy   ( t_nBins_energy    ),
+      m_nSamples       ( t_nSamples        ),
+      m_z_entrance     ( t_z_entrance      ),
+      m_energy_min     ( t_energy_min      ),
+      m_energy_max     ( t_energy_max      ) {
+    if( m_nBins_position < 1 || m_nBins_direction < 1 || m_nBins_energy < 1 || m_nSamples < 1 )
+        throw invalid_argument( "LensResponseTable: the numbers of bins and samples have to be positive" );
+    if( m_energy_max < m_energy_min )
+        throw invalid_argument( "LensResponseTable: energy_max is smaller than energy_min" );
+}
+
+// Traces nSamples photons per cell, uniformly distributed over its position, direction cosines
+// and energy. The generator has a fixed seed, so a key always gives the same table.
+void LensResponseTable::make( const RayTracer& t_rayTracer ) {
+    m_halfWidth = t_rayTracer.get_halfWidth();
+    m_samples.assign( get_nCells() * m_nSamples, LensResponseTableSample{} );
+
+    std::mt19937_64                          generator( 12345 );
+    std::uniform_real_distribution< double > uniform  ( 0, 1  );
+
+    double width_position  = 2 * m_halfWidth / m_nBins_position;
+    double width_direction = 2.0 / m_nBins_direction;
+    double width_energy    = ( m_energy_max - m_energy_min ) / m_nBins_energy;
+
+    // one batch per entry position cell, holding all its directions
+    RayTracerBatch batch( size_t( m_nBins_direction ) * m_nBins_direction * m_nSamples );
+    size_t         index_samples{ 0 };
+    for( int n_energy = 0; n_energy < m_nBins_energy; n_energy++ ) {
+        for( int n_x = 0; n_x < m_nBins_position; n_x++ ) {
+            for( int n_y = 0; n_y < m_nBins_position; n_y++ ) {
+                // the refractive indices are evaluated once per batch, at the energy bin center
+                double energy = m_energy_min + ( n_energy + 0.5 ) * width_energy;
+
+                size_t index{ 0 };
+                for( int n_dx = 0; n_dx < m_nBins_direction; n_dx++ )
+                    for( int n_dy = 0; n_dy < m_nBins_direction; n_dy++ )
+                        for( int n_sample = 0; n_sample < m_nSamples; n_sample++ ) {
+                            double x  = -m_halfWidth + ( n_x  + uniform( generator ) ) * width_position ;
+                            double y  = -m_halfWidth + ( n_y  + uniform( generator ) ) * width_position ;
+                            double dx = -1           + ( n_dx + uniform( generator ) ) * width_direction;
+                            double dy = -1           + ( n_dy + uniform( generator ) ) * width_direction;
+                            double dz2 = 1 - dx * dx - dy * dy;
+                            // directions outside the unit circle are not moving towards the photosensor (missed)
+                            batch.set( index++, x, y, m_z_entrance, dx, dy, ( dz2 > 0 ) ? sqrt( dz2 ) : 0 );
+                        }
+
+                t_rayTracer.trace( batch, energy );
+
+                for( size_t i = 0; i < batch.size(); i++ ) {
+                    LensResponseTableSample& sample = m_samples[ index_samples++ ];
+                    sample.m_x               = float( batch.m_x              [ i ] );
+                    sample.m_y               = float( batch.m_y              [ i ] );
+                    sample.m_dx              = float( batch.m_dx             [ i ] );
+                    sample.m_dy              = float( batch.m_dy             [ i ] );
+                    sample.m_pathLength      = float( batch.m_pathLength     [ i ] );
+                    sample.m_groupPathLength = float( batch.m_groupPathLength[ i ] );
+                    sample.m_weight          = ( batch.m_status[ i ] == RayTracerBatch::m_detected ) ? float( batch.m_weight[ i ] ) : -1.f;
+                }
+            }
+        }
+    }
+}
+
+bool LensResponseTable::read( const std::string& t_fileName, const std::string& t_key ) {
+    std::ifstream file( t_fileName, std::ios::binary );
+    if( !file.is_open() )
+        return false;
+
+    char     magic[ 8 ];
+    int32_t  version;
+    uint64_t key_length;
+    file.read( magic                                    , sizeof( magic      ) );
+    file.read( reinterpret_cast< char* >( &version    ), sizeof( version    ) );
+    file.read( reinterpret_cast< char* >( &key_length ), sizeof( key_length ) );
+    if( !file || std::memcmp( magic, m_magic, sizeof( magic ) ) != 0 || version != m_version || key_length != t_key.size() )
+        return false;
+
+    std::string key( key_length, '\0' );
+    file.read( &key[ 0 ], key_length );
+    if( !file || key != t_key )
+        return false;
+
+    int32_t nBins[ 4 ];
+    double  limits[ 4 ];
+    file.read( reinterpret_cast< char* >( nBins  ), sizeof( nBins  ) );
+    file.read( reinterpret_cast< char* >( limits ), sizeof( limits ) );
+    if( !file || nBins[ 0 ] != m_nBins_position || nBins[ 1 ] != m_nBins_direction || nBins[ 2 ] != m_nBins_energy || nBins[ 3 ] != m_nSamples )
+        return false;
+    m_halfWidth = limits[ 1 ];
+
+    m_samples.resize( get_nCells() * m_nSamples );
+    file.read( reinterpret_cast< char* >( m_samples.data() ), m_samples.size() * sizeof( LensResponseTableSample ) );
+    if( !file ) {
+        m_samples.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void LensResponseTable::write( const std::string& t_fileName, const std::string& t_key ) const {
+    std::ofstream file( t_fileName, std::ios::binary );
+    if( !file.is_open() )
+        throw runtime_error( "LensResponseTable::write: cannot open `" + t_fileName + "'" );
+
+    int32_t  version   { m_version    };
+    uint64_t key_length{ t_key.size() };
+    int32_t  nBins [ 4 ]{ m_nBins_position, m_nBins_direction, m_nBins_energy, m_nSamples };
+    double   limits[ 4 ]{ m_z_entrance, m_halfWidth, m_energy_min, m_energy_max };
+    file.write( m_magic                                      , sizeof( m_magic    ) );
+    file.write( reinterpret_cast< const char* >( &version    ), sizeof( version    ) );
+    file.write( reinterpret_cast< const char* >( &key_length ), sizeof( key_length ) );
+    file.write( t_key.data()                                 , key_length          );
+    file.write( reinterpret_cast< const char* >( nBins       ), sizeof( nBins      ) );
+    file.write( reinterpret_cast< const char* >( limits      ), sizeof( limits     ) );
+    file.write( reinterpret_cast< const char* >( m_samples.data() ), m_samples.size() * sizeof( LensResponseTableSample ) );
+    if( !file )
+        throw runtime_error( "LensResponseTable::write: cannot write `" + t_fileName + "'" );
+}
+
+// Everything the table depends on, in full precision
+std::string LensResponseTable::get_key( const RayTracer& t_rayTracer ) const {
+    std::ostringstream key;
+    key << std::setprecision( 17 )
+        << "version "    << m_version << '\n'
+        << "bins "       << m_nBins_position << ' ' << m_nBins_direction << ' ' << m_nBins_energy << ' ' << m_nSamples << '\n'
+        << "entrance "   << m_z_entrance << '\n'
+        << "energy "     << m_energy_min << ' ' << m_energy_max << '\n'
+        << "photoSensor " << t_rayTracer.get_photoSensor_z() << ' ' << t_rayTracer.get_halfWidth() << '\n'
+        << "medium\n";
+    t_rayTracer.get_medium().print( key );
+    for( const RayTracerLens& lens : t_rayTracer.get_lenses() ) {
+        key << "lens";
+        for( int surface = 0; surface < 2; surface++ )
+            key << ' ' << lens.m_surface_radius_x[ surface ] << ' ' << lens.m_surface_radius_y[ surface ] << ' ' << lens.m_surface_vertex[ surface ];
+        key << ' ' << lens.m_yLimits << ' ' << lens.m_circular << ' ' << lens.m_position << '\n';
+        lens.m_material.print( key );
+    }
+    return key.str();
+}
+
+// 64 bit FNV-1a as in GeometryCache, stable across compilers and runs
+std::string LensResponseTable::get_hash( const std::string& t_key ) {
+    uint64_t hash{ 14695981039346656037ull };
+    for( unsigned char character : t_key ) {
+        hash ^= character;
+        hash *= 1099511628211ull;
+    }
+    std::ostringstream hash_hex;
+    hash_hex << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash;
+    return hash_hex.str();
+}
+
+// Cell of a photon entering at ( t_x, t_y ) along ( t_dx, t_dy, dz ) with energy t_energy; false outside the table
+bool LensResponseTable::get_cell( double t_x, double t_y, double t_dx, double t_dy, double t_energy, size_t& t_cell ) const {
+    if( m_halfWidth <= 0 || t_energy < m_energy_min || t_energy > m_energy_max )
+        return false;
+
+    auto bin = []( double t_value, double t_min, double t_max, int t_nBins ) {
+        int n = int( floor( ( t_value - t_min ) / ( t_max - t_min ) * t_nBins ) );
+        return ( n == t_nBins && t_value == t_max ) ? n - 1 : n;
+    };
+    int n_x      = bin( t_x , -m_halfWidth, m_halfWidth, m_nBins_position  );
+    int n_y      = bin( t_y , -m_halfWidth, m_halfWidth, m_nBins_position  );
+    int n_dx     = bin( t_dx, -1          , 1          , m_nBins_direction );
+    int n_dy     = bin( t_dy, -1          , 1          , m_nBins_direction );
+    int n_energy = ( m_energy_max > m_energy_min ) ? bin( t_energy, m_energy_min, m_energy_max, m_nBins_energy ) : 0;
+    if( n_x  < 0 || n_x  >= m_nBins_position  || n_y  < 0 || n_y  >= m_nBins_position  ||
+        n_dx < 0 || n_dx >= m_nBins_direction || n_dy < 0 || n_dy >= m_nBins_direction ||
+        n_energy < 0 || n_energy >= m_nBins_energy )
+        return false;
+
+    t_cell = ( ( size_t( n_energy ) * m_nBins_position + n_x ) * m_nBins_position + n_y ) * m_nBins_direction * m_nBins_direction
+           + n_dx * m_nBins_direction + n_dy;
+    return true;
+}
+
+// Sample of t_cell picked by t_uniform in [0, 1)
+const LensResponseTableSample& LensResponseTable::get_sample( size_t t_cell, double t_uniform ) const {
+    size_t index = std::min( size_t( t_uniform * m_nSamples ), size_t( m_nSamples - 1 ) );
+    return m_samples[ t_cell * m_nSamples + index ];
+}
+
+size_t LensResponseTable::get_nCells() const {
+    return size_t( m_nBins_energy ) * m_nBins_position * m_nBins_position * m_nBins_direction * m_nBins_direction;
+}
+
+double LensResponseTable::get_z_entrance() const {
+    return m_z_entrance;
+}
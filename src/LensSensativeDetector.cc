@@ -11,10 +11,11 @@
 
 #include "LensSensitiveDetector.hh"
 
-LensSensitiveDetector::LensSensitiveDetector( G4String t_name, G4int t_ID )
+#include <algorithm>
+
+LensSensitiveDetector::LensSensitiveDetector( G4String t_name )
     : G4VSensitiveDetector( t_name ) {
     m_name = t_name;
-    m_ID = t_ID;
     collectionName.insert( "LensSensitiveDetector" );
 }
 
@@ -23,15 +24,22 @@ void LensSensitiveDetector::Initialize( G4HCofThisEvent* t_hitCollectionOfThisEv
     if( m_lensHitsCollection_ID < 0 )
         m_lensHitsCollection_ID = G4SDManager::GetSDMpointer()->GetCollectionID( m_lensHitsCollection );
     t_hitCollectionOfThisEvent->AddHitsCollection( m_lensHitsCollection_ID, m_lensHitsCollection );
+    // previous event's hits are gone (EventArena::reset); only the copies hit then are reset,
+    // so the reset costs nothing per DSPD that was not hit
+    for( G4int copyNumber : m_copy_hit )
+        m_copy_firstHits[ copyNumber ] = nullptr;
+    m_copy_hit.clear();
 }
 
 G4bool LensSensitiveDetector::ProcessHits( G4Step* t_step, G4TouchableHistory* t_hist ) {
+    G4int copyNumber = m_copyNumberMap.get_ID( t_step->GetPreStepPoint()->GetTouchable() );
+
     LensHit* hit = new LensHit();
 
-    hit->set_lens_position            ( m_position                                                              );
-    hit->set_lens_rotationMatrix      ( m_rotationMatrix                                                        );
-    hit->set_lens_name                ( m_name                                                                  );
-    hit->set_lens_ID                  ( m_ID                                                                    );
+    hit->set_lens_position            ( get_position      ( copyNumber )                                        );
+    hit->set_lens_rotationMatrix      ( get_rotationMatrix( copyNumber )                                        );
+    hit->set_lens_name                ( get_name          ( copyNumber )                                        );
+    hit->set_lens_ID                  ( copyNumber                                                              );
     hit->set_hit_position_absolute    ( t_step->GetPostStepPoint()->GetPosition      ()                         );
     hit->set_hit_time                 ( t_step->GetPostStepPoint()->GetGlobalTime    ()                         );
     hit->set_hit_process              ( t_step->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName()   );
@@ -42,31 +50,86 @@ G4bool LensSensitiveDetector::ProcessHits( G4Step* t_step, G4TouchableHistory* t
 
     m_lensHitsCollection->insert( hit );
 
-    if( t_step->IsFirstStepInVolume() )
-        m_firstHit = hit;
+    if( t_step->IsFirstStepInVolume() ) {
+        if( !m_copy_firstHits[ copyNumber ] )
+            m_copy_hit.push_back( copyNumber );
+        m_copy_firstHits[ copyNumber ] = hit;
+    }
 
     return true;
 }
 
-G4String LensSensitiveDetector::get_name() {
+const G4String& LensSensitiveDetector::get_name() {
     return m_name;
 }
 
+// Hits keep a reference to the name, so the name of a surface lattice copy is made when
+// it is first asked for and kept until the sensitive detector is deleted
+const G4String& LensSensitiveDetector::get_name( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_names.size() ) )
+        return m_copy_names[ t_copyNumber ];
+    if( t_copyNumber >= G4int( m_surfaceLattice_names.size() ) || m_surfaceLattice_names[ t_copyNumber ].empty() ) {
+        const SurfaceLattice* surfaceLattice = SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber );
+        m_surfaceLattice_names.at( t_copyNumber ) = surfaceLattice->get_name( surfaceLattice->get_DSPD( t_copyNumber ) ) + m_surfaceLattice_suffix;
+    }
+    return m_surfaceLattice_names[ t_copyNumber ];
+}
+
+void LensSensitiveDetector::set_copyNumberMap( const CopyNumberMap& t_copyNumberMap ) {
+    m_copyNumberMap = t_copyNumberMap;
+}
+
+void LensSensitiveDetector::add_copy( const G4String     & t_name          , 
+                                      G4ThreeVector        t_position      , 
+                                      G4RotationMatrix   * t_rotationMatrix ) {
+    m_copy_names           .push_back( t_name           );
+    m_copy_positions       .push_back( t_position       );
+    m_copy_rotationMatrices.push_back( t_rotationMatrix );
+    m_copy_firstHits       .push_back( nullptr          );
+}
 
-void LensSensitiveDetector::set_position( G4ThreeVector t_position ) {
-    m_position = t_position;
+// Every DSPD of t_surfaceLattice, after the copies added so far. Copies are named after
+// their DSPD followed by t_suffix and sit at t_offset from the back of the photosensor,
+// in the DSPD frame.
+void LensSensitiveDetector::add_copies( const SurfaceLattice* t_surfaceLattice, 
+                                        const G4String      & t_suffix        , 
+                                        G4ThreeVector         t_offset         ) {
+    m_surfaceLattices.push_back( t_surfaceLattice );
+    m_surfaceLattice_suffix = t_suffix;
+    m_surfaceLattice_offset = t_offset;
+    m_copy_firstHits.resize( get_nCopies(), nullptr );
+    m_surfaceLattice_names.resize( std::max( G4int( m_surfaceLattice_names.size() ), 
+                                             t_surfaceLattice->get_DSPD_ID_begin() + t_surfaceLattice->get_amount( SurfaceLattice::DSPD ) ) );
 }
 
-void LensSensitiveDetector::set_rotationMatrix( G4RotationMatrix* t_rotationMatrix ) {
-    m_rotationMatrix = t_rotationMatrix;
+void LensSensitiveDetector::set_position( G4int t_copyNumber, G4ThreeVector t_position ) {
+    m_copy_positions.at( t_copyNumber ) = t_position;
 }
 
-G4ThreeVector LensSensitiveDetector::get_position() {
-    return m_position;
+// for the copies of add_copies(), when the lens moved (see DetectorConstruction::rebuild_lensSystem)
+void LensSensitiveDetector::set_copies_offset( G4ThreeVector t_offset ) {
+    m_surfaceLattice_offset = t_offset;
 }
 
-G4RotationMatrix* LensSensitiveDetector::get_rotationMatrix() {
-    return m_rotationMatrix;
+G4ThreeVector LensSensitiveDetector::get_position( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_positions.size() ) )
+        return m_copy_positions[ t_copyNumber ];
+    const SurfaceLattice* surfaceLattice = SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber );
+    return surfaceLattice->get_position( surfaceLattice->get_DSPD( t_copyNumber ) ) 
+         + *surfaceLattice->get_rotationMatrix( SurfaceLattice::DSPD ) * m_surfaceLattice_offset;
+}
+
+G4RotationMatrix* LensSensitiveDetector::get_rotationMatrix( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_rotationMatrices.size() ) )
+        return m_copy_rotationMatrices[ t_copyNumber ];
+    return SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber )->get_rotationMatrix( SurfaceLattice::DSPD );
+}
+
+G4int LensSensitiveDetector::get_nCopies() {
+    G4int nCopies = m_copy_names.size();
+    for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+        nCopies += surfaceLattice->get_amount( SurfaceLattice::DSPD );
+    return nCopies;
 }
 
 LensHitsCollection* LensSensitiveDetector::get_hitsCollection( const G4Event* t_event ) {
@@ -87,10 +150,6 @@ void LensSensitiveDetector::set_hitsCollection_ID( G4int t_lensHitsCollection_ID
     m_lensHitsCollection_ID = t_lensHitsCollection_ID;
 }
 
-G4int LensSensitiveDetector::get_ID() {
-    return m_ID;
-}
-
-LensHit* LensSensitiveDetector::get_firstHit() {
-    return m_firstHit;
+LensHit* LensSensitiveDetector::get_firstHit( G4int t_copyNumber ) {
+    return m_copy_firstHits[ t_copyNumber ];
 }
\ No newline at end of file
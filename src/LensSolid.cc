@@ -0,0 +1,505 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "LensSolid.hh"
+
+#include "G4BoundingEnvelope.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4VGraphicsScene.hh"
+#include "G4PolyhedronArbitrary.hh"
+#include "G4AutoLock.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+using std::abs;
+using std::sqrt;
+using std::min;
+using std::max;
+using std::vector;
+using std::pair;
+
+namespace { G4Mutex lensSolidPolyhedronMutex = G4MUTEX_INITIALIZER; }
+
+LensSolid::LensSolid( const G4String& t_name              ,
+                            G4double  t_surface_1_radius_x, G4double t_surface_1_radius_y,
+                            G4double  t_surface_2_radius_x, G4double t_surface_2_radius_y,
+                            G4double  t_thickness         , G4double t_yLimits           ,
+                            G4bool    t_circular          , G4double t_halfWidth          )
+    : G4VSolid( t_name ) {
+    m_surface_radius_x[ 0 ] = t_surface_1_radius_x;
+    m_surface_radius_y[ 0 ] = t_surface_1_radius_y;
+    m_surface_radius_x[ 1 ] = t_surface_2_radius_x;
+    m_surface_radius_y[ 1 ] = t_surface_2_radius_y;
+    m_thickness             = t_thickness         ;
+    m_yLimits               = t_yLimits           ;
+    m_circular              = t_circular          ;
+    m_halfWidth             = t_circular ? t_yLimits : t_halfWidth;
+    m_halfTolerance         = 0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+
+    if( m_thickness <= 0 || m_yLimits <= 0 || m_halfWidth <= 0 )
+        G4Exception( "LensSolid::LensSolid", "InvalidSetup", FatalErrorInArgument, 
+                     ( "Lens `" + t_name + "' has a non-positive thickness, yLimits or aperture." ).c_str() );
+    for( G4int i = 0; i < 2; i++ )
+        if( m_surface_radius_x[ i ] == 0 || m_surface_radius_y[ i ] <= m_yLimits )
+            G4Exception( "LensSolid::LensSolid", "InvalidSetup", FatalErrorInArgument, 
+                         ( "Lens `" + t_name + "' needs radius_x != 0 and radius_y > yLimits for both surfaces." ).c_str() );
+
+    m_surface_vertex[ 0 ] = -m_thickness / 2;
+    m_surface_vertex[ 1 ] =  m_thickness / 2;
+    for( G4int i = 0; i < 2; i++ ) {
+        m_surface_center   [ i ] = m_surface_vertex[ i ] - m_surface_radius_x[ i ];
+        m_surface_slope_max[ i ] = abs( get_surface_slope( i, m_yLimits * ( 1 - 1e-12 ) ) );
+        m_surface_z_yLimits[ i ] = get_surface_z( i, m_yLimits );
+    }
+
+    G4double rho_max = get_rho_max();
+    m_zMin = min( get_surface_z( 0, 0 ), get_surface_z( 0, rho_max ) );
+    m_zMax = max( get_surface_z( 1, 0 ), get_surface_z( 1, rho_max ) );
+    m_diagonal = sqrt( 8 * m_halfWidth * m_halfWidth + ( m_zMax - m_zMin ) * ( m_zMax - m_zMin ) );
+
+    // surfaces may not cross inside the aperture
+    for( G4int i = 0; i <= 64; i++ ) {
+        G4double rho = rho_max * i / 64;
+        if( get_surface_z( 1, rho ) - get_surface_z( 0, rho ) < 0 )
+            G4Exception( "LensSolid::LensSolid", "InvalidSetup", FatalErrorInArgument, 
+                         ( "Lens `" + t_name + "' surfaces intersect inside the aperture (negative edge thickness)." ).c_str() );
+    }
+}
+
+LensSolid::LensSolid( const LensSolid& t_lensSolid ) 
+    : G4VSolid( t_lensSolid ) {
+    *this = t_lensSolid;
+}
+
+LensSolid::~LensSolid() {
+    delete m_polyhedron;
+}
+
+LensSolid& LensSolid::operator=( const LensSolid& t_lensSolid ) {
+    if( this == &t_lensSolid )
+        return *this;
+
+    G4VSolid::operator=( t_lensSolid );
+    for( G4int i = 0; i < 2; i++ ) {
+        m_surface_radius_x [ i ] = t_lensSolid.m_surface_radius_x [ i ];
+        m_surface_radius_y [ i ] = t_lensSolid.m_surface_radius_y [ i ];
+        m_surface_vertex   [ i ] = t_lensSolid.m_surface_vertex   [ i ];
+        m_surface_center   [ i ] = t_lensSolid.m_surface_center   [ i ];
+        m_surface_slope_max[ i ] = t_lensSolid.m_surface_slope_max[ i ];
+        m_surface_z_yLimits[ i ] = t_lensSolid.m_surface_z_yLimits[ i ];
+    }
+    m_thickness     = t_lensSolid.m_thickness    ;
+    m_yLimits       = t_lensSolid.m_yLimits      ;
+    m_circular      = t_lensSolid.m_circular     ;
+    m_halfWidth     = t_lensSolid.m_halfWidth    ;
+    m_zMin          = t_lensSolid.m_zMin         ;
+    m_zMax          = t_lensSolid.m_zMax         ;
+    m_diagonal      = t_lensSolid.m_diagonal     ;
+    m_halfTolerance = t_lensSolid.m_halfTolerance;
+    m_cubicVolume   = t_lensSolid.m_cubicVolume  ;
+    delete m_polyhedron;
+    m_polyhedron    = nullptr;
+
+    return *this;
+}
+
+G4double LensSolid::get_surface_z( G4int t_surface, G4double t_rho ) const {
+    G4double u = min( t_rho, m_yLimits ) / m_surface_radius_y[ t_surface ];
+    return m_surface_vertex[ t_surface ] - m_surface_radius_x[ t_surface ] * ( 1 - sqrt( 1 - u * u ) );
+}
+
+G4double LensSolid::get_surface_slope( G4int t_surface, G4double t_rho ) const {
+    if( t_rho >= m_yLimits )
+        return 0;
+    G4double u = t_rho / m_surface_radius_y[ t_surface ];
+    return -m_surface_radius_x[ t_surface ] * u / ( m_surface_radius_y[ t_surface ] * sqrt( 1 - u * u ) );
+}
+
+G4double LensSolid::get_rho_max() const {
+    return m_circular ? m_yLimits : m_halfWidth * sqrt( 2. );
+}
+
+// Signed distance to the aperture prism (negative inside).
+G4double LensSolid::get_distance_aperture( G4double t_x, G4double t_y ) const {
+    if( m_circular )
+        return sqrt( t_x * t_x + t_y * t_y ) - m_yLimits;
+
+    G4double dx = abs( t_x ) - m_halfWidth;
+    G4double dy = abs( t_y ) - m_halfWidth;
+    if( dx > 0 || dy > 0 ) {
+        dx = max( dx, 0. );
+        dy = max( dy, 0. );
+        return sqrt( dx * dx + dy * dy );
+    }
+    return max( dx, dy );
+}
+
+// First order signed distance to surface 1 (back) or 2 (front), positive outside.
+G4double LensSolid::get_distance_surface( G4int t_surface, const G4ThreeVector& t_p ) const {
+    G4double rho   = t_p.perp();
+    G4double slope = get_surface_slope( t_surface, rho );
+    G4double dz    = t_p.z() - get_surface_z( t_surface, rho );
+    return ( t_surface == 1 ? dz : -dz ) / sqrt( 1 + slope * slope );
+}
+
+G4bool LensSolid::is_inside( const G4ThreeVector& t_p ) const {
+    if( t_p.z() < m_zMin || t_p.z() > m_zMax || get_distance_aperture( t_p.x(), t_p.y() ) > 0 )
+        return false;
+    G4double rho = t_p.perp();
+    return t_p.z() >= get_surface_z( 0, rho ) && t_p.z() <= get_surface_z( 1, rho );
+}
+
+EInside LensSolid::Inside( const G4ThreeVector& t_p ) const {
+    G4double distance = max( { get_distance_aperture( t_p.x(), t_p.y() ), 
+                               get_distance_surface ( 0, t_p          ), 
+                               get_distance_surface ( 1, t_p          )  } );
+    if( distance >  m_halfTolerance ) return kOutside;
+    if( distance < -m_halfTolerance ) return kInside ;
+    return kSurface;
+}
+
+G4ThreeVector LensSolid::SurfaceNormal( const G4ThreeVector& t_p ) const {
+    G4double distance[ 3 ] = { get_distance_aperture( t_p.x(), t_p.y() ),
+                               get_distance_surface ( 0, t_p           ),
+                               get_distance_surface ( 1, t_p           ) };
+    G4double distance_max = max( { distance[ 0 ], distance[ 1 ], distance[ 2 ] } );
+    G4double rho          = t_p.perp();
+    G4ThreeVector normal;
+
+    for( G4int i = 0; i < 3; i++ ) {
+        if( abs( distance[ i ] ) > m_halfTolerance && distance[ i ] != distance_max )
+            continue;
+        if( i == 0 ) {
+            if( m_circular )
+                normal += rho > 0 ? G4ThreeVector( t_p.x() / rho, t_p.y() / rho, 0 ) : G4ThreeVector( 1, 0, 0 );
+            else if( abs( t_p.x() ) >= abs( t_p.y() ) )
+                normal += G4ThreeVector( t_p.x() >= 0 ? 1 : -1, 0, 0 );
+            else
+                normal += G4ThreeVector( 0, t_p.y() >= 0 ? 1 : -1, 0 );
+        } else {
+            G4int    surface = i - 1;
+            G4double sign    = surface == 1 ? 1 : -1;
+            G4double slope   = get_surface_slope( surface, rho );
+            G4double nx      = rho > 0 ? -sign * slope * t_p.x() / rho : 0;
+            G4double ny      = rho > 0 ? -sign * slope * t_p.y() / rho : 0;
+            normal += G4ThreeVector( nx, ny, sign ).unit();
+        }
+    }
+
+    return normal.unit();
+}
+
+// All parameters s > halfTolerance at which p + s v may cross a boundary, sorted.
+// Crossings with the full ellipsoids, the flat rims and the aperture walls are
+// collected without checking their domain; callers classify the intervals between
+// them, so a spurious crossing only splits an interval.
+G4int LensSolid::get_crossings( const G4ThreeVector& t_p, const G4ThreeVector& t_v, G4double* t_s ) const {
+    G4int n = 0;
+    auto add = [ & ]( G4double t_sCandidate ) {
+        if( t_sCandidate > m_halfTolerance && n < m_crossings_max )
+            t_s[ n++ ] = t_sCandidate;
+    };
+
+    for( G4int i = 0; i < 2; i++ ) {
+        G4double ry2 = m_surface_radius_y[ i ] * m_surface_radius_y[ i ];
+        G4double rx2 = m_surface_radius_x[ i ] * m_surface_radius_x[ i ];
+        G4double dz  = t_p.z() - m_surface_center[ i ];
+        G4double a   = ( t_v.x() * t_v.x() + t_v.y() * t_v.y() ) / ry2 + t_v.z() * t_v.z() / rx2;
+        G4double b   = ( t_p.x() * t_v.x() + t_p.y() * t_v.y() ) / ry2 + dz * t_v.z() / rx2;
+        G4double c   = ( t_p.x() * t_p.x() + t_p.y() * t_p.y() ) / ry2 + dz * dz / rx2 - 1;
+        G4double discriminant = b * b - a * c;
+        if( discriminant >= 0 ) {
+            G4double q = -( b + ( b >= 0 ? 1 : -1 ) * sqrt( discriminant ) );
+            add( q / a );
+            if( q != 0 )
+                add( c / q );
+        }
+        if( t_v.z() != 0 )
+            add( ( m_surface_z_yLimits[ i ] - t_p.z() ) / t_v.z() );
+    }
+
+    if( m_circular ) {
+        G4double a = t_v.x() * t_v.x() + t_v.y() * t_v.y();
+        G4double b = t_p.x() * t_v.x() + t_p.y() * t_v.y();
+        G4double c = t_p.x() * t_p.x() + t_p.y() * t_p.y() - m_yLimits * m_yLimits;
+        G4double discriminant = b * b - a * c;
+        if( a > 0 && discriminant >= 0 ) {
+            add( ( -b - sqrt( discriminant ) ) / a );
+            add( ( -b + sqrt( discriminant ) ) / a );
+        }
+    } else {
+        if( t_v.x() != 0 ) {
+            add( (  m_halfWidth - t_p.x() ) / t_v.x() );
+            add( ( -m_halfWidth - t_p.x() ) / t_v.x() );
+        }
+        if( t_v.y() != 0 ) {
+            add( (  m_halfWidth - t_p.y() ) / t_v.y() );
+            add( ( -m_halfWidth - t_p.y() ) / t_v.y() );
+        }
+    }
+
+    std::sort( t_s, t_s + n );
+    return n;
+}
+
+G4double LensSolid::DistanceToIn( const G4ThreeVector& t_p, const G4ThreeVector& t_v ) const {
+    // reject rays missing the bounding box
+    G4double sMin = 0, sMax = kInfinity;
+    G4double pMin[ 3 ] = { -m_halfWidth, -m_halfWidth, m_zMin };
+    G4double pMax[ 3 ] = {  m_halfWidth,  m_halfWidth, m_zMax };
+    for( G4int i = 0; i < 3; i++ ) {
+        if( t_v[ i ] == 0 ) {
+            if( t_p[ i ] < pMin[ i ] - m_halfTolerance || t_p[ i ] > pMax[ i ] + m_halfTolerance )
+                return kInfinity;
+            continue;
+        }
+        G4double s1 = ( pMin[ i ] - m_halfTolerance - t_p[ i ] ) / t_v[ i ];
+        G4double s2 = ( pMax[ i ] + m_halfTolerance - t_p[ i ] ) / t_v[ i ];
+        sMin = max( sMin, min( s1, s2 ) );
+        sMax = min( sMax, max( s1, s2 ) );
+        if( sMin > sMax )
+            return kInfinity;
+    }
+
+    G4double s[ m_crossings_max ];
+    G4int    n = get_crossings( t_p, t_v, s );
+
+    G4double sStart = 0;
+    for( G4int k = 0; k <= n; k++ ) {
+        G4double sEnd = k < n ? s[ k ] : sStart + m_diagonal;
+        if( is_inside( t_p + 0.5 * ( sStart + sEnd ) * t_v ) )
+            return sStart;
+        sStart = sEnd;
+    }
+
+    return kInfinity;
+}
+
+G4double LensSolid::DistanceToIn( const G4ThreeVector& t_p ) const {
+    G4double safety = max( { get_distance_aperture( t_p.x(), t_p.y() ),
+                             ( t_p.z() - get_surface_z( 1, t_p.perp() ) ) / sqrt( 1 + m_surface_slope_max[ 1 ] * m_surface_slope_max[ 1 ] ),
+                             ( get_surface_z( 0, t_p.perp() ) - t_p.z() ) / sqrt( 1 + m_surface_slope_max[ 0 ] * m_surface_slope_max[ 0 ] ) } );
+    return safety > 0 ? safety : 0;
+}
+
+G4double LensSolid::DistanceToOut( const G4ThreeVector& t_p        , const G4ThreeVector& t_v, 
+                                   const G4bool         t_calcNorm , G4bool*              t_validNorm, 
+                                         G4ThreeVector* t_n                                           ) const {
+    G4double s[ m_crossings_max ];
+    G4int    n = get_crossings( t_p, t_v, s );
+
+    G4double sExit  = n > 0 ? s[ n - 1 ] : 0;
+    G4double sStart = 0;
+    for( G4int k = 0; k <= n; k++ ) {
+        G4double sEnd = k < n ? s[ k ] : sStart + m_diagonal;
+        if( !is_inside( t_p + 0.5 * ( sStart + sEnd ) * t_v ) ) {
+            sExit = sStart;
+            break;
+        }
+        sStart = sEnd;
+    }
+
+    if( t_calcNorm ) {
+        *t_validNorm = false;
+        *t_n         = SurfaceNormal( t_p + sExit * t_v );
+    }
+
+    return sExit;
+}
+
+G4double LensSolid::DistanceToOut( const G4ThreeVector& t_p ) const {
+    G4double safety = min( { -get_distance_aperture( t_p.x(), t_p.y() ),
+                             ( get_surface_z( 1, t_p.perp() ) - t_p.z() ) / sqrt( 1 + m_surface_slope_max[ 1 ] * m_surface_slope_max[ 1 ] ),
+                             ( t_p.z() - get_surface_z( 0, t_p.perp() ) ) / sqrt( 1 + m_surface_slope_max[ 0 ] * m_surface_slope_max[ 0 ] ) } );
+    return safety > 0 ? safety : 0;
+}
+
+void LensSolid::BoundingLimits( G4ThreeVector& t_pMin, G4ThreeVector& t_pMax ) const {
+    t_pMin.set( -m_halfWidth, -m_halfWidth, m_zMin );
+    t_pMax.set(  m_halfWidth,  m_halfWidth, m_zMax );
+}
+
+G4bool LensSolid::CalculateExtent( const EAxis              t_axis      ,
+                                   const G4VoxelLimits    & t_voxelLimit,
+                                   const G4AffineTransform& t_transform ,
+                                         G4double         & t_min       ,
+                                         G4double         & t_max        ) const {
+    G4ThreeVector pMin, pMax;
+    BoundingLimits( pMin, pMax );
+    G4BoundingEnvelope boundingEnvelope( pMin, pMax );
+    return boundingEnvelope.CalculateExtent( t_axis, t_voxelLimit, t_transform, t_min, t_max );
+}
+
+// Midpoint rule over the aperture, computed on first use.
+G4double LensSolid::GetCubicVolume() {
+    if( m_cubicVolume > 0 )
+        return m_cubicVolume;
+
+    const G4int nSteps = 400;
+    G4double step = 2 * m_halfWidth / nSteps;
+    for( G4int i = 0; i < nSteps; i++ )
+        for( G4int j = 0; j < nSteps; j++ ) {
+            G4double x = -m_halfWidth + ( i + 0.5 ) * step;
+            G4double y = -m_halfWidth + ( j + 0.5 ) * step;
+            if( get_distance_aperture( x, y ) > 0 )
+                continue;
+            G4double rho = sqrt( x * x + y * y );
+            m_cubicVolume += ( get_surface_z( 1, rho ) - get_surface_z( 0, rho ) ) * step * step;
+        }
+
+    return m_cubicVolume;
+}
+
+G4ThreeVector LensSolid::get_aperture_point( G4double t_u, G4double t_v ) const {
+    // t_u, t_v in [ -1, 1 ]; squircle mapping onto the disk for circular apertures
+    if( m_circular )
+        return G4ThreeVector( m_yLimits * t_u * sqrt( 1 - t_v * t_v / 2 ), m_yLimits * t_v * sqrt( 1 - t_u * t_u / 2 ), 0 );
+    return G4ThreeVector( m_halfWidth * t_u, m_halfWidth * t_v, 0 );
+}
+
+G4ThreeVector LensSolid::GetPointOnSurface() const {
+    G4double rho_max   = get_rho_max();
+    G4double area_face = m_circular ? CLHEP::pi * m_yLimits * m_yLimits : 4 * m_halfWidth * m_halfWidth;
+    G4double area_side = ( m_circular ? CLHEP::twopi * m_yLimits : 8 * m_halfWidth ) 
+                       * ( get_surface_z( 1, rho_max ) - get_surface_z( 0, rho_max ) );
+
+    G4double select = G4UniformRand() * ( 2 * area_face + area_side );
+    if( select < 2 * area_face ) {
+        G4ThreeVector point;
+        do {
+            point.set( ( 2 * G4UniformRand() - 1 ) * m_halfWidth, ( 2 * G4UniformRand() - 1 ) * m_halfWidth, 0 );
+        } while( get_distance_aperture( point.x(), point.y() ) > 0 );
+        point.setZ( get_surface_z( select < area_face ? 0 : 1, point.perp() ) );
+        return point;
+    }
+
+    G4ThreeVector point;
+    if( m_circular ) {
+        G4double phi = CLHEP::twopi * G4UniformRand();
+        point.set( m_yLimits * cos( phi ), m_yLimits * sin( phi ), 0 );
+    } else {
+        G4double t    = ( 2 * G4UniformRand() - 1 ) * m_halfWidth;
+        G4int    side = G4int( 4 * G4UniformRand() );
+        if     ( side == 0 ) point.set(  m_halfWidth, t, 0 );
+        else if( side == 1 ) point.set( -m_halfWidth, t, 0 );
+        else if( side == 2 ) point.set( t,  m_halfWidth, 0 );
+        else                 point.set( t, -m_halfWidth, 0 );
+    }
+    G4double z_back  = get_surface_z( 0, point.perp() );
+    G4double z_front = get_surface_z( 1, point.perp() );
+    point.setZ( z_back + G4UniformRand() * ( z_front - z_back ) );
+    return point;
+}
+
+G4GeometryType LensSolid::GetEntityType() const {
+    return G4String( "LensSolid" );
+}
+
+G4VSolid* LensSolid::Clone() const {
+    return new LensSolid( *this );
+}
+
+ostream& LensSolid::StreamInfo( ostream& t_os ) const {
+    t_os << "-----------------------------------------------------------\n"
+         << "    *** Dump for solid - " << GetName() << " ***\n"
+         << "    ===================================================\n"
+         << " Solid type: LensSolid\n"
+         << " Parameters: \n"
+         << "    surface 1 radius x: " << m_surface_radius_x[ 0 ] / CLHEP::mm << " mm \n"
+         << "    surface 1 radius y: " << m_surface_radius_y[ 0 ] / CLHEP::mm << " mm \n"
+         << "    surface 2 radius x: " << m_surface_radius_x[ 1 ] / CLHEP::mm << " mm \n"
+         << "    surface 2 radius y: " << m_surface_radius_y[ 1 ] / CLHEP::mm << " mm \n"
+         << "    thickness         : " << m_thickness             / CLHEP::mm << " mm \n"
+         << "    yLimits           : " << m_yLimits               / CLHEP::mm << " mm \n"
+         << "    aperture          : " << ( m_circular ? "circular" : "rectangular" ) << "\n"
+         << "    aperture halfWidth: " << m_halfWidth             / CLHEP::mm << " mm \n"
+         << "-----------------------------------------------------------\n";
+    return t_os;
+}
+
+void LensSolid::DescribeYourselfTo( G4VGraphicsScene& t_scene ) const {
+    t_scene.AddSolid( *this );
+}
+
+G4Polyhedron* LensSolid::CreatePolyhedron() const {
+    const G4int n       = m_polyhedron_nDivisions;
+    const G4int nFace   = ( n + 1 ) * ( n + 1 );
+    auto index = [ & ]( G4int t_surface, G4int t_i, G4int t_j ) {
+        return 1 + t_surface * nFace + t_i * ( n + 1 ) + t_j;
+    };
+
+    G4PolyhedronArbitrary* polyhedron = new G4PolyhedronArbitrary( 2 * nFace, 2 * n * n + 4 * n );
+    for( G4int surface = 0; surface < 2; surface++ )
+        for( G4int i = 0; i <= n; i++ )
+            for( G4int j = 0; j <= n; j++ ) {
+                G4ThreeVector point = get_aperture_point( 2. * i / n - 1, 2. * j / n - 1 );
+                point.setZ( get_surface_z( surface, point.perp() ) );
+                polyhedron->AddVertex( point );
+            }
+
+    for( G4int i = 0; i < n; i++ )
+        for( G4int j = 0; j < n; j++ ) {
+            polyhedron->AddFacet( index( 1, i, j ), index( 1, i + 1, j ), index( 1, i + 1, j + 1 ), index( 1, i, j + 1 ) );
+            polyhedron->AddFacet( index( 0, i, j ), index( 0, i, j + 1 ), index( 0, i + 1, j + 1 ), index( 0, i + 1, j ) );
+        }
+
+    // side walls, walking the aperture boundary counter clockwise seen from +z
+    vector< pair< G4int, G4int > > boundary;
+    for( G4int k = 0; k < n; k++ ) boundary.push_back( { k    , 0     } );
+    for( G4int k = 0; k < n; k++ ) boundary.push_back( { n    , k     } );
+    for( G4int k = 0; k < n; k++ ) boundary.push_back( { n - k, n     } );
+    for( G4int k = 0; k < n; k++ ) boundary.push_back( { 0    , n - k } );
+    for( size_t k = 0; k < boundary.size(); k++ ) {
+        auto a = boundary[ k ];
+        auto b = boundary[ ( k + 1 ) % boundary.size() ];
+        polyhedron->AddFacet( index( 1, a.first, a.second ), index( 0, a.first, a.second ), 
+                              index( 0, b.first, b.second ), index( 1, b.first, b.second ) );
+    }
+
+    polyhedron->SetReferences();
+    return polyhedron;
+}
+
+G4Polyhedron* LensSolid::GetPolyhedron() const {
+    if( !m_polyhedron ) {
+        G4AutoLock lock( &lensSolidPolyhedronMutex );
+        if( !m_polyhedron )
+            m_polyhedron = CreatePolyhedron();
+    }
+    return m_polyhedron;
+}
+
+G4double LensSolid::get_zMin() const {
+    return m_zMin;
+}
+
+G4double LensSolid::get_zMax() const {
+    return m_zMax;
+}
+
+G4double LensSolid::get_thickness() const {
+    return m_thickness;
+}
+
+G4double LensSolid::get_yLimits() const {
+    return m_yLimits;
+}
+
+G4bool LensSolid::get_circular() const {
+    return m_circular;
+}
+
+G4double LensSolid::get_halfWidth() const {
+    return m_halfWidth;
+}
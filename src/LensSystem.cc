@@ -10,6 +10,7 @@
 //*/////////////////////////////////////////////////////////////////////////*//
 
 #include "LensSystem.hh"
+#include "Materials.hh"
 
 LensSystem::LensSystem( const G4String& t_name, G4bool t_makeLenses ) {
     m_name = t_name;
@@ -37,7 +38,8 @@ void LensSystem::add_lens( Lens* t_lens ) {
 void  LensSystem::place( G4RotationMatrix* t_rotationMatrix     , 
                          G4ThreeVector     t_translationVector  , 
                          G4LogicalVolume * t_motherLogicalVolume, 
-                         G4bool            t_isMany              ) {
+                         G4bool            t_isMany             ,
+                         G4int             t_copyNumber          ) {
     m_rotationMatrix    = t_rotationMatrix;
     m_translationVector = t_translationVector;
 
@@ -48,8 +50,45 @@ void  LensSystem::place( G4RotationMatrix* t_rotationMatrix     ,
         if( position.z() < m_relativePosition_front.z() )
             m_relativePosition_front = position;
         G4cout << "LensSystem::place: " << m_name << " lens " << nLens << " position: " << position << G4endl;
-        position = *t_rotationMatrix * position;
-        m_lenses[ nLens ]->place( t_rotationMatrix, t_translationVector + position, t_motherLogicalVolume, t_isMany );
+        if( t_rotationMatrix )
+            position = *t_rotationMatrix * position;
+        m_lenses[ nLens ]->place( t_rotationMatrix, t_translationVector + position, t_motherLogicalVolume, t_isMany, t_copyNumber );
+    }
+    m_relativePosition_center = ( m_relativePosition_front + m_relativePosition_back ) / 2;
+}
+
+// Sequential ray tracer of the current lenses (see RayTracer), in the frame of this lens system:
+// the photosensor surface is the plane z = 0 and the DSPD walls are at x, y = +-width / 2.
+RayTracer LensSystem::make_rayTracer() {
+    RayTracer rayTracer( Materials::get_rayTracerMaterial( m_constructionMessenger->get_detector_medium_material() ),
+                         0, m_constructionMessenger->get_photoSensor_surface_size_width() / 2 );
+    for( Lens* lens : m_lenses )
+        rayTracer.add_lens( lens->make_rayTracerLens() );
+    return rayTracer;
+}
+
+// Rebuilds every lens from the current lens parameters (see Lens::rebuild). The lenses are put
+// back in index order, so sort_lenses() has to be called again if they were sorted.
+void LensSystem::rebuild() {
+    if( m_constructionMessenger->get_lens_amount() != m_lenses.size() )
+        G4Exception( "LensSystem::rebuild", "InvalidArgument", FatalException, 
+                     "The lens amount cannot change between runs. Start a new DSPS process instead." );
+
+    vector< Lens* > lenses( m_lenses.size() );
+    for( Lens* lens : m_lenses )
+        lenses[ lens->get_index() ] = lens;
+    m_lenses = lenses;
+
+    m_relativePosition_front = G4ThreeVector();
+    m_relativePosition_back  = G4ThreeVector();
+    for( G4int nLens{ 0 }; nLens < m_lenses.size(); nLens++ ) {
+        m_lenses[ nLens ]->rebuild();
+
+        G4ThreeVector position( 0, 0, m_constructionMessenger->get_lens_position( nLens ) );
+        if( position.z() > m_relativePosition_back.z() )
+            m_relativePosition_back = position;
+        if( position.z() < m_relativePosition_front.z() )
+            m_relativePosition_front = position;
     }
     m_relativePosition_center = ( m_relativePosition_front + m_relativePosition_back ) / 2;
 }
@@ -173,6 +212,10 @@ G4ThreeVector LensSystem::get_position_back() {
     return m_translationVector + *m_rotationMatrix * m_relativePosition_back;
 }
 
+G4ThreeVector LensSystem::get_relativePosition_front() {
+    return m_relativePosition_front;
+}
+
 G4ThreeVector LensSystem::get_position( const char* t_relativePosition ) {
     G4String relativePosition( t_relativePosition );
     to_lower( relativePosition );
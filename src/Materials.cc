@@ -31,6 +31,44 @@ void Materials::delete_instance() {
     }
 }
 
+// Copies the RINDEX and ABSLENGTH tables of a material for the ray tracer (see RayTracer)
+RayTracerMaterial Materials::get_rayTracerMaterial( const G4String& t_name ) {
+    G4Material               * material                = G4Material::GetMaterial( t_name );
+    G4MaterialPropertiesTable* materialPropertiesTable = ( material ) ? material->GetMaterialPropertiesTable() : nullptr;
+    G4MaterialPropertyVector * rindex                  = ( materialPropertiesTable ) ? materialPropertiesTable->GetProperty( "RINDEX" ) : nullptr;
+    if( !rindex ) {
+        G4Exception( "Materials::get_rayTracerMaterial", "InvalidSetup", FatalException, 
+                     ( "Material `" + t_name + "' has no refractive index." ).c_str() );
+        return RayTracerMaterial();
+    }
+
+    vector< G4double > rindex_energies, rindex_values;
+    for( size_t i = 0; i < rindex->GetVectorLength(); i++ ) {
+        rindex_energies.push_back( rindex->Energy( i ) );
+        rindex_values  .push_back( ( *rindex )[ i ]    );
+    }
+
+    vector< G4double > absorptionLength_energies, absorptionLength_values;
+    G4MaterialPropertyVector* absorptionLength = materialPropertiesTable->GetProperty( "ABSLENGTH" );
+    if( absorptionLength )
+        for( size_t i = 0; i < absorptionLength->GetVectorLength(); i++ ) {
+            absorptionLength_energies.push_back( absorptionLength->Energy( i ) );
+            absorptionLength_values  .push_back( ( *absorptionLength )[ i ]    );
+        }
+
+    vector< G4double > scatteringLength_energies, scatteringLength_values;
+    G4MaterialPropertyVector* scatteringLength = materialPropertiesTable->GetProperty( "RAYLEIGH" );
+    if( scatteringLength )
+        for( size_t i = 0; i < scatteringLength->GetVectorLength(); i++ ) {
+            scatteringLength_energies.push_back( scatteringLength->Energy( i ) );
+            scatteringLength_values  .push_back( ( *scatteringLength )[ i ]    );
+        }
+
+    return RayTracerMaterial( rindex_energies          , rindex_values          , 
+                              absorptionLength_energies, absorptionLength_values,
+                              scatteringLength_energies, scatteringLength_values );
+}
+
 void Materials::print_materials() {
     G4cout << "Attemting to use materials:" << G4endl
            << "  world_medium--------: " << m_constructionMessenger->get_world_material              () << G4endl
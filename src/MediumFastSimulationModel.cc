@@ -0,0 +1,85 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "MediumFastSimulationModel.hh"
+
+MediumFastSimulationModel::MediumFastSimulationModel( const G4String         & t_name    , 
+                                                            G4Region         * t_region  , 
+                                                      const RayTracerMaterial& t_medium  , 
+                                                      const G4ThreeVector    & t_halfSize ) 
+    : G4VFastSimulationModel( t_name, t_region ),
+      m_photonTransport( t_medium, t_halfSize.x(), t_halfSize.y(), t_halfSize.z() ) {
+}
+
+G4bool MediumFastSimulationModel::IsApplicable( const G4ParticleDefinition& t_particleDefinition ) {
+    return &t_particleDefinition == G4OpticalPhoton::Definition();
+}
+
+// Triggers on photons in the medium volume itself (not in a wall) that are inside the walls or
+// enter that box. Transported photons end on its faces moving outwards, so they are not caught again.
+G4bool MediumFastSimulationModel::ModelTrigger( const G4FastTrack& t_fastTrack ) {
+    if( !m_constructionMessenger->get_fastSimulation_medium() )
+        return false;
+
+    const G4Track* track = t_fastTrack.GetPrimaryTrack();
+    if( track->GetVolume()->GetLogicalVolume() != t_fastTrack.GetEnvelopeLogicalVolume() )
+        return false;
+
+    G4ThreeVector position  = t_fastTrack.GetPrimaryTrackLocalPosition ();
+    G4ThreeVector direction = t_fastTrack.GetPrimaryTrackLocalDirection();
+    return m_photonTransport.contains( position .x(), position .y(), position .z(), 
+                                       direction.x(), direction.y(), direction.z() );
+}
+
+void MediumFastSimulationModel::DoIt( const G4FastTrack& t_fastTrack, G4FastStep& t_fastStep ) {
+    const G4Track* track = t_fastTrack.GetPrimaryTrack();
+    update_generator();
+
+    G4ThreeVector position  = t_fastTrack.GetPrimaryTrackLocalPosition ();
+    G4ThreeVector direction = t_fastTrack.GetPrimaryTrackLocalDirection();
+    m_batch.set( 0, position .x(), position .y(), position .z(), 
+                    direction.x(), direction.y(), direction.z() );
+    m_photonTransport.transport( m_batch, track->GetKineticEnergy(), m_generator );
+
+    t_fastStep.ProposePrimaryTrackPathLength( m_batch.m_pathLength[ 0 ] );
+    if( m_batch.m_status[ 0 ] == RayTracerBatch::m_absorbed ) {
+        t_fastStep.KillPrimaryTrack();
+        return;
+    }
+
+    G4ThreeVector position_final ( m_batch.m_x [ 0 ], m_batch.m_y [ 0 ], m_batch.m_z [ 0 ] );
+    G4ThreeVector direction_final( m_batch.m_dx[ 0 ], m_batch.m_dy[ 0 ], m_batch.m_dz[ 0 ] );
+    t_fastStep.ProposePrimaryTrackFinalPosition         ( position_final  );
+    t_fastStep.ProposePrimaryTrackFinalMomentumDirection( direction_final );
+    t_fastStep.ProposePrimaryTrackFinalTime( track->GetGlobalTime() + m_batch.m_groupPathLength[ 0 ] / c_light );
+
+    // the scattered photon keeps the part of its polarisation transverse to the new direction
+    if( direction_final != direction ) {
+        G4ThreeVector polarization = t_fastTrack.GetPrimaryTrackLocalPolarization();
+        polarization -= polarization.dot( direction_final ) * direction_final;
+        if( polarization.mag2() < 1e-12 )
+            polarization = direction_final.orthogonal();
+        t_fastStep.ProposePrimaryTrackFinalPolarization( polarization.unit() );
+    }
+}
+
+void MediumFastSimulationModel::update_generator() {
+    G4int runID   = G4RunManager  ::GetRunManager  ()->GetCurrentRun         ()->GetRunID  ();
+    G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+    if( runID == m_generator_runID && eventID == m_generator_eventID )
+        return;
+
+    m_generator.seed( static_cast< std::uint64_t >( G4UniformRand() * 4294967296. ) << 32 |
+                      static_cast< std::uint64_t >( G4UniformRand() * 4294967296. )         );
+    m_generator_runID   = runID  ;
+    m_generator_eventID = eventID;
+}
@@ -11,8 +11,6 @@
 
 #include "MediumHit.hh"
 
-G4ThreadLocal G4Allocator< MediumHit >* MediumHitAllocator;
-
 MediumHit::MediumHit() {
 }
 
@@ -28,7 +26,7 @@ MediumHit::MediumHit( const G4ThreeVector    & t_medium_position          ,
                             G4bool             t_particle_transmittance    ) {
     m_medium_position           = t_medium_position          ;
     m_medium_rotationMatrix     = t_medium_rotationMatrix    ;
-    m_medium_name               = t_medium_name              ;
+    m_medium_name               = &t_medium_name             ;
     m_medium_ID                 = t_medium_ID                ;
     m_hit_position_absolute     = t_hit_position_absolute    ;
     m_hit_time                  = t_hit_time                 ;
@@ -72,7 +70,7 @@ void MediumHit::Print() {
 std::ostream& operator<<( std::ostream& t_os, const MediumHit& t_mediumHit ) {
     t_os << "[" << "medium_position="       <<  t_mediumHit.m_medium_position              << ", \n"
                 << "medium_rotationMatrix=" << *t_mediumHit.m_medium_rotationMatrix        << ", \n"
-                << "medium_name="           <<  t_mediumHit.m_medium_name                  << ", \n"
+                << "medium_name="           << *t_mediumHit.m_medium_name                  << ", \n"
                 << "medium_ID="             <<  t_mediumHit.m_medium_ID                    << ", \n"
                 << "hit_position_absolute=" <<  t_mediumHit.m_hit_position_absolute        << ", \n"
                 << "hit_time="              <<  t_mediumHit.m_hit_time                     << ", \n"
@@ -103,7 +101,7 @@ void MediumHit::set_medium_rotationMatrix( G4RotationMatrix* t_medium_rotationMa
 }
 
 void MediumHit::set_medium_name( const G4String& t_medium_name ) {
-    m_medium_name = t_medium_name;
+    m_medium_name = &t_medium_name;
 }
 
 void MediumHit::set_medium_ID( G4int t_medium_ID ) {
@@ -127,7 +125,7 @@ void MediumHit::set_particle_position_initial( G4ThreeVector t_particle_position
 }
 
 void MediumHit::set_hit_process( const G4String& t_hit_process ) {
-    m_hit_process = t_hit_process;
+    m_hit_process = &t_hit_process;
 }
 
 void MediumHit::set_particle_transmittance( G4bool t_particle_transmittance ) {
@@ -150,8 +148,8 @@ G4RotationMatrix* MediumHit::get_medium_rotationMatrix() {
     return m_medium_rotationMatrix;
 }
 
-G4String MediumHit::get_medium_name() {
-    return m_medium_name;
+const G4String& MediumHit::get_medium_name() {
+    return *m_medium_name;
 }
 
 G4int MediumHit::get_medium_ID() {
@@ -166,8 +164,8 @@ G4ThreeVector MediumHit::get_particle_position_initial() {
     return m_particle_position_initial;
 }
 
-G4String MediumHit::get_hit_process() {
-    return m_hit_process;
+const G4String& MediumHit::get_hit_process() {
+    return *m_hit_process;
 }
 
 G4double MediumHit::get_particle_energy() {
@@ -33,6 +33,17 @@ OutputMessenger::OutputMessenger() {
 
     m_command_photoSensor_hits_position_binned_save              = new G4UIcmdWithABool    ( "/output/photoSensor/hits/position/binned/save"             , this );
     m_command_photoSensor_hits_position_binned_nBinsPerSide      = new G4UIcmdWithAnInteger( "/output/photoSensor/hits/position/binned/nBinsPerSide"     , this );
+    m_command_photoSensor_hits_position_binned_memoryMax         = new G4UIcmdWithAnInteger( "/output/photoSensor/hits/position/binned/memoryMax"        , this );
+    m_command_lensScan_fileName                                  = new G4UIcmdWithAString  ( "/output/lensScan/fileName"                                 , this );
+    m_command_visibility_save                                    = new G4UIcmdWithABool    ( "/output/visibility/save"                                  , this );
+    m_command_visibility_fileName                                = new G4UIcmdWithAString  ( "/output/visibility/fileName"                              , this );
+    m_command_visibility_size                                    = new G4UIcmdWith3VectorAndUnit( "/output/visibility/size"                                  , this );
+    m_command_visibility_nVoxelsPerSide                          = new G4UIcmdWithAnInteger( "/output/visibility/nVoxelsPerSide"                        , this );
+    m_command_visibility_direction_nBinsPerSide                  = new G4UIcmdWithAnInteger( "/output/visibility/direction/nBinsPerSide"                , this );
+    m_command_visibility_threshold                               = new G4UIcmdWithADouble  ( "/output/visibility/threshold"                             , this );
+    m_command_visibility_fold                                    = new G4UIcmdWithABool    ( "/output/visibility/fold"                                  , this );
+    m_command_hitLibrary_save                                    = new G4UIcmdWithABool    ( "/output/hitLibrary/save"                                  , this );
+    m_command_hitLibrary_fileName                                = new G4UIcmdWithAString  ( "/output/hitLibrary/fileName"                              , this );
     m_command_photoSensor_hits_position_absolute_save            = new G4UIcmdWithABool    ( "/output/photoSensor/hits/position/absolute/save"           , this );
     m_command_photoSensor_hits_position_relative_save            = new G4UIcmdWithABool    ( "/output/photoSensor/hits/position/relative/save"           , this );
     m_command_photoSensor_hits_position_relative_lens_save       = new G4UIcmdWithAString  ( "/output/photoSensor/hits/position/relative/lens/save"      , this );
@@ -47,6 +58,7 @@ OutputMessenger::OutputMessenger() {
     m_command_photoSensor_hits_process_save                      = new G4UIcmdWithABool    ( "/output/photoSensor/hits/process/save"                     , this );
     m_command_photoSensor_hits_photoSensorID_save                = new G4UIcmdWithABool    ( "/output/photoSensor/hits/photoSensorID/save"               , this );
     m_command_photoSensor_hits_energy_save                       = new G4UIcmdWithABool    ( "/output/photoSensor/hits/energy/save"                      , this );
+    m_command_photoSensor_hits_weight_save                       = new G4UIcmdWithABool    ( "/output/photoSensor/hits/weight/save"                      , this );
 
     m_command_calorimeter_hits_position_absolute_save            = new G4UIcmdWithABool    ( "/output/calorimeter/hits/position/absolute/save"           , this );
     m_command_calorimeter_hits_position_relative_save            = new G4UIcmdWithABool    ( "/output/calorimeter/hits/position/relative/save"           , this );
@@ -106,6 +118,17 @@ OutputMessenger::~OutputMessenger() {
 
     if( m_command_photoSensor_hits_position_binned_save              ) delete m_command_photoSensor_hits_position_binned_save;
     if( m_command_photoSensor_hits_position_binned_nBinsPerSide      ) delete m_command_photoSensor_hits_position_binned_nBinsPerSide;
+    if( m_command_photoSensor_hits_position_binned_memoryMax         ) delete m_command_photoSensor_hits_position_binned_memoryMax;
+    if( m_command_lensScan_fileName                                  ) delete m_command_lensScan_fileName;
+    if( m_command_visibility_save                                    ) delete m_command_visibility_save;
+    if( m_command_visibility_fileName                                ) delete m_command_visibility_fileName;
+    if( m_command_visibility_size                                    ) delete m_command_visibility_size;
+    if( m_command_visibility_nVoxelsPerSide                          ) delete m_command_visibility_nVoxelsPerSide;
+    if( m_command_visibility_direction_nBinsPerSide                  ) delete m_command_visibility_direction_nBinsPerSide;
+    if( m_command_visibility_threshold                               ) delete m_command_visibility_threshold;
+    if( m_command_visibility_fold                                    ) delete m_command_visibility_fold;
+    if( m_command_hitLibrary_save                                    ) delete m_command_hitLibrary_save;
+    if( m_command_hitLibrary_fileName                                ) delete m_command_hitLibrary_fileName;
     if( m_command_photoSensor_hits_position_absolute_save            ) delete m_command_photoSensor_hits_position_absolute_save;
     if( m_command_photoSensor_hits_position_relative_save            ) delete m_command_photoSensor_hits_position_relative_save;
     if( m_command_photoSensor_hits_position_relative_lens_save       ) delete m_command_photoSensor_hits_position_relative_lens_save;
@@ -120,6 +143,7 @@ OutputMessenger::~OutputMessenger() {
     if( m_command_photoSensor_hits_process_save                      ) delete m_command_photoSensor_hits_process_save;
     if( m_command_photoSensor_hits_photoSensorID_save                ) delete m_command_photoSensor_hits_photoSensorID_save;
     if( m_command_photoSensor_hits_energy_save                       ) delete m_command_photoSensor_hits_energy_save;
+    if( m_command_photoSensor_hits_weight_save                       ) delete m_command_photoSensor_hits_weight_save;
 
     if( m_command_calorimeter_hits_position_absolute_save            ) delete m_command_calorimeter_hits_position_absolute_save;
     if( m_command_calorimeter_hits_position_relative_save            ) delete m_command_calorimeter_hits_position_relative_save;
@@ -186,6 +210,39 @@ void OutputMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newValue )
     } else if( t_command == m_command_photoSensor_hits_position_binned_nBinsPerSide ) {
         set_photoSensor_hits_position_binned_nBinsPerSide( m_command_photoSensor_hits_position_binned_nBinsPerSide->GetNewIntValue( t_newValue ) );
         G4cout << "Setting `/output/photoSensor/hits/position/binned/nBinsPerSide' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_photoSensor_hits_position_binned_memoryMax ) {
+        set_photoSensor_hits_position_binned_memoryMax( m_command_photoSensor_hits_position_binned_memoryMax->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `/output/photoSensor/hits/position/binned/memoryMax' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_lensScan_fileName ) {
+        set_lensScan_fileName( t_newValue );
+        G4cout << "Setting `/output/lensScan/fileName' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_save ) {
+        set_visibility_save( m_command_visibility_save->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/save' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_fileName ) {
+        set_visibility_fileName( t_newValue );
+        G4cout << "Setting `/output/visibility/fileName' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_size ) {
+        set_visibility_size( m_command_visibility_size->GetNew3VectorValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/size' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_nVoxelsPerSide ) {
+        set_visibility_nVoxelsPerSide( m_command_visibility_nVoxelsPerSide->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/nVoxelsPerSide' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_direction_nBinsPerSide ) {
+        set_visibility_direction_nBinsPerSide( m_command_visibility_direction_nBinsPerSide->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/direction/nBinsPerSide' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_threshold ) {
+        set_visibility_threshold( m_command_visibility_threshold->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/threshold' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_visibility_fold ) {
+        set_visibility_fold( m_command_visibility_fold->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `/output/visibility/fold' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_hitLibrary_save ) {
+        set_hitLibrary_save( m_command_hitLibrary_save->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `/output/hitLibrary/save' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_hitLibrary_fileName ) {
+        set_hitLibrary_fileName( t_newValue );
+        G4cout << "Setting `/output/hitLibrary/fileName' to " << t_newValue << G4endl;
     } else if( t_command == m_command_photoSensor_hits_position_absolute_save ) {
         set_photoSensor_hits_position_absolute_save( m_command_photoSensor_hits_position_absolute_save->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `/output/photoSensor/hits/position/absolute/save' to " << t_newValue << G4endl;
@@ -228,6 +285,9 @@ void OutputMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newValue )
     } else if( t_command == m_command_photoSensor_hits_energy_save ) {
         set_photoSensor_hits_energy_save( m_command_photoSensor_hits_energy_save->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `/output/photoSensor/hits/energy/save' to " << t_newValue << G4endl;
+    } else if( t_command == m_command_photoSensor_hits_weight_save ) {
+        set_photoSensor_hits_weight_save( m_command_photoSensor_hits_weight_save->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `/output/photoSensor/hits/weight/save' to " << t_newValue << G4endl;
     } else if( t_command == m_command_calorimeter_hits_position_absolute_save ) {
         set_calorimeter_hits_position_absolute_save( m_command_calorimeter_hits_position_absolute_save->GetNewBoolValue( t_newValue ) );
         G4cout << "Setting `/output/calorimeter/hits/position/absolute/save' to " << t_newValue << G4endl;
@@ -383,6 +443,40 @@ G4bool OutputMessenger::get_photoSensor_hits_position_binned_save() const {
 G4int OutputMessenger::get_photoSensor_hits_position_binned_nBinsPerSide() const {
     return m_variable_photoSensor_hits_position_binned_nBinsPerSide;
 }
+G4int OutputMessenger::get_photoSensor_hits_position_binned_memoryMax() const {
+    return m_variable_photoSensor_hits_position_binned_memoryMax;
+}
+
+G4String OutputMessenger::get_lensScan_fileName() const {
+    return m_variable_lensScan_fileName;
+}
+G4bool OutputMessenger::get_visibility_save() const {
+    return m_variable_visibility_save;
+}
+G4String OutputMessenger::get_visibility_fileName() const {
+    return m_variable_visibility_fileName;
+}
+G4ThreeVector OutputMessenger::get_visibility_size() const {
+    return m_variable_visibility_size;
+}
+G4int OutputMessenger::get_visibility_nVoxelsPerSide() const {
+    return m_variable_visibility_nVoxelsPerSide;
+}
+G4int OutputMessenger::get_visibility_direction_nBinsPerSide() const {
+    return m_variable_visibility_direction_nBinsPerSide;
+}
+G4double OutputMessenger::get_visibility_threshold() const {
+    return m_variable_visibility_threshold;
+}
+G4bool OutputMessenger::get_visibility_fold() const {
+    return m_variable_visibility_fold;
+}
+G4bool OutputMessenger::get_hitLibrary_save() const {
+    return m_variable_hitLibrary_save;
+}
+G4String OutputMessenger::get_hitLibrary_fileName() const {
+    return m_variable_hitLibrary_fileName;
+}
 G4bool OutputMessenger::get_photoSensor_hits_position_absolute_save() const {
     return m_variable_photoSensor_hits_position_absolute_save;
 }
@@ -435,6 +529,9 @@ G4bool OutputMessenger::get_photoSensor_hits_photoSensorID_save() const {
 G4bool OutputMessenger::get_photoSensor_hits_energy_save() const {
     return m_variable_photoSensor_hits_energy_save;
 }
+G4bool OutputMessenger::get_photoSensor_hits_weight_save() const {
+    return m_variable_photoSensor_hits_weight_save;
+}
 G4bool OutputMessenger::get_calorimeter_hits_position_absolute_save() const {
     return m_variable_calorimeter_hits_position_absolute_save;
 }
@@ -585,7 +682,8 @@ G4bool OutputMessenger::get_photoSensor_hits_tuple_save() const {
            m_variable_photoSensor_hits_time_save                                ||
            m_variable_photoSensor_hits_process_save                             ||
            m_variable_photoSensor_hits_photoSensorID_save                       ||
-           m_variable_photoSensor_hits_energy_save                                ;
+           m_variable_photoSensor_hits_energy_save                              ||
+           m_variable_photoSensor_hits_weight_save                                ;
 }
 G4bool OutputMessenger::get_photoSensor_hits_save() const {
     return m_variable_photoSensor_hits_position_binned_save ||
@@ -662,6 +760,40 @@ void OutputMessenger::set_photoSensor_hits_position_binned_save( G4bool t_newVal
 void OutputMessenger::set_photoSensor_hits_position_binned_nBinsPerSide( G4int t_newValue ) {
     m_variable_photoSensor_hits_position_binned_nBinsPerSide = t_newValue;
 }
+void OutputMessenger::set_photoSensor_hits_position_binned_memoryMax( G4int t_newValue ) {
+    m_variable_photoSensor_hits_position_binned_memoryMax = t_newValue;
+}
+
+void OutputMessenger::set_lensScan_fileName( G4String t_newValue ) {
+    m_variable_lensScan_fileName = t_newValue;
+}
+void OutputMessenger::set_visibility_save( G4bool t_newValue ) {
+    m_variable_visibility_save = t_newValue;
+}
+void OutputMessenger::set_visibility_fileName( G4String t_newValue ) {
+    m_variable_visibility_fileName = t_newValue;
+}
+void OutputMessenger::set_visibility_size( G4ThreeVector t_newValue ) {
+    m_variable_visibility_size = t_newValue;
+}
+void OutputMessenger::set_visibility_nVoxelsPerSide( G4int t_newValue ) {
+    m_variable_visibility_nVoxelsPerSide = t_newValue;
+}
+void OutputMessenger::set_visibility_direction_nBinsPerSide( G4int t_newValue ) {
+    m_variable_visibility_direction_nBinsPerSide = t_newValue;
+}
+void OutputMessenger::set_visibility_threshold( G4double t_newValue ) {
+    m_variable_visibility_threshold = t_newValue;
+}
+void OutputMessenger::set_visibility_fold( G4bool t_newValue ) {
+    m_variable_visibility_fold = t_newValue;
+}
+void OutputMessenger::set_hitLibrary_save( G4bool t_newValue ) {
+    m_variable_hitLibrary_save = t_newValue;
+}
+void OutputMessenger::set_hitLibrary_fileName( G4String t_newValue ) {
+    m_variable_hitLibrary_fileName = t_newValue;
+}
 void OutputMessenger::set_photoSensor_hits_position_absolute_save( G4bool t_newValue ) {
     m_variable_photoSensor_hits_position_absolute_save = t_newValue;
 }
@@ -764,6 +896,9 @@ void OutputMessenger::set_photoSensor_hits_photoSensorID_save( G4bool t_newValue
 void OutputMessenger::set_photoSensor_hits_energy_save( G4bool t_newValue ) {
     m_variable_photoSensor_hits_energy_save = t_newValue;
 }
+void OutputMessenger::set_photoSensor_hits_weight_save( G4bool t_newValue ) {
+    m_variable_photoSensor_hits_weight_save = t_newValue;
+}
 void OutputMessenger::set_calorimeter_hits_position_absolute_save( G4bool t_newValue ) {
     m_variable_calorimeter_hits_position_absolute_save = t_newValue;
 }
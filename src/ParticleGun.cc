@@ -48,61 +48,142 @@ G4ThreeVector ParticleGun::get_momentum_random( G4double t_x_min, G4double t_x_m
 }
 
 void ParticleGun::GeneratePrimaries( G4Event* t_event ) {
+    if( ConstructionMessenger::get_instance()->get_lensScan() ) {
+        generate_lensScan( t_event );
+        return;
+    }
+
     if( particle_definition == 0 )
         return;
 
-    // create a new vertex
-    G4ThreeVector position = particle_position;
-    if( m_particleGunMessenger->get_position_x_random() )
-        position.setX( get_position_random( m_particleGunMessenger->get_position_x_random_min(),
-                                            m_particleGunMessenger->get_position_x_random_max(),
-                                            m_particleGunMessenger->get_position_x_nSteps    () ) );
-    if( m_particleGunMessenger->get_position_y_random() )
-        position.setY( get_position_random( m_particleGunMessenger->get_position_y_random_min(),
-                                            m_particleGunMessenger->get_position_y_random_max(),
-                                            m_particleGunMessenger->get_position_y_nSteps    () ) );
-    if( m_particleGunMessenger->get_position_z_random() )
-        position.setZ( get_position_random( m_particleGunMessenger->get_position_z_random_min(),
-                                            m_particleGunMessenger->get_position_z_random_max(),
-                                            m_particleGunMessenger->get_position_z_nSteps    () ) );
-    G4PrimaryVertex* vertex = new G4PrimaryVertex( position, particle_time );
-
-    // create new primaries and set them to the vertex
-    G4double mass =  particle_definition->GetPDGMass();
-    for( G4int i{ 0 }; i < NumberOfParticlesToBeGenerated; i++ ){
-        G4PrimaryParticle* particle{ nullptr };
-        if( particle_definition->GetParticleName() == "PhotonCreator" ) {
-            particle = new G4PrimaryParticle( G4OpticalPhoton::Definition() );
-            particle->SetKineticEnergy( 6.974754362888755 * eV ); // fit from NEST data
-            // G4double energy = G4RandGauss::shoot( 24.12 * eV, 1979. * eV );
-            // if( energy > 24.12 * eV / 2. )
-            //     particle->SetKineticEnergy( energy );
-            // else
-            //     particle->SetKineticEnergy( 24.12 * eV / 2. );
+    // one vertex per `/particleGun/nVertices', each at its own random position
+    for( G4int n{ 0 }; n < m_particleGunMessenger->get_nVertices(); n++ ) {
+        // create a new vertex
+        G4ThreeVector position = particle_position;
+        if( m_particleGunMessenger->get_position_x_random() )
+            position.setX( get_position_random( m_particleGunMessenger->get_position_x_random_min(),
+                                                m_particleGunMessenger->get_position_x_random_max(),
+                                                m_particleGunMessenger->get_position_x_nSteps    () ) );
+        if( m_particleGunMessenger->get_position_y_random() )
+            position.setY( get_position_random( m_particleGunMessenger->get_position_y_random_min(),
+                                                m_particleGunMessenger->get_position_y_random_max(),
+                                                m_particleGunMessenger->get_position_y_nSteps    () ) );
+        if( m_particleGunMessenger->get_position_z_random() )
+            position.setZ( get_position_random( m_particleGunMessenger->get_position_z_random_min(),
+                                                m_particleGunMessenger->get_position_z_random_max(),
+                                                m_particleGunMessenger->get_position_z_nSteps    () ) );
+        // into the part of the cube that a folded visibility library keeps (see VisibilityLibrary::fold)
+        if( m_particleGunMessenger->get_position_fold() ) {
+            G4double components[ 3 ]{ std::abs( position.x() ), std::abs( position.y() ), std::abs( position.z() ) };
+            std::sort( components, components + 3 );
+            position.set( components[ 0 ], components[ 1 ], components[ 2 ] );
+        }
+        G4PrimaryVertex* vertex = new G4PrimaryVertex( position, particle_time );
+
+        // create new primaries and set them to the vertex
+        G4double mass =  particle_definition->GetPDGMass();
+        for( G4int i{ 0 }; i < NumberOfParticlesToBeGenerated; i++ ){
+            G4PrimaryParticle* particle{ nullptr };
+            if( particle_definition->GetParticleName() == "PhotonCreator" ) {
+                particle = new G4PrimaryParticle( G4OpticalPhoton::Definition() );
+                particle->SetKineticEnergy( 6.974754362888755 * eV ); // fit from NEST data
+                // G4double energy = G4RandGauss::shoot( 24.12 * eV, 1979. * eV );
+                // if( energy > 24.12 * eV / 2. )
+                //     particle->SetKineticEnergy( energy );
+                // else
+                //     particle->SetKineticEnergy( 24.12 * eV / 2. );
+                particle->SetMass( G4OpticalPhoton::Definition()->GetPDGMass() );
+                particle->SetCharge( G4OpticalPhoton::Definition()->GetPDGCharge() );
+            } else {
+                particle = new G4PrimaryParticle( particle_definition );
+                particle->SetKineticEnergy( particle_energy );
+                particle->SetMass( mass );
+                particle->SetCharge( particle_charge );
+            }
+
+            if( m_particleGunMessenger->get_momentum_random() )
+                particle->SetMomentumDirection( get_momentum_random( m_particleGunMessenger->get_momentum_x_random_min(),
+                                                                     m_particleGunMessenger->get_momentum_x_random_max(),
+                                                                     m_particleGunMessenger->get_momentum_y_random_min(),
+                                                                     m_particleGunMessenger->get_momentum_y_random_max(),
+                                                                     m_particleGunMessenger->get_momentum_z_random_min(),
+                                                                     m_particleGunMessenger->get_momentum_z_random_max() ) );
+            else
+                particle->SetMomentumDirection( particle_momentum_direction );
+
+            particle->SetPolarization( particle_polarization.x(),
+                                       particle_polarization.y(),
+                                       particle_polarization.z() );
+
+            vertex->SetPrimary( particle );
+        }
+        t_event->AddPrimaryVertex( vertex );
+    }
+}
+// Parallel beams of optical photons onto the single DSPD of a lens scan (see
+// DetectorConstruction::make_lensScan). Event n uses direction n % nDirections of the
+// PointSpreadFunction. The beam is a grid of offsetNSteps x offsetNSteps beamlets over
+// [-offsetMax, offsetMax] perpendicular to the direction, one vertex each, aimed at the centre
+// of the lens system and starting `distance' in front of it.
+void ParticleGun::generate_lensScan( G4Event* t_event ) {
+    ConstructionMessenger* constructionMessenger = ConstructionMessenger::get_instance();
+
+    G4int    angle_x_nSteps = m_particleGunMessenger->get_lensScan_angle_x_nSteps();
+    G4int    angle_y_nSteps = m_particleGunMessenger->get_lensScan_angle_y_nSteps();
+    G4double angle_x_min    = m_particleGunMessenger->get_lensScan_angle_x_min   ();
+    G4double angle_x_max    = m_particleGunMessenger->get_lensScan_angle_x_max   ();
+    G4double angle_y_min    = m_particleGunMessenger->get_lensScan_angle_y_min   ();
+    G4double angle_y_max    = m_particleGunMessenger->get_lensScan_angle_y_max   ();
+    G4int    offset_nSteps  = m_particleGunMessenger->get_lensScan_offset_nSteps ();
+    G4double offset_max     = m_particleGunMessenger->get_lensScan_offset_max    ();
+    G4double distance       = m_particleGunMessenger->get_lensScan_distance      ();
+
+    G4int    direction = t_event->GetEventID() % ( angle_x_nSteps * angle_y_nSteps );
+    G4int    n_x       = direction / angle_y_nSteps;
+    G4int    n_y       = direction % angle_y_nSteps;
+    G4double angle_x   = ( angle_x_nSteps > 1 ) ? angle_x_min + n_x * ( angle_x_max - angle_x_min ) / ( angle_x_nSteps - 1 ) : angle_x_min;
+    G4double angle_y   = ( angle_y_nSteps > 1 ) ? angle_y_min + n_y * ( angle_y_max - angle_y_min ) / ( angle_y_nSteps - 1 ) : angle_y_min;
+
+    G4ThreeVector momentum = PointSpreadFunction::get_direction( angle_x, angle_y );
+    G4ThreeVector axis_u   = G4ThreeVector( 0, 1, 0 ).cross( momentum ).unit();
+    G4ThreeVector axis_v   = momentum.cross( axis_u );
+
+    // lens z in the DSPD frame is lens_position - DSPD depth (see DirectionSensitivePhotoDetector)
+    G4double lens_position_min = constructionMessenger->get_lens_position( 0 );
+    G4double lens_position_max = lens_position_min;
+    for( G4int nLens{ 1 }; nLens < constructionMessenger->get_lens_amount(); nLens++ ) {
+        lens_position_min = min( lens_position_min, constructionMessenger->get_lens_position( nLens ) );
+        lens_position_max = max( lens_position_max, constructionMessenger->get_lens_position( nLens ) );
+    }
+    G4ThreeVector target( 0, 0, constructionMessenger->get_lensScan_medium_size().z() / 2 
+                                - DirectionSensitivePhotoDetector::get_depth() 
+                                + ( lens_position_min + lens_position_max ) / 2 );
+
+    G4int nBeamlets = offset_nSteps * offset_nSteps;
+    for( G4int nBeamlet{ 0 }; nBeamlet < nBeamlets; nBeamlet++ ) {
+        G4int nParticles = NumberOfParticlesToBeGenerated / nBeamlets 
+                         + ( ( nBeamlet < NumberOfParticlesToBeGenerated % nBeamlets ) ? 1 : 0 );
+        if( nParticles == 0 )
+            continue;
+
+        G4double offset_u = ( offset_nSteps > 1 ) ? -offset_max + 2 * offset_max * ( nBeamlet / offset_nSteps ) / ( offset_nSteps - 1 ) : 0;
+        G4double offset_v = ( offset_nSteps > 1 ) ? -offset_max + 2 * offset_max * ( nBeamlet % offset_nSteps ) / ( offset_nSteps - 1 ) : 0;
+        G4ThreeVector position = target - distance * momentum + offset_u * axis_u + offset_v * axis_v;
+        G4PrimaryVertex* vertex = new G4PrimaryVertex( position, particle_time );
+
+        for( G4int i{ 0 }; i < nParticles; i++ ) {
+            G4PrimaryParticle* particle = new G4PrimaryParticle( G4OpticalPhoton::Definition() );
+            particle->SetKineticEnergy( 6.974754362888755 * eV ); // as PhotonCreator
             particle->SetMass( G4OpticalPhoton::Definition()->GetPDGMass() );
             particle->SetCharge( G4OpticalPhoton::Definition()->GetPDGCharge() );
-        } else {
-            particle = new G4PrimaryParticle( particle_definition );
-            particle->SetKineticEnergy( particle_energy );
-            particle->SetMass( mass );
-            particle->SetCharge( particle_charge );
-        }
+            particle->SetMomentumDirection( momentum );
+
+            G4double      phi          = CLHEP::twopi * G4UniformRand();
+            G4ThreeVector polarization = cos( phi ) * axis_u + sin( phi ) * axis_v;
+            particle->SetPolarization( polarization.x(), polarization.y(), polarization.z() );
 
-        if( m_particleGunMessenger->get_momentum_random() )
-            particle->SetMomentumDirection( get_momentum_random( m_particleGunMessenger->get_momentum_x_random_min(),
-                                                                 m_particleGunMessenger->get_momentum_x_random_max(),
-                                                                 m_particleGunMessenger->get_momentum_y_random_min(),
-                                                                 m_particleGunMessenger->get_momentum_y_random_max(),
-                                                                 m_particleGunMessenger->get_momentum_z_random_min(),
-                                                                 m_particleGunMessenger->get_momentum_z_random_max() ) );
-        else
-            particle->SetMomentumDirection( particle_momentum_direction );
-
-        particle->SetPolarization( particle_polarization.x(),
-                                   particle_polarization.y(),
-                                   particle_polarization.z() );
-
-        vertex->SetPrimary( particle );
+            vertex->SetPrimary( particle );
+        }
+        t_event->AddPrimaryVertex( vertex );
     }
-    t_event->AddPrimaryVertex( vertex );
-}
\ No newline at end of file
+}
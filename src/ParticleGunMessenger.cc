@@ -34,7 +34,19 @@ ParticleGunMessenger::ParticleGunMessenger() {
     m_parameter_position_x_random_max = new G4UIcmdWithADoubleAndUnit( "/particleGun/position/x/max"   , this );
     m_parameter_position_y_random_max = new G4UIcmdWithADoubleAndUnit( "/particleGun/position/y/max"   , this );
     m_parameter_position_z_random_max = new G4UIcmdWithADoubleAndUnit( "/particleGun/position/z/max"   , this );
+    m_parameter_position_fold         = new G4UIcmdWithABool         ( "/particleGun/position/fold"    , this );
     m_parameter_nParticles            = new G4UIcmdWithAnInteger     ( "/particleGun/nParticles"       , this );
+    m_parameter_nVertices             = new G4UIcmdWithAnInteger     ( "/particleGun/nVertices"        , this );
+
+    m_parameter_lensScan_angle_x_min    = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/angle/x/min"   , this );
+    m_parameter_lensScan_angle_x_max    = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/angle/x/max"   , this );
+    m_parameter_lensScan_angle_x_nSteps = new G4UIcmdWithAnInteger     ( "/particleGun/lensScan/angle/x/nSteps", this );
+    m_parameter_lensScan_angle_y_min    = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/angle/y/min"   , this );
+    m_parameter_lensScan_angle_y_max    = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/angle/y/max"   , this );
+    m_parameter_lensScan_angle_y_nSteps = new G4UIcmdWithAnInteger     ( "/particleGun/lensScan/angle/y/nSteps", this );
+    m_parameter_lensScan_offset_max     = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/offset/max"    , this );
+    m_parameter_lensScan_offset_nSteps  = new G4UIcmdWithAnInteger     ( "/particleGun/lensScan/offset/nSteps" , this );
+    m_parameter_lensScan_distance       = new G4UIcmdWithADoubleAndUnit( "/particleGun/lensScan/distance"      , this );
 
     m_parameter_momentum_random->SetDefaultValue( false );
 }
@@ -59,7 +71,18 @@ ParticleGunMessenger::~ParticleGunMessenger() {
     if( m_parameter_position_x_random_max ) delete m_parameter_position_x_random_max;
     if( m_parameter_position_y_random_max ) delete m_parameter_position_y_random_max;
     if( m_parameter_position_z_random_max ) delete m_parameter_position_z_random_max;
+    if( m_parameter_position_fold         ) delete m_parameter_position_fold        ;
     if( m_parameter_nParticles            ) delete m_parameter_nParticles           ;
+    if( m_parameter_nVertices             ) delete m_parameter_nVertices            ;
+    if( m_parameter_lensScan_angle_x_min    ) delete m_parameter_lensScan_angle_x_min    ;
+    if( m_parameter_lensScan_angle_x_max    ) delete m_parameter_lensScan_angle_x_max    ;
+    if( m_parameter_lensScan_angle_x_nSteps ) delete m_parameter_lensScan_angle_x_nSteps ;
+    if( m_parameter_lensScan_angle_y_min    ) delete m_parameter_lensScan_angle_y_min    ;
+    if( m_parameter_lensScan_angle_y_max    ) delete m_parameter_lensScan_angle_y_max    ;
+    if( m_parameter_lensScan_angle_y_nSteps ) delete m_parameter_lensScan_angle_y_nSteps ;
+    if( m_parameter_lensScan_offset_max     ) delete m_parameter_lensScan_offset_max     ;
+    if( m_parameter_lensScan_offset_nSteps  ) delete m_parameter_lensScan_offset_nSteps  ;
+    if( m_parameter_lensScan_distance       ) delete m_parameter_lensScan_distance       ;
 }
 
 ParticleGunMessenger* ParticleGunMessenger::get_instance() {
@@ -133,9 +156,42 @@ void ParticleGunMessenger::SetNewValue( G4UIcommand* t_command, G4String t_newVa
     } else if( t_command == m_parameter_position_z_random_max ) {
         set_position_z_random_max( m_parameter_position_z_random_max->GetNewDoubleValue( t_newValue ) );
         G4cout << "Setting `position_z_max' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_position_fold ) {
+        set_position_fold( m_parameter_position_fold->GetNewBoolValue( t_newValue ) );
+        G4cout << "Setting `position_fold' to " << t_newValue << G4endl;
     } else if( t_command == m_parameter_nParticles ) {
         set_nParticles( m_parameter_nParticles->GetNewIntValue( t_newValue ) );
         G4cout << "Setting `nParticles' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_nVertices ) {
+        set_nVertices( m_parameter_nVertices->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `nVertices' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_x_min ) {
+        set_lensScan_angle_x_min( m_parameter_lensScan_angle_x_min->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_x_min' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_x_max ) {
+        set_lensScan_angle_x_max( m_parameter_lensScan_angle_x_max->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_x_max' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_x_nSteps ) {
+        set_lensScan_angle_x_nSteps( m_parameter_lensScan_angle_x_nSteps->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_x_nSteps' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_y_min ) {
+        set_lensScan_angle_y_min( m_parameter_lensScan_angle_y_min->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_y_min' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_y_max ) {
+        set_lensScan_angle_y_max( m_parameter_lensScan_angle_y_max->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_y_max' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_angle_y_nSteps ) {
+        set_lensScan_angle_y_nSteps( m_parameter_lensScan_angle_y_nSteps->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `lensScan_angle_y_nSteps' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_offset_max ) {
+        set_lensScan_offset_max( m_parameter_lensScan_offset_max->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_offset_max' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_offset_nSteps ) {
+        set_lensScan_offset_nSteps( m_parameter_lensScan_offset_nSteps->GetNewIntValue( t_newValue ) );
+        G4cout << "Setting `lensScan_offset_nSteps' to " << t_newValue << G4endl;
+    } else if( t_command == m_parameter_lensScan_distance ) {
+        set_lensScan_distance( m_parameter_lensScan_distance->GetNewDoubleValue( t_newValue ) );
+        G4cout << "Setting `lensScan_distance' to " << t_newValue << G4endl;
     } else
         G4Exception( "ParticleGunMessenger::SetNewValue", "Unknown command", FatalErrorInArgument, t_newValue );
 }
@@ -197,9 +253,42 @@ G4double ParticleGunMessenger::get_position_y_random_max() {
 G4double ParticleGunMessenger::get_position_z_random_max() { 
     return m_variable_position_z_random_max; 
 }
+G4bool ParticleGunMessenger::get_position_fold() { 
+    return m_variable_position_fold; 
+}
 G4int ParticleGunMessenger::get_nParticles() { 
     return m_variable_nParticles; 
 }
+G4int ParticleGunMessenger::get_nVertices() { 
+    return m_variable_nVertices; 
+}
+G4double ParticleGunMessenger::get_lensScan_angle_x_min() { 
+    return m_variable_lensScan_angle_x_min; 
+}
+G4double ParticleGunMessenger::get_lensScan_angle_x_max() { 
+    return m_variable_lensScan_angle_x_max; 
+}
+G4int ParticleGunMessenger::get_lensScan_angle_x_nSteps() { 
+    return m_variable_lensScan_angle_x_nSteps; 
+}
+G4double ParticleGunMessenger::get_lensScan_angle_y_min() { 
+    return m_variable_lensScan_angle_y_min; 
+}
+G4double ParticleGunMessenger::get_lensScan_angle_y_max() { 
+    return m_variable_lensScan_angle_y_max; 
+}
+G4int ParticleGunMessenger::get_lensScan_angle_y_nSteps() { 
+    return m_variable_lensScan_angle_y_nSteps; 
+}
+G4double ParticleGunMessenger::get_lensScan_offset_max() { 
+    return m_variable_lensScan_offset_max; 
+}
+G4int ParticleGunMessenger::get_lensScan_offset_nSteps() { 
+    return m_variable_lensScan_offset_nSteps; 
+}
+G4double ParticleGunMessenger::get_lensScan_distance() { 
+    return m_variable_lensScan_distance; 
+}
 
 void ParticleGunMessenger::set_momentum_random( G4bool t_variable_momentum_random ) { 
     m_variable_momentum_random = t_variable_momentum_random; 
@@ -258,6 +347,9 @@ void ParticleGunMessenger::set_position_y_random_max( G4double t_variable_positi
 void ParticleGunMessenger::set_position_z_random_max( G4double t_variable_position_z_random_max ) { 
     m_variable_position_z_random_max = t_variable_position_z_random_max; 
 }
+void ParticleGunMessenger::set_position_fold( G4bool t_variable_position_fold ) { 
+    m_variable_position_fold = t_variable_position_fold; 
+}
 void ParticleGunMessenger::set_nParticles( G4int t_variable_nParticles ) { 
     m_variable_nParticles = t_variable_nParticles; 
 
@@ -265,6 +357,37 @@ void ParticleGunMessenger::set_nParticles( G4int t_variable_nParticles ) {
         for( ParticleGun* particleGun : m_particleGuns )
             particleGun->SetNumberOfParticles( m_variable_nParticles );
 }
+void ParticleGunMessenger::set_nVertices( G4int t_variable_nVertices ) { 
+    m_variable_nVertices = t_variable_nVertices; 
+}
+
+void ParticleGunMessenger::set_lensScan_angle_x_min( G4double t_variable_lensScan_angle_x_min ) { 
+    m_variable_lensScan_angle_x_min = t_variable_lensScan_angle_x_min; 
+}
+void ParticleGunMessenger::set_lensScan_angle_x_max( G4double t_variable_lensScan_angle_x_max ) { 
+    m_variable_lensScan_angle_x_max = t_variable_lensScan_angle_x_max; 
+}
+void ParticleGunMessenger::set_lensScan_angle_x_nSteps( G4int t_variable_lensScan_angle_x_nSteps ) { 
+    m_variable_lensScan_angle_x_nSteps = t_variable_lensScan_angle_x_nSteps; 
+}
+void ParticleGunMessenger::set_lensScan_angle_y_min( G4double t_variable_lensScan_angle_y_min ) { 
+    m_variable_lensScan_angle_y_min = t_variable_lensScan_angle_y_min; 
+}
+void ParticleGunMessenger::set_lensScan_angle_y_max( G4double t_variable_lensScan_angle_y_max ) { 
+    m_variable_lensScan_angle_y_max = t_variable_lensScan_angle_y_max; 
+}
+void ParticleGunMessenger::set_lensScan_angle_y_nSteps( G4int t_variable_lensScan_angle_y_nSteps ) { 
+    m_variable_lensScan_angle_y_nSteps = t_variable_lensScan_angle_y_nSteps; 
+}
+void ParticleGunMessenger::set_lensScan_offset_max( G4double t_variable_lensScan_offset_max ) { 
+    m_variable_lensScan_offset_max = t_variable_lensScan_offset_max; 
+}
+void ParticleGunMessenger::set_lensScan_offset_nSteps( G4int t_variable_lensScan_offset_nSteps ) { 
+    m_variable_lensScan_offset_nSteps = t_variable_lensScan_offset_nSteps; 
+}
+void ParticleGunMessenger::set_lensScan_distance( G4double t_variable_lensScan_distance ) { 
+    m_variable_lensScan_distance = t_variable_lensScan_distance; 
+}
 
 void ParticleGunMessenger::add_primaryGeneratorAction( PrimaryGeneratorAction* t_primaryGeneratorAction ) {
     m_primaryGeneratorActions.push_back( t_primaryGeneratorAction );
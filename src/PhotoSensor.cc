@@ -38,7 +38,8 @@ PhotoSensor::~PhotoSensor() {
 void PhotoSensor::place( G4RotationMatrix* t_rotationMatrix     , 
                          G4ThreeVector     t_translation        , 
                          G4LogicalVolume * t_motherLogicalVolume, 
-                         G4bool            t_isMany              ) {
+                         G4bool            t_isMany             ,
+                         G4int             t_copyNumber          ) {
     m_position = t_translation;
     m_rotationMatrix = t_rotationMatrix;
 
@@ -49,11 +50,13 @@ void PhotoSensor::place( G4RotationMatrix* t_rotationMatrix     ,
     G4ThreeVector translation_surface( 0, 0,  2 * body_z + surface_z );
     G4ThreeVector translation_body   ( 0, 0,  body_z                 );
 
-    translation_surface = *t_rotationMatrix * translation_surface;
-    translation_body    = *t_rotationMatrix * translation_body;
+    if( t_rotationMatrix ) {
+        translation_surface = *t_rotationMatrix * translation_surface;
+        translation_body    = *t_rotationMatrix * translation_body;
+    }
 
-    m_surface->place( t_rotationMatrix, t_translation - translation_surface, t_motherLogicalVolume, t_isMany );
-    m_body   ->place( t_rotationMatrix, t_translation - translation_body   , t_motherLogicalVolume, t_isMany );
+    m_surface->place( t_rotationMatrix, t_translation - translation_surface, t_motherLogicalVolume, t_isMany, t_copyNumber );
+    m_body   ->place( t_rotationMatrix, t_translation - translation_body   , t_motherLogicalVolume, t_isMany, t_copyNumber );
 }
 
 G4String PhotoSensor::get_name() {
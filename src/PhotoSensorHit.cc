@@ -11,8 +11,6 @@
 
 #include "PhotoSensorHit.hh"
 
-G4ThreadLocal G4Allocator< PhotoSensorHit >* PhotoSensorHitAllocator;
-
 PhotoSensorHit::PhotoSensorHit() {
 }
 
@@ -29,7 +27,7 @@ PhotoSensorHit::PhotoSensorHit( const G4ThreeVector     & t_photoSensor_position
                                 const vector< LensHit* >& t_lensHits                   ) {
     m_photoSensor_position       = t_photoSensor_position      ;
     m_photoSensor_rotationMatrix = t_photoSensor_rotationMatrix;
-    m_photoSensor_name           = t_photoSensor_name          ;
+    m_photoSensor_name           = &t_photoSensor_name         ;
     m_photoSensor_ID             = t_photoSensor_ID            ;
     m_hit_position               = t_hit_position              ;
     m_hit_time                   = t_hit_time                  ;
@@ -37,7 +35,7 @@ PhotoSensorHit::PhotoSensorHit( const G4ThreeVector     & t_photoSensor_position
     m_hit_momentum               = t_hit_momentum              ;
     m_particle_energy            = t_particle_energy           ;
     m_particle_momentum          = t_particle_momentum         ;
-    m_lensHits                   = t_lensHits                  ;
+    m_lensHits.assign( t_lensHits.begin(), t_lensHits.end() );
 }
 
 PhotoSensorHit::PhotoSensorHit( const PhotoSensorHit& t_hit ) {
@@ -48,6 +46,7 @@ PhotoSensorHit::PhotoSensorHit( const PhotoSensorHit& t_hit ) {
     m_hit_position               = t_hit.m_hit_position              ;
     m_hit_time                   = t_hit.m_hit_time                  ;
     m_hit_energy                 = t_hit.m_hit_energy                ;
+    m_hit_weight                 = t_hit.m_hit_weight                ;
     m_hit_momentum               = t_hit.m_hit_momentum              ;
     m_particle_energy            = t_hit.m_particle_energy           ;
     m_particle_momentum          = t_hit.m_particle_momentum         ;
@@ -75,11 +74,12 @@ void PhotoSensorHit::Print() {
 std::ostream& operator<<( std::ostream& t_os, const PhotoSensorHit& t_photoSensorHit ) {
     t_os << "[" << "photoSensor_position="       <<  t_photoSensorHit.m_photoSensor_position       << ", \n"
                 << "photoSensor_rotationMatrix=" << *t_photoSensorHit.m_photoSensor_rotationMatrix << ", \n"
-                << "photoSensor_name="           <<  t_photoSensorHit.m_photoSensor_name           << ", \n"
+                << "photoSensor_name="           << *t_photoSensorHit.m_photoSensor_name           << ", \n"
                 << "photoSensor_ID="             <<  t_photoSensorHit.m_photoSensor_ID             << ", \n"
                 << "hit_position="               <<  t_photoSensorHit.m_hit_position               << ", \n"
                 << "hit_time="                   <<  t_photoSensorHit.m_hit_time                   << ", \n"
                 << "hit_energy="                 <<  t_photoSensorHit.m_hit_energy                 << ", \n"
+                << "hit_weight="                 <<  t_photoSensorHit.m_hit_weight                 << ", \n"
                 << "hit_momentum="               <<  t_photoSensorHit.m_hit_momentum               << ", \n"
                 << "particle_energy="            <<  t_photoSensorHit.m_particle_energy            << ", \n"
                 << "particle_momentum="          <<  t_photoSensorHit.m_particle_momentum          << "]";
@@ -106,7 +106,7 @@ void PhotoSensorHit::set_photoSensor_rotationMatrix( G4RotationMatrix* t_photoSe
 }
 
 void PhotoSensorHit::set_photoSensor_name( const G4String& t_photoSensor_name ) {
-    m_photoSensor_name = t_photoSensor_name;
+    m_photoSensor_name = &t_photoSensor_name;
 }
 
 void PhotoSensorHit::set_photoSensor_ID( G4int t_photoSensor_ID ) {
@@ -121,6 +121,10 @@ void PhotoSensorHit::set_hit_energy( G4double t_hit_energy ) {
     m_hit_energy = t_hit_energy;
 }
 
+void PhotoSensorHit::set_hit_weight( G4double t_hit_weight ) {
+    m_hit_weight = t_hit_weight;
+}
+
 void PhotoSensorHit::set_particle_energy( G4double t_particle_energy ) {
     m_particle_energy = t_particle_energy;
 }
@@ -138,7 +142,7 @@ void PhotoSensorHit::set_particle_position_initial( G4ThreeVector t_particle_pos
 }
 
 void PhotoSensorHit::set_hit_process( const G4String& t_hit_process ) {
-    m_hit_process = t_hit_process;
+    m_hit_process = &t_hit_process;
 }
 
 G4ThreeVector PhotoSensorHit::get_hit_position_absolute() {
@@ -155,7 +159,7 @@ G4ThreeVector PhotoSensorHit::get_hit_position_relative() {
         abs( rotated_relative_position.x() ) > m_constructionMessenger->get_photoSensor_surface_size_height() / 2 + epsilon ||
         abs( rotated_relative_position.y() ) > m_constructionMessenger->get_photoSensor_surface_size_width () / 2 + epsilon   ) {
         G4cout << G4endl;
-        G4cout << "photosensor = " << m_photoSensor_name << G4endl;
+        G4cout << "photosensor = " << *m_photoSensor_name << G4endl;
         G4cout << "photosensor position = " << m_photoSensor_position << G4endl;
         G4cout << "photosensor size = " << m_constructionMessenger->get_photoSensor_surface_size_depth () 
                                << " x " << m_constructionMessenger->get_photoSensor_surface_size_height() 
@@ -176,8 +180,8 @@ G4RotationMatrix* PhotoSensorHit::get_photoSensor_rotationMatrix() {
     return m_photoSensor_rotationMatrix;
 }
 
-G4String PhotoSensorHit::get_photoSensor_name() {
-    return m_photoSensor_name;
+const G4String& PhotoSensorHit::get_photoSensor_name() {
+    return *m_photoSensor_name;
 }
 
 G4int PhotoSensorHit::get_photoSensor_ID() {
@@ -192,6 +196,10 @@ G4double PhotoSensorHit::get_hit_energy() {
     return m_hit_energy;
 }
 
+G4double PhotoSensorHit::get_hit_weight() {
+    return m_hit_weight;
+}
+
 G4double PhotoSensorHit::get_particle_energy() {
     return m_particle_energy;
 }
@@ -208,8 +216,8 @@ G4ThreeVector PhotoSensorHit::get_particle_position_initial() {
     return m_particle_position_initial;
 }
 
-G4String PhotoSensorHit::get_hit_process() {
-    return m_hit_process;
+const G4String& PhotoSensorHit::get_hit_process() {
+    return *m_hit_process;
 }
 
 G4ThreeVector PhotoSensorHit::get_particle_direction() {
@@ -224,7 +232,15 @@ G4ThreeVector PhotoSensorHit::get_particle_direction_relative() {
 }
 
 void PhotoSensorHit::set_lensHits( const vector< LensHit* >& t_lensHits ) {
-    m_lensHits = t_lensHits;
+    m_lensHits.assign( t_lensHits.begin(), t_lensHits.end() );
+}
+
+void PhotoSensorHit::reserve_lensHits( size_t t_nLensHits ) {
+    m_lensHits.reserve( t_nLensHits );
+}
+
+void PhotoSensorHit::add_lensHit( LensHit* t_lensHit ) {
+    m_lensHits.push_back( t_lensHit );
 }
 
 LensHit* PhotoSensorHit::get_lensHit( G4int t_nLens ) {
@@ -11,69 +11,220 @@
 
 #include "PhotoSensorSensitiveDetector.hh"
 
-PhotoSensorSensitiveDetector::PhotoSensorSensitiveDetector( G4String t_name, G4int t_ID )
+PhotoSensorSensitiveDetector::PhotoSensorSensitiveDetector( G4String t_name )
     : G4VSensitiveDetector( t_name ) {
     m_name = t_name;
-    m_ID = t_ID;
     collectionName.insert( "PhotoSensorSensitiveDetector" );
 }
 
+PhotoSensorSensitiveDetector::~PhotoSensorSensitiveDetector() {
+    if( m_efficiency ) delete m_efficiency;
+}
+
 void PhotoSensorSensitiveDetector::Initialize( G4HCofThisEvent* t_hitCollectionOfThisEvent ) {
     m_photoSensorHitsCollection = new PhotoSensorHitsCollection( SensitiveDetectorName, collectionName[ 0 ] );
     if( m_photoSensorHitsCollection_ID < 0 )
         m_photoSensorHitsCollection_ID = G4SDManager::GetSDMpointer()->GetCollectionID( m_photoSensorHitsCollection );
     t_hitCollectionOfThisEvent->AddHitsCollection( m_photoSensorHitsCollection_ID, m_photoSensorHitsCollection );
+
+    update_efficiency();
 }
 
+// Records a photon arriving on the photosensor of a DSPD, with the first hit of every lens
+// in that DSPD. Optical photons are dropped with the detection efficiency left after the
+// prescale at birth.
 G4bool PhotoSensorSensitiveDetector::ProcessHits( G4Step* t_step, G4TouchableHistory* t_hist ) {
     // m_outputManager->save_step_photoSensor_hits( t_step, m_name, m_position, m_rotationMatrix, false );
-    PhotoSensorHit* hit = new PhotoSensorHit();
+    G4Track    * track         = t_step->GetTrack        ();
+    G4StepPoint* postStepPoint = t_step->GetPostStepPoint();
+    track->SetTrackStatus( fKillTrackAndSecondaries );
+
+    if( track->GetDefinition() == G4OpticalPhoton::Definition() && !draw_efficiency( postStepPoint->GetKineticEnergy() ) )
+        return true;
+
+    G4int           copyNumber = m_copyNumberMap.get_ID( t_step->GetPreStepPoint()->GetTouchable() );
+    PhotoSensorHit* hit        = new PhotoSensorHit();
     
-    vector< LensHit* > lensHits;
+    hit->reserve_lensHits( m_lensSensitiveDetectors.size() );
     for( auto lens : m_lensSensitiveDetectors ) {
-        lensHits.push_back( lens->get_firstHit() );
+        hit->add_lensHit( lens->get_firstHit( copyNumber ) );
     }
 
-    hit->set_photoSensor_position      ( m_position                                                            );
-    hit->set_photoSensor_rotationMatrix( m_rotationMatrix                                                      );
-    hit->set_photoSensor_name          ( m_name                                                                );
-    hit->set_photoSensor_ID            ( m_ID                                                                  );
-    hit->set_hit_position_absolute     ( t_step->GetPostStepPoint()->GetPosition      ()                       );
-    hit->set_hit_time                  ( t_step->GetPostStepPoint()->GetGlobalTime    ()                       );
-    hit->set_hit_energy                ( t_step->GetPostStepPoint()->GetKineticEnergy ()                       );
-    hit->set_hit_momentum              ( t_step->GetPostStepPoint()->GetMomentum      ()                       );
-    hit->set_hit_process               ( t_step->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName() );
-    hit->set_particle_energy           ( t_step->GetTrack        ()->GetKineticEnergy ()                       );
-    hit->set_particle_momentum         ( t_step->GetTrack        ()->GetMomentum      ()                       );
-    hit->set_particle_position_initial ( t_step->GetTrack        ()->GetVertexPosition()                       );
-    hit->set_lensHits                  ( lensHits                                                              );
+    hit->set_photoSensor_position      ( get_position      ( copyNumber )                         );
+    hit->set_photoSensor_rotationMatrix( get_rotationMatrix( copyNumber )                         );
+    hit->set_photoSensor_name          ( get_name          ( copyNumber )                         );
+    hit->set_photoSensor_ID            ( copyNumber                                               );
+    hit->set_hit_position_absolute     ( postStepPoint->GetPosition      ()                       );
+    hit->set_hit_time                  ( postStepPoint->GetGlobalTime    ()                       );
+    hit->set_hit_energy                ( postStepPoint->GetKineticEnergy ()                       );
+    hit->set_hit_weight                ( track->GetWeight        ()                               );
+    hit->set_hit_momentum              ( postStepPoint->GetMomentum      ()                       );
+    hit->set_hit_process               ( postStepPoint->GetProcessDefinedStep()->GetProcessName() );
+    hit->set_particle_energy           ( track->GetKineticEnergy ()                               );
+    hit->set_particle_momentum         ( track->GetMomentum      ()                               );
+    hit->set_particle_position_initial ( track->GetVertexPosition()                               );
 
     m_photoSensorHitsCollection->insert( hit );
 
-    t_step->GetTrack()->SetTrackStatus( fKillTrackAndSecondaries );
-
     return true;
 }
 
-G4String PhotoSensorSensitiveDetector::get_name() {
+// Records a photon that was not tracked onto the photosensor of DSPD t_copyNumber (see
+// DSPDFastSimulationModel and StackingAction), arriving with energy t_energy and momentum
+// t_momentum, of weight t_weight and born at t_position_initial. No lens hits are attached
+// and the caller draws the detection efficiency (see draw_efficiency()). t_process has to
+// outlive the event.
+void PhotoSensorSensitiveDetector::add_hit(       G4int          t_copyNumber      , 
+                                            const G4ThreeVector& t_position        , 
+                                                  G4double       t_time            , 
+                                                  G4double       t_energy          , 
+                                            const G4ThreeVector& t_momentum        , 
+                                            const G4String     & t_process         , 
+                                                  G4double       t_weight          , 
+                                            const G4ThreeVector& t_position_initial ) {
+    PhotoSensorHit* hit = new PhotoSensorHit();
+
+    hit->set_photoSensor_position      ( get_position      ( t_copyNumber ) );
+    hit->set_photoSensor_rotationMatrix( get_rotationMatrix( t_copyNumber ) );
+    hit->set_photoSensor_name          ( get_name          ( t_copyNumber ) );
+    hit->set_photoSensor_ID            ( t_copyNumber                       );
+    hit->set_hit_position_absolute     ( t_position                         );
+    hit->set_hit_time                  ( t_time                             );
+    hit->set_hit_energy                ( t_energy                           );
+    hit->set_hit_weight                ( t_weight                           );
+    hit->set_hit_momentum              ( t_momentum                         );
+    hit->set_hit_process               ( t_process                          );
+    hit->set_particle_energy           ( t_energy                           );
+    hit->set_particle_momentum         ( t_momentum                         );
+    hit->set_particle_position_initial ( t_position_initial                 );
+
+    m_photoSensorHitsCollection->insert( hit );
+}
+
+// Reads `/geometry/photoSensor/efficiency' when it changed, given as pairs of wavelength [nm]
+// and efficiency ("none" for every photon to be recorded), and the prescale of this event.
+// Called per event by Initialize() and StackingAction::PrepareNewEvent(), in either order.
+void PhotoSensorSensitiveDetector::update_efficiency() {
+    ConstructionMessenger* constructionMessenger = ConstructionMessenger::get_instance();
+
+    G4String efficiency_string = constructionMessenger->get_photoSensor_efficiency();
+    if( efficiency_string != m_efficiency_string ) {
+        if( m_efficiency ) delete m_efficiency;
+        m_efficiency        = nullptr;
+        m_efficiency_max    = 1.;
+        m_efficiency_string = efficiency_string;
+
+        if( to_lower_copy( efficiency_string ) != "none" ) {
+            vector< G4double > values;
+            G4Tokenizer tokenizer( efficiency_string );
+            G4String value_string;
+            while( !( value_string = tokenizer( " ,\t" ) ).empty() )
+                values.push_back( stod( value_string ) );
+
+            if( values.size() < 2 || values.size() % 2 != 0 )
+                G4Exception( "PhotoSensorSensitiveDetector::update_efficiency", "InvalidArgument", FatalException, 
+                             "`/geometry/photoSensor/efficiency' needs pairs of wavelength [nm] and efficiency." );
+
+            // by increasing energy, i.e. decreasing wavelength
+            vector< pair< G4double, G4double > > points;
+            for( size_t index{ 0 }; index < values.size(); index += 2 ) {
+                if( values[ index ] <= 0 || values[ index + 1 ] < 0 || values[ index + 1 ] > 1 )
+                    G4Exception( "PhotoSensorSensitiveDetector::update_efficiency", "InvalidArgument", FatalException, 
+                                 "`/geometry/photoSensor/efficiency' needs wavelengths > 0 and efficiencies in [0,1]." );
+                points.push_back( { h_Planck * c_light / ( values[ index ] * nm ), values[ index + 1 ] } );
+            }
+            sort( points.begin(), points.end() );
+
+            m_efficiency     = new G4MaterialPropertyVector();
+            m_efficiency_max = 0.;
+            for( const pair< G4double, G4double >& point : points ) {
+                m_efficiency->InsertValues( point.first, point.second );
+                m_efficiency_max = max( m_efficiency_max, point.second );
+            }
+            if( m_efficiency_max <= 0 )
+                G4Exception( "PhotoSensorSensitiveDetector::update_efficiency", "InvalidArgument", FatalException, 
+                             "`/geometry/photoSensor/efficiency' is 0 at every wavelength." );
+        }
+    }
+
+    m_efficiency_prescale = ( m_efficiency && constructionMessenger->get_photoSensor_efficiency_prescale() ) ? m_efficiency_max : 1.;
+}
+
+// Detection efficiency of a photon of energy t_energy, clamped at the ends of the curve
+G4double PhotoSensorSensitiveDetector::get_efficiency( G4double t_energy ) {
+    return m_efficiency ? m_efficiency->Value( t_energy ) : 1.;
+}
+
+// Whether an optical photon of energy t_energy that survived the prescale at birth is detected
+G4bool PhotoSensorSensitiveDetector::draw_efficiency( G4double t_energy ) {
+    return !m_efficiency || G4UniformRand() * m_efficiency_prescale < get_efficiency( t_energy );
+}
+
+// Survival probability StackingAction applies to optical photons at birth, 1 for none
+G4double PhotoSensorSensitiveDetector::get_efficiency_prescale() {
+    return m_efficiency_prescale;
+}
+
+const G4String& PhotoSensorSensitiveDetector::get_name() {
     return m_name;
 }
 
+// Hits keep a reference to the name, so the name of a surface lattice copy is made when
+// it is first asked for and kept until the sensitive detector is deleted
+const G4String& PhotoSensorSensitiveDetector::get_name( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_names.size() ) )
+        return m_copy_names[ t_copyNumber ];
+    if( t_copyNumber >= G4int( m_surfaceLattice_names.size() ) || m_surfaceLattice_names[ t_copyNumber ].empty() ) {
+        const SurfaceLattice* surfaceLattice = SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber );
+        m_surfaceLattice_names.at( t_copyNumber ) = surfaceLattice->get_name( surfaceLattice->get_DSPD( t_copyNumber ) ) + m_surfaceLattice_suffix;
+    }
+    return m_surfaceLattice_names[ t_copyNumber ];
+}
+
+void PhotoSensorSensitiveDetector::set_copyNumberMap( const CopyNumberMap& t_copyNumberMap ) {
+    m_copyNumberMap = t_copyNumberMap;
+}
 
-void PhotoSensorSensitiveDetector::set_position( G4ThreeVector t_position ) {
-    m_position = t_position;
+void PhotoSensorSensitiveDetector::add_copy( const G4String     & t_name          , 
+                                             G4ThreeVector        t_position      , 
+                                             G4RotationMatrix   * t_rotationMatrix ) {
+    m_copy_names           .push_back( t_name           );
+    m_copy_positions       .push_back( t_position       );
+    m_copy_rotationMatrices.push_back( t_rotationMatrix );
 }
 
-void PhotoSensorSensitiveDetector::set_rotationMatrix( G4RotationMatrix* t_rotationMatrix ) {
-    m_rotationMatrix = t_rotationMatrix;
+// Every DSPD of t_surfaceLattice, after the copies added so far. Copies are named after
+// their DSPD followed by t_suffix and sit at t_offset from the back of the photosensor,
+// in the DSPD frame.
+void PhotoSensorSensitiveDetector::add_copies( const SurfaceLattice* t_surfaceLattice, 
+                                               const G4String      & t_suffix        , 
+                                               G4ThreeVector         t_offset         ) {
+    m_surfaceLattices.push_back( t_surfaceLattice );
+    m_surfaceLattice_suffix = t_suffix;
+    m_surfaceLattice_offset = t_offset;
+    m_surfaceLattice_names.resize( std::max( G4int( m_surfaceLattice_names.size() ), 
+                                             t_surfaceLattice->get_DSPD_ID_begin() + t_surfaceLattice->get_amount( SurfaceLattice::DSPD ) ) );
 }
 
-G4ThreeVector PhotoSensorSensitiveDetector::get_position() {
-    return m_position;
+G4ThreeVector PhotoSensorSensitiveDetector::get_position( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_positions.size() ) )
+        return m_copy_positions[ t_copyNumber ];
+    const SurfaceLattice* surfaceLattice = SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber );
+    return surfaceLattice->get_position( surfaceLattice->get_DSPD( t_copyNumber ) ) 
+         + *surfaceLattice->get_rotationMatrix( SurfaceLattice::DSPD ) * m_surfaceLattice_offset;
 }
 
-G4RotationMatrix* PhotoSensorSensitiveDetector::get_rotationMatrix() {
-    return m_rotationMatrix;
+G4RotationMatrix* PhotoSensorSensitiveDetector::get_rotationMatrix( G4int t_copyNumber ) {
+    if( t_copyNumber < G4int( m_copy_rotationMatrices.size() ) )
+        return m_copy_rotationMatrices[ t_copyNumber ];
+    return SurfaceLattice::find_DSPD( m_surfaceLattices, t_copyNumber )->get_rotationMatrix( SurfaceLattice::DSPD );
+}
+
+G4int PhotoSensorSensitiveDetector::get_nCopies() {
+    G4int nCopies = m_copy_names.size();
+    for( const SurfaceLattice* surfaceLattice : m_surfaceLattices )
+        nCopies += surfaceLattice->get_amount( SurfaceLattice::DSPD );
+    return nCopies;
 }
 
 PhotoSensorHitsCollection* PhotoSensorSensitiveDetector::get_hitsCollection( const G4Event* t_event ) {
@@ -94,10 +245,6 @@ void PhotoSensorSensitiveDetector::set_hitsCollection_ID( G4int t_photoSensorHit
     m_photoSensorHitsCollection_ID = t_photoSensorHitsCollection_ID;
 }
 
-G4int PhotoSensorSensitiveDetector::get_ID() {
-    return m_ID;
-}
-
 void PhotoSensorSensitiveDetector::set_lensSensitiveDetectors( vector< LensSensitiveDetector* > t_lensSensitiveDetectors ) {
     m_lensSensitiveDetectors = t_lensSensitiveDetectors;
 }
\ No newline at end of file
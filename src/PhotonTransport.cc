@@ -0,0 +1,147 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "PhotonTransport.hh"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+using std::sqrt;
+using std::log;
+using std::cbrt;
+using std::cos;
+using std::sin;
+using std::abs;
+using std::min;
+using std::copysign;
+using std::invalid_argument;
+
+PhotonTransport::PhotonTransport( const RayTracerMaterial& t_medium    , 
+                                  double                   t_halfSize_x, 
+                                  double                   t_halfSize_y, 
+                                  double                   t_halfSize_z ) 
+    : m_medium  ( t_medium                                   ),
+      m_halfSize{ t_halfSize_x, t_halfSize_y, t_halfSize_z } {
+    if( t_halfSize_x <= 0 || t_halfSize_y <= 0 || t_halfSize_z <= 0 )
+        throw invalid_argument( "PhotonTransport: the half sizes of the box must be positive" );
+}
+
+namespace {
+    // Distance drawn from an exponential distribution with mean t_length for t_uniform in [0, 1)
+    inline double get_distance_exponential( double t_length, double t_uniform ) {
+        if( t_length == HUGE_VAL )
+            return HUGE_VAL;
+        return -t_length * log( 1 - t_uniform );
+    }
+}
+
+// Transports every alive photon of t_batch with energy t_energy until it is absorbed or
+// reaches a face of the box
+void PhotonTransport::transport( RayTracerBatch& t_batch, double t_energy, std::mt19937_64& t_generator ) const {
+    double groupIndex       = m_medium.get_groupIndex      ( t_energy );
+    double absorptionLength = m_medium.get_absorptionLength( t_energy );
+    double scatteringLength = m_medium.get_scatteringLength( t_energy );
+    std::uniform_real_distribution< double > uniform( 0, 1 );
+
+    // the absorption point is drawn once, the distance left to it is carried between steps
+    vector< double > absorption( t_batch.size() ), scattering( t_batch.size() );
+    vector< double > cosTheta  ( t_batch.size() ), phi       ( t_batch.size() );
+    vector< char   > scattered ( t_batch.size() );
+    for( size_t i = 0; i < t_batch.size(); i++ )
+        absorption[ i ] = get_distance_exponential( absorptionLength, uniform( t_generator ) );
+
+    size_t nAlive = std::count( t_batch.m_status.begin(), t_batch.m_status.end(), RayTracerBatch::m_alive );
+    for( int step = 0; step < m_nSteps_max && nAlive > 0; step++ ) {
+        // random numbers first, so that the loops below do not depend on the generator
+        for( size_t i = 0; i < t_batch.size(); i++ ) {
+            if( t_batch.m_status[ i ] != RayTracerBatch::m_alive )
+                continue;
+            scattering[ i ] = get_distance_exponential( scatteringLength, uniform( t_generator ) );
+            if( scattering[ i ] < HUGE_VAL ) {
+                // unpolarised Rayleigh phase function ( 1 + cos^2 ), inverted analytically
+                double a = 4 * uniform( t_generator ) - 2;
+                double c = cbrt( a + sqrt( a * a + 1 ) );
+                cosTheta[ i ] = min( 1.0, std::max( -1.0, c - 1 / c ) );
+                phi     [ i ] = 2 * M_PI * uniform( t_generator );
+            }
+        }
+
+        // move to the nearest of the box, the scattering point and the absorption point
+        for( size_t i = 0; i < t_batch.size(); i++ ) {
+            scattered[ i ] = 0;
+            if( t_batch.m_status[ i ] != RayTracerBatch::m_alive )
+                continue;
+
+            // a zero direction component gives an infinite distance for either sign of zero
+            double box = min( { ( copysign( m_halfSize[ 0 ], t_batch.m_dx[ i ] ) - t_batch.m_x[ i ] ) / t_batch.m_dx[ i ],
+                                ( copysign( m_halfSize[ 1 ], t_batch.m_dy[ i ] ) - t_batch.m_y[ i ] ) / t_batch.m_dy[ i ],
+                                ( copysign( m_halfSize[ 2 ], t_batch.m_dz[ i ] ) - t_batch.m_z[ i ] ) / t_batch.m_dz[ i ] } );
+            box = std::max( box, 0.0 );
+            double distance = min( { box, scattering[ i ], absorption[ i ] } );
+
+            if     ( distance == box             ) t_batch.m_status[ i ] = RayTracerBatch::m_boundary;
+            else if( distance == absorption[ i ] ) t_batch.m_status[ i ] = RayTracerBatch::m_absorbed;
+            else                                   scattered       [ i ] = 1;
+
+            t_batch.m_x                [ i ] += distance * t_batch.m_dx[ i ];
+            t_batch.m_y                [ i ] += distance * t_batch.m_dy[ i ];
+            t_batch.m_z                [ i ] += distance * t_batch.m_dz[ i ];
+            t_batch.m_pathLength       [ i ] += distance;
+            t_batch.m_groupPathLength  [ i ] += distance * groupIndex;
+            absorption                 [ i ] -= distance;
+        }
+
+        // new directions of the scattered photons
+        nAlive = 0;
+        for( size_t i = 0; i < t_batch.size(); i++ ) {
+            if( !scattered[ i ] )
+                continue;
+            nAlive++;
+
+            double dx = t_batch.m_dx[ i ], dy = t_batch.m_dy[ i ], dz = t_batch.m_dz[ i ];
+            double sinTheta = sqrt( 1 - cosTheta[ i ] * cosTheta[ i ] );
+            double cosPhi   = cos( phi[ i ] ), sinPhi = sin( phi[ i ] );
+            if( abs( dz ) > 0.99999 ) {
+                t_batch.m_dx[ i ] = sinTheta * cosPhi;
+                t_batch.m_dy[ i ] = sinTheta * sinPhi;
+                t_batch.m_dz[ i ] = copysign( cosTheta[ i ], dz );
+            } else {
+                double norm = sqrt( 1 - dz * dz );
+                t_batch.m_dx[ i ] = sinTheta * ( dx * dz * cosPhi - dy * sinPhi ) / norm + dx * cosTheta[ i ];
+                t_batch.m_dy[ i ] = sinTheta * ( dy * dz * cosPhi + dx * sinPhi ) / norm + dy * cosTheta[ i ];
+                t_batch.m_dz[ i ] = -sinTheta * cosPhi * norm                            + dz * cosTheta[ i ];
+            }
+        }
+    }
+}
+
+bool PhotonTransport::contains( double t_x , double t_y , double t_z , 
+                                double t_dx, double t_dy, double t_dz ) const {
+    double position [ 3 ]{ t_x , t_y , t_z  };
+    double direction[ 3 ]{ t_dx, t_dy, t_dz };
+    for( int axis = 0; axis < 3; axis++ ) {
+        if( abs( position[ axis ] ) > m_halfSize[ axis ] + m_tolerance )
+            return false;
+        if( abs( position[ axis ] ) > m_halfSize[ axis ] - m_tolerance && position[ axis ] * direction[ axis ] >= 0 )
+            return false;
+    }
+    return true;
+}
+
+const RayTracerMaterial& PhotonTransport::get_medium() const {
+    return m_medium;
+}
+
+double PhotonTransport::get_halfSize( int t_axis ) const {
+    return m_halfSize[ t_axis ];
+}
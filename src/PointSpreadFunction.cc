@@ -0,0 +1,185 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "PointSpreadFunction.hh"
+#include "ParticleGunMessenger.hh"
+#include "OutputMessenger.hh"
+#include "ConstructionMessenger.hh"
+
+#include "G4AutoLock.hh"
+
+#include <cmath>
+#include <cstring>
+
+namespace { G4Mutex pointSpreadFunctionMutex = G4MUTEX_INITIALIZER; }
+
+PointSpreadFunction* PointSpreadFunction::m_instance{ nullptr };
+
+PointSpreadFunction::PointSpreadFunction() {
+    reset();
+}
+
+PointSpreadFunction* PointSpreadFunction::get_instance() {
+    G4AutoLock lock( &pointSpreadFunctionMutex );
+    if( !m_instance ) 
+        m_instance = new PointSpreadFunction();
+    return m_instance;
+}
+
+void PointSpreadFunction::delete_instance() {
+    if( m_instance ) {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+}
+
+// Clears the table and takes its dimensions from the current lens scan parameters
+void PointSpreadFunction::reset() {
+    ParticleGunMessenger* particleGunMessenger = ParticleGunMessenger::get_instance();
+
+    m_nAngles_x   = std::max( 1, particleGunMessenger->get_lensScan_angle_x_nSteps() );
+    m_nAngles_y   = std::max( 1, particleGunMessenger->get_lensScan_angle_y_nSteps() );
+    m_angle_x_min = particleGunMessenger->get_lensScan_angle_x_min();
+    m_angle_x_max = particleGunMessenger->get_lensScan_angle_x_max();
+    m_angle_y_min = particleGunMessenger->get_lensScan_angle_y_min();
+    m_angle_y_max = particleGunMessenger->get_lensScan_angle_y_max();
+    m_nBins       = OutputMessenger      ::get_instance()->get_photoSensor_hits_position_binned_nBinsPerSide();
+    m_width       = ConstructionMessenger::get_instance()->get_photoSensor_body_size_width                   ();
+
+    m_nPhotons.assign( get_nDirections()                    , 0 );
+    m_hits    .assign( get_nDirections() * m_nBins * m_nBins, 0 );
+}
+
+// Adds a hit at ( t_x, t_y ) relative to the photosensor center; hits outside the binned range are dropped
+void PointSpreadFunction::fill( G4int t_direction, G4double t_x, G4double t_y ) {
+    G4int bin_x = G4int( std::floor( ( t_x / m_width + 0.5 ) * m_nBins ) );
+    G4int bin_y = G4int( std::floor( ( t_y / m_width + 0.5 ) * m_nBins ) );
+    if( bin_x < 0 || bin_x >= m_nBins || bin_y < 0 || bin_y >= m_nBins )
+        return;
+    m_hits[ ( size_t( t_direction ) * m_nBins + bin_x ) * m_nBins + bin_y ]++;
+}
+
+void PointSpreadFunction::add_photons( G4int t_direction, G4long t_nPhotons ) {
+    m_nPhotons[ t_direction ] += t_nPhotons;
+}
+
+void PointSpreadFunction::merge( const PointSpreadFunction& t_pointSpreadFunction ) {
+    G4AutoLock lock( &pointSpreadFunctionMutex );
+    if( t_pointSpreadFunction.m_hits.size() != m_hits.size() )
+        G4Exception( "PointSpreadFunction::merge", "InvalidSetup", FatalException, 
+                     "The lens scan parameters changed during the run." );
+    for( size_t index{ 0 }; index < m_nPhotons.size(); index++ )
+        m_nPhotons[ index ] += t_pointSpreadFunction.m_nPhotons[ index ];
+    for( size_t index{ 0 }; index < m_hits.size(); index++ )
+        m_hits[ index ] += t_pointSpreadFunction.m_hits[ index ];
+}
+
+void PointSpreadFunction::write( const G4String& t_fileName ) const {
+    ofstream file( t_fileName, std::ios::binary );
+    if( !file )
+        G4Exception( "PointSpreadFunction::write", "InvalidSetup", FatalException, 
+                     ( "Cannot open `" + t_fileName + "'." ).c_str() );
+
+    int32_t nAngles_x = m_nAngles_x, nAngles_y = m_nAngles_y, nBins = m_nBins, version = m_version;
+    file.write( m_magic                                          , sizeof( m_magic       ) );
+    file.write( reinterpret_cast< const char* >( &version       ), sizeof( version       ) );
+    file.write( reinterpret_cast< const char* >( &nAngles_x     ), sizeof( nAngles_x     ) );
+    file.write( reinterpret_cast< const char* >( &nAngles_y     ), sizeof( nAngles_y     ) );
+    file.write( reinterpret_cast< const char* >( &m_angle_x_min ), sizeof( m_angle_x_min ) );
+    file.write( reinterpret_cast< const char* >( &m_angle_x_max ), sizeof( m_angle_x_max ) );
+    file.write( reinterpret_cast< const char* >( &m_angle_y_min ), sizeof( m_angle_y_min ) );
+    file.write( reinterpret_cast< const char* >( &m_angle_y_max ), sizeof( m_angle_y_max ) );
+    file.write( reinterpret_cast< const char* >( &nBins         ), sizeof( nBins         ) );
+    file.write( reinterpret_cast< const char* >( &m_width       ), sizeof( m_width       ) );
+    for( G4int direction{ 0 }; direction < get_nDirections(); direction++ ) {
+        file.write( reinterpret_cast< const char* >( &m_nPhotons[ direction                     ] ), sizeof( uint64_t )                   );
+        file.write( reinterpret_cast< const char* >( &m_hits    [ direction * m_nBins * m_nBins ] ), sizeof( uint32_t ) * m_nBins * m_nBins );
+    }
+
+    G4cout << "PointSpreadFunction::write: " << get_nDirections() << " directions with " 
+           << m_nBins << "x" << m_nBins << " bins written to " << t_fileName << G4endl;
+}
+
+void PointSpreadFunction::read( const G4String& t_fileName ) {
+    ifstream file( t_fileName, std::ios::binary );
+    char    magic[ 8 ];
+    int32_t version{ 0 }, nAngles_x{ 0 }, nAngles_y{ 0 }, nBins{ 0 };
+    file.read( magic                                , sizeof( magic   ) );
+    file.read( reinterpret_cast< char* >( &version ), sizeof( version ) );
+    if( !file || std::memcmp( magic, m_magic, sizeof( magic ) ) != 0 || version != m_version )
+        G4Exception( "PointSpreadFunction::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is not a lens scan table of this version." ).c_str() );
+
+    file.read( reinterpret_cast< char* >( &nAngles_x     ), sizeof( nAngles_x     ) );
+    file.read( reinterpret_cast< char* >( &nAngles_y     ), sizeof( nAngles_y     ) );
+    file.read( reinterpret_cast< char* >( &m_angle_x_min ), sizeof( m_angle_x_min ) );
+    file.read( reinterpret_cast< char* >( &m_angle_x_max ), sizeof( m_angle_x_max ) );
+    file.read( reinterpret_cast< char* >( &m_angle_y_min ), sizeof( m_angle_y_min ) );
+    file.read( reinterpret_cast< char* >( &m_angle_y_max ), sizeof( m_angle_y_max ) );
+    file.read( reinterpret_cast< char* >( &nBins         ), sizeof( nBins         ) );
+    file.read( reinterpret_cast< char* >( &m_width       ), sizeof( m_width       ) );
+    m_nAngles_x = nAngles_x;
+    m_nAngles_y = nAngles_y;
+    m_nBins     = nBins;
+
+    m_nPhotons.assign( get_nDirections()                    , 0 );
+    m_hits    .assign( get_nDirections() * m_nBins * m_nBins, 0 );
+    for( G4int direction{ 0 }; direction < get_nDirections(); direction++ ) {
+        file.read( reinterpret_cast< char* >( &m_nPhotons[ direction                     ] ), sizeof( uint64_t )                   );
+        file.read( reinterpret_cast< char* >( &m_hits    [ direction * m_nBins * m_nBins ] ), sizeof( uint32_t ) * m_nBins * m_nBins );
+    }
+    if( !file )
+        G4Exception( "PointSpreadFunction::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is truncated." ).c_str() );
+}
+
+G4int PointSpreadFunction::get_nDirections() const {
+    return m_nAngles_x * m_nAngles_y;
+}
+
+G4int PointSpreadFunction::get_nAngles_x() const {
+    return m_nAngles_x;
+}
+
+G4int PointSpreadFunction::get_nAngles_y() const {
+    return m_nAngles_y;
+}
+
+G4int PointSpreadFunction::get_nBins() const {
+    return m_nBins;
+}
+
+G4double PointSpreadFunction::get_width() const {
+    return m_width;
+}
+
+G4long PointSpreadFunction::get_nPhotons( G4int t_direction ) const {
+    return m_nPhotons.at( t_direction );
+}
+
+G4long PointSpreadFunction::get_nHits( G4int t_direction ) const {
+    G4long nHits{ 0 };
+    for( G4int bin{ 0 }; bin < m_nBins * m_nBins; bin++ )
+        nHits += m_hits[ size_t( t_direction ) * m_nBins * m_nBins + bin ];
+    return nHits;
+}
+
+// Probability of a photon of direction t_direction to hit bin t_bin
+G4double PointSpreadFunction::get_probability( G4int t_direction, G4int t_bin ) const {
+    if( m_nPhotons.at( t_direction ) == 0 )
+        return 0;
+    return G4double( m_hits.at( size_t( t_direction ) * m_nBins * m_nBins + t_bin ) ) / m_nPhotons[ t_direction ];
+}
+
+// Direction of a beam at the given angles to the DSPD axis (+z, into the DSPD) in the x-z and y-z planes
+G4ThreeVector PointSpreadFunction::get_direction( G4double t_angle_x, G4double t_angle_y ) {
+    return G4ThreeVector( std::tan( t_angle_x ), std::tan( t_angle_y ), 1 ).unit();
+}
@@ -0,0 +1,389 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "RayTracer.hh"
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+using std::sqrt;
+using std::exp;
+using std::log;
+using std::abs;
+using std::min;
+using std::max;
+using std::invalid_argument;
+
+RayTracerMaterial::RayTracerMaterial( double t_rindex ) 
+    : m_rindex_energies{ 0 }, m_rindex_values{ t_rindex } {
+    make_groupIndex();
+}
+
+RayTracerMaterial::RayTracerMaterial( const vector< double >& t_rindex_energies          , 
+                                      const vector< double >& t_rindex_values            ,
+                                      const vector< double >& t_absorptionLength_energies, 
+                                      const vector< double >& t_absorptionLength_values  ,
+                                      const vector< double >& t_scatteringLength_energies, 
+                                      const vector< double >& t_scatteringLength_values   ) 
+    : m_rindex_energies          ( t_rindex_energies           ),
+      m_rindex_values            ( t_rindex_values             ),
+      m_absorptionLength_energies( t_absorptionLength_energies ),
+      m_absorptionLength_values  ( t_absorptionLength_values   ),
+      m_scatteringLength_energies( t_scatteringLength_energies ),
+      m_scatteringLength_values  ( t_scatteringLength_values   ) {
+    if( m_rindex_energies.empty() || m_rindex_energies.size() != m_rindex_values.size() )
+        throw invalid_argument( "RayTracerMaterial: the refractive index table is empty or its columns differ in length" );
+    if( m_absorptionLength_energies.size() != m_absorptionLength_values.size() )
+        throw invalid_argument( "RayTracerMaterial: the columns of the absorption length table differ in length" );
+    if( m_scatteringLength_energies.size() != m_scatteringLength_values.size() )
+        throw invalid_argument( "RayTracerMaterial: the columns of the scattering length table differ in length" );
+    if( !std::is_sorted( m_rindex_energies.begin(), m_rindex_energies.end() ) ||
+        !std::is_sorted( m_absorptionLength_energies.begin(), m_absorptionLength_energies.end() ) ||
+        !std::is_sorted( m_scatteringLength_energies.begin(), m_scatteringLength_energies.end() ) )
+        throw invalid_argument( "RayTracerMaterial: the energies are not in increasing order" );
+    make_groupIndex();
+}
+
+// Group index n + dn / d( ln E ) as in G4MaterialPropertiesTable::CalculateGROUPVEL: at the
+// first and last energies from the first and last intervals, in between at the midpoints of
+// the intervals but the last, and n itself where the dispersion is anomalous
+void RayTracerMaterial::make_groupIndex() {
+    size_t size = m_rindex_energies.size();
+    if( size == 1 ) {
+        m_groupIndex_energies = m_rindex_energies;
+        m_groupIndex_values   = m_rindex_values  ;
+        return;
+    }
+    if( m_rindex_energies.front() <= 0 )
+        throw invalid_argument( "RayTracerMaterial: the energies of a refractive index table have to be positive" );
+
+    auto get_dispersion = [ & ]( size_t t_index ) {
+        return ( m_rindex_values[ t_index + 1 ] - m_rindex_values[ t_index ] ) 
+             / log( m_rindex_energies[ t_index + 1 ] / m_rindex_energies[ t_index ] );
+    };
+    m_groupIndex_energies.clear();
+    m_groupIndex_values  .clear();
+    m_groupIndex_energies.push_back( m_rindex_energies.front() );
+    m_groupIndex_values  .push_back( m_rindex_values.front() + max( 0., get_dispersion( 0 ) ) );
+    for( size_t i = 0; i + 2 < size; i++ ) {
+        m_groupIndex_energies.push_back( ( m_rindex_energies[ i ] + m_rindex_energies[ i + 1 ] ) / 2 );
+        m_groupIndex_values  .push_back( ( m_rindex_values  [ i ] + m_rindex_values  [ i + 1 ] ) / 2 + max( 0., get_dispersion( i ) ) );
+    }
+    m_groupIndex_energies.push_back( m_rindex_energies.back() );
+    m_groupIndex_values  .push_back( m_rindex_values.back() + max( 0., get_dispersion( size - 2 ) ) );
+}
+
+double RayTracerMaterial::interpolate( const vector< double >& t_energies, const vector< double >& t_values, double t_energy ) {
+    if( t_energy <= t_energies.front() ) return t_values.front();
+    if( t_energy >= t_energies.back () ) return t_values.back ();
+    size_t index = std::upper_bound( t_energies.begin(), t_energies.end(), t_energy ) - t_energies.begin();
+    double fraction = ( t_energy - t_energies[ index - 1 ] ) / ( t_energies[ index ] - t_energies[ index - 1 ] );
+    return t_values[ index - 1 ] + fraction * ( t_values[ index ] - t_values[ index - 1 ] );
+}
+
+double RayTracerMaterial::get_rindex( double t_energy ) const {
+    return interpolate( m_rindex_energies, m_rindex_values, t_energy );
+}
+
+double RayTracerMaterial::get_groupIndex( double t_energy ) const {
+    return interpolate( m_groupIndex_energies, m_groupIndex_values, t_energy );
+}
+
+double RayTracerMaterial::get_absorptionLength( double t_energy ) const {
+    if( m_absorptionLength_energies.empty() )
+        return HUGE_VAL;
+    return interpolate( m_absorptionLength_energies, m_absorptionLength_values, t_energy );
+}
+
+double RayTracerMaterial::get_scatteringLength( double t_energy ) const {
+    if( m_scatteringLength_energies.empty() )
+        return HUGE_VAL;
+    return interpolate( m_scatteringLength_energies, m_scatteringLength_values, t_energy );
+}
+
+// All tables, one line each, e.g. as part of a cache key (see LensResponseTable::get_key)
+void RayTracerMaterial::print( std::ostream& t_ostream ) const {
+    for( const vector< double >* table : { &m_rindex_energies          , &m_rindex_values          , 
+                                           &m_absorptionLength_energies, &m_absorptionLength_values,
+                                           &m_scatteringLength_energies, &m_scatteringLength_values } ) {
+        for( double value : *table )
+            t_ostream << value << ' ';
+        t_ostream << '\n';
+    }
+}
+
+RayTracerLens::RayTracerLens( double t_surface_1_radius_x, double t_surface_1_radius_y,
+                              double t_surface_2_radius_x, double t_surface_2_radius_y,
+                              double t_thickness         , double t_position          ,
+                              double t_yLimits           , bool   t_circular          ,
+                              const RayTracerMaterial& t_material                      ) 
+    : m_surface_radius_x{ t_surface_1_radius_x, t_surface_2_radius_x },
+      m_surface_radius_y{ t_surface_1_radius_y, t_surface_2_radius_y },
+      m_surface_vertex  { t_position - t_thickness / 2, t_position + t_thickness / 2 },
+      m_yLimits         ( t_yLimits  ),
+      m_circular        ( t_circular ),
+      m_position        ( t_position ),
+      m_material        ( t_material ) {
+    for( int surface = 0; surface < 2; surface++ )
+        if( m_surface_radius_x[ surface ] == 0 || m_surface_radius_y[ surface ] < m_yLimits )
+            throw invalid_argument( "RayTracerLens: radius_x is 0 or radius_y is smaller than yLimits" );
+}
+
+double RayTracerLens::get_position() const {
+    return m_position;
+}
+
+double RayTracerLens::get_surface_z( int t_surface, double t_rho ) const {
+    double u = min( t_rho, m_yLimits ) / m_surface_radius_y[ t_surface ];
+    return m_surface_vertex[ t_surface ] - m_surface_radius_x[ t_surface ] * ( 1 - sqrt( 1 - u * u ) );
+}
+
+RayTracerBatch::RayTracerBatch( size_t t_size ) {
+    resize( t_size );
+}
+
+void RayTracerBatch::resize( size_t t_size ) {
+    for( vector< double >* component : { &m_x, &m_y, &m_z, &m_dx, &m_dy, &m_dz, &m_pathLength, &m_groupPathLength } )
+        component->assign( t_size, 0 );
+    m_weight.assign( t_size, 1       );
+    m_status.assign( t_size, m_alive );
+}
+
+size_t RayTracerBatch::size() const {
+    return m_x.size();
+}
+
+// Sets photon t_index at ( t_x, t_y, t_z ) moving along ( t_dx, t_dy, t_dz ), which is normalised here
+void RayTracerBatch::set( size_t t_index, double t_x , double t_y , double t_z , 
+                                          double t_dx, double t_dy, double t_dz ) {
+    double norm = sqrt( t_dx * t_dx + t_dy * t_dy + t_dz * t_dz );
+    m_x                [ t_index ] = t_x;
+    m_y                [ t_index ] = t_y;
+    m_z                [ t_index ] = t_z;
+    m_dx               [ t_index ] = t_dx / norm;
+    m_dy               [ t_index ] = t_dy / norm;
+    m_dz               [ t_index ] = t_dz / norm;
+    m_weight           [ t_index ] = 1;
+    m_pathLength       [ t_index ] = 0;
+    m_groupPathLength  [ t_index ] = 0;
+    m_status           [ t_index ] = m_alive;
+}
+
+RayTracer::RayTracer( const RayTracerMaterial& t_medium, double t_photoSensor_z, double t_halfWidth ) 
+    : m_medium       ( t_medium        ),
+      m_photoSensor_z( t_photoSensor_z ),
+      m_halfWidth    ( t_halfWidth     ) {
+}
+
+void RayTracer::add_lens( const RayTracerLens& t_lens ) {
+    if( t_lens.get_surface_z( 1, 0 ) > m_photoSensor_z )
+        throw invalid_argument( "RayTracer::add_lens: the lens is behind the photosensor" );
+    auto position = std::upper_bound( m_lenses.begin(), m_lenses.end(), t_lens, 
+                                      []( const RayTracerLens& t_a, const RayTracerLens& t_b ) { return t_a.get_position() < t_b.get_position(); } );
+    m_lenses.insert( position, t_lens );
+}
+
+// Traces every alive photon of t_batch with energy t_energy to the photosensor
+void RayTracer::trace( RayTracerBatch& t_batch, double t_energy ) const {
+    for( size_t i = 0; i < t_batch.size(); i++ )
+        if( t_batch.m_status[ i ] == RayTracerBatch::m_alive && t_batch.m_dz[ i ] <= 0 )
+            t_batch.m_status[ i ] = RayTracerBatch::m_missed;
+
+    double rindex_medium           = m_medium.get_rindex          ( t_energy );
+    double groupIndex_medium       = m_medium.get_groupIndex      ( t_energy );
+    double absorptionLength_medium = m_medium.get_absorptionLength( t_energy );
+
+    // photons passing beside a circular lens skip it
+    vector< char > skip( t_batch.size() );
+    for( const RayTracerLens& lens : m_lenses ) {
+        double rindex_lens           = lens.m_material.get_rindex          ( t_energy );
+        double groupIndex_lens       = lens.m_material.get_groupIndex      ( t_energy );
+        double absorptionLength_lens = lens.m_material.get_absorptionLength( t_energy );
+
+        std::fill( skip.begin(), skip.end(), 0 );
+        move_to_surface( t_batch, lens, 0, groupIndex_medium, absorptionLength_medium, skip );
+        if( lens.m_circular )
+            for( size_t i = 0; i < t_batch.size(); i++ )
+                skip[ i ] = t_batch.m_x[ i ] * t_batch.m_x[ i ] + t_batch.m_y[ i ] * t_batch.m_y[ i ] > lens.m_yLimits * lens.m_yLimits;
+        refract        ( t_batch, lens, 0, rindex_medium, rindex_lens, skip );
+        move_to_surface( t_batch, lens, 1, groupIndex_lens, absorptionLength_lens, skip );
+        if( lens.m_circular )
+            for( size_t i = 0; i < t_batch.size(); i++ )
+                if( !skip[ i ] && t_batch.m_status[ i ] == RayTracerBatch::m_alive &&
+                    t_batch.m_x[ i ] * t_batch.m_x[ i ] + t_batch.m_y[ i ] * t_batch.m_y[ i ] > lens.m_yLimits * lens.m_yLimits )
+                    t_batch.m_status[ i ] = RayTracerBatch::m_lensSide;
+        refract        ( t_batch, lens, 1, rindex_lens, rindex_medium, skip );
+    }
+
+    move_to_plane( t_batch, m_photoSensor_z, groupIndex_medium, absorptionLength_medium );
+    for( size_t i = 0; i < t_batch.size(); i++ )
+        if( t_batch.m_status[ i ] == RayTracerBatch::m_alive )
+            t_batch.m_status[ i ] = RayTracerBatch::m_detected;
+}
+
+namespace {
+    // Distance along ( t_dx, t_dy, t_dz ) from ( t_x, t_y, t_z ) to surface t_surface of t_lens:
+    // the ellipsoid cap containing the vertex inside yLimits, the plane through its edge outside.
+    inline double get_distance_surface( const RayTracerLens& t_lens, int t_surface, 
+                                        double t_x , double t_y , double t_z , 
+                                        double t_dx, double t_dy, double t_dz ) {
+        double radius_x = t_lens.m_surface_radius_x[ t_surface ];
+        double radius_y = t_lens.m_surface_radius_y[ t_surface ];
+        double center   = t_lens.m_surface_vertex  [ t_surface ] - radius_x;
+        double q_z      = t_z - center;
+
+        double a = ( t_dx * t_dx + t_dy * t_dy ) / ( radius_y * radius_y ) + t_dz * t_dz / ( radius_x * radius_x );
+        double b = ( t_x * t_dx + t_y * t_dy ) / ( radius_y * radius_y ) + q_z * t_dz / ( radius_x * radius_x );
+        double c = ( t_x * t_x  + t_y * t_y  ) / ( radius_y * radius_y ) + q_z * q_z  / ( radius_x * radius_x ) - 1;
+        double discriminant = b * b - a * c;
+        if( discriminant >= 0 ) {
+            double root = sqrt( discriminant );
+            for( double distance : { ( -b - root ) / a, ( -b + root ) / a } ) {
+                double x = t_x + distance * t_dx;
+                double y = t_y + distance * t_dy;
+                double z = t_z + distance * t_dz;
+                if( distance >= 0 && ( z - center ) * radius_x > 0 && 
+                    x * x + y * y < t_lens.m_yLimits * t_lens.m_yLimits )
+                    return distance;
+            }
+        }
+
+        return ( t_lens.get_surface_z( t_surface, t_lens.m_yLimits ) - t_z ) / t_dz;
+    }
+}
+
+// Moves the photons to surface t_surface of t_lens through a material with group index
+// t_groupIndex and absorption length t_absorptionLength
+void RayTracer::move_to_surface( RayTracerBatch      & t_batch           , 
+                                 const RayTracerLens & t_lens            , 
+                                 int                   t_surface         , 
+                                 double                t_groupIndex      , 
+                                 double                t_absorptionLength, 
+                                 const vector< char >& t_skip             ) const {
+    for( size_t i = 0; i < t_batch.size(); i++ ) {
+        if( t_batch.m_status[ i ] != RayTracerBatch::m_alive || t_skip[ i ] )
+            continue;
+
+        double distance = get_distance_surface( t_lens, t_surface, 
+                                                t_batch.m_x [ i ], t_batch.m_y [ i ], t_batch.m_z [ i ],
+                                                t_batch.m_dx[ i ], t_batch.m_dy[ i ], t_batch.m_dz[ i ] );
+        if( distance < 0 ) {
+            t_batch.m_status[ i ] = RayTracerBatch::m_missed;
+            continue;
+        }
+
+        t_batch.m_x                [ i ] += distance * t_batch.m_dx[ i ];
+        t_batch.m_y                [ i ] += distance * t_batch.m_dy[ i ];
+        t_batch.m_z                [ i ] += distance * t_batch.m_dz[ i ];
+        t_batch.m_pathLength       [ i ] += distance;
+        t_batch.m_groupPathLength  [ i ] += distance * t_groupIndex;
+        if( distance > 0 )
+            t_batch.m_weight[ i ] *= exp( -distance / t_absorptionLength );
+        if( abs( t_batch.m_x[ i ] ) > m_halfWidth || abs( t_batch.m_y[ i ] ) > m_halfWidth )
+            t_batch.m_status[ i ] = RayTracerBatch::m_wall;
+    }
+}
+
+// Moves the photons to the plane z = t_z through a material with group index t_groupIndex and
+// absorption length t_absorptionLength
+void RayTracer::move_to_plane( RayTracerBatch& t_batch, double t_z, double t_groupIndex, double t_absorptionLength ) const {
+    for( size_t i = 0; i < t_batch.size(); i++ ) {
+        if( t_batch.m_status[ i ] != RayTracerBatch::m_alive )
+            continue;
+
+        double distance = ( t_z - t_batch.m_z[ i ] ) / t_batch.m_dz[ i ];
+        if( distance < 0 ) {
+            t_batch.m_status[ i ] = RayTracerBatch::m_missed;
+            continue;
+        }
+
+        t_batch.m_x                [ i ] += distance * t_batch.m_dx[ i ];
+        t_batch.m_y                [ i ] += distance * t_batch.m_dy[ i ];
+        t_batch.m_z                [ i ]  = t_z;
+        t_batch.m_pathLength       [ i ] += distance;
+        t_batch.m_groupPathLength  [ i ] += distance * t_groupIndex;
+        if( distance > 0 )
+            t_batch.m_weight[ i ] *= exp( -distance / t_absorptionLength );
+        if( abs( t_batch.m_x[ i ] ) > m_halfWidth || abs( t_batch.m_y[ i ] ) > m_halfWidth )
+            t_batch.m_status[ i ] = RayTracerBatch::m_wall;
+    }
+}
+
+// Refracts the photons at surface t_surface of t_lens from refractive index t_rindex_in to t_rindex_out
+void RayTracer::refract( RayTracerBatch      & t_batch     , 
+                         const RayTracerLens & t_lens      , 
+                         int                   t_surface   , 
+                         double                t_rindex_in , 
+                         double                t_rindex_out, 
+                         const vector< char >& t_skip       ) const {
+    double eta      = t_rindex_in / t_rindex_out;
+    double radius_x = t_lens.m_surface_radius_x[ t_surface ];
+    double radius_y = t_lens.m_surface_radius_y[ t_surface ];
+    double center   = t_lens.m_surface_vertex  [ t_surface ] - radius_x;
+
+    for( size_t i = 0; i < t_batch.size(); i++ ) {
+        if( t_batch.m_status[ i ] != RayTracerBatch::m_alive || t_skip[ i ] )
+            continue;
+
+        double x = t_batch.m_x[ i ], y = t_batch.m_y[ i ], z = t_batch.m_z[ i ];
+        double normal_x = 0, normal_y = 0, normal_z = 1;
+        if( x * x + y * y < t_lens.m_yLimits * t_lens.m_yLimits ) {
+            normal_x = x / ( radius_y * radius_y );
+            normal_y = y / ( radius_y * radius_y );
+            normal_z = ( z - center ) / ( radius_x * radius_x );
+            double norm = sqrt( normal_x * normal_x + normal_y * normal_y + normal_z * normal_z );
+            normal_x /= norm;
+            normal_y /= norm;
+            normal_z /= norm;
+        }
+
+        double cos_in = -( normal_x * t_batch.m_dx[ i ] + normal_y * t_batch.m_dy[ i ] + normal_z * t_batch.m_dz[ i ] );
+        if( cos_in < 0 ) {
+            normal_x = -normal_x;
+            normal_y = -normal_y;
+            normal_z = -normal_z;
+            cos_in   = -cos_in;
+        }
+
+        double k = 1 - eta * eta * ( 1 - cos_in * cos_in );
+        if( k < 0 ) {
+            t_batch.m_status[ i ] = RayTracerBatch::m_reflected;
+            continue;
+        }
+
+        double cos_out = sqrt( k );
+        double r_s = ( t_rindex_in  * cos_in - t_rindex_out * cos_out ) / ( t_rindex_in  * cos_in + t_rindex_out * cos_out );
+        double r_p = ( t_rindex_out * cos_in - t_rindex_in  * cos_out ) / ( t_rindex_out * cos_in + t_rindex_in  * cos_out );
+        t_batch.m_weight[ i ] *= 1 - ( r_s * r_s + r_p * r_p ) / 2;
+
+        double scale = eta * cos_in - cos_out;
+        t_batch.m_dx[ i ] = eta * t_batch.m_dx[ i ] + scale * normal_x;
+        t_batch.m_dy[ i ] = eta * t_batch.m_dy[ i ] + scale * normal_y;
+        t_batch.m_dz[ i ] = eta * t_batch.m_dz[ i ] + scale * normal_z;
+    }
+}
+
+const RayTracerMaterial& RayTracer::get_medium() const {
+    return m_medium;
+}
+
+const vector< RayTracerLens >& RayTracer::get_lenses() const {
+    return m_lenses;
+}
+
+double RayTracer::get_photoSensor_z() const {
+    return m_photoSensor_z;
+}
+
+double RayTracer::get_halfWidth() const {
+    return m_halfWidth;
+}
@@ -10,11 +10,21 @@
 //*/////////////////////////////////////////////////////////////////////////*//
 
 #include "RunAction.hh"
+#include "SteppingAction.hh"
+
+#include "G4RunManager.hh"
+
+#include<sys/resource.h>
 
 RunAction::RunAction( DetectorConstruction* t_detectorConstruction ) 
     : m_detectorConstruction( t_detectorConstruction ) {
     G4cout << "RunAction::RunAction()" << G4endl;
 
+    G4AccumulableManager::Instance()->RegisterAccumulable( m_nPhotons_late     );
+    G4AccumulableManager::Instance()->RegisterAccumulable( m_stack_peak        );
+    G4AccumulableManager::Instance()->RegisterAccumulable( m_stack_buffer_peak );
+    G4AccumulableManager::Instance()->RegisterAccumulable( m_stack_spill_peak  );
+
     if( m_detectorConstruction && !m_detectorConstruction->get_make_SDandField() ) 
         return;
 
@@ -27,11 +37,21 @@ RunAction::RunAction( DetectorConstruction* t_detectorConstruction )
     m_analysisManager->SetNtupleMerging( true );
     m_analysisManager->SetHistoDirectoryName( "photoSensor_hits" );
     
-    // Make DSPD histograms
-    if( m_outputMessenger->get_photoSensor_hits_position_binned_save() ) {
+    // Make DSPD histograms. Every bin takes about 100 bytes (entries and moments), so for large
+    // detectors these can outgrow everything else; above memoryMax they are not made at all.
+    G4int    histograms_amount = ( m_constructionMessenger->get_lensScan() ) ? 1 : m_constructionMessenger->get_directionSensitivePhotoDetector_amount_total();
+    G4int    histograms_nBins  = m_outputMessenger->get_photoSensor_hits_position_binned_nBinsPerSide() + 2; // with under- and overflow
+    G4double histograms_memory = 100. * histograms_amount * histograms_nBins * histograms_nBins / ( 1024 * 1024 ); // MB
+    if( m_outputMessenger->get_photoSensor_hits_position_binned_save() && 
+        histograms_memory > m_outputMessenger->get_photoSensor_hits_position_binned_memoryMax() )
+        G4Exception( "RunAction::RunAction", "InvalidSetup", JustWarning, 
+                     ( "The binned photosensor hits of " + to_string( histograms_amount ) + " DSPDs would take about " 
+                     + to_string( G4int( histograms_memory ) ) + " MB (/output/photoSensor/hits/position/binned/memoryMax), "
+                     + "they are not saved." ).c_str() );
+    else if( m_outputMessenger->get_photoSensor_hits_position_binned_save() ) {
         G4int index_histogram_1D{ 0 };
         // for( DirectionSensitivePhotoDetector* DSPD : m_detectorConstruction->get_directionSensitivePhotoDetectors() ) {
-        for( G4int i = 0; i < m_constructionMessenger->get_directionSensitivePhotoDetector_amount_total(); i++ ) {
+        for( G4int i = 0; i < histograms_amount; i++ ) {
             G4String t_photoSensorID = "photoSensor_" + to_string( i );
             G4double width = m_constructionMessenger->get_photoSensor_body_size_width();
             G4int nBins = m_outputMessenger->get_photoSensor_hits_position_binned_nBinsPerSide();
@@ -42,6 +62,15 @@ RunAction::RunAction( DetectorConstruction* t_detectorConstruction )
         }
     }
 
+    if( m_constructionMessenger->get_lensScan() )
+        m_pointSpreadFunction = new PointSpreadFunction();
+
+    if( m_outputMessenger->get_visibility_save() )
+        m_visibilityLibrary = new VisibilityLibrary();
+
+    if( m_outputMessenger->get_hitLibrary_save() )
+        m_hitLibrary = new HitLibrary();
+
     // Make tuples
     G4int index_tuple { 0 };
 
@@ -73,6 +102,8 @@ RunAction::RunAction( DetectorConstruction* t_detectorConstruction )
             m_outputManager->add_tuple_column_string( "photoSensor_hits_photoSensorID", index_tuple );
         if( m_outputMessenger->get_photoSensor_hits_energy_save() )
             m_outputManager->add_tuple_column_double( "photoSensor_hits_energy", index_tuple );
+        if( m_outputMessenger->get_photoSensor_hits_weight_save() )
+            m_outputManager->add_tuple_column_double( "photoSensor_hits_weight", index_tuple );
         m_outputManager->add_tuple_finalize();
     }
 
@@ -193,40 +224,193 @@ RunAction::RunAction( DetectorConstruction* t_detectorConstruction )
             m_outputManager->add_tuple_column_integer( "photon_stepNumber", index_tuple );
         m_outputManager->add_tuple_finalize();
     }
+
+    // Make photoSensor_expected tuple (see StackingAction::get_visibility_expected)
+    if( m_constructionMessenger->get_fastSimulation_visibility() == "expected" ) {
+        index_tuple = m_outputManager->add_tuple_initialize( "photoSensor_expected", "photoSensor_expected" );
+        m_outputManager->add_tuple_column_integer( "photoSensor_expected_photoSensorID", index_tuple );
+        m_outputManager->add_tuple_column_double ( "photoSensor_expected_nHits"        , index_tuple );
+        m_outputManager->add_tuple_finalize();
+    }
+
+    // Make metadata tuple, one row per run filled by the master
+    index_tuple = m_outputManager->add_tuple_initialize( "metadata", "metadata" );
+    m_outputManager->add_tuple_column_integer( "metadata_runID"   , index_tuple );
+    m_outputManager->add_tuple_column_double ( "metadata_prescale", index_tuple );
+    m_outputManager->add_tuple_finalize();
 }
 
 RunAction::~RunAction() {
     G4cout << "RunAction::~RunAction()" << G4endl;
     delete m_outputManager;
+    if( m_pointSpreadFunction ) delete m_pointSpreadFunction;
+    if( m_visibilityLibrary   ) delete m_visibilityLibrary  ;
+    if( m_hitLibrary          ) delete m_hitLibrary         ;
+    if( m_steppingAction && !m_steppingAction_registered ) delete m_steppingAction;
 }
 
 void RunAction::BeginOfRunAction( const G4Run* t_run ) {
     G4cout << "RunAction::BeginOfRunAction()" << G4endl;
+
+    // the step output and readout window can change between runs; without either, the stepping
+    // action is not registered, so that Geant4 does not call it for every step
+    if( m_steppingAction ) {
+        m_steppingAction->prepare_run();
+        if( m_steppingAction->get_active() != m_steppingAction_registered ) {
+            m_steppingAction_registered = m_steppingAction->get_active();
+            G4UserSteppingAction* steppingAction = m_steppingAction_registered ? m_steppingAction : nullptr;
+            G4RunManager::GetRunManager()->SetUserAction( steppingAction );
+        }
+    }
+
     m_analysisManager = G4AnalysisManager::Instance();
     m_analysisManager->Reset();
     m_analysisManager->OpenFile();
+
+    EventArena::get_instance()->release(); // events kept during the previous run are deleted by now
+
+    if( m_visibilityLibrary || m_hitLibrary )
+        check_library();
+
+    // the master's EndOfRunAction comes after every worker has merged its table
+    if( m_pointSpreadFunction ) {
+        m_pointSpreadFunction->reset();
+        if( G4Threading::IsMasterThread() )
+            PointSpreadFunction::get_instance()->reset();
+    }
+    if( m_visibilityLibrary ) {
+        m_visibilityLibrary->reset();
+        // the master of a multithreaded run has no sensitive detectors, nor events to fold
+        PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+        if( photoSensorSensitiveDetector )
+            m_visibilityLibrary->set_symmetries( photoSensorSensitiveDetector );
+        if( G4Threading::IsMasterThread() )
+            VisibilityLibrary::get_instance()->reset();
+    }
+    if( m_hitLibrary ) {
+        m_hitLibrary->reset();
+        if( G4Threading::IsMasterThread() )
+            HitLibrary::get_instance()->reset();
+    }
+
+    m_nSteps = 0;
+    G4AccumulableManager::Instance()->Reset();
+    m_timer.Start();
 }
 
 void RunAction::EndOfRunAction( const G4Run* run ) {
     G4cout << "RunAction::EndOfRunAction()" << G4endl;
+    m_timer.Stop();
     m_analysisManager = G4AnalysisManager::Instance();
 
     if( m_outputMessenger->get_photoSensor_hits_position_binned_save() ) {
         G4int ID = m_outputManager->get_histogram_2D_ID( "photoSensor_0" );
         if( ID != kInvalidId && m_analysisManager->GetH2Title( ID ) == "photoSensor_0" )
-            for( DirectionSensitivePhotoDetector* DSPD : m_detectorConstruction->get_directionSensitivePhotoDetectors() ) {
-                // G4cout << "Resetting histogram name : photoSensor_" << DSPD->get_photoSensor()->get_sensitiveDetector()->get_ID() 
-                //        << " --> " << DSPD->get_photoSensor()->get_sensitiveDetector()->get_name() << G4endl;
+            for( G4int DSPD_ID{ 0 }; DSPD_ID < m_detectorConstruction->get_nDSPDs(); DSPD_ID++ ) {
                 m_analysisManager->SetH2Title( m_outputManager->get_histogram_2D_ID( 
-                                            "photoSensor_" + to_string( DSPD->get_photoSensor()->get_sensitiveDetector()->get_ID() ) ),
-                                            DSPD->get_photoSensor()->get_sensitiveDetector()->get_name() );
+                                            "photoSensor_" + to_string( DSPD_ID ) ),
+                                            m_detectorConstruction->get_photoSensor()->get_sensitiveDetector()->get_name( DSPD_ID ) );
             }
     }
 
+    // hits of a prescaled run are to be divided by the prescale (see StackingAction)
+    if( G4Threading::IsMasterThread() ) {
+        m_outputManager->fill_tuple_column_integer( "metadata_runID"   , run->GetRunID()                                        );
+        m_outputManager->fill_tuple_column_double ( "metadata_prescale", m_constructionMessenger->get_fastSimulation_prescale() );
+        m_outputManager->fill_tuple_column        ( "metadata" );
+    }
+
     m_analysisManager->Write();
     m_analysisManager->CloseFile( false );
+
+    if( m_pointSpreadFunction ) {
+        PointSpreadFunction::get_instance()->merge( *m_pointSpreadFunction );
+        if( G4Threading::IsMasterThread() )
+            PointSpreadFunction::get_instance()->write( m_outputMessenger->get_lensScan_fileName() );
+    }
+    if( m_visibilityLibrary ) {
+        VisibilityLibrary::get_instance()->merge( *m_visibilityLibrary );
+        if( G4Threading::IsMasterThread() )
+            VisibilityLibrary::get_instance()->write( m_outputMessenger->get_visibility_fileName (), 
+                                                      m_outputMessenger->get_visibility_threshold() );
+    }
+    if( m_hitLibrary ) {
+        HitLibrary::get_instance()->merge( *m_hitLibrary );
+        if( G4Threading::IsMasterThread() )
+            HitLibrary::get_instance()->write( m_outputMessenger->get_hitLibrary_fileName() );
+    }
+
+    G4AccumulableManager::Instance()->Merge();
+
+    if( EventArena::get_instance()->get_nEvents() > 0 )
+        EventArena::get_instance()->print_statistics();
+
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage ); // ru_maxrss in kB on Linux
+
+    G4cout << "RunAction statistics:" << G4endl
+           << "  events--------------: " << run->GetNumberOfEvent()                       << G4endl
+           << "  time [s]------------: " << m_timer.GetRealElapsed()                      << G4endl;
+    if( run->GetNumberOfEvent() > 0 )
+        G4cout << "  time per event [s]--: " << m_timer.GetRealElapsed() / run->GetNumberOfEvent() << G4endl;
+    if( m_nSteps > 0 )
+        G4cout << "  steps---------------: " << m_nSteps                                      << G4endl
+               << "  time per step [us]--: " << m_timer.GetRealElapsed() / m_nSteps * 1e6     << G4endl;
+    if( m_constructionMessenger->get_fastSimulation_timeWindow() > 0 )
+        G4cout << "  late photons killed-: " << m_nPhotons_late.GetValue()                    << G4endl;
+    G4cout << "  peak stack depth----: " << m_stack_peak.GetValue()                        << G4endl;
+    if( m_constructionMessenger->get_fastSimulation_stackChunk() > 0 )
+        G4cout << "  peak photon buffer--: " << m_stack_buffer_peak.GetValue()                 << G4endl
+               << "  peak photon spill---: " << m_stack_spill_peak .GetValue()                 << G4endl;
+    G4cout << "  peak memory [MB]----: " << usage.ru_maxrss / 1024.                       << G4endl;
+}
+
+void RunAction::count_steps( G4int t_nSteps ) {
+    m_nSteps += t_nSteps;
+}
+
+void RunAction::count_photon_late() {
+    m_nPhotons_late += 1;
+}
+
+void RunAction::set_steppingAction( SteppingAction* t_steppingAction ) {
+    m_steppingAction = t_steppingAction;
+}
+
+void RunAction::record_stack_peak( G4long t_stack, G4long t_buffer, G4long t_spill ) {
+    m_stack_peak        = std::max( m_stack_peak       .GetValue(), t_stack  );
+    m_stack_buffer_peak = std::max( m_stack_buffer_peak.GetValue(), t_buffer );
+    m_stack_spill_peak  = std::max( m_stack_spill_peak .GetValue(), t_spill  );
 }
 
 OutputManager* RunAction::get_outputManager() {
     return m_outputManager;
+}
+
+PointSpreadFunction* RunAction::get_pointSpreadFunction() {
+    return m_pointSpreadFunction;
+}
+
+// The visibility and hit libraries count every hit once and the detection efficiency is drawn
+// again where they are used, so their photons have to reach the photosensor without the
+// efficiency, the yield prescale or the acceptance roulette (whose survivors are weighted).
+void RunAction::check_library() {
+    G4String command;
+    if( to_lower_copy( m_constructionMessenger->get_photoSensor_efficiency() ) != "none" )
+        command = "/geometry/photoSensor/efficiency none";
+    else if( m_constructionMessenger->get_fastSimulation_prescale() != 1 )
+        command = "/geometry/fastSimulation_prescale 1";
+    else if( m_constructionMessenger->get_fastSimulation_acceptance() > 0 )
+        command = "/geometry/fastSimulation_acceptance 0";
+    if( !command.empty() )
+        G4Exception( "RunAction::check_library", "InvalidSetup", FatalException, 
+                     ( "Building a visibility or hit library needs `" + command + "'." ).c_str() );
+}
+
+VisibilityLibrary* RunAction::get_visibilityLibrary() {
+    return m_visibilityLibrary;
+}
+
+HitLibrary* RunAction::get_hitLibrary() {
+    return m_hitLibrary;
 }
\ No newline at end of file
@@ -9,10 +9,304 @@
 //*//                                                                     //*//
 //*/////////////////////////////////////////////////////////////////////////*//
 
+
 #include "StackingAction.hh"
 
 #include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4StackManager.hh"
+#include "G4RunManager.hh"
+
+using std::max;
+using std::min;
+
+StackingAction::StackingAction( DetectorConstruction* t_detectorConstruction ) 
+    : m_detectorConstruction( t_detectorConstruction ) { 
+}
+
+StackingAction::~StackingAction() {
+    if( m_acceptance  ) delete m_acceptance;
+    if( m_stack_spill ) std::fclose( m_stack_spill );
+}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack( const G4Track* t_track ) {
+    // photons pushed back from the buffer were classified when they were born
+    if( m_stack_releasing )
+        return m_stack_release;
+    if( stackManager )
+        m_stack_peak = max( m_stack_peak, G4long( stackManager->GetNTotalTrack() ) + 1 );
+
+    if( m_hitLibrary && t_track->GetParentID() == 0 ) {
+        size_t                 symmetry{ 0 };
+        const HitLibraryEvent* event = m_hitLibrary->find( t_track->GetDefinition()->GetPDGEncoding(), t_track->GetKineticEnergy(), 
+                                                           t_track->GetPosition(), t_track->GetMomentumDirection(), 
+                                                           m_constructionMessenger->get_fastSimulation_overlay_energy  (), 
+                                                           m_constructionMessenger->get_fastSimulation_overlay_position(), 
+                                                           m_constructionMessenger->get_fastSimulation_overlay_angle   (), symmetry );
+        if( event ) {
+            PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+            const DSPDSymmetries        & symmetries                   = m_hitLibrary->get_symmetries();
+            const CubeSymmetry          & mapping                      = symmetries.get_symmetry( symmetry );
+            // the photons of the library hits are taken to start at the primary
+            for( const HitLibraryHit& hit : event->m_hits ) {
+                if( G4UniformRand() >= photoSensorSensitiveDetector->get_efficiency( hit.m_energy ) )
+                    continue;
+                photoSensorSensitiveDetector->add_hit( symmetries.get_DSPD( symmetry, hit.m_DSPD ), 
+                                                       mapping.apply( hit.m_position ), 
+                                                       t_track->GetGlobalTime() + hit.m_time, hit.m_energy, 
+                                                       hit.m_energy * mapping.apply( hit.m_direction ), 
+                                                       m_hitLibrary_process, t_track->GetWeight(), t_track->GetPosition() );
+            }
+            return fKill;
+        }
+    }
+
+    if( t_track->GetDefinition() != G4OpticalPhoton::Definition() )
+        return NESTStackingAction::ClassifyNewTrack( t_track );
+
+    // the peak detection efficiency, the rest is drawn by the photosensor sensitive detector,
+    // and the yield prescale of scintillation and Cerenkov photons (not rescaled here)
+    G4double survival = m_efficiency_prescale * ( ( t_track->GetParentID() > 0 ) ? m_prescale : 1. );
+    if( survival < 1 && G4UniformRand() >= survival )
+        return fKill;
+
+    // Russian roulette of the photons unlikely to reach a DSPD, the survivors carry the weight
+    if( m_acceptance_threshold > 0 && m_acceptance->get_probability( t_track->GetPosition(), t_track->GetMomentumDirection(), 
+                                                                     t_track->GetKineticEnergy() ) < m_acceptance_threshold ) {
+        if( G4UniformRand() >= m_acceptance_survival )
+            return fKill;
+        const_cast< G4Track* >( t_track )->SetWeight( t_track->GetWeight() / m_acceptance_survival );
+    }
+
+    if( !m_visibilityLibrary )
+        return classify_photon( t_track );
+
+    G4int voxel = m_visibilityLibrary->get_voxel( t_track->GetPosition() );
+    if( voxel < 0 )
+        return classify_photon( t_track );
+
+    if( !m_visibility_sampled ) {
+        m_visibility_nPhotons[ voxel ] += t_track->GetWeight() * ( m_efficiency_sensitiveDetector 
+                                        ? m_efficiency_sensitiveDetector->get_efficiency( t_track->GetKineticEnergy() ) / m_efficiency_prescale 
+                                        : 1. );
+        return fKill;
+    }
+
+    // drawn in the folded voxel, then mapped back
+    size_t                        symmetry{ 0 };
+    const VisibilityLibraryEntry* entry = m_visibilityLibrary->sample_entry( m_visibilityLibrary->fold( voxel, symmetry ), G4UniformRand() );
+    PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+    if( !entry || !photoSensorSensitiveDetector )
+        return fKill;
+
+    const DSPDSymmetries& symmetries = m_visibilityLibrary->get_symmetries();
+    G4int         DSPD      = symmetries.get_DSPD_inverse     ( symmetry, entry->m_DSPD );
+    G4ThreeVector direction = symmetries.map_direction_inverse( symmetry, entry->m_DSPD, 
+                                                                m_visibilityLibrary->sample_direction( *entry, G4UniformRand(), G4UniformRand(), G4UniformRand() ) );
+    G4ThreeVector position  = photoSensorSensitiveDetector->get_position( DSPD );
+    G4double      energy    = t_track->GetKineticEnergy();
+    G4double      time      = t_track->GetGlobalTime() 
+                            + ( position - t_track->GetPosition() ).mag() * m_visibility_medium.get_groupIndex( energy ) / c_light;
+    if( !photoSensorSensitiveDetector->draw_efficiency( energy ) )
+        return fKill;
+    photoSensorSensitiveDetector->add_hit( DSPD, position, time, energy, 
+                                           energy * ( *photoSensorSensitiveDetector->get_rotationMatrix( DSPD ) * direction ),
+                                           m_visibility_process, t_track->GetWeight(), t_track->GetPosition() );
+    return fKill;
+}
+
+void StackingAction::PrepareNewEvent() {
+    NESTStackingAction::PrepareNewEvent();
+
+    // the efficiency curve can change between runs (see PhotoSensorSensitiveDetector::update_efficiency)
+    m_efficiency_sensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+    m_efficiency_prescale          = 1.;
+    if( m_efficiency_sensitiveDetector ) {
+        m_efficiency_sensitiveDetector->update_efficiency();
+        m_efficiency_prescale = m_efficiency_sensitiveDetector->get_efficiency_prescale();
+    }
+
+    m_prescale = m_constructionMessenger->get_fastSimulation_prescale();
+    if( m_prescale <= 0 || m_prescale > 1 )
+        G4Exception( "StackingAction::PrepareNewEvent", "InvalidArgument", FatalException, 
+                     ( "`/geometry/fastSimulation_prescale " + to_string( m_prescale ) + "' is not in (0,1]." ).c_str() );
+
+    m_acceptance_threshold = m_constructionMessenger->get_fastSimulation_acceptance         ();
+    m_acceptance_survival  = m_constructionMessenger->get_fastSimulation_acceptance_survival();
+    if( m_acceptance_threshold > 0 ) {
+        if( m_acceptance_survival <= 0 || m_acceptance_survival > 1 )
+            G4Exception( "StackingAction::PrepareNewEvent", "InvalidArgument", FatalException, 
+                         ( "`/geometry/fastSimulation_acceptance_survival " + to_string( m_acceptance_survival ) + "' is not in (0,1]." ).c_str() );
+        // the apertures follow the lenses, which can change between runs (see DetectorConstruction::rebuild_lensSystem)
+        G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+        if( !m_acceptance || runID != m_acceptance_runID ) {
+            if( m_acceptance ) delete m_acceptance;
+            m_acceptance       = new GeometricAcceptance( m_detectorConstruction, 
+                                                          m_detectorConstruction->get_mediums().at(0)->get_size() / 2, 
+                                                          Materials::get_rayTracerMaterial( m_constructionMessenger->get_detector_medium_material() ) );
+            m_acceptance_runID = runID;
+            G4cout << "StackingAction::PrepareNewEvent: DSPD apertures cover " << m_acceptance->get_coverage() 
+                   << " of the faces of the medium" << G4endl;
+        }
+    }
+
+    m_hitLibrary = nullptr;
+    if( m_constructionMessenger->get_fastSimulation_overlay() ) {
+        PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+        if( !photoSensorSensitiveDetector )
+            G4Exception( "StackingAction::PrepareNewEvent", "InvalidSetup", FatalException, 
+                         "`/geometry/fastSimulation_overlay' needs the photosensor sensitive detector." );
+        m_hitLibrary = HitLibrary::get_library( m_constructionMessenger->get_fastSimulation_overlay_fileName(), photoSensorSensitiveDetector );
+    }
+
+    m_stack_chunk = m_constructionMessenger->get_fastSimulation_stackChunk();
+    if( m_stack_chunk < 0 )
+        G4Exception( "StackingAction::PrepareNewEvent", "InvalidArgument", FatalException, 
+                     ( "`/geometry/fastSimulation_stackChunk " + to_string( m_stack_chunk ) + "' is negative." ).c_str() );
+    m_stack_buffer_max = m_constructionMessenger->get_fastSimulation_stackBuffer();
+    if( m_stack_chunk > 0 && m_stack_buffer_max < m_stack_chunk )
+        G4Exception( "StackingAction::PrepareNewEvent", "InvalidArgument", FatalException, 
+                     ( "`/geometry/fastSimulation_stackBuffer " + to_string( m_stack_buffer_max ) + "' is below the stack chunk." ).c_str() );
+    m_stack_buffer.clear();
+    m_stack_spilled     = 0;
+    m_stack_waiting     = false;
+    m_stack_releasing   = false;
+    m_stack_peak        = 0;
+    m_stack_buffer_peak = 0;
+    m_stack_spill_peak  = 0;
+
+    m_visibility_nPhotons.clear();
+
+    G4String mode = m_constructionMessenger->get_fastSimulation_visibility();
+    if( mode == "none" ) {
+        m_visibilityLibrary = nullptr;
+        return;
+    }
+    if( mode != "expected" && mode != "sampled" )
+        G4Exception( "StackingAction::PrepareNewEvent", "InvalidArgument", FatalException, 
+                     ( "`/geometry/fastSimulation_visibility " + mode + "' is not none, expected or sampled." ).c_str() );
+
+    PhotoSensorSensitiveDetector* photoSensorSensitiveDetector = m_detectorConstruction->get_photoSensor()->get_sensitiveDetector();
+    if( !photoSensorSensitiveDetector )
+        G4Exception( "StackingAction::PrepareNewEvent", "InvalidSetup", FatalException, 
+                     "`/geometry/fastSimulation_visibility' needs the photosensor sensitive detector." );
+    m_visibilityLibrary  = VisibilityLibrary::get_library( m_constructionMessenger->get_fastSimulation_visibility_fileName(), photoSensorSensitiveDetector );
+    m_visibility_sampled = mode == "sampled";
+    m_visibility_medium  = Materials::get_rayTracerMaterial( m_constructionMessenger->get_detector_medium_material() );
+}
+
+// Called by G4StackManager when the urgent stack is empty, after the waiting stack was moved onto it
+void StackingAction::NewStage() {
+    NESTStackingAction::NewStage();
+
+    m_stack_waiting = false;
+    if( m_stack_buffer.size() < size_t( m_stack_chunk ) + 1 && m_stack_spilled > 0 )
+        read_spill();
+    if( m_stack_buffer.empty() )
+        return;
+
+    m_stack_releasing = true;
+    size_t nPhotons = min( size_t( m_stack_chunk ), m_stack_buffer.size() );
+    for( size_t i{ 0 }; i < nPhotons; i++ )
+        release_photon( fUrgent );
+    if( !m_stack_buffer.empty() ) {
+        release_photon( fWaiting );
+        m_stack_waiting = true;
+    }
+    m_stack_releasing = false;
+}
+
+G4long StackingAction::get_stack_peak() const {
+    return m_stack_peak;
+}
+
+G4long StackingAction::get_stack_buffer_peak() const {
+    return m_stack_buffer_peak;
+}
+
+G4long StackingAction::get_stack_spill_peak() const {
+    return m_stack_spill_peak;
+}
+
+// Optical photon to be tracked: with a chunk size, the first one waits (so that NewStage() is
+// called) and the others go to the buffer, or to the spill file once the buffer is full
+G4ClassificationOfNewTrack StackingAction::classify_photon( const G4Track* t_track ) {
+    if( m_stack_chunk == 0 )
+        return NESTStackingAction::ClassifyNewTrack( t_track );
+
+    if( !m_stack_waiting ) {
+        m_stack_waiting = true;
+        return fWaiting;
+    }
+
+    StackedPhoton photon{ t_track->GetPosition(), t_track->GetMomentumDirection(), t_track->GetPolarization(), 
+                          t_track->GetKineticEnergy(), t_track->GetGlobalTime(), t_track->GetWeight(), 
+                          t_track->GetTrackID(), t_track->GetParentID(), t_track->GetCreatorModelID(), 
+                          t_track->GetCreatorProcess() };
+    if( m_stack_buffer.size() < size_t( m_stack_buffer_max ) ) {
+        m_stack_buffer.push_back( photon );
+        m_stack_buffer_peak = max( m_stack_buffer_peak, G4long( m_stack_buffer.size() ) );
+    } else
+        write_spill( photon );
+    return fKill;
+}
+
+// Appends t_photon to the spill file, which is used as a stack: records past m_stack_spilled
+// are stale and overwritten, so the file never grows beyond the peak of spilled photons
+void StackingAction::write_spill( const StackedPhoton& t_photon ) {
+    if( !m_stack_spill ) {
+        m_stack_spill = std::tmpfile();
+        if( !m_stack_spill )
+            G4Exception( "StackingAction::write_spill", "FileError", FatalException, 
+                         "Cannot open a temporary file for the photons beyond `/geometry/fastSimulation_stackBuffer'." );
+    }
+    if( std::fseek ( m_stack_spill, m_stack_spilled * long( sizeof( StackedPhoton ) ), SEEK_SET ) != 0 ||
+        std::fwrite( &t_photon, sizeof( StackedPhoton ), 1, m_stack_spill ) != 1 )
+        G4Exception( "StackingAction::write_spill", "FileError", FatalException, "Cannot write to the photon spill file." );
+    m_stack_spilled++;
+    m_stack_spill_peak = max( m_stack_spill_peak, m_stack_spilled );
+}
+
+// Moves the last spilled photons back into the buffer, filling it up to half its size so that
+// the photons born while they are tracked still fit
+void StackingAction::read_spill() {
+    G4long nPhotons = min( m_stack_spilled, max( G4long( m_stack_buffer_max / 2 ) - G4long( m_stack_buffer.size() ), 
+                                                 G4long( m_stack_chunk ) + 1 ) );
+    size_t size     = m_stack_buffer.size();
+    m_stack_buffer.resize( size + nPhotons );
+    m_stack_spilled -= nPhotons;
+    if( std::fseek( m_stack_spill, m_stack_spilled * long( sizeof( StackedPhoton ) ), SEEK_SET ) != 0 ||
+        std::fread( m_stack_buffer.data() + size, sizeof( StackedPhoton ), nPhotons, m_stack_spill ) != size_t( nPhotons ) )
+        G4Exception( "StackingAction::read_spill", "FileError", FatalException, "Cannot read from the photon spill file." );
+    m_stack_buffer_peak = max( m_stack_buffer_peak, G4long( m_stack_buffer.size() ) );
+}
 
-StackingAction::StackingAction() { }
+// Moves the last photon of the buffer back onto the stack as a G4Track
+void StackingAction::release_photon( G4ClassificationOfNewTrack t_classification ) {
+    const StackedPhoton& photon = m_stack_buffer.back();
+    G4Track* track = new G4Track( new G4DynamicParticle( G4OpticalPhoton::Definition(), photon.m_direction, photon.m_energy ), 
+                                  photon.m_time, photon.m_position );
+    track->SetTrackID       ( photon.m_trackID        );
+    track->SetParentID      ( photon.m_parentID       );
+    track->SetWeight        ( photon.m_weight         );
+    track->SetPolarization  ( photon.m_polarization   );
+    track->SetCreatorProcess( photon.m_creatorProcess );
+    track->SetCreatorModelID( photon.m_creatorModelID );
+    m_stack_release = t_classification;
+    stackManager->PushOneTrack( track ); // classified by ClassifyNewTrack() as t_classification
+    m_stack_buffer.pop_back();
+}
 
-StackingAction::~StackingAction() { }
\ No newline at end of file
+// Expected number of hits per DSPD ID of the photons killed in this event
+map< G4int, G4double > StackingAction::get_visibility_expected() const {
+    map< G4int, G4double > expected;
+    for( const auto& [ voxel, nPhotons ] : m_visibility_nPhotons ) {
+        size_t                                  symmetry{ 0 };
+        G4int                                   folded  = m_visibilityLibrary->fold( voxel, symmetry );
+        const vector< VisibilityLibraryEntry >& entries = m_visibilityLibrary->get_entries( folded );
+        for( size_t index{ 0 }; index < entries.size(); index++ )
+            expected[ m_visibilityLibrary->get_symmetries().get_DSPD_inverse( symmetry, entries[ index ].m_DSPD ) ] 
+                += nPhotons * m_visibilityLibrary->get_probability( folded, index );
+    }
+    return expected;
+}
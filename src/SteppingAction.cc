@@ -12,27 +12,56 @@
 
 #include "SteppingAction.hh"
 
-SteppingAction::SteppingAction( RunAction* t_runAction ) :
+SteppingAction::SteppingAction( RunAction* t_runAction, DetectorConstruction* t_detectorConstruction ) :
     m_runAction( t_runAction ),
-    m_outputManager( m_runAction->get_outputManager() ) {
+    m_outputManager( m_runAction->get_outputManager() ),
+    m_detectorConstruction( t_detectorConstruction ) {
 }
 
 SteppingAction::~SteppingAction() {
+    if( m_acceptance ) delete m_acceptance;
 }
 
+// Called by RunAction::BeginOfRunAction, the output and readout window commands can change between runs
+void SteppingAction::prepare_run() {
+    m_photon_save  = m_outputMessenger      ->get_photon_save              ();
+    m_primary_save = m_outputMessenger      ->get_primary_save             ();
+    m_timeWindow   = m_constructionMessenger->get_fastSimulation_timeWindow();
+    m_active       = m_photon_save || m_primary_save || m_timeWindow > 0;
+
+    // made again at the first late photon check, the lenses can change between runs
+    if( m_acceptance ) delete m_acceptance;
+    m_acceptance = nullptr;
+}
+
+G4bool SteppingAction::get_active() const {
+    return m_active;
+}
+
+// Tracks leaving the detector are killed by the physics (see DetectorConstruction::make_regions)
+// and the steps are counted by TrackingAction, so this is only registered for runs with the step
+// output or the readout window (see RunAction::BeginOfRunAction).
 void SteppingAction::UserSteppingAction( const G4Step* t_step ) {
-    if( !t_step->GetPostStepPoint()->GetPhysicalVolume()                ||
-        abs( t_step->GetTrack()->GetPosition().x() ) > m_world_size.x() ||
-        abs( t_step->GetTrack()->GetPosition().y() ) > m_world_size.y() ||
-        abs( t_step->GetTrack()->GetPosition().z() ) > m_world_size.z() ||
-        t_step->GetTrack()->GetVolume()->GetName() == "world"           ||
-        t_step->GetTrack()->GetVolume()->GetName() == "detector_wall"      ) {
-        t_step->GetTrack()->SetTrackStatus( fKillTrackAndSecondaries );
+    if( !t_step->GetPostStepPoint()->GetPhysicalVolume() ) // out of the world
         return;
+
+    // Readout window: optical photons that cannot reach a DSPD front before its end, even
+    // straight at the speed of light in vacuum, are killed (see GeometricAcceptance::get_distance).
+    if( m_timeWindow > 0 && t_step->GetTrack()->GetDefinition () == G4OpticalPhoton::Definition() 
+                         && t_step->GetTrack()->GetTrackStatus() == fAlive                          ) {
+        if( !m_acceptance )
+            m_acceptance = new GeometricAcceptance( m_detectorConstruction, 
+                                                    m_detectorConstruction->get_mediums().at(0)->get_size() / 2, RayTracerMaterial() );
+        G4StepPoint* postStepPoint = t_step->GetPostStepPoint();
+        if( postStepPoint->GetGlobalTime() + m_acceptance->get_distance( postStepPoint->GetPosition() ) / c_light > m_timeWindow ) {
+            t_step->GetTrack()->SetTrackStatus( fStopAndKill );
+            m_runAction->count_photon_late();
+            return;
+        }
     }
 
-    if( abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 0  || 
-        abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 22    ) {
+    if( m_photon_save && ( abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 0  || 
+                           abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 22    ) ) {
         m_outputManager->fill_tuple_column_double ( "photon_length"     , t_step->GetStepLength()                                               );
         m_outputManager->fill_tuple_column_string ( "photon_process"    , t_step->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName() );
         m_outputManager->fill_tuple_column_double ( "photon_time"       , t_step->GetPostStepPoint()->GetGlobalTime()                           );
@@ -50,7 +79,7 @@ void SteppingAction::UserSteppingAction( const G4Step* t_step ) {
     // if( t_step->GetTrack()->GetParentID()                            == 0 || 
     //     abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 0 || 
     //     abs( t_step->GetTrack()->GetDefinition()->GetPDGEncoding() ) == 22   ) {
-    if( t_step->GetTrack()->GetParentID() == 0 ) {
+    if( m_primary_save && t_step->GetTrack()->GetParentID() == 0 ) {
         m_outputManager->fill_tuple_column_double ( "primary_position_x" , t_step->GetPostStepPoint()->GetPosition().x()                         );
         m_outputManager->fill_tuple_column_double ( "primary_position_y" , t_step->GetPostStepPoint()->GetPosition().y()                         );
         m_outputManager->fill_tuple_column_double ( "primary_position_z" , t_step->GetPostStepPoint()->GetPosition().z()                         );
@@ -0,0 +1,171 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "SurfaceLattice.hh"
+
+#include "Calorimeter.hh"
+#include "DirectionSensitivePhotoDetector.hh"
+
+using std::to_string;
+
+// t_index names the face (e.g. "+x"), t_rotationMatrix turns it from +z to its normal and
+// t_halfSize is the half size of the medium; t_amount_x and t_amount_y DSPDs lie on it.
+SurfaceLattice::SurfaceLattice( const G4String  & t_index                         , 
+                                G4RotationMatrix* t_rotationMatrix                , 
+                                G4RotationMatrix* t_rotationMatrix_calorimeterFull, 
+                                G4RotationMatrix* t_rotationMatrix_DSPD           , 
+                                G4ThreeVector     t_halfSize                      , 
+                                G4int             t_amount_x                      , 
+                                G4int             t_amount_y                       ) {
+    m_index                          = t_index;
+    m_rotationMatrix                 = t_rotationMatrix;
+    m_rotationMatrix_calorimeterFull = t_rotationMatrix_calorimeterFull;
+    m_rotationMatrix_DSPD            = t_rotationMatrix_DSPD;
+    m_calorimeter_width              = Calorimeter::get_width () / 2;
+    m_calorimeter_height             = Calorimeter::get_height() / 2;
+    m_amount_x                       = t_amount_x;
+    m_amount_y                       = t_amount_y;
+
+    G4double detector_medium_x  = t_halfSize.x();
+    G4double detector_medium_y  = t_halfSize.y();
+    G4double detector_medium_z  = t_halfSize.z();
+    G4double calorimeter_width  = m_calorimeter_width;
+    G4double calorimeter_height = m_calorimeter_height;
+    G4double calorimeter_depth  = Calorimeter::get_depth() / 2;
+    m_translations_initial[ horizontal ] = G4ThreeVector( detector_medium_x - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_y - calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_z - calorimeter_depth );
+    m_translations_initial[ vertical   ] = G4ThreeVector( detector_medium_x - calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_y - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_z - calorimeter_depth );
+    m_translations_initial[ middle     ] = G4ThreeVector( detector_medium_x - calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_y - calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_z - calorimeter_depth );
+    m_translations_initial[ DSPD       ] = G4ThreeVector( detector_medium_x - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_y - calorimeter_width - 2*calorimeter_height - 2*calorimeter_depth,
+                                                          detector_medium_z );
+}
+
+G4String SurfaceLattice::get_prefix( Component t_component ) {
+    switch( t_component ) {
+        case horizontal: return "/calorimeter_horizontal";
+        case vertical  : return "/calorimeter_vertical"  ;
+        case middle    : return "/calorimeter_middle"    ;
+        default        : return "/DSPD"                  ;
+    }
+}
+
+// IDs of the first DSPD and of the first calorimeter of the face
+void SurfaceLattice::set_IDs( G4int t_DSPD_ID_begin, G4int t_calorimeter_ID_begin ) {
+    m_DSPD_ID_begin        = t_DSPD_ID_begin;
+    m_calorimeter_ID_begin = t_calorimeter_ID_begin;
+}
+
+G4int SurfaceLattice::get_amount_x( Component t_component ) const {
+    return ( t_component == vertical || t_component == middle ) ? m_amount_x + 1 : m_amount_x;
+}
+
+G4int SurfaceLattice::get_amount_y( Component t_component ) const {
+    return ( t_component == horizontal || t_component == middle ) ? m_amount_y + 1 : m_amount_y;
+}
+
+G4int SurfaceLattice::get_amount( Component t_component ) const {
+    return get_amount_x( t_component ) * get_amount_y( t_component );
+}
+
+// In the medium frame. For a DSPD this is the back of its photosensor.
+G4ThreeVector SurfaceLattice::get_position( Component t_component, G4int t_x, G4int t_y ) const {
+    G4ThreeVector translation( -2*(m_calorimeter_width + m_calorimeter_height) * t_x, 0, 0 );
+    translation.setY( -2*(m_calorimeter_width + m_calorimeter_height) * t_y );
+    G4ThreeVector position = translation + m_translations_initial[ t_component ];
+    return *m_rotationMatrix * position;
+}
+
+G4ThreeVector SurfaceLattice::get_position( const Element& t_element ) const {
+    return get_position( t_element.m_component, t_element.m_x, t_element.m_y );
+}
+
+G4RotationMatrix* SurfaceLattice::get_rotationMatrix( Component t_component ) const {
+    switch( t_component ) {
+        case vertical: return m_rotationMatrix_calorimeterFull;
+        case DSPD    : return m_rotationMatrix_DSPD           ;
+        default      : return m_rotationMatrix                ;
+    }
+}
+
+// Face, position (the front for a DSPD) and count of the component on the face
+G4String SurfaceLattice::get_index( Component t_component, G4int t_x, G4int t_y ) const {
+    G4ThreeVector position = get_position( t_component, t_x, t_y );
+    if( t_component == DSPD )
+        position = DirectionSensitivePhotoDetector::get_position_front( m_rotationMatrix, position, "back" );
+
+    return m_index                 + "_"
+         + to_string( position.x() ) + "_"
+         + to_string( position.y() ) + "_"
+         + to_string( position.z() ) + "_"
+         + to_string( t_x * get_amount_y( t_component ) + t_y );
+}
+
+G4String SurfaceLattice::get_name( const Element& t_element ) const {
+    return get_prefix( t_element.m_component ) + "_" + get_index( t_element.m_component, t_element.m_x, t_element.m_y );
+}
+
+G4int SurfaceLattice::get_DSPD_ID_begin() const {
+    return m_DSPD_ID_begin;
+}
+
+G4int SurfaceLattice::get_calorimeter_ID_begin() const {
+    return m_calorimeter_ID_begin;
+}
+
+G4int SurfaceLattice::get_calorimeter_amount() const {
+    return get_amount( horizontal ) + get_amount( vertical ) + get_amount( middle );
+}
+
+SurfaceLattice::Element SurfaceLattice::get_DSPD( G4int t_ID ) const {
+    G4int index = t_ID - m_DSPD_ID_begin;
+    return { DSPD, index / m_amount_y, index % m_amount_y };
+}
+
+// Calorimeter with ID t_ID on a parameterised face
+SurfaceLattice::Element SurfaceLattice::get_calorimeter( G4int t_ID ) const {
+    G4int index = t_ID - m_calorimeter_ID_begin;
+    G4int cells = 3 * m_amount_x * m_amount_y;
+    if( index < cells )
+        return { Component( index % 3 ), index / 3 / m_amount_y, index / 3 % m_amount_y };
+
+    index -= cells; // row along the edge with y = amount_y
+    if( index < 2 * m_amount_x + 1 )
+        return { ( index % 2 == 0 ) ? middle : horizontal, index / 2, m_amount_y };
+
+    index -= 2 * m_amount_x + 1; // column along the edge with x = amount_x
+    return { ( index % 2 == 0 ) ? middle : vertical, m_amount_x, index / 2 };
+}
+
+const SurfaceLattice* SurfaceLattice::find_DSPD( const vector< const SurfaceLattice* >& t_surfaceLattices, G4int t_ID ) {
+    for( const SurfaceLattice* surfaceLattice : t_surfaceLattices )
+        if( t_ID >= surfaceLattice->m_DSPD_ID_begin && t_ID < surfaceLattice->m_DSPD_ID_begin + surfaceLattice->get_amount( DSPD ) )
+            return surfaceLattice;
+
+    G4Exception( "SurfaceLattice::find_DSPD", "InvalidArgument", FatalException, 
+                 ( "No surface holds DSPD " + to_string( t_ID ) + "." ).c_str() );
+    return nullptr;
+}
+
+const SurfaceLattice* SurfaceLattice::find_calorimeter( const vector< const SurfaceLattice* >& t_surfaceLattices, G4int t_ID ) {
+    for( const SurfaceLattice* surfaceLattice : t_surfaceLattices )
+        if( t_ID >= surfaceLattice->m_calorimeter_ID_begin && t_ID < surfaceLattice->m_calorimeter_ID_begin + surfaceLattice->get_calorimeter_amount() )
+            return surfaceLattice;
+
+    G4Exception( "SurfaceLattice::find_calorimeter", "InvalidArgument", FatalException, 
+                 ( "No surface holds calorimeter " + to_string( t_ID ) + "." ).c_str() );
+    return nullptr;
+}
@@ -0,0 +1,24 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "TrackingAction.hh"
+
+TrackingAction::TrackingAction( RunAction* t_runAction ) 
+    : m_runAction( t_runAction ) {
+}
+
+TrackingAction::~TrackingAction() {
+}
+
+void TrackingAction::PostUserTrackingAction( const G4Track* t_track ) {
+    m_runAction->count_steps( t_track->GetCurrentStepNumber() );
+}
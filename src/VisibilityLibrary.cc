@@ -0,0 +1,334 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+
+#include "VisibilityLibrary.hh"
+#include "OutputMessenger.hh"
+
+#include "G4AutoLock.hh"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace { 
+    G4Mutex visibilityLibraryMutex = G4MUTEX_INITIALIZER; 
+
+    // libraries read for the fast mode, kept until the end so the threads can share them
+    std::map< G4String, std::unique_ptr< VisibilityLibrary > > visibilityLibraries;
+}
+
+VisibilityLibrary* VisibilityLibrary::m_instance{ nullptr };
+
+VisibilityLibrary::VisibilityLibrary() {
+    reset();
+}
+
+VisibilityLibrary* VisibilityLibrary::get_instance() {
+    G4AutoLock lock( &visibilityLibraryMutex );
+    if( !m_instance ) 
+        m_instance = new VisibilityLibrary();
+    return m_instance;
+}
+
+void VisibilityLibrary::delete_instance() {
+    if( m_instance ) {
+        delete m_instance;
+        m_instance = nullptr;
+    }
+}
+
+// The library in t_fileName, read by the first thread asking for it. A folded library has to
+// be folded by symmetries of the DSPDs of t_photoSensorSensitiveDetector.
+const VisibilityLibrary* VisibilityLibrary::get_library( const G4String& t_fileName, PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector ) {
+    G4AutoLock lock( &visibilityLibraryMutex );
+    std::unique_ptr< VisibilityLibrary >& library = visibilityLibraries[ t_fileName ];
+    if( !library ) {
+        library = std::make_unique< VisibilityLibrary >();
+        library->read          ( t_fileName                     );
+        library->set_symmetries( t_photoSensorSensitiveDetector );
+        if( library->m_symmetries.get_nSymmetries() != library->m_symmetries_candidates.size() )
+            G4Exception( "VisibilityLibrary::get_library", "InvalidSetup", FatalException, 
+                         ( "`" + t_fileName + "' is folded by symmetries that the DSPDs do not have." ).c_str() );
+    }
+    return library.get();
+}
+
+// Clears the library and takes its dimensions from the current `/output/visibility/' parameters
+void VisibilityLibrary::reset() {
+    OutputMessenger* outputMessenger = OutputMessenger::get_instance();
+
+    m_nVoxelsPerSide = std::max( 1, outputMessenger->get_visibility_nVoxelsPerSide         () );
+    m_size           =              outputMessenger->get_visibility_size                   ();
+    m_nBins          = std::max( 1, outputMessenger->get_visibility_direction_nBinsPerSide() );
+
+    // the identity, and if folded the symmetries of the cube that also map the voxels onto voxels
+    m_symmetries_candidates.clear();
+    for( const CubeSymmetry& symmetry : CubeSymmetry::get_all() ) {
+        if( !m_symmetries_candidates.empty() && !outputMessenger->get_visibility_fold() )
+            break;
+        G4bool valid{ true };
+        for( G4int axis{ 0 }; axis < 3; axis++ )
+            valid = valid && m_size[ symmetry.m_axes[ axis ] ] == m_size[ axis ];
+        if( valid )
+            m_symmetries_candidates.push_back( symmetry );
+    }
+    m_symmetries = DSPDSymmetries();
+
+    m_nPhotons  .assign( get_nVoxels(), 0  );
+    m_entries   .assign( get_nVoxels(), {} );
+    m_index     .assign( get_nVoxels(), {} );
+    m_cumulative.clear();
+}
+
+void VisibilityLibrary::add_photons( G4int t_voxel, G4long t_nPhotons ) {
+    m_nPhotons[ t_voxel ] += t_nPhotons;
+}
+
+// Adds a photon of voxel t_voxel that reached DSPD t_DSPD with direction t_direction relative to it
+void VisibilityLibrary::fill( G4int t_voxel, G4int t_DSPD, const G4ThreeVector& t_direction ) {
+    auto [ index, inserted ] = m_index[ t_voxel ].try_emplace( t_DSPD, m_entries[ t_voxel ].size() );
+    if( inserted )
+        m_entries[ t_voxel ].push_back( { t_DSPD, 0, vector< uint32_t >( m_nBins * m_nBins, 0 ) } );
+
+    G4int bin_x = std::clamp( G4int( std::floor( ( t_direction.x() + 1 ) / 2 * m_nBins ) ), 0, m_nBins - 1 );
+    G4int bin_y = std::clamp( G4int( std::floor( ( t_direction.y() + 1 ) / 2 * m_nBins ) ), 0, m_nBins - 1 );
+    VisibilityLibraryEntry& entry = m_entries[ t_voxel ][ index->second ];
+    entry.m_nHits++;
+    entry.m_directions[ bin_x * m_nBins + bin_y ]++;
+}
+
+void VisibilityLibrary::merge( const VisibilityLibrary& t_visibilityLibrary ) {
+    G4AutoLock lock( &visibilityLibraryMutex );
+    if( t_visibilityLibrary.m_nPhotons.size() != m_nPhotons.size() || t_visibilityLibrary.m_nBins != m_nBins )
+        G4Exception( "VisibilityLibrary::merge", "InvalidSetup", FatalException, 
+                     "The visibility library parameters changed during the run." );
+    // the master has no DSPDs to find the symmetries with, it takes those of the threads
+    if( m_symmetries.get_nSymmetries() == 0 )
+        m_symmetries = t_visibilityLibrary.m_symmetries;
+    for( G4int voxel{ 0 }; voxel < get_nVoxels(); voxel++ ) {
+        m_nPhotons[ voxel ] += t_visibilityLibrary.m_nPhotons[ voxel ];
+        for( const VisibilityLibraryEntry& entry : t_visibilityLibrary.m_entries[ voxel ] ) {
+            auto [ index, inserted ] = m_index[ voxel ].try_emplace( entry.m_DSPD, m_entries[ voxel ].size() );
+            if( inserted ) {
+                m_entries[ voxel ].push_back( entry );
+                continue;
+            }
+            VisibilityLibraryEntry& merged = m_entries[ voxel ][ index->second ];
+            merged.m_nHits += entry.m_nHits;
+            for( size_t bin{ 0 }; bin < merged.m_directions.size(); bin++ )
+                merged.m_directions[ bin ] += entry.m_directions[ bin ];
+        }
+    }
+}
+
+// Writes the DSPDs reached with at least probability t_threshold from each voxel
+void VisibilityLibrary::write( const G4String& t_fileName, G4double t_threshold ) const {
+    ofstream file( t_fileName, std::ios::binary );
+    if( !file )
+        G4Exception( "VisibilityLibrary::write", "InvalidSetup", FatalException, 
+                     ( "Cannot open `" + t_fileName + "'." ).c_str() );
+
+    int32_t nVoxelsPerSide = m_nVoxelsPerSide, nBins = m_nBins, version = m_version;
+    G4double size_x = m_size.x(), size_y = m_size.y(), size_z = m_size.z();
+    file.write( m_magic                                           , sizeof( m_magic        ) );
+    file.write( reinterpret_cast< const char* >( &version        ), sizeof( version        ) );
+    file.write( reinterpret_cast< const char* >( &nVoxelsPerSide ), sizeof( nVoxelsPerSide ) );
+    file.write( reinterpret_cast< const char* >( &size_x         ), sizeof( size_x         ) );
+    file.write( reinterpret_cast< const char* >( &size_y         ), sizeof( size_y         ) );
+    file.write( reinterpret_cast< const char* >( &size_z         ), sizeof( size_z         ) );
+    file.write( reinterpret_cast< const char* >( &nBins          ), sizeof( nBins          ) );
+
+    int32_t nSymmetries = m_symmetries.get_nSymmetries();
+    file.write( reinterpret_cast< const char* >( &nSymmetries ), sizeof( nSymmetries ) );
+    for( int32_t i{ 0 }; i < nSymmetries; i++ ) {
+        const CubeSymmetry& symmetry = m_symmetries.get_symmetry( i );
+        int32_t values[ 6 ]{ symmetry.m_axes [ 0 ], symmetry.m_axes [ 1 ], symmetry.m_axes [ 2 ], 
+                             symmetry.m_signs[ 0 ], symmetry.m_signs[ 1 ], symmetry.m_signs[ 2 ] };
+        file.write( reinterpret_cast< const char* >( values ), sizeof( values ) );
+    }
+
+    size_t nEntries_total{ 0 };
+    for( G4int voxel{ 0 }; voxel < get_nVoxels(); voxel++ ) {
+        vector< const VisibilityLibraryEntry* > entries;
+        for( const VisibilityLibraryEntry& entry : m_entries[ voxel ] )
+            if( entry.m_nHits >= t_threshold * m_nPhotons[ voxel ] )
+                entries.push_back( &entry );
+        std::sort( entries.begin(), entries.end(), 
+                   []( const VisibilityLibraryEntry* t_a, const VisibilityLibraryEntry* t_b ) { return t_a->m_DSPD < t_b->m_DSPD; } );
+
+        uint32_t nEntries = entries.size();
+        file.write( reinterpret_cast< const char* >( &m_nPhotons[ voxel ] ), sizeof( uint64_t ) );
+        file.write( reinterpret_cast< const char* >( &nEntries            ), sizeof( nEntries ) );
+        for( const VisibilityLibraryEntry* entry : entries ) {
+            int32_t DSPD = entry->m_DSPD;
+            file.write( reinterpret_cast< const char* >( &DSPD                     ), sizeof( DSPD     )                   );
+            file.write( reinterpret_cast< const char* >( entry->m_directions.data() ), sizeof( uint32_t ) * m_nBins * m_nBins );
+        }
+        nEntries_total += nEntries;
+    }
+
+    G4cout << "VisibilityLibrary::write: " << get_nVoxels() << " voxels with " << nEntries_total 
+           << " DSPD entries written to " << t_fileName << G4endl;
+}
+
+void VisibilityLibrary::read( const G4String& t_fileName ) {
+    ifstream file( t_fileName, std::ios::binary );
+    char    magic[ 8 ];
+    int32_t version{ 0 }, nVoxelsPerSide{ 0 }, nBins{ 0 };
+    file.read( magic                                , sizeof( magic   ) );
+    file.read( reinterpret_cast< char* >( &version ), sizeof( version ) );
+    if( !file || std::memcmp( magic, m_magic, sizeof( magic ) ) != 0 || version != m_version )
+        G4Exception( "VisibilityLibrary::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is not a visibility library of this version." ).c_str() );
+
+    G4double size_x{ 0 }, size_y{ 0 }, size_z{ 0 };
+    file.read( reinterpret_cast< char* >( &nVoxelsPerSide ), sizeof( nVoxelsPerSide ) );
+    file.read( reinterpret_cast< char* >( &size_x         ), sizeof( size_x         ) );
+    file.read( reinterpret_cast< char* >( &size_y         ), sizeof( size_y         ) );
+    file.read( reinterpret_cast< char* >( &size_z         ), sizeof( size_z         ) );
+    file.read( reinterpret_cast< char* >( &nBins          ), sizeof( nBins          ) );
+    m_nVoxelsPerSide = nVoxelsPerSide;
+    m_size           = G4ThreeVector( size_x, size_y, size_z );
+    m_nBins          = nBins;
+
+    int32_t nSymmetries{ 0 };
+    file.read( reinterpret_cast< char* >( &nSymmetries ), sizeof( nSymmetries ) );
+    m_symmetries_candidates.clear();
+    for( int32_t i{ 0 }; i < nSymmetries && file; i++ ) {
+        int32_t values[ 6 ]{};
+        file.read( reinterpret_cast< char* >( values ), sizeof( values ) );
+        m_symmetries_candidates.push_back( { { values[ 0 ], values[ 1 ], values[ 2 ] }, { values[ 3 ], values[ 4 ], values[ 5 ] } } );
+    }
+    m_symmetries = DSPDSymmetries();
+
+    m_nPhotons  .assign( get_nVoxels(), 0  );
+    m_entries   .assign( get_nVoxels(), {} );
+    m_index     .assign( get_nVoxels(), {} );
+    m_cumulative.assign( get_nVoxels(), {} );
+    for( G4int voxel{ 0 }; voxel < get_nVoxels() && file; voxel++ ) {
+        uint32_t nEntries{ 0 };
+        file.read( reinterpret_cast< char* >( &m_nPhotons[ voxel ] ), sizeof( uint64_t ) );
+        file.read( reinterpret_cast< char* >( &nEntries            ), sizeof( nEntries ) );
+        for( uint32_t i{ 0 }; i < nEntries && file; i++ ) {
+            int32_t                DSPD{ 0 };
+            VisibilityLibraryEntry entry{ 0, 0, vector< uint32_t >( m_nBins * m_nBins ) };
+            file.read( reinterpret_cast< char* >( &DSPD                    ), sizeof( DSPD     )                   );
+            file.read( reinterpret_cast< char* >( entry.m_directions.data() ), sizeof( uint32_t ) * m_nBins * m_nBins );
+            entry.m_DSPD  = DSPD;
+            for( uint32_t hits : entry.m_directions )
+                entry.m_nHits += hits;
+            m_entries[ voxel ].push_back( std::move( entry ) );
+        }
+
+        G4double cumulative{ 0 };
+        for( size_t index{ 0 }; index < m_entries[ voxel ].size(); index++ ) {
+            cumulative += get_probability( voxel, index );
+            m_cumulative[ voxel ].push_back( cumulative );
+        }
+    }
+    if( !file )
+        G4Exception( "VisibilityLibrary::read", "InvalidSetup", FatalException, 
+                     ( "`" + t_fileName + "' is truncated." ).c_str() );
+}
+
+// Keeps the candidate symmetries (see reset() and read()) that map the DSPDs onto DSPDs
+void VisibilityLibrary::set_symmetries( PhotoSensorSensitiveDetector* t_photoSensorSensitiveDetector ) {
+    m_symmetries.set( t_photoSensorSensitiveDetector, m_symmetries_candidates );
+}
+
+const DSPDSymmetries& VisibilityLibrary::get_symmetries() const {
+    return m_symmetries;
+}
+
+// The voxel in x <= y <= z that t_voxel is mapped onto by symmetry t_symmetry (of
+// get_symmetries()), t_voxel itself unless folded. The symmetries have to be set.
+G4int VisibilityLibrary::fold( G4int t_voxel, size_t& t_symmetry ) const {
+    // twice the voxel centre, in voxels
+    G4ThreeVector centre( 2 * (   t_voxel / ( m_nVoxelsPerSide * m_nVoxelsPerSide )                    ) - ( m_nVoxelsPerSide - 1 ), 
+                          2 * ( ( t_voxel / m_nVoxelsPerSide                        ) % m_nVoxelsPerSide ) - ( m_nVoxelsPerSide - 1 ), 
+                          2 * (   t_voxel                                             % m_nVoxelsPerSide ) - ( m_nVoxelsPerSide - 1 ) );
+    t_symmetry = m_symmetries.fold( centre );
+    centre     = m_symmetries.get_symmetry( t_symmetry ).apply( centre );
+
+    G4int voxel{ 0 };
+    for( G4int axis{ 0 }; axis < 3; axis++ )
+        voxel = voxel * m_nVoxelsPerSide + G4int( std::lround( ( centre[ axis ] + m_nVoxelsPerSide - 1 ) / 2 ) );
+    return voxel;
+}
+
+G4int VisibilityLibrary::get_voxel( const G4ThreeVector& t_position ) const {
+    G4int voxel{ 0 };
+    for( G4int axis{ 0 }; axis < 3; axis++ ) {
+        G4int n = G4int( std::floor( ( t_position[ axis ] / m_size[ axis ] + 0.5 ) * m_nVoxelsPerSide ) );
+        if( n < 0 || n >= m_nVoxelsPerSide )
+            return -1;
+        voxel = voxel * m_nVoxelsPerSide + n;
+    }
+    return voxel;
+}
+
+G4int VisibilityLibrary::get_nVoxels() const {
+    return m_nVoxelsPerSide * m_nVoxelsPerSide * m_nVoxelsPerSide;
+}
+
+G4int VisibilityLibrary::get_nBins() const {
+    return m_nBins;
+}
+
+G4long VisibilityLibrary::get_nPhotons( G4int t_voxel ) const {
+    return m_nPhotons.at( t_voxel );
+}
+
+const vector< VisibilityLibraryEntry >& VisibilityLibrary::get_entries( G4int t_voxel ) const {
+    return m_entries.at( t_voxel );
+}
+
+// Probability of a photon of voxel t_voxel to reach the DSPD of entry t_index
+G4double VisibilityLibrary::get_probability( G4int t_voxel, size_t t_index ) const {
+    if( m_nPhotons.at( t_voxel ) == 0 )
+        return 0;
+    return G4double( m_entries[ t_voxel ].at( t_index ).m_nHits ) / m_nPhotons[ t_voxel ];
+}
+
+// The DSPD reached by a photon of voxel t_voxel for t_uniform in [0, 1), after read()
+const VisibilityLibraryEntry* VisibilityLibrary::sample_entry( G4int t_voxel, G4double t_uniform ) const {
+    const vector< G4double >& cumulative = m_cumulative.at( t_voxel );
+    size_t index = std::upper_bound( cumulative.begin(), cumulative.end(), t_uniform ) - cumulative.begin();
+    if( index == cumulative.size() )
+        return nullptr;
+    return &m_entries[ t_voxel ][ index ];
+}
+
+// A direction relative to the DSPD of t_entry, uniform within a bin drawn by its number of hits
+G4ThreeVector VisibilityLibrary::sample_direction( const VisibilityLibraryEntry& t_entry    , 
+                                                   G4double                      t_uniform_1, 
+                                                   G4double                      t_uniform_2, 
+                                                   G4double                      t_uniform_3 ) const {
+    uint64_t hit = uint64_t( t_uniform_1 * t_entry.m_nHits );
+    G4int    bin{ 0 };
+    for( uint64_t cumulative{ 0 }; bin < m_nBins * m_nBins - 1; bin++ ) {
+        cumulative += t_entry.m_directions[ bin ];
+        if( hit < cumulative )
+            break;
+    }
+
+    G4double dx = 2. * ( bin / m_nBins + t_uniform_2 ) / m_nBins - 1;
+    G4double dy = 2. * ( bin % m_nBins + t_uniform_3 ) / m_nBins - 1;
+    G4double norm = std::sqrt( dx * dx + dy * dy );
+    if( norm > 1 ) {
+        dx /= norm;
+        dy /= norm;
+    }
+    return G4ThreeVector( dx, dy, std::sqrt( std::max( 0., 1 - dx * dx - dy * dy ) ) );
+}
@@ -0,0 +1,135 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+#include "Wall.hh"
+
+// t_rotationMatrix maps the wall's local +z onto the outward normal of the face (same
+// convention as the DSPD rotations); t_halfSize is the half size of the medium.
+Wall::Wall( const G4String   & t_name          , 
+            G4RotationMatrix * t_rotationMatrix, 
+            G4ThreeVector      t_halfSize      , 
+            G4double           t_thickness      ) {
+    m_name           = t_name;
+    m_rotationMatrix = t_rotationMatrix;
+    m_thickness      = t_thickness;
+
+    G4RotationMatrix rotationMatrix_inverse = m_rotationMatrix->inverse();
+    G4ThreeVector    axis_x = rotationMatrix_inverse * G4ThreeVector( 1, 0, 0 );
+    G4ThreeVector    axis_y = rotationMatrix_inverse * G4ThreeVector( 0, 1, 0 );
+    G4ThreeVector    axis_z = rotationMatrix_inverse * G4ThreeVector( 0, 0, 1 );
+    G4ThreeVector    size( std::abs( axis_x.dot( t_halfSize ) ), std::abs( axis_y.dot( t_halfSize ) ), std::abs( axis_z.dot( t_halfSize ) ) );
+
+    if( m_thickness <= 0 || m_thickness >= size.x() || m_thickness >= size.y() || m_thickness >= size.z() )
+        G4Exception( "Wall::Wall", "InvalidSetup", FatalException, 
+                     ( "Wall `" + m_name + "' is thicker than half of the detector medium." ).c_str() );
+
+    m_position = axis_z * ( size.z() - m_thickness / 2 );
+
+    m_wall->set_material     ( m_constructionMessenger->get_detector_medium_material() );
+    m_wall->set_solid        ( new G4Trd( m_name, size.x() - m_thickness, size.x(), 
+                                                  size.y() - m_thickness, size.y(), m_thickness / 2 ) );
+    m_wall->set_visAttributes( new G4VisAttributes( false ) );
+    m_wall->make_logicalVolume();
+}
+
+Wall::~Wall() {
+    if( m_wall ) delete m_wall;
+    for( auto& rotationMatrix : m_rotationMatrices_local )
+        if( rotationMatrix.second ) 
+            delete rotationMatrix.second;
+    for( auto& container : m_containers )
+        if( container ) 
+            delete container;
+    for( auto& parameterisation : m_parameterisations )
+        if( parameterisation ) 
+            delete parameterisation;
+}
+
+void Wall::place( G4LogicalVolume* t_motherLogicalVolume, G4bool t_isMany, G4int t_copyNumber ) {
+    m_wall->place( m_rotationMatrix, m_position, t_motherLogicalVolume, t_isMany, t_copyNumber );
+}
+
+// Places a container of shape t_solid at t_position (wall frame) with copy number t_copyNumber
+// and fills it with t_amount copies of t_logicalVolume positioned by t_parameterisation
+// (container frame). The wall takes ownership of the parameterisation.
+void Wall::place_parameterised( const G4String       & t_name            , 
+                                G4VSolid             * t_solid           , 
+                                G4ThreeVector          t_position        , 
+                                G4int                  t_copyNumber      , 
+                                G4LogicalVolume      * t_logicalVolume   , 
+                                GridParameterisation * t_parameterisation, 
+                                G4int                  t_amount           ) {
+    GeometricObjectVSolid* container = new GeometricObjectVSolid();
+    container->set_material     ( m_constructionMessenger->get_detector_medium_material() );
+    container->set_solid        ( t_solid                                                 );
+    container->set_visAttributes( new G4VisAttributes( false )                            );
+    container->make_logicalVolume();
+    container->place( nullptr, t_position, m_wall->get_logicalVolume(), false, t_copyNumber );
+
+    new G4PVParameterised( t_name + "_parameterised", t_logicalVolume, container->get_logicalVolume(), 
+                           kUndefined, t_amount, t_parameterisation, false ); // see DetectorConstruction::check_overlaps
+
+    m_containers       .push_back( container          );
+    m_parameterisations.push_back( t_parameterisation );
+}
+
+// A daughter at t_position in the medium frame sits at m_rotationMatrix * ( t_position - m_position ) in the wall.
+G4ThreeVector Wall::get_position_local( G4ThreeVector t_position ) {
+    return *m_rotationMatrix * ( t_position - m_position );
+}
+
+// Rotation to place a daughter with so that it ends up with t_rotationMatrix in the
+// medium frame. Returns nullptr for daughters aligned with the wall (e.g. the DSPDs).
+G4RotationMatrix* Wall::get_rotationMatrix_local( G4RotationMatrix* t_rotationMatrix ) {
+    auto rotationMatrix = m_rotationMatrices_local.find( t_rotationMatrix );
+    if( rotationMatrix != m_rotationMatrices_local.end() )
+        return rotationMatrix->second;
+
+    G4RotationMatrix rotationMatrix_local = *t_rotationMatrix * m_rotationMatrix->inverse();
+    G4RotationMatrix* rotationMatrix_local_pointer = rotationMatrix_local.isIdentity() ? nullptr : new G4RotationMatrix( rotationMatrix_local );
+    m_rotationMatrices_local[ t_rotationMatrix ] = rotationMatrix_local_pointer;
+    return rotationMatrix_local_pointer;
+}
+
+// the containers are filled with the medium as well
+void Wall::set_sensitiveDetector( G4VSensitiveDetector* t_sensitiveDetector ) {
+    m_wall->set_sensitiveDetector( t_sensitiveDetector );
+    for( auto& container : m_containers )
+        container->set_sensitiveDetector( t_sensitiveDetector );
+}
+
+G4String Wall::get_name() {
+    return m_name;
+}
+
+G4LogicalVolume* Wall::get_logicalVolume() {
+    return m_wall->get_logicalVolume();
+}
+
+GeometricObjectTrd* Wall::get_geometricObject() {
+    return m_wall;
+}
+
+G4RotationMatrix* Wall::get_rotationMatrix() {
+    return m_rotationMatrix;
+}
+
+G4ThreeVector Wall::get_position() {
+    return m_position;
+}
+
+G4double Wall::get_thickness() {
+    return m_thickness;
+}
+
+vector< GeometricObjectVSolid* > Wall::get_containers() {
+    return m_containers;
+}
@@ -0,0 +1,219 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+// Compares LensSolid with the same lens built from Geant4 boolean solids: the aperture
+// prism intersected with (or, for a surface curving away from the lens, minus) the
+// ellipsoid of each surface, plus the flat rim outside yLimits of a square aperture.
+// At random points around each lens Inside must agree, and along random directions
+// DistanceToIn / DistanceToOut must agree and the safeties must not exceed them. Points
+// on a surface of either solid are skipped. Inside is also checked against the textbook
+// conic sag of each surface, which does not share LensSolid's expression. Returns the
+// number of failed lenses.
+
+#include "LensSolid.hh"
+
+#include "G4Box.hh"
+#include "G4Tubs.hh"
+#include "G4Ellipsoid.hh"
+#include "G4DisplacedSolid.hh"
+#include "G4IntersectionSolid.hh"
+#include "G4SubtractionSolid.hh"
+#include "G4UnionSolid.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using std::abs;
+using std::max;
+using std::min;
+using std::sqrt;
+using std::vector;
+
+struct Lens
+{
+    G4String m_name      ;
+    G4double m_radius_x[ 2 ];
+    G4double m_radius_y[ 2 ];
+    G4double m_thickness ;
+    G4double m_yLimits   ;
+    G4bool   m_circular  ;
+    G4double m_halfWidth ;
+};
+
+// z of surface t_surface at distance t_rho from the axis, flat outside yLimits. The sag is
+// that of a conic with vertex curvature c = |radius_x| / radius_y^2 and conic constant
+// k = radius_y^2 / radius_x^2 - 1; radius_x > 0 curves the surface towards -z.
+G4double get_surface_z( const Lens& t_lens, G4int t_surface, G4double t_rho ) {
+    G4double vertex   = ( t_surface == 0 ) ? -t_lens.m_thickness / 2 : t_lens.m_thickness / 2;
+    G4double radius_x = t_lens.m_radius_x[ t_surface ];
+    G4double radius_y = t_lens.m_radius_y[ t_surface ];
+    G4double rho      = min( t_rho, t_lens.m_yLimits );
+    G4double c        = abs( radius_x ) / ( radius_y * radius_y );
+    G4double k        = radius_y * radius_y / ( radius_x * radius_x ) - 1;
+    G4double sag      = c * rho * rho / ( 1 + sqrt( 1 - ( 1 + k ) * c * c * rho * rho ) );
+    return ( radius_x > 0 ) ? vertex - sag : vertex + sag;
+}
+
+// Inside from the sag and the aperture alone, kSurface within t_tolerance of a boundary
+EInside get_inside( const Lens& t_lens, const G4ThreeVector& t_position, G4double t_tolerance ) {
+    G4double rho      = t_position.perp();
+    G4double aperture = t_lens.m_circular ? rho - t_lens.m_yLimits
+                                          : max( abs( t_position.x() ), abs( t_position.y() ) ) - t_lens.m_halfWidth;
+    G4double outside  = max( { aperture, get_surface_z( t_lens, 0, rho ) - t_position.z(),
+                                         t_position.z() - get_surface_z( t_lens, 1, rho ) } );
+    if( outside > t_tolerance )
+        return kOutside;
+    return ( outside < -t_tolerance ) ? kInside : kSurface;
+}
+
+// The lens between t_zMin and t_zMax within t_aperture (centered on the axis at z = 0)
+G4VSolid* make_reference_surfaces( const Lens& t_lens, G4VSolid* t_aperture, G4double t_zMin, G4double t_zMax ) {
+    G4double  halfLength = max( t_lens.m_halfWidth, t_lens.m_yLimits ) + 1;
+    G4VSolid* slab       = new G4Box( t_lens.m_name + "_slab", halfLength, halfLength, ( t_zMax - t_zMin ) / 2 );
+    G4VSolid* solid      = new G4IntersectionSolid( t_lens.m_name + "_aperture", t_aperture, slab, nullptr,
+                                                    G4ThreeVector( 0, 0, ( t_zMin + t_zMax ) / 2 ) );
+
+    // the lens is inside the ellipsoid of the back surface if it is convex (radius_x < 0), of
+    // the front surface if it is convex (radius_x > 0), and outside of it otherwise
+    for( G4int surface{ 0 }; surface < 2; surface++ ) {
+        G4double      radius_x  = t_lens.m_radius_x[ surface ];
+        G4double      vertex    = ( surface == 0 ) ? -t_lens.m_thickness / 2 : t_lens.m_thickness / 2;
+        G4ThreeVector center( 0, 0, vertex - radius_x );
+        G4VSolid    * ellipsoid = new G4Ellipsoid( t_lens.m_name + "_ellipsoid_" + std::to_string( surface ),
+                                                   t_lens.m_radius_y[ surface ], t_lens.m_radius_y[ surface ], abs( radius_x ) );
+        G4bool inside = ( surface == 0 ) ? radius_x < 0 : radius_x > 0;
+        if( inside )
+            solid = new G4IntersectionSolid( t_lens.m_name + "_surface_" + std::to_string( surface ), solid, ellipsoid, nullptr, center );
+        else
+            solid = new G4SubtractionSolid ( t_lens.m_name + "_surface_" + std::to_string( surface ), solid, ellipsoid, nullptr, center );
+    }
+    return solid;
+}
+
+G4VSolid* make_reference( const Lens& t_lens ) {
+    G4double rho_max = t_lens.m_circular ? t_lens.m_yLimits : t_lens.m_halfWidth * sqrt( 2. );
+    G4double zMin    = min( get_surface_z( t_lens, 0, 0 ), get_surface_z( t_lens, 0, rho_max ) );
+    G4double zMax    = max( get_surface_z( t_lens, 1, 0 ), get_surface_z( t_lens, 1, rho_max ) );
+    G4double height  = zMax - zMin + 2;
+
+    G4VSolid* circle = new G4Tubs( t_lens.m_name + "_circle", 0, t_lens.m_yLimits, height, 0, twopi );
+    if( t_lens.m_circular )
+        return make_reference_surfaces( t_lens, circle, zMin, zMax );
+
+    // inside yLimits the curved surfaces, outside of it the flat rim between their edges
+    G4VSolid* square = new G4Box( t_lens.m_name + "_square", t_lens.m_halfWidth, t_lens.m_halfWidth, height );
+    G4VSolid* inner  = make_reference_surfaces( t_lens, new G4IntersectionSolid( t_lens.m_name + "_inner", square, circle ), zMin, zMax );
+    if( rho_max <= t_lens.m_yLimits )
+        return inner;
+
+    G4double  rim_zMin = get_surface_z( t_lens, 0, t_lens.m_yLimits );
+    G4double  rim_zMax = get_surface_z( t_lens, 1, t_lens.m_yLimits );
+    G4VSolid* rim      = new G4SubtractionSolid( t_lens.m_name + "_rim",
+                                                 new G4Box( t_lens.m_name + "_rim_box", t_lens.m_halfWidth, t_lens.m_halfWidth, ( rim_zMax - rim_zMin ) / 2 ),
+                                                 circle, nullptr, G4ThreeVector( 0, 0, -( rim_zMin + rim_zMax ) / 2 ) );
+    return new G4UnionSolid( t_lens.m_name + "_reference", inner, rim, nullptr, G4ThreeVector( 0, 0, ( rim_zMin + rim_zMax ) / 2 ) );
+}
+
+G4ThreeVector get_direction() {
+    G4double cosTheta = 2 * G4UniformRand() - 1;
+    G4double phi      = twopi * G4UniformRand();
+    return G4ThreeVector( sqrt( 1 - cosTheta * cosTheta ) * std::cos( phi ),
+                          sqrt( 1 - cosTheta * cosTheta ) * std::sin( phi ),
+                          cosTheta );
+}
+
+// Number of disagreements between LensSolid and the reference, the first few are printed
+G4int test( const Lens& t_lens, G4int t_points ) {
+    LensSolid lensSolid( t_lens.m_name, t_lens.m_radius_x[ 0 ], t_lens.m_radius_y[ 0 ], t_lens.m_radius_x[ 1 ], t_lens.m_radius_y[ 1 ],
+                         t_lens.m_thickness, t_lens.m_yLimits, t_lens.m_circular, t_lens.m_halfWidth );
+    G4VSolid* reference = make_reference( t_lens );
+
+    const G4double tolerance = 1e-6 * mm;
+    G4int problems{ 0 };
+    auto report = [ & ]( const G4String& t_problem, const G4ThreeVector& t_position, G4double t_lens, G4double t_reference ) {
+        if( problems++ < 10 )
+            G4cout << " |  |--< " << t_problem << " at " << t_position << " >: " << t_lens << " (reference " << t_reference << ")" << G4endl;
+    };
+
+    G4ThreeVector limit_min, limit_max;
+    lensSolid.BoundingLimits( limit_min, limit_max );
+    G4ThreeVector margin( 1 * mm, 1 * mm, 1 * mm );
+    limit_min -= margin;
+    limit_max += margin;
+
+    G4int inside{ 0 };
+    for( G4int nPoint{ 0 }; nPoint < t_points; nPoint++ ) {
+        G4ThreeVector position( limit_min.x() + ( limit_max.x() - limit_min.x() ) * G4UniformRand(),
+                                limit_min.y() + ( limit_max.y() - limit_min.y() ) * G4UniformRand(),
+                                limit_min.z() + ( limit_max.z() - limit_min.z() ) * G4UniformRand() );
+        G4ThreeVector direction = get_direction();
+
+        EInside inside_lens      = lensSolid .Inside( position );
+        EInside inside_reference = reference->Inside( position );
+        EInside inside_sag       = get_inside( t_lens, position, tolerance );
+        if( inside_lens != kSurface && inside_sag != kSurface && inside_lens != inside_sag )
+            report( "Inside (sag)", position, inside_lens, inside_sag );
+        if( inside_lens == kSurface || inside_reference == kSurface )
+            continue;
+        if( inside_lens != inside_reference ) {
+            report( "Inside", position, inside_lens, inside_reference );
+            continue;
+        }
+
+        G4double distance_lens, distance_reference, safety;
+        if( inside_lens == kInside ) {
+            inside++;
+            if( position.z() < limit_min.z() + margin.z() || position.z() > limit_max.z() - margin.z() )
+                report( "BoundingLimits", position, limit_min.z() + margin.z(), limit_max.z() - margin.z() );
+            distance_lens      = lensSolid .DistanceToOut( position, direction );
+            distance_reference = reference->DistanceToOut( position, direction );
+            safety             = lensSolid .DistanceToOut( position );
+        } else {
+            distance_lens      = lensSolid .DistanceToIn( position, direction );
+            distance_reference = reference->DistanceToIn( position, direction );
+            safety             = lensSolid .DistanceToIn( position );
+        }
+
+        G4bool missed = distance_lens >= kInfinity || distance_reference >= kInfinity;
+        if( ( missed && distance_lens != distance_reference ) ||
+            ( !missed && abs( distance_lens - distance_reference ) > tolerance ) )
+            report( ( inside_lens == kInside ) ? "DistanceToOut" : "DistanceToIn", position, distance_lens, distance_reference );
+        if( safety > distance_reference + tolerance )
+            report( ( inside_lens == kInside ) ? "DistanceToOut safety" : "DistanceToIn safety", position, safety, distance_reference );
+    }
+
+    G4cout << " |--< " << t_lens.m_name << " >: " << problems << " problems, " << inside << " of " << t_points << " points inside" << G4endl;
+    return problems;
+}
+
+int main() {
+    CLHEP::HepRandom::setTheSeed( 12345 );
+
+    // biconvex, convex-concave with the flat rim of a square aperture, concave-convex, and
+    // biconcave with a circular and with a square aperture
+    vector< Lens > lenses{ { "biconvex"        , { -40 * mm, 60 * mm }, { 50 * mm, 55 * mm }, 8 * mm, 20 * mm, true , 0       },
+                           { "convex_concave"  , { -30 * mm,-80 * mm }, { 40 * mm, 60 * mm }, 6 * mm, 15 * mm, false, 12 * mm },
+                           { "concave_convex"  , {  50 * mm, 35 * mm }, { 60 * mm, 45 * mm }, 5 * mm, 18 * mm, true , 0       },
+                           { "biconcave"       , {  40 * mm,-60 * mm }, { 50 * mm, 70 * mm }, 3 * mm, 20 * mm, true , 0       },
+                           { "biconcave_square", {  35 * mm,-45 * mm }, { 45 * mm, 50 * mm }, 2 * mm, 15 * mm, false, 12 * mm } };
+
+    G4int failed{ 0 };
+    G4cout << "[-]==: LensSolid test" << G4endl;
+    for( const Lens& lens : lenses )
+        if( test( lens, 20000 ) > 0 )
+            failed++;
+    G4cout << "[-]==: " << ( ( failed == 0 ) ? "passed" : "FAILED" ) << G4endl;
+
+    return failed;
+}
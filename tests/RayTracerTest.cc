@@ -0,0 +1,107 @@
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                    G4-DSPS-Detector-Simulation                      //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*// Author:                                                             //*//
+//*//   Noah Everett (noah.everett@mines.sdsmt.edu)                       //*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+//*//                                                                     //*//
+//*/////////////////////////////////////////////////////////////////////////*//
+
+// Checks the sequential ray tracer against closed-form optics, without Geant4:
+//  - a paraxial ray through a thick spherical lens crosses the axis at the back focal
+//    distance of the lensmaker's formula,
+//  - an axial ray is weighted by the Fresnel transmission at normal incidence of both surfaces,
+//  - a ray hitting the front surface beyond the critical angle is totally reflected,
+//  - a ray beside a circular lens passes it unchanged,
+//  - in a dispersive medium the travel time follows the group index n + dn / d( ln E ).
+// Returns the number of failed checks.
+
+#include "RayTracer.hh"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using std::abs;
+using std::cout;
+using std::endl;
+using std::string;
+
+int failed{ 0 };
+
+void check( const string& t_name, bool t_passed, double t_value, double t_expected ) {
+    cout << " |--< " << t_name << " >: " << t_value << " (expected " << t_expected << ") "
+         << ( t_passed ? "passed" : "FAILED" ) << endl;
+    if( !t_passed )
+        failed++;
+}
+
+void check_close( const string& t_name, double t_value, double t_expected, double t_tolerance ) {
+    check( t_name, abs( t_value - t_expected ) <= t_tolerance, t_value, t_expected );
+}
+
+// One photon starting at ( t_x, 0, t_z ) along +z, traced through t_rayTracer
+RayTracerBatch trace( const RayTracer& t_rayTracer, double t_x, double t_z ) {
+    RayTracerBatch batch( 1 );
+    batch.set( 0, t_x, 0, t_z, 0, 0, 1 );
+    t_rayTracer.trace( batch, 3e-6 );
+    return batch;
+}
+
+int main() {
+    cout << "[-]==: RayTracer test" << endl;
+
+    // biconvex spherical lens (radius_y = |radius_x|) in a medium
+    double rindex_medium = 1.33;
+    double rindex_lens   = 1.5;
+    double radius_1      = 50; // of curvature, in the optical sign convention
+    double radius_2      = -80;
+    double thickness     = 6;
+    RayTracer rayTracer( RayTracerMaterial( rindex_medium ), 200, 1000 );
+    rayTracer.add_lens( RayTracerLens( -radius_1, abs( radius_1 ), -radius_2, abs( radius_2 ), thickness, 0, 20, true,
+                                       RayTracerMaterial( rindex_lens ) ) );
+
+    // back focal distance from the front vertex, thick lens lensmaker's formula
+    double n     = rindex_lens / rindex_medium;
+    double power = ( n - 1 ) * ( 1 / radius_1 - 1 / radius_2 + ( n - 1 ) * thickness / ( n * radius_1 * radius_2 ) );
+    double backFocalDistance = ( 1 - ( n - 1 ) * thickness / ( n * radius_1 ) ) / power;
+
+    RayTracerBatch paraxial = trace( rayTracer, 0.01, -20 );
+    double focus = paraxial.m_z[ 0 ] - paraxial.m_x[ 0 ] * paraxial.m_dz[ 0 ] / paraxial.m_dx[ 0 ] - thickness / 2;
+    check( "paraxial ray detected", paraxial.m_status[ 0 ] == RayTracerBatch::m_detected, paraxial.m_status[ 0 ], RayTracerBatch::m_detected );
+    check_close( "back focal distance [mm]", focus, backFocalDistance, 1e-6 * backFocalDistance );
+
+    RayTracerBatch axial = trace( rayTracer, 0, -20 );
+    double reflectance = ( rindex_lens - rindex_medium ) * ( rindex_lens - rindex_medium )
+                       / ( ( rindex_lens + rindex_medium ) * ( rindex_lens + rindex_medium ) );
+    check_close( "axial Fresnel weight", axial.m_weight[ 0 ], ( 1 - reflectance ) * ( 1 - reflectance ), 1e-12 );
+
+    // planar back, strongly curved front: a ray parallel to the axis at height h meets the front
+    // at sin( incidence ) = h / radius, reflected beyond rindex_medium / rindex_lens
+    double radius_front = 12;
+    RayTracer rayTracer_TIR( RayTracerMaterial( 1 ), 200, 1000 );
+    rayTracer_TIR.add_lens( RayTracerLens( -1e6, 1e6, radius_front, radius_front, 8, 0, 10, true, RayTracerMaterial( rindex_lens ) ) );
+    double height_critical = radius_front / rindex_lens;
+
+    RayTracerBatch reflected = trace( rayTracer_TIR, 1.1 * height_critical, -20 );
+    check( "beyond the critical angle", reflected.m_status[ 0 ] == RayTracerBatch::m_reflected, reflected.m_status[ 0 ], RayTracerBatch::m_reflected );
+    RayTracerBatch refracted = trace( rayTracer_TIR, 0.9 * height_critical, -20 );
+    check( "within the critical angle", refracted.m_status[ 0 ] == RayTracerBatch::m_detected, refracted.m_status[ 0 ], RayTracerBatch::m_detected );
+
+    // outside yLimits of the circular lens
+    RayTracerBatch beside = trace( rayTracer, 25, -20 );
+    check( "beside the lens detected", beside.m_status[ 0 ] == RayTracerBatch::m_detected, beside.m_status[ 0 ], RayTracerBatch::m_detected );
+    check_close( "beside the lens x [mm]", beside.m_x     [ 0 ], 25, 1e-12 );
+    check_close( "beside the lens weight", beside.m_weight[ 0 ], 1 , 1e-12 );
+
+    // between the two energies of the table, n and dn / d( ln E ) are those of the interval
+    RayTracer      rayTracer_dispersion( RayTracerMaterial( { 2e-6, 4e-6 }, { 1.30, 1.36 } ), 200, 1000 );
+    RayTracerBatch dispersed  = trace( rayTracer_dispersion, 0, -20 );
+    double         groupIndex = ( 1.30 + 1.36 ) / 2 + ( 1.36 - 1.30 ) / std::log( 2. );
+    check_close( "group path length [mm]", dispersed.m_groupPathLength[ 0 ], 220 * groupIndex, 1e-9 );
+
+    cout << "[-]==: " << ( ( failed == 0 ) ? "passed" : "FAILED" ) << endl;
+    return failed;
+}